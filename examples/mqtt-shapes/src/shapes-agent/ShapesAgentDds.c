@@ -128,6 +128,7 @@ ShapesAgent_finalize(struct ShapesAgent *self)
         DDS_DynamicData_delete(self->shape);
         self->shape = NULL;
     }
+    RTI_TSFM_Json_Arena_finalize(&self->shape_arena);
 }
 
 int
@@ -143,6 +144,7 @@ ShapesAgent_initialize(struct ShapesAgent *self)
                         DDS_TYPE_ALLOCATION_PARAMS_DEFAULT;
     DDS_Entity *dp_entity = NULL;
     DDS_InstanceHandle_t dp_handle = DDS_HANDLE_NIL;
+    RTI_TSFM_Json_Arena def_arena = RTI_TSFM_Json_Arena_INITIALIZER;
 
     alloc_params.allocate_memory = RTI_TRUE;
     alloc_params.allocate_pointers = RTI_TRUE;
@@ -160,6 +162,7 @@ ShapesAgent_initialize(struct ShapesAgent *self)
     self->msg_sent_tot = 0;
     self->pub_msg = NULL;
     self->shape = NULL;
+    self->shape_arena = def_arena;
     self->thread_pub = NULL;
     self->thread_sub = NULL;
     self->topic_circles = NULL;
@@ -404,6 +407,13 @@ ShapesAgent_initialize(struct ShapesAgent *self)
         goto done;
     }
 
+    if (DDS_RETCODE_OK !=
+            RTI_TSFM_Json_Arena_initialize(&self->shape_arena, 0))
+    {
+        RTI_MQTT_ERROR("failed to initialize JSON arena")
+        goto done;
+    }
+
     ShapesAgent_setup_signal_handler();
 
     rc = 0;
@@ -607,8 +617,11 @@ ShapesAgent_print_mqtt_message(struct ShapesAgent *self,
             DDS_OctetSeq_get_contiguous_buffer(&msg->payload.data);
         
         if (DDS_RETCODE_OK != 
-                RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape(
-                    msg_payload, msg_payload_len, self->shape))
+                RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape_w_arena(
+                    &self->shape_arena,
+                    msg_payload,
+                    msg_payload_len,
+                    self->shape))
         {
             RTI_MQTT_ERROR("failed to deserialize JSON shape")
             goto done;
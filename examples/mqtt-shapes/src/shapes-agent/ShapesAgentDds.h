@@ -39,6 +39,7 @@ struct ShapesAgent
 
     RTI_MQTT_KeyedMessage           *pub_msg;
     DDS_DynamicData                 *shape;
+    RTI_TSFM_Json_Arena             shape_arena;
     char                            *topic_squares;
     char                            *topic_circles;
     char                            *topic_triangles;
@@ -0,0 +1,688 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+/* ========================================================================= */
+/* RTI Routing Service File Adapter                                          */
+/* ========================================================================= */
+/*                                                                           */
+/* Conversion between CDR records and DDS dynamic data samples               */
+/*                                                                           */
+/* When the FileFormat of a stream is "cdr", every sample is stored in the   */
+/* file as a length-prefixed record containing the sample serialized with    */
+/* DDS_DynamicData_to_cdr_buffer. Any type can be recorded and replayed      */
+/* this way, and no text needs to be formatted or parsed.                    */
+/*                                                                           */
+/* All the integers are little endian. The file is laid out as follows:      */
+/*                                                                           */
+/* header:  "RTIRSCDR" | version (4 bytes) | reserved (4 bytes)              */
+/* record:  length (4 bytes) | reserved (4 bytes) | CDR data | padding       */
+/* index:   offset of every record (8 bytes each)                            */
+/* trailer: record count (8 bytes) | index offset (8 bytes) | "RTIRSIDX"     */
+/*                                                                           */
+/* Records are padded to a multiple of 8 bytes, so that the CDR data of a    */
+/* memory-mapped file is always aligned. The index and trailer are written   */
+/* when the stream writer is deleted: files without them (e.g. if Routing    */
+/* Service was killed) can still be read up to their last complete record.   */
+/*                                                                           */
+/* Readers locate every record through the index, and stop after the number */
+/* of records in the trailer. A damaged record is then skipped, instead of   */
+/* ending the stream.                                                        */
+/*                                                                           */
+/* ========================================================================= */
+
+#ifndef RTI_WIN32
+  /* fseeko() and ftello(), with 64-bit offsets on 32-bit platforms too */
+  #define _LARGEFILE_SOURCE
+  #define _FILE_OFFSET_BITS 64
+  #include <sys/types.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "CdrConversion.h"
+
+/*
+ * Recorded files can be larger than 2 GB, which doesn't fit in the long
+ * used by fseek() and ftell()
+ */
+#ifdef RTI_WIN32
+  #define RTIRS_CdrFile_seek(file_, offset_) \
+      _fseeki64((file_), (__int64) (offset_), SEEK_SET)
+  #define RTIRS_CdrFile_size(file_, sizeOut_) \
+      (_fseeki64((file_), 0, SEEK_END) == 0 && \
+       (*(sizeOut_) = _ftelli64(file_)) >= 0)
+  typedef __int64 RTIRS_CdrFileOffset;
+#else
+  #define RTIRS_CdrFile_seek(file_, offset_) \
+      fseeko((file_), (off_t) (offset_), SEEK_SET)
+  #define RTIRS_CdrFile_size(file_, sizeOut_) \
+      (fseeko((file_), 0, SEEK_END) == 0 && \
+       (*(sizeOut_) = ftello(file_)) >= 0)
+  typedef off_t RTIRS_CdrFileOffset;
+#endif
+
+/* ========================================================================= */
+/*                                                                           */
+/* Utility                                                                   */
+/*                                                                           */
+/* ========================================================================= */
+
+static DDS_UnsignedLongLong RTIRS_CdrFile_align(DDS_UnsignedLongLong size)
+{
+    return (size + RTIRS_CDR_RECORD_ALIGNMENT - 1) &
+           ~((DDS_UnsignedLongLong) RTIRS_CDR_RECORD_ALIGNMENT - 1);
+}
+
+/*****************************************************************************/
+
+static void RTIRS_CdrFile_put_uint32(unsigned char * out, DDS_UnsignedLong value)
+{
+    int i;
+    for (i = 0; i < 4; i++) {
+        out[i] = (unsigned char) (value >> (8 * i));
+    }
+}
+
+/*****************************************************************************/
+
+static void RTIRS_CdrFile_put_uint64(
+    unsigned char * out,
+    DDS_UnsignedLongLong value)
+{
+    int i;
+    for (i = 0; i < 8; i++) {
+        out[i] = (unsigned char) (value >> (8 * i));
+    }
+}
+
+/*****************************************************************************/
+
+static DDS_UnsignedLong RTIRS_CdrFile_get_uint32(const unsigned char * in)
+{
+    return (DDS_UnsignedLong) in[0] |
+           ((DDS_UnsignedLong) in[1] << 8) |
+           ((DDS_UnsignedLong) in[2] << 16) |
+           ((DDS_UnsignedLong) in[3] << 24);
+}
+
+/*****************************************************************************/
+
+static DDS_UnsignedLongLong RTIRS_CdrFile_get_uint64(const unsigned char * in)
+{
+    DDS_UnsignedLongLong value = 0;
+    int i;
+    for (i = 7; i >= 0; i--) {
+        value = (value << 8) | in[i];
+    }
+    return value;
+}
+
+/*****************************************************************************/
+
+/*
+ * Checks the header of a file, and finds where its records end and how
+ * many there are according to its trailer (if it has a valid one)
+ */
+static int RTIRS_CdrFile_parse(
+    struct RTIRS_CdrFileReader * self,
+    const unsigned char * header,
+    const unsigned char * trailer,
+    DDS_UnsignedLongLong fileSize,
+    RTI_RoutingServiceEnvironment * env)
+{
+    DDS_UnsignedLongLong count;
+    DDS_UnsignedLongLong indexOffset;
+
+    if (fileSize < RTIRS_CDR_FILE_HEADER_SIZE ||
+        memcmp(header, RTIRS_CDR_FILE_MAGIC, RTIRS_CDR_MAGIC_SIZE) != 0) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Not a CDR file (FileFormat cdr)");
+        return 0;
+    }
+    if (RTIRS_CdrFile_get_uint32(header + RTIRS_CDR_MAGIC_SIZE) !=
+            RTIRS_CDR_FILE_VERSION) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Unsupported CDR file version %u",
+            (unsigned int) RTIRS_CdrFile_get_uint32(
+                header + RTIRS_CDR_MAGIC_SIZE));
+        return 0;
+    }
+
+    self->dataEnd = fileSize;
+    if (trailer == NULL ||
+        memcmp(trailer + 16, RTIRS_CDR_INDEX_MAGIC,
+               RTIRS_CDR_MAGIC_SIZE) != 0) {
+        /* No index: the writer didn't finish, read up to the end */
+        return 1;
+    }
+
+    count       = RTIRS_CdrFile_get_uint64(trailer);
+    indexOffset = RTIRS_CdrFile_get_uint64(trailer + 8);
+    if (indexOffset >= RTIRS_CDR_FILE_HEADER_SIZE &&
+        indexOffset <= fileSize - RTIRS_CDR_INDEX_TRAILER_SIZE &&
+        count == (fileSize - RTIRS_CDR_INDEX_TRAILER_SIZE - indexOffset) / 8) {
+        self->dataEnd     = indexOffset;
+        self->recordCount = count;
+    }
+
+    return 1;
+}
+
+/*****************************************************************************/
+
+static DDS_UnsignedLongLong RTIRS_CdrFileReader_offset(
+    const struct RTIRS_CdrFileReader * self,
+    DDS_UnsignedLongLong record)
+{
+    return RTIRS_CdrFile_get_uint64(self->index + 8 * record);
+}
+
+/*****************************************************************************/
+
+/*
+ * Uses the index read or mapped at self->index, unless its offsets don't
+ * point to consecutive records between the header and the index itself
+ */
+static void RTIRS_CdrFileReader_check_index(struct RTIRS_CdrFileReader * self)
+{
+    DDS_UnsignedLongLong i;
+    DDS_UnsignedLongLong previous = 0;
+    DDS_UnsignedLongLong offset;
+
+    for (i = 0; i < self->recordCount && self->index != NULL; i++) {
+        offset = RTIRS_CdrFileReader_offset(self, i);
+        if (offset < RTIRS_CDR_FILE_HEADER_SIZE ||
+            offset > self->dataEnd - RTIRS_CDR_RECORD_HEADER_SIZE ||
+            offset % RTIRS_CDR_RECORD_ALIGNMENT != 0 ||
+            (i > 0 && offset <= previous)) {
+            self->index = NULL;
+        }
+        previous = offset;
+    }
+
+    if (self->index == NULL) {
+        self->recordCount = 0;
+        free(self->indexBuffer);
+        self->indexBuffer = NULL;
+    }
+}
+
+/*****************************************************************************/
+
+/*
+ * Finds the bounds of the next record: the index gives where it starts and
+ * where the following one starts. Without an index, records are read one
+ * after the other up to dataEnd.
+ */
+static void RTIRS_CdrFileReader_next_record(
+    struct RTIRS_CdrFileReader * self,
+    DDS_UnsignedLongLong * start,
+    DDS_UnsignedLongLong * end)
+{
+    if (self->index == NULL) {
+        *start = self->position;
+        *end   = self->dataEnd;
+        return;
+    }
+
+    *start = RTIRS_CdrFileReader_offset(self, self->record);
+    *end   = (self->record + 1 < self->recordCount)
+             ? RTIRS_CdrFileReader_offset(self, self->record + 1)
+             : self->dataEnd;
+    self->record++;
+}
+
+/* ========================================================================= */
+/*                                                                           */
+/* Write record                                                              */
+/*                                                                           */
+/* ========================================================================= */
+
+/**
+ * @brief Writes the header of a CDR file
+ *
+ * @return 0 for error, 1 for success.
+ */
+int RTIRS_CdrFileWriter_open(
+    struct RTIRS_CdrFileWriter * self,
+    FILE * file,
+    RTI_RoutingServiceEnvironment * env)
+{
+    unsigned char header[RTIRS_CDR_FILE_HEADER_SIZE];
+
+    memset(self, 0, sizeof(struct RTIRS_CdrFileWriter));
+    memset(header, 0, sizeof(header));
+
+    memcpy(header, RTIRS_CDR_FILE_MAGIC, RTIRS_CDR_MAGIC_SIZE);
+    RTIRS_CdrFile_put_uint32(
+        header + RTIRS_CDR_MAGIC_SIZE, RTIRS_CDR_FILE_VERSION);
+
+    if (fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Error writing CDR file header");
+        return 0;
+    }
+    self->position = RTIRS_CDR_FILE_HEADER_SIZE;
+
+    return 1;
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Serializes a sample and writes it as a record
+ *
+ * @return 0 for error, 1 for success.
+ */
+int RTIRS_CdrFileWriter_write_sample(
+    struct RTIRS_CdrFileWriter * self,
+    struct DDS_DynamicData * sample,
+    FILE * file,
+    RTI_RoutingServiceEnvironment * env)
+{
+    unsigned char recordHeader[RTIRS_CDR_RECORD_HEADER_SIZE];
+    DDS_UnsignedLong length = 0;
+    DDS_UnsignedLong paddedLength;
+    DDS_UnsignedLongLong * offsets = NULL;
+    char * buffer = NULL;
+    size_t capacity;
+
+    /* Get the serialized size first */
+    if (DDS_DynamicData_to_cdr_buffer(sample, NULL, &length)
+            != DDS_RETCODE_OK) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Error getting serialized size of sample");
+        return 0;
+    }
+    paddedLength = (DDS_UnsignedLong) RTIRS_CdrFile_align(length);
+
+    if (paddedLength > self->bufferSize) {
+        buffer = realloc(self->buffer, paddedLength);
+        if (buffer == NULL) {
+            RTI_RoutingServiceEnvironment_set_error(
+                env, "Memory allocation error");
+            return 0;
+        }
+        self->buffer     = buffer;
+        self->bufferSize = paddedLength;
+    }
+
+    if (self->count == self->capacity) {
+        capacity = (self->capacity == 0) ? 1024 : self->capacity * 2;
+        offsets = realloc(
+            self->offsets, capacity * sizeof(DDS_UnsignedLongLong));
+        if (offsets == NULL) {
+            RTI_RoutingServiceEnvironment_set_error(
+                env, "Memory allocation error");
+            return 0;
+        }
+        self->offsets  = offsets;
+        self->capacity = capacity;
+    }
+
+    if (DDS_DynamicData_to_cdr_buffer(sample, self->buffer, &length)
+            != DDS_RETCODE_OK) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Error serializing sample");
+        return 0;
+    }
+    memset(self->buffer + length, 0, paddedLength - length);
+
+    memset(recordHeader, 0, sizeof(recordHeader));
+    RTIRS_CdrFile_put_uint32(recordHeader, length);
+
+    if (fwrite(recordHeader, 1, sizeof(recordHeader), file)
+            != sizeof(recordHeader) ||
+        fwrite(self->buffer, 1, paddedLength, file) != paddedLength) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Error writing CDR record");
+        return 0;
+    }
+
+    self->offsets[self->count++] = self->position;
+    self->position += RTIRS_CDR_RECORD_HEADER_SIZE + paddedLength;
+
+    return 1;
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Writes the index footer of a CDR file and frees the writer
+ *
+ * @return 0 for error, 1 for success.
+ */
+int RTIRS_CdrFileWriter_close(
+    struct RTIRS_CdrFileWriter * self,
+    FILE * file,
+    RTI_RoutingServiceEnvironment * env)
+{
+    unsigned char entry[8];
+    unsigned char trailer[RTIRS_CDR_INDEX_TRAILER_SIZE];
+    size_t i;
+    int ok = 1;
+
+    for (i = 0; i < self->count && ok; i++) {
+        RTIRS_CdrFile_put_uint64(entry, self->offsets[i]);
+        ok = (fwrite(entry, 1, sizeof(entry), file) == sizeof(entry));
+    }
+
+    RTIRS_CdrFile_put_uint64(trailer, (DDS_UnsignedLongLong) self->count);
+    RTIRS_CdrFile_put_uint64(trailer + 8, self->position);
+    memcpy(trailer + 16, RTIRS_CDR_INDEX_MAGIC, RTIRS_CDR_MAGIC_SIZE);
+    if (ok) {
+        ok = (fwrite(trailer, 1, sizeof(trailer), file) == sizeof(trailer));
+    }
+
+    if (!ok) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Error writing CDR file index");
+    }
+
+    free(self->buffer);
+    free(self->offsets);
+    memset(self, 0, sizeof(struct RTIRS_CdrFileWriter));
+
+    return ok;
+}
+
+/* ========================================================================= */
+/*                                                                           */
+/* Read record                                                               */
+/*                                                                           */
+/* ========================================================================= */
+
+/**
+ * @brief Checks the header of a CDR file and finds its index, leaving
+ * the file positioned at the first record
+ *
+ * @return 0 for error, 1 for success.
+ */
+int RTIRS_CdrFileReader_open(
+    struct RTIRS_CdrFileReader * self,
+    FILE * file,
+    RTI_RoutingServiceEnvironment * env)
+{
+    unsigned char header[RTIRS_CDR_FILE_HEADER_SIZE];
+    unsigned char trailer[RTIRS_CDR_INDEX_TRAILER_SIZE];
+    const unsigned char * trailerRead = NULL;
+    RTIRS_CdrFileOffset fileSize = 0;
+    size_t indexSize;
+
+    memset(self, 0, sizeof(struct RTIRS_CdrFileReader));
+
+    if (!RTIRS_CdrFile_size(file, &fileSize)) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Could not get size of CDR file");
+        return 0;
+    }
+
+    if (fileSize >= RTIRS_CDR_FILE_HEADER_SIZE + RTIRS_CDR_INDEX_TRAILER_SIZE &&
+        RTIRS_CdrFile_seek(file, fileSize - RTIRS_CDR_INDEX_TRAILER_SIZE) == 0 &&
+        fread(trailer, 1, sizeof(trailer), file) == sizeof(trailer)) {
+        trailerRead = trailer;
+    }
+
+    memset(header, 0, sizeof(header));
+    if (RTIRS_CdrFile_seek(file, 0) != 0) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Could not read CDR file header");
+        return 0;
+    }
+    if (fread(header, 1, sizeof(header), file) != sizeof(header)) {
+        fileSize = 0;
+    }
+
+    if (!RTIRS_CdrFile_parse(
+            self, header, trailerRead, (DDS_UnsignedLongLong) fileSize, env)) {
+        return 0;
+    }
+
+    /* The index takes 8 bytes per record, like the one kept by the writer */
+    indexSize = (size_t) self->recordCount * 8;
+    if (self->recordCount > 0 &&
+        (DDS_UnsignedLongLong) indexSize / 8 == self->recordCount) {
+        self->indexBuffer = malloc(indexSize);
+        if (self->indexBuffer != NULL &&
+            RTIRS_CdrFile_seek(file, self->dataEnd) == 0 &&
+            fread(self->indexBuffer, 1, indexSize, file) == indexSize) {
+            self->index = self->indexBuffer;
+        }
+    }
+    RTIRS_CdrFileReader_check_index(self);
+
+    self->position = RTIRS_CDR_FILE_HEADER_SIZE;
+    if (RTIRS_CdrFile_seek(file, self->position) != 0) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Could not read CDR file records");
+        RTIRS_CdrFileReader_close(self);
+        return 0;
+    }
+
+    return 1;
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Checks the header of a memory-mapped CDR file and finds its index
+ *
+ * @return 0 for error, 1 for success.
+ */
+int RTIRS_CdrFileReader_open_mapped(
+    struct RTIRS_CdrFileReader * self,
+    const struct RTIRS_MappedFile * file,
+    RTI_RoutingServiceEnvironment * env)
+{
+    const unsigned char * data = (const unsigned char *) file->data;
+    const unsigned char * trailer = NULL;
+    static const unsigned char empty[RTIRS_CDR_FILE_HEADER_SIZE] = { 0 };
+
+    memset(self, 0, sizeof(struct RTIRS_CdrFileReader));
+
+    if (file->size >= RTIRS_CDR_FILE_HEADER_SIZE + RTIRS_CDR_INDEX_TRAILER_SIZE) {
+        trailer = data + file->size - RTIRS_CDR_INDEX_TRAILER_SIZE;
+    }
+
+    if (!RTIRS_CdrFile_parse(
+            self,
+            (file->size >= RTIRS_CDR_FILE_HEADER_SIZE) ? data : empty,
+            trailer, (DDS_UnsignedLongLong) file->size, env)) {
+        return 0;
+    }
+
+    if (self->recordCount > 0) {
+        self->index = data + self->dataEnd;
+    }
+    RTIRS_CdrFileReader_check_index(self);
+    self->position = RTIRS_CDR_FILE_HEADER_SIZE;
+
+    return 1;
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Reads the next record of a CDR file to provide the values of
+ * one dynamic data sample
+ *
+ * @param self The reader
+ * @param sampleOut The sample to deserialize
+ * @param file The file from which to read
+ * @param buffer A buffer of allocated memory that can be used to read
+ * @param maxSampleSize The size of \ref buffer, which limits the size
+ *        of the records
+ * @param env The environment to report error messages
+ *
+ * @return 0 for error, 1 for success, -1 to indicate that the sample
+ *         should not be sent.
+ */
+enum RTIRS_FileAdapter_READ_ACTION RTIRS_CdrFileReader_read_sample(
+    struct RTIRS_CdrFileReader * self,
+    struct DDS_DynamicData * sampleOut,
+    FILE * file,
+    char * buffer,
+    int maxSampleSize,
+    RTI_RoutingServiceEnvironment * env)
+{
+    unsigned char recordHeader[RTIRS_CDR_RECORD_HEADER_SIZE];
+    unsigned char padding[RTIRS_CDR_RECORD_ALIGNMENT];
+    DDS_UnsignedLong length;
+    DDS_UnsignedLongLong paddedLength;
+    DDS_UnsignedLongLong start;
+    DDS_UnsignedLongLong end;
+
+    if (RTIRS_CdrFileReader_eof(self)) {
+        return -1;
+    }
+
+    RTIRS_CdrFileReader_next_record(self, &start, &end);
+    if (start != self->position) {
+        /* The previous record was damaged, or followed by a gap */
+        if (RTIRS_CdrFile_seek(file, start) != 0) {
+            RTI_RoutingServiceEnvironment_set_error(
+                env, "Could not seek to CDR record");
+            return 0;
+        }
+        self->position = start;
+    }
+
+    if (fread(recordHeader, 1, sizeof(recordHeader), file)
+            != sizeof(recordHeader)) {
+        /* Incomplete last record */
+        self->position = self->dataEnd;
+        return -1;
+    }
+    self->position += RTIRS_CDR_RECORD_HEADER_SIZE;
+    length = RTIRS_CdrFile_get_uint32(recordHeader);
+    paddedLength = RTIRS_CdrFile_align(length);
+
+    if (self->position + length > end) {
+        /* Incomplete last record, or a damaged one if there is an index:
+           the next read then seeks to the following record */
+        if (self->index == NULL) {
+            self->position = self->dataEnd;
+        }
+        return -1;
+    }
+    if (length > (DDS_UnsignedLong) maxSampleSize) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "CDR record of %u bytes exceeds MaxSampleSize",
+            (unsigned int) length);
+        return 0;
+    }
+    if (fread(buffer, 1, length, file) != length ||
+        fread(padding, 1, (size_t) (paddedLength - length), file)
+            != paddedLength - length) {
+        self->position = self->dataEnd;
+        return -1;
+    }
+    self->position += paddedLength;
+
+    if (DDS_DynamicData_from_cdr_buffer(sampleOut, buffer, length)
+            != DDS_RETCODE_OK) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Error deserializing CDR record");
+        return 0;
+    }
+
+    return 1;
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Deserializes the next record of a memory-mapped CDR file
+ * directly from the mapping
+ *
+ * @return 0 for error, 1 for success, -1 to indicate that the sample
+ *         should not be sent.
+ */
+enum RTIRS_FileAdapter_READ_ACTION RTIRS_CdrFileReader_read_mapped_sample(
+    struct RTIRS_CdrFileReader * self,
+    struct DDS_DynamicData * sampleOut,
+    const struct RTIRS_MappedFile * file,
+    RTI_RoutingServiceEnvironment * env)
+{
+    const unsigned char * record = NULL;
+    DDS_UnsignedLong length;
+    DDS_UnsignedLongLong end;
+
+    if (RTIRS_CdrFileReader_eof(self)) {
+        return -1;
+    }
+
+    RTIRS_CdrFileReader_next_record(self, &self->position, &end);
+    record = (const unsigned char *) file->data + self->position;
+    if (end - self->position < RTIRS_CDR_RECORD_HEADER_SIZE) {
+        self->position = self->dataEnd;
+        return -1;
+    }
+    length = RTIRS_CdrFile_get_uint32(record);
+    if (end - self->position - RTIRS_CDR_RECORD_HEADER_SIZE < length) {
+        /* Incomplete last record, or a damaged one if there is an index */
+        self->position = (self->index != NULL) ? end : self->dataEnd;
+        return -1;
+    }
+    self->position += RTIRS_CDR_RECORD_HEADER_SIZE +
+                      RTIRS_CdrFile_align(length);
+
+    if (DDS_DynamicData_from_cdr_buffer(
+            sampleOut,
+            (const char *) record + RTIRS_CDR_RECORD_HEADER_SIZE,
+            length) != DDS_RETCODE_OK) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Error deserializing CDR record");
+        return 0;
+    }
+
+    return 1;
+}
+
+/*****************************************************************************/
+
+int RTIRS_CdrFileReader_eof(const struct RTIRS_CdrFileReader * self)
+{
+    if (self->index != NULL) {
+        return self->record >= self->recordCount;
+    }
+    return self->position >= self->dataEnd;
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Moves back to the first record. file is NULL for
+ * memory-mapped files.
+ */
+void RTIRS_CdrFileReader_rewind(
+    struct RTIRS_CdrFileReader * self,
+    FILE * file)
+{
+    self->position = RTIRS_CDR_FILE_HEADER_SIZE;
+    self->record   = 0;
+    if (file != NULL) {
+        RTIRS_CdrFile_seek(file, RTIRS_CDR_FILE_HEADER_SIZE);
+    }
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Frees the index read by RTIRS_CdrFileReader_open
+ */
+void RTIRS_CdrFileReader_close(struct RTIRS_CdrFileReader * self)
+{
+    free(self->indexBuffer);
+    memset(self, 0, sizeof(struct RTIRS_CdrFileReader));
+}
@@ -0,0 +1,156 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+/* ========================================================================= */
+/* RTI Routing Service File Adapter                                          */
+/* ========================================================================= */
+/*                                                                           */
+/* See CdrConversion.c                                                       */
+/*                                                                           */
+/* ========================================================================= */
+
+#ifndef _cdrconversion_h_
+#define _cdrconversion_h_
+
+#include <stdio.h>
+#include "rtiadapt_file.h"
+#include "LineConversion.h"
+#include "MappedFile.h"
+
+#define RTIRS_CDR_FILE_MAGIC            "RTIRSCDR"
+#define RTIRS_CDR_INDEX_MAGIC           "RTIRSIDX"
+#define RTIRS_CDR_MAGIC_SIZE            8
+#define RTIRS_CDR_FILE_VERSION          1
+
+#define RTIRS_CDR_FILE_HEADER_SIZE      16
+#define RTIRS_CDR_RECORD_HEADER_SIZE    8
+#define RTIRS_CDR_INDEX_TRAILER_SIZE    24
+#define RTIRS_CDR_RECORD_ALIGNMENT      8
+
+/* stdio buffer of the files, so that records are read and written in bulk */
+#define RTIRS_CDR_FILE_BUFFER_SIZE      (1024 * 1024)
+
+/* ========================================================================= */
+/*                                                                           */
+/* Data types                                                                */
+/*                                                                           */
+/* ========================================================================= */
+
+/*
+ * Writes a CDR file: serializes every sample in a reusable buffer, and
+ * keeps the offset of every record for the index footer.
+ */
+struct RTIRS_CdrFileWriter {
+    char * buffer;
+    DDS_UnsignedLong bufferSize;
+
+    DDS_UnsignedLongLong * offsets;
+    size_t count;
+    size_t capacity;
+
+    DDS_UnsignedLongLong position;
+};
+
+/*
+ * Reads the records of a CDR file between its header and dataEnd (the
+ * index footer, or the end of the file if there is no footer). index
+ * points to the offsets of the recordCount records of the footer, in the
+ * mapped file or in indexBuffer. It is NULL if the file has no valid
+ * footer. record is the number of the next record to read.
+ */
+struct RTIRS_CdrFileReader {
+    DDS_UnsignedLongLong position;
+    DDS_UnsignedLongLong dataEnd;
+
+    const unsigned char * index;
+    unsigned char * indexBuffer;
+    DDS_UnsignedLongLong recordCount;
+    DDS_UnsignedLongLong record;
+};
+
+/* ========================================================================= */
+/*                                                                           */
+/* Write record                                                              */
+/*                                                                           */
+/* ========================================================================= */
+
+int RTIRS_CdrFileWriter_open(
+    struct RTIRS_CdrFileWriter * self,
+    FILE * file,
+    RTI_RoutingServiceEnvironment * env);
+
+/*****************************************************************************/
+
+int RTIRS_CdrFileWriter_write_sample(
+    struct RTIRS_CdrFileWriter * self,
+    struct DDS_DynamicData * sample,
+    FILE * file,
+    RTI_RoutingServiceEnvironment * env);
+
+/*****************************************************************************/
+
+int RTIRS_CdrFileWriter_close(
+    struct RTIRS_CdrFileWriter * self,
+    FILE * file,
+    RTI_RoutingServiceEnvironment * env);
+
+/* ========================================================================= */
+/*                                                                           */
+/* Read record                                                               */
+/*                                                                           */
+/* ========================================================================= */
+
+int RTIRS_CdrFileReader_open(
+    struct RTIRS_CdrFileReader * self,
+    FILE * file,
+    RTI_RoutingServiceEnvironment * env);
+
+/*****************************************************************************/
+
+int RTIRS_CdrFileReader_open_mapped(
+    struct RTIRS_CdrFileReader * self,
+    const struct RTIRS_MappedFile * file,
+    RTI_RoutingServiceEnvironment * env);
+
+/*****************************************************************************/
+
+enum RTIRS_FileAdapter_READ_ACTION RTIRS_CdrFileReader_read_sample(
+    struct RTIRS_CdrFileReader * self,
+    struct DDS_DynamicData * sampleOut,
+    FILE * file,
+    char * buffer,
+    int maxSampleSize,
+    RTI_RoutingServiceEnvironment * env);
+
+/*****************************************************************************/
+
+enum RTIRS_FileAdapter_READ_ACTION RTIRS_CdrFileReader_read_mapped_sample(
+    struct RTIRS_CdrFileReader * self,
+    struct DDS_DynamicData * sampleOut,
+    const struct RTIRS_MappedFile * file,
+    RTI_RoutingServiceEnvironment * env);
+
+/*****************************************************************************/
+
+int RTIRS_CdrFileReader_eof(const struct RTIRS_CdrFileReader * self);
+
+/*****************************************************************************/
+
+void RTIRS_CdrFileReader_rewind(
+    struct RTIRS_CdrFileReader * self,
+    FILE * file);
+
+/*****************************************************************************/
+
+void RTIRS_CdrFileReader_close(struct RTIRS_CdrFileReader * self);
+
+#endif
@@ -22,6 +22,11 @@
 /* ========================================================================= */
 
 
+#ifndef RTI_WIN32
+  /* Files larger than 2 GB can be opened on 32-bit platforms too */
+  #define _FILE_OFFSET_BITS 64
+#endif
+
 #include <stdio.h>
 #include <string.h>
 
@@ -47,8 +52,21 @@
   #include <sys/select.h>
   #include <semaphore.h>
   #include <pthread.h> 
+  #include <errno.h>
+  #include <time.h>
 #endif
 
+/*
+ * Files read with ReadMode "mmap" are implemented in MappedFile.c
+ */
+#include "MappedFile.h"
+
+/*
+ * The mapping between samples and CDR records (FileFormat "cdr")
+ * is implemented in CdrConversion.c
+ */
+#include "CdrConversion.h"
+
 
 /* ========================================================================= */
 /*                                                                           */
@@ -69,9 +87,42 @@ struct RTIRS_FileConnection {
 
 /*****************************************************************************/
 
+enum RTIRS_FileAdapter_FILE_FORMAT {
+    FILE_FORMAT_TEXT = 0,
+    FILE_FORMAT_CDR  = 1
+};
+
+/*****************************************************************************/
+
 struct RTIRS_FileStreamWriter {
     FILE * file;
     int flushEnabled;
+
+    int fileFormat;
+    struct RTIRS_CdrFileWriter cdrWriter;
+};
+
+/*****************************************************************************/
+
+enum RTIRS_FileStreamReader_READ_MODE {
+    READ_MODE_STREAM = 0,
+    READ_MODE_MMAP   = 1
+};
+
+/*
+ * Special values of ReplayRate. Any other value is a number of samples
+ * per second.
+ */
+#define RTIRS_FILE_REPLAY_RATE_PERIOD   0
+#define RTIRS_FILE_REPLAY_RATE_MAX      (-1)
+
+/*
+ * Reference point used to replay samples at ReplayRate
+ */
+struct RTIRS_FileReplayClock {
+    DDS_UnsignedLongLong startUsec;
+    int startCount;
+    int rate;
 };
 
 /*****************************************************************************/
@@ -108,6 +159,30 @@ struct RTIRS_FileStreamReader {
     int samplesReadCount;
   
   FILE * file;
+
+    int readMode;
+    struct RTIRS_MappedFile mappedFile;
+
+    int fileFormat;
+    struct RTIRS_CdrFileReader cdrReader;
+
+    /* Print every notification and read (only in ReadMode "stream") */
+    int verbose;
+
+    /*
+     * Unless replayRate is RTIRS_FILE_REPLAY_RATE_PERIOD, data is only
+     * notified again once the previous notification has been read
+     */
+    int replayRate;
+    int _readDone;
+    int _readDoneInitialized;
+  #ifdef RTI_WIN32
+    CRITICAL_SECTION _readDoneMutex;
+    CONDITION_VARIABLE _readDoneCond;
+  #else
+    pthread_mutex_t _readDoneMutex;
+    pthread_cond_t _readDoneCond;
+  #endif
 };
 
 /* ========================================================================= */
@@ -116,29 +191,268 @@ struct RTIRS_FileStreamReader {
 /*                                                                           */
 /* ========================================================================= */
 
+DDS_UnsignedLongLong RTIRS_FileStreamReader_now(void)
+{
+  #ifdef RTI_WIN32
+    LARGE_INTEGER now, freq;
+
+    if (!QueryPerformanceCounter(&now) || !QueryPerformanceFrequency(&freq)) {
+        return 0;
+    }
+    return ((DDS_UnsignedLongLong)(now.QuadPart / freq.QuadPart) * 1000000) +
+           (((now.QuadPart % freq.QuadPart) * 1000000) / freq.QuadPart);
+  #else
+    struct timespec now;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &now) != 0) {
+        return 0;
+    }
+    return ((DDS_UnsignedLongLong)now.tv_sec * 1000000) +
+           (now.tv_nsec / 1000);
+  #endif
+}
+
+/*****************************************************************************/
+
+/*
+ * Called by the session thread once it has read the data notified by
+ * RTIRS_FileStreamReader_run
+ */
+void RTIRS_FileStreamReader_signalReadDone(
+    struct RTIRS_FileStreamReader * self)
+{
+  #ifdef RTI_WIN32
+    EnterCriticalSection(&self->_readDoneMutex);
+    self->_readDone = 1;
+    WakeConditionVariable(&self->_readDoneCond);
+    LeaveCriticalSection(&self->_readDoneMutex);
+  #else
+    pthread_mutex_lock(&self->_readDoneMutex);
+    self->_readDone = 1;
+    pthread_cond_signal(&self->_readDoneCond);
+    pthread_mutex_unlock(&self->_readDoneMutex);
+  #endif
+}
+
+/*****************************************************************************/
+
+/*
+ * Waits until the session thread has read the last notification, for
+ * at most timeout. Returns 1 if the data was read.
+ */
+int RTIRS_FileStreamReader_waitReadDone(
+    struct RTIRS_FileStreamReader * self,
+    const struct DDS_Duration_t * timeout)
+{
+    int readDone;
+  #ifdef RTI_WIN32
+    DWORD timeoutMs = timeout->sec * 1000 + timeout->nanosec / 1000000;
+
+    EnterCriticalSection(&self->_readDoneMutex);
+    while (!self->_readDone) {
+        if (!SleepConditionVariableCS(
+                &self->_readDoneCond, &self->_readDoneMutex, timeoutMs)) {
+            break;
+        }
+    }
+  #else
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec  += timeout->sec;
+    deadline.tv_nsec += timeout->nanosec;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec  += 1;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&self->_readDoneMutex);
+    while (!self->_readDone) {
+        if (pthread_cond_timedwait(
+                &self->_readDoneCond, &self->_readDoneMutex,
+                &deadline) == ETIMEDOUT) {
+            break;
+        }
+    }
+  #endif
+
+    readDone = self->_readDone;
+    self->_readDone = 0;
+
+  #ifdef RTI_WIN32
+    LeaveCriticalSection(&self->_readDoneMutex);
+  #else
+    pthread_mutex_unlock(&self->_readDoneMutex);
+  #endif
+
+    return readDone;
+}
+
+/*****************************************************************************/
+
+/*
+ * Sleeps until the samples read since the clock was started are due
+ * according to ReplayRate
+ */
+void RTIRS_FileStreamReader_throttle(
+    struct RTIRS_FileStreamReader * self,
+    struct RTIRS_FileReplayClock * clock)
+{
+    DDS_UnsignedLongLong now = RTIRS_FileStreamReader_now();
+    DDS_UnsignedLongLong due;
+    struct DDS_Duration_t delay;
+
+    if (clock->rate != self->replayRate) {
+        clock->startUsec  = now;
+        clock->startCount = self->samplesReadCount;
+        clock->rate       = self->replayRate;
+        return;
+    }
+
+    due = clock->startUsec +
+          (DDS_UnsignedLongLong)(self->samplesReadCount - clock->startCount) *
+          1000000 / clock->rate;
+
+    if (now >= due) {
+        /*
+         * Don't try to catch up after falling behind by more than a
+         * second (e.g. while the route was paused)
+         */
+        if (now - due > 1000000) {
+            clock->startUsec  = now;
+            clock->startCount = self->samplesReadCount;
+        }
+        return;
+    }
+
+    delay.sec     = (DDS_Long) ((due - now) / 1000000);
+    delay.nanosec = (DDS_UnsignedLong) ((due - now) % 1000000) * 1000;
+    NDDS_Utility_sleep(&delay);
+}
+
+/*****************************************************************************/
+
+int RTIRS_FileStreamReader_eof(struct RTIRS_FileStreamReader * self)
+{
+    if (self->fileFormat == FILE_FORMAT_CDR) {
+        return RTIRS_CdrFileReader_eof(&self->cdrReader);
+    }
+    if (self->readMode == READ_MODE_MMAP) {
+        return RTIRS_MappedFile_eof(&self->mappedFile);
+    }
+    return feof(self->file);
+}
+
+/*****************************************************************************/
+
+void RTIRS_FileStreamReader_rewind(struct RTIRS_FileStreamReader * self)
+{
+    if (self->fileFormat == FILE_FORMAT_CDR) {
+        RTIRS_CdrFileReader_rewind(
+            &self->cdrReader,
+            (self->readMode == READ_MODE_MMAP) ? NULL : self->file);
+    } else if (self->readMode == READ_MODE_MMAP) {
+        RTIRS_MappedFile_rewind(&self->mappedFile);
+    } else {
+        fseek(self->file, 0, SEEK_SET);
+    }
+}
+
+/*****************************************************************************/
+
+/*
+ * Whether there are samples left to read. The file is rewound here
+ * when Loop is enabled.
+ */
+int RTIRS_FileStreamReader_hasData(struct RTIRS_FileStreamReader * self)
+{
+    if (self->loop && RTIRS_FileStreamReader_eof(self)) {
+        RTIRS_FileStreamReader_rewind(self);
+    }
+    return !RTIRS_FileStreamReader_eof(self);
+}
+
+/*****************************************************************************/
+
+/*
+ * Reads the next sample with the FileFormat and ReadMode of the stream
+ */
+enum RTIRS_FileAdapter_READ_ACTION RTIRS_FileStreamReader_readSample(
+    struct RTIRS_FileStreamReader * self,
+    struct DDS_DynamicData * sample,
+    RTI_RoutingServiceEnvironment * env)
+{
+    if (self->fileFormat == FILE_FORMAT_CDR) {
+        if (self->readMode == READ_MODE_MMAP) {
+            return RTIRS_CdrFileReader_read_mapped_sample(
+                        &self->cdrReader, sample, &self->mappedFile, env);
+        }
+        return RTIRS_CdrFileReader_read_sample(
+                    &self->cdrReader, sample, self->file,
+                    self->_buffer, self->maxSampleSize, env);
+    }
+
+    if (self->readMode == READ_MODE_MMAP) {
+        return RTIRS_FileAdapter_read_mapped_sample(
+                    sample, &self->mappedFile,
+                    self->_buffer, self->maxSampleSize, env);
+    }
+    return RTIRS_FileAdapter_read_sample(
+                sample, self->file, 
+                self->_buffer, self->maxSampleSize, env);
+}
+
+/*****************************************************************************/
+
 void * RTIRS_FileStreamReader_run(void * threadParam) {
 
     struct RTIRS_FileStreamReader * self = 
         (struct RTIRS_FileStreamReader *) threadParam;
+    struct RTIRS_FileReplayClock clock = { 0, 0, RTIRS_FILE_REPLAY_RATE_PERIOD };
+    int notified = 0;
+    int idle = 0;
 
     /*
      * This thread will notify of data availability in the file
      */
-    printf("RTIRS_FileStreamReader_run. Period: {%d,%u}\n", self->readPeriod.sec + self->readPeriod.nanosec);
+    if (self->verbose) {
+        printf("RTIRS_FileStreamReader_run. Period: {%d,%u}\n",
+               self->readPeriod.sec, self->readPeriod.nanosec);
+    }
 
     while (self->_run) {
 
-        NDDS_Utility_sleep(&self->readPeriod);
-        printf("RTIRS_FileStreamReader_run.\n");
+        /*
+         * With a ReplayRate, the next notification is sent as soon as the
+         * previous one has been read (and the rate allows it). ReadPeriod
+         * is then only how long to wait for a notification to be read,
+         * or for new data when there was nothing to notify.
+         */
+        if (self->replayRate == RTIRS_FILE_REPLAY_RATE_PERIOD || idle) {
+            NDDS_Utility_sleep(&self->readPeriod);
+        } else if (notified
+                   && RTIRS_FileStreamReader_waitReadDone(self, &self->readPeriod)
+                   && self->replayRate > 0) {
+            RTIRS_FileStreamReader_throttle(self, &clock);
+        }
+        if (!self->_run) {
+            break;
+        }
+        if (self->verbose) {
+            printf("RTIRS_FileStreamReader_run.\n");
+        }
 
-        if (!feof(self->file)) {
-            self->listener.on_data_available(
-                self, self->listener.listener_data);
-        } else if (self->loop) {
-            fseek(self->file, 0, SEEK_SET);
+        /*
+         * The session thread rewinds the file when looping
+         * (see RTIRS_FileStreamReader_hasData)
+         */
+        notified = self->loop || !RTIRS_FileStreamReader_eof(self);
+
+        if (notified) {
             self->listener.on_data_available(
                 self, self->listener.listener_data);
         }
+        idle = !notified;
 
     }
 
@@ -174,21 +488,25 @@ void RTIRS_FileStreamReader_read(
     struct RTIRS_FileStreamReader * self =
         (struct RTIRS_FileStreamReader *) stream_reader;
 
-    printf("%s\n", __func__);
+    struct DDS_DynamicData * sample = NULL;
+    struct DDS_SampleInfo  * info   = NULL;
+
+    if (self->verbose) {
+        printf("%s\n", __func__);
+    }
 
     *sample_list = NULL;
     *info_list   = NULL;
     *count = 0;
     
-    struct DDS_DynamicData * sample = NULL;
-    struct DDS_SampleInfo  * info   = NULL;
-    
-    printf("RTIRS_FileStreamReader_read...\n");
+    if (self->verbose) {
+        printf("RTIRS_FileStreamReader_read...\n");
+    }
 
     /*
      * Read as many as samplesPerRead (or less if we encounter the end of file)
      */
-    for (i=0; i<self->samplesPerRead && !feof(self->file); ++i) {
+    for (i=0; i<self->samplesPerRead && RTIRS_FileStreamReader_hasData(self); ++i) {
 
         /*
          * Create a dynamic data sample for every buffer we read. We use
@@ -201,12 +519,10 @@ void RTIRS_FileStreamReader_read(
          * Fill the dynamic data sample fields
          * with the buffer read from the file.
          *
-         * This function is meant to be customized to specific
-         * file formats
+         * The text format (LineConversion.c) is meant to be
+         * customized to specific file formats
          */
-        result = RTIRS_FileAdapter_read_sample(
-                    sample, self->file, 
-                    self->_buffer, self->maxSampleSize, env);
+        result = RTIRS_FileStreamReader_readSample(self, sample, env);
 
         /* Set instance state according to parameters */
         if ( (self->samplesReadCount % self->samplesPerDisposedSample) == 1 ) {
@@ -218,7 +534,6 @@ void RTIRS_FileStreamReader_read(
         	info->valid_data     = DDS_BOOLEAN_FALSE;
         }
         else {
-            printf("RTIRS_FileStreamReader_read...\n");
        	    info->instance_state = DDS_ALIVE_INSTANCE_STATE;
         	info->valid_data     = DDS_BOOLEAN_FALSE;
         }
@@ -228,19 +543,22 @@ void RTIRS_FileStreamReader_read(
         case READ_ACTION_ERROR :
             RTI_RoutingServiceEnvironment_set_error( env, "Incorrect file");
         	*count = 0;
+            RTIRS_FileStreamReader_signalReadDone(self);
             return;
         case READ_ACTION_SKIP_SAMPLE :
-            printf("RTIRS_FileStreamReader_read skipped sample\n");
+            if (self->verbose) {
+                printf("RTIRS_FileStreamReader_read skipped sample\n");
+            }
         	continue;
         case READ_ACTION_SEND_SAMPLE :
-        	if ( info->instance_state == DDS_ALIVE_INSTANCE_STATE ) {
+        	if ( self->verbose && info->instance_state == DDS_ALIVE_INSTANCE_STATE ) {
         		printf("RTIRS_FileStreamReader_read: Returning regular sample:\n");
         		DDS_DynamicDataTypeSupport_print_data(self->_typeSupport, sample);
         	}
-        	else if ( info->instance_state == DDS_NOT_ALIVE_DISPOSED_INSTANCE_STATE ) {
+        	else if ( self->verbose && info->instance_state == DDS_NOT_ALIVE_DISPOSED_INSTANCE_STATE ) {
         		printf("RTIRS_FileStreamReader_read Returning disposed sample: \n");
         	}
-           	else if ( info->instance_state == DDS_NOT_ALIVE_NO_WRITERS_INSTANCE_STATE ) {
+           	else if ( self->verbose && info->instance_state == DDS_NOT_ALIVE_NO_WRITERS_INSTANCE_STATE ) {
             	printf("RTIRS_FileStreamReader_read Returning unregistered sample: \n");
             }
 
@@ -255,6 +573,8 @@ void RTIRS_FileStreamReader_read(
         *sample_list = (RTI_RoutingServiceSample *)self->_sample_list;
         *info_list   = (RTI_RoutingServiceSampleInfo *)self->_info_list;
     }
+
+    RTIRS_FileStreamReader_signalReadDone(self);
     
     /*
      * We don't provide sample info in this adapter, which
@@ -272,7 +592,12 @@ void RTIRS_FileStreamReader_return_loan(
         int count,
         RTI_RoutingServiceEnvironment * env) 
 {
-    printf("%s\n", __func__);
+    struct RTIRS_FileStreamReader * self =
+        (struct RTIRS_FileStreamReader *) stream_reader;
+
+    if (self->verbose) {
+        printf("%s\n", __func__);
+    }
 
     /*
      * Nothing to do here since the samples and sample list are
@@ -306,6 +631,33 @@ int RTIRS_FileStreamReader_parsePositiveIntProperty(
     return 1;
 }
 
+/*****************************************************************************/
+/*
+ * FileFormat: "text" (default) for <field>=<value> lines (LineConversion.c),
+ * "cdr" for serialized samples (CdrConversion.c)
+ */
+int RTIRS_FileAdapter_parseFileFormatProperty(
+    int *outFileFormat,
+    const struct RTI_RoutingServiceProperties * properties,
+    RTI_RoutingServiceEnvironment * env)
+{
+    const char *fileFormatProp =
+            RTI_RoutingServiceProperties_lookup_property(properties, "FileFormat");
+
+    if (fileFormatProp == NULL || !strcmp(fileFormatProp, "text")) {
+        *outFileFormat = FILE_FORMAT_TEXT;
+    } else if (!strcmp(fileFormatProp, "cdr")) {
+        *outFileFormat = FILE_FORMAT_CDR;
+    } else {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Invalid value for FileFormat (%s). Allowed values: text (default), cdr",
+            fileFormatProp);
+        return 0;
+    }
+
+    return 1;
+}
+
 /*****************************************************************************/
 int RTIRS_FileStreamReader_parseUpdateableProperties(
 	    RTI_RoutingServiceAdapterEntity stream_reader,
@@ -316,7 +668,9 @@ int RTIRS_FileStreamReader_parseUpdateableProperties(
         (struct RTIRS_FileStreamReader *) stream_reader;
 
     const char * loopProp = NULL;
+    const char * replayRateProp = NULL;
     int loop = 0;
+    int replayRate = RTIRS_FILE_REPLAY_RATE_PERIOD;
     int readPeriodIntProp;
     int samplesPerReadIntProp;
     int samplesPerDisposedSampleIntProp;
@@ -353,6 +707,21 @@ int RTIRS_FileStreamReader_parseUpdateableProperties(
         return 0;
     }
 
+    /*
+     * ReplayRate: samples per second, or "max" to replay the file as fast
+     * as it is read. When it is not set, data is notified every ReadPeriod.
+     */
+    replayRateProp = RTI_RoutingServiceProperties_lookup_property(
+        properties, "ReplayRate");
+    if (replayRateProp != NULL) {
+        if (!strcmp(replayRateProp, "max")) {
+            replayRate = RTIRS_FILE_REPLAY_RATE_MAX;
+        } else if ( !RTIRS_FileStreamReader_parsePositiveIntProperty(
+    			&replayRate, 0, "ReplayRate", properties, env) ) {
+            return 0;
+        }
+    }
+
     if ( self->maxSampleSize == 0 ) {
     	self->maxSampleSize = maxSampleSizeIntProp;
     }
@@ -366,6 +735,7 @@ int RTIRS_FileStreamReader_parseUpdateableProperties(
     self->readPeriod.sec     =  readPeriodIntProp / 1000;
     self->readPeriod.nanosec = (readPeriodIntProp % 1000) * 1000000;
     self->loop = loop;
+    self->replayRate = replayRate;
 
     self->samplesPerDisposedSample     = samplesPerDisposedSampleIntProp;
     self->samplesPerUnregisteredSample = samplesPerUnregisteredSampleIntProp;
@@ -412,7 +782,12 @@ int RTIRS_FileStreamWriter_write(
         sample = (struct DDS_DynamicData *) sample_list[i];
         sample_info = (struct DDS_SampleInfo  *)info_list[i];
 
-        if (!RTIRS_FileAdapter_write_sample(
+        if (self->fileFormat == FILE_FORMAT_CDR) {
+            if (!RTIRS_CdrFileWriter_write_sample(
+                    &self->cdrWriter, sample, self->file, env)) {
+                return i;
+            }
+        } else if (!RTIRS_FileAdapter_write_sample(
                 sample_info, sample, self->file, env)) {
             return i;
         }
@@ -467,10 +842,22 @@ void RTIRS_FileStreamReader_delete(
 {
     printf("%s\n", __func__);
 
-    if (self->file != stdin) {
+    if (self->file != NULL && self->file != stdin) {
         fclose(self->file);
     }
 
+    RTIRS_MappedFile_close(&self->mappedFile);
+    RTIRS_CdrFileReader_close(&self->cdrReader);
+
+    if (self->_readDoneInitialized) {
+      #ifdef RTI_WIN32
+        DeleteCriticalSection(&self->_readDoneMutex);
+      #else
+        pthread_cond_destroy(&self->_readDoneCond);
+        pthread_mutex_destroy(&self->_readDoneMutex);
+      #endif
+    }
+
     if (self->_buffer != NULL) {
         free(self->_buffer);
         self->_buffer = NULL;
@@ -502,6 +889,7 @@ RTIRS_FileConnection_create_stream_reader(
 {
     struct RTIRS_FileStreamReader * stream_reader = NULL;
     const char * fileNameProp = NULL;
+    const char * readModeProp = NULL;
     FILE * file = NULL;
     int error = 0;
     int i;
@@ -530,6 +918,15 @@ RTIRS_FileConnection_create_stream_reader(
         return NULL;
     }
 
+  #ifdef RTI_WIN32
+    InitializeCriticalSection(&stream_reader->_readDoneMutex);
+    InitializeConditionVariable(&stream_reader->_readDoneCond);
+  #else
+    pthread_mutex_init(&stream_reader->_readDoneMutex, NULL);
+    pthread_cond_init(&stream_reader->_readDoneCond, NULL);
+  #endif
+    stream_reader->_readDoneInitialized = 1;
+
     /*
      * Get the configuration properties in <route>/<input>/<property>
      */
@@ -550,9 +947,80 @@ RTIRS_FileConnection_create_stream_reader(
         return NULL;
     }
 
+    /*
+     * ReadMode: "stream" (default) reads the file with stdio, "mmap" maps
+     * the file in memory. The mmap mode is meant to replay large files, so
+     * it also turns off the printing (verbose) of every sample read.
+     */
+    readModeProp = RTI_RoutingServiceProperties_lookup_property(
+        properties, "ReadMode");
+    if (readModeProp == NULL || !strcmp(readModeProp, "stream")) {
+        stream_reader->readMode = READ_MODE_STREAM;
+        stream_reader->verbose  = 1;
+    } else if (!strcmp(readModeProp, "mmap")) {
+        stream_reader->readMode = READ_MODE_MMAP;
+        stream_reader->verbose  = 0;
+    } else {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Invalid value for ReadMode (%s). Allowed values: stream (default), mmap",
+            readModeProp);
+        RTIRS_FileStreamReader_delete(stream_reader);
+        return NULL;
+    }
+
+    if ( !RTIRS_FileAdapter_parseFileFormatProperty(
+                &stream_reader->fileFormat, properties, env) ) {
+        RTIRS_FileStreamReader_delete(stream_reader);
+        return NULL;
+    }
+
     if ( strcmp("stdin", fileNameProp) == 0 ) {
+        if (stream_reader->fileFormat == FILE_FORMAT_CDR) {
+            RTI_RoutingServiceEnvironment_set_error(
+                env, "FileFormat cdr cannot read from stdin");
+            RTIRS_FileStreamReader_delete(stream_reader);
+            return NULL;
+        }
+        if (stream_reader->readMode == READ_MODE_MMAP) {
+            RTI_RoutingServiceEnvironment_set_error(
+                env, "ReadMode mmap cannot read from stdin");
+            RTIRS_FileStreamReader_delete(stream_reader);
+            return NULL;
+        }
         file = stdin;
     }
+    else if (stream_reader->readMode == READ_MODE_MMAP) {
+        if (!RTIRS_MappedFile_open(
+                &stream_reader->mappedFile, fileNameProp, env)) {
+            RTIRS_FileStreamReader_delete(stream_reader);
+            return NULL;
+        }
+        if (stream_reader->fileFormat == FILE_FORMAT_CDR &&
+            !RTIRS_CdrFileReader_open_mapped(
+                &stream_reader->cdrReader, &stream_reader->mappedFile, env)) {
+            RTIRS_FileStreamReader_delete(stream_reader);
+            return NULL;
+        }
+    }
+    else if (stream_reader->fileFormat == FILE_FORMAT_CDR) {
+        stream_reader->file = fopen(fileNameProp, "rb");
+
+        if (stream_reader->file == NULL) {
+            RTI_RoutingServiceEnvironment_set_error(
+                env, "Could not open file for read: %s", fileNameProp);
+
+           RTIRS_FileStreamReader_delete(stream_reader);
+           return NULL;
+        }
+        setvbuf(stream_reader->file, NULL, _IOFBF, RTIRS_CDR_FILE_BUFFER_SIZE);
+
+        if (!RTIRS_CdrFileReader_open(
+                &stream_reader->cdrReader, stream_reader->file, env)) {
+            RTIRS_FileStreamReader_delete(stream_reader);
+            return NULL;
+        }
+        file = stream_reader->file;
+    }
     else {
         file = fopen(fileNameProp, "r");
 
@@ -725,6 +1193,7 @@ RTIRS_FileConnection_create_stream_writer(
     const char * modeProp = NULL;
     const char * flushProp = NULL;
     int flushEnabled = 0;
+    int fileFormat = FILE_FORMAT_TEXT;
     char * fileName = NULL;
     FILE * file = NULL;
     char * pos;
@@ -769,6 +1238,24 @@ RTIRS_FileConnection_create_stream_writer(
         }
     }
 
+    if (!RTIRS_FileAdapter_parseFileFormatProperty(
+            &fileFormat, properties, env)) {
+        return NULL;
+    }
+    if (fileFormat == FILE_FORMAT_CDR) {
+        /* The index footer must be at the end of the file */
+        if (!strcmp(modeProp, "append")) {
+            RTI_RoutingServiceEnvironment_set_error(
+                env, "WriteMode append is not supported with FileFormat cdr");
+            return NULL;
+        }
+        if (!strcmp(fileNameProp, "stdout")) {
+            RTI_RoutingServiceEnvironment_set_error(
+                env, "FileFormat cdr cannot write to stdout");
+            return NULL;
+        }
+    }
+
     /*
      * Replace (stream_name) in the file name with the stream name of this writer
      */
@@ -799,7 +1286,11 @@ RTIRS_FileConnection_create_stream_writer(
                 error = 1;
             }
         }
-        file = fopen(fileName, !strcmp(modeProp, "append") ? "a" : "w");
+        if (fileFormat == FILE_FORMAT_CDR) {
+            file = fopen(fileName, "wb");
+        } else {
+            file = fopen(fileName, !strcmp(modeProp, "append") ? "a" : "w");
+        }
         if (file == NULL) {
             RTI_RoutingServiceEnvironment_set_error(
                 env, "Could not open file for write: %s", fileName);
@@ -836,6 +1327,17 @@ RTIRS_FileConnection_create_stream_writer(
 
     stream_writer->file = file;
     stream_writer->flushEnabled = flushEnabled;
+    stream_writer->fileFormat = fileFormat;
+
+    if (fileFormat == FILE_FORMAT_CDR) {
+        setvbuf(file, NULL, _IOFBF, RTIRS_CDR_FILE_BUFFER_SIZE);
+
+        if (!RTIRS_CdrFileWriter_open(&stream_writer->cdrWriter, file, env)) {
+            fclose(file);
+            free(stream_writer);
+            return NULL;
+        }
+    }
 
     return stream_writer;
 }
@@ -855,6 +1357,10 @@ void RTIRS_FileConnection_delete_stream_writer(
 
     printf("%s\n", __func__);
 
+    if (self->fileFormat == FILE_FORMAT_CDR) {
+        RTIRS_CdrFileWriter_close(&self->cdrWriter, self->file, env);
+    }
+
     if (self->file != stdout) {
         fclose(self->file);
     }
@@ -73,6 +73,57 @@ enum RTIRS_FileAdapter_READ_ACTION RTIRS_FileAdapter_read_sample(
     char * buffer, 
     int maxSampleSize,
     RTI_RoutingServiceEnvironment * env)
+{
+    /*
+     * Read a line or a partial line if the current one is shorter
+     * than maxCharsPerRead characters.
+     */
+    if(fgets(buffer, maxSampleSize, file) == NULL) {
+        return -1;
+    }
+
+    return RTIRS_FileAdapter_parse_sample(sampleOut, buffer, env);
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Reads from a memory-mapped file to provide the values of
+ * one dynamic data sample
+ *
+ * Same as RTIRS_FileAdapter_read_sample, but the line is taken
+ * from a file mapped in memory (ReadMode "mmap").
+ */
+enum RTIRS_FileAdapter_READ_ACTION RTIRS_FileAdapter_read_mapped_sample(
+    struct DDS_DynamicData * sampleOut,
+    struct RTIRS_MappedFile * file,
+    char * buffer,
+    int maxSampleSize,
+    RTI_RoutingServiceEnvironment * env)
+{
+    if (RTIRS_MappedFile_read_line(file, buffer, maxSampleSize) == NULL) {
+        return -1;
+    }
+
+    return RTIRS_FileAdapter_parse_sample(sampleOut, buffer, env);
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Parses a line to provide the values of one dynamic data sample
+ *
+ * @param sampleOut The sample whose field values shall be set
+ * @param buffer The line. It is modified while it is parsed
+ * @param env The environment to report error messages
+ *
+ * @return 0 for error, 1 for success, -1 to indicate that the sample
+ *         should not be sent.
+ */
+enum RTIRS_FileAdapter_READ_ACTION RTIRS_FileAdapter_parse_sample(
+    struct DDS_DynamicData * sampleOut,
+    char * buffer,
+    RTI_RoutingServiceEnvironment * env)
 {
     size_t i;
     size_t length;
@@ -85,14 +136,6 @@ enum RTIRS_FileAdapter_READ_ACTION RTIRS_FileAdapter_read_sample(
     char c;
     char * token = NULL, * field = NULL, * value = NULL;
 
-    /*
-     * Read a line or a partial line if the current one is shorter
-     * than maxCharsPerRead characters.
-     */
-    if(fgets(buffer, maxSampleSize, file) == NULL) {
-        return -1;
-    }
-
     /*
      * Trim spaces
      */
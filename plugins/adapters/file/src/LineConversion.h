@@ -24,6 +24,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "rtiadapt_file.h"
+#include "MappedFile.h"
 
 /* ========================================================================= */
 /*                                                                           */
@@ -43,6 +44,18 @@ enum RTIRS_FileAdapter_READ_ACTION RTIRS_FileAdapter_read_sample(
     int maxSampleSize,
     RTI_RoutingServiceEnvironment * env);
 
+enum RTIRS_FileAdapter_READ_ACTION RTIRS_FileAdapter_read_mapped_sample(
+    struct DDS_DynamicData * sampleOut,
+    struct RTIRS_MappedFile * file,
+    char * buffer,
+    int maxSampleSize,
+    RTI_RoutingServiceEnvironment * env);
+
+enum RTIRS_FileAdapter_READ_ACTION RTIRS_FileAdapter_parse_sample(
+    struct DDS_DynamicData * sampleOut,
+    char * buffer,
+    RTI_RoutingServiceEnvironment * env);
+
 
 /* ========================================================================= */
 /*                                                                           */
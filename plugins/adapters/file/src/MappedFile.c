@@ -0,0 +1,218 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+/* ========================================================================= */
+/* RTI Routing Service File Adapter                                          */
+/* ========================================================================= */
+/*                                                                           */
+/* Memory-mapped input files                                                 */
+/*                                                                           */
+/* When the ReadMode of a stream reader is "mmap", the whole input file is   */
+/* mapped in memory instead of being read through stdio. Line boundaries     */
+/* are found with memchr, which the C runtime implements with vector         */
+/* instructions, and every line is copied once into the buffer of the        */
+/* stream reader, where LineConversion.c parses it in place.                 */
+/*                                                                           */
+/* ========================================================================= */
+
+#include <string.h>
+
+#include "MappedFile.h"
+
+#ifdef RTI_WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+/* ========================================================================= */
+/*                                                                           */
+/* Mapped file methods                                                       */
+/*                                                                           */
+/* ========================================================================= */
+
+/**
+ * @brief Maps a whole file in memory, to read it line by line.
+ *
+ * @param self The mapped file to initialize
+ * @param fileName The path of the file
+ * @param env The environment to report error messages
+ *
+ * @return 0 for error, 1 for success.
+ */
+int RTIRS_MappedFile_open(
+    struct RTIRS_MappedFile * self,
+    const char * fileName,
+    RTI_RoutingServiceEnvironment * env)
+{
+  #ifdef RTI_WIN32
+    LARGE_INTEGER fileSize;
+  #else
+    int fd = -1;
+    struct stat fileStat;
+    void * data = NULL;
+  #endif
+
+    memset(self, 0, sizeof(struct RTIRS_MappedFile));
+
+  #ifdef RTI_WIN32
+    self->_file = CreateFileA(
+        fileName, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (self->_file == INVALID_HANDLE_VALUE) {
+        self->_file = NULL;
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Could not open file for read: %s", fileName);
+        return 0;
+    }
+    if (!GetFileSizeEx((HANDLE) self->_file, &fileSize)) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Could not get size of file: %s", fileName);
+        RTIRS_MappedFile_close(self);
+        return 0;
+    }
+    self->size = (size_t) fileSize.QuadPart;
+
+    /* Empty files cannot be mapped, but they have no lines to read either */
+    if (self->size == 0) {
+        return 1;
+    }
+
+    self->_mapping = CreateFileMappingA(
+        (HANDLE) self->_file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (self->_mapping != NULL) {
+        self->data = (const char *) MapViewOfFile(
+            (HANDLE) self->_mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (self->data == NULL) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Could not map file: %s", fileName);
+        RTIRS_MappedFile_close(self);
+        return 0;
+    }
+  #else
+    fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Could not open file for read: %s", fileName);
+        return 0;
+    }
+    if (fstat(fd, &fileStat) != 0) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Could not get size of file: %s", fileName);
+        close(fd);
+        return 0;
+    }
+    self->size = (size_t) fileStat.st_size;
+
+    /* Empty files cannot be mapped, but they have no lines to read either */
+    if (self->size == 0) {
+        close(fd);
+        return 1;
+    }
+
+    data = mmap(NULL, self->size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    /* The mapping keeps its own reference to the file */
+    close(fd);
+
+    if (data == MAP_FAILED) {
+        RTI_RoutingServiceEnvironment_set_error(
+            env, "Could not map file: %s", fileName);
+        self->size = 0;
+        return 0;
+    }
+    self->data = (const char *) data;
+
+    /* Lines are read front to back: let the kernel read ahead */
+    madvise(data, self->size, MADV_SEQUENTIAL);
+  #endif
+
+    return 1;
+}
+
+/*****************************************************************************/
+
+void RTIRS_MappedFile_close(struct RTIRS_MappedFile * self)
+{
+  #ifdef RTI_WIN32
+    if (self->data != NULL) {
+        UnmapViewOfFile(self->data);
+    }
+    if (self->_mapping != NULL) {
+        CloseHandle((HANDLE) self->_mapping);
+    }
+    if (self->_file != NULL) {
+        CloseHandle((HANDLE) self->_file);
+    }
+  #else
+    if (self->data != NULL) {
+        munmap((void *) self->data, self->size);
+    }
+  #endif
+
+    memset(self, 0, sizeof(struct RTIRS_MappedFile));
+}
+
+/*****************************************************************************/
+
+/**
+ * @brief Copies the next line of the file into a buffer, with the same
+ * semantics as fgets: the line is truncated to maxSampleSize-1 characters
+ * (the rest is returned by the next call), and it keeps its newline.
+ *
+ * @return The buffer, or NULL if the end of the file was reached.
+ */
+char * RTIRS_MappedFile_read_line(
+    struct RTIRS_MappedFile * self,
+    char * buffer,
+    int maxSampleSize)
+{
+    const char * line = self->data + self->position;
+    const char * newline = NULL;
+    size_t length = self->size - self->position;
+
+    if (length == 0 || maxSampleSize <= 1) {
+        return NULL;
+    }
+    if (length > (size_t) (maxSampleSize - 1)) {
+        length = (size_t) (maxSampleSize - 1);
+    }
+
+    newline = (const char *) memchr(line, '\n', length);
+    if (newline != NULL) {
+        length = (size_t) (newline - line) + 1;
+    }
+
+    memcpy(buffer, line, length);
+    buffer[length] = '\0';
+    self->position += length;
+
+    return buffer;
+}
+
+/*****************************************************************************/
+
+int RTIRS_MappedFile_eof(const struct RTIRS_MappedFile * self)
+{
+    return self->position >= self->size;
+}
+
+/*****************************************************************************/
+
+void RTIRS_MappedFile_rewind(struct RTIRS_MappedFile * self)
+{
+    self->position = 0;
+}
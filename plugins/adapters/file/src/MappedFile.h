@@ -0,0 +1,81 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+/* ========================================================================= */
+/* RTI Routing Service File Adapter                                          */
+/* ========================================================================= */
+/*                                                                           */
+/* See MappedFile.c                                                          */
+/*                                                                           */
+/* ========================================================================= */
+
+#ifndef _mappedfile_h_
+#define _mappedfile_h_
+
+#include <stddef.h>
+#include "rtiadapt_file.h"
+
+/* ========================================================================= */
+/*                                                                           */
+/* Data types                                                                */
+/*                                                                           */
+/* ========================================================================= */
+
+/*
+ * A file mapped read-only in memory, which is consumed one line at a
+ * time. position is the offset of the next line to read.
+ *
+ * The Windows handles are kept as void pointers so that this header
+ * doesn't need windows.h (FileAdapter.c includes Winsock2.h).
+ */
+struct RTIRS_MappedFile {
+    const char * data;
+    size_t size;
+    size_t position;
+
+  #ifdef RTI_WIN32
+    void * _file;
+    void * _mapping;
+  #endif
+};
+
+/* ========================================================================= */
+/*                                                                           */
+/* Mapped file methods                                                       */
+/*                                                                           */
+/* ========================================================================= */
+
+int RTIRS_MappedFile_open(
+    struct RTIRS_MappedFile * self,
+    const char * fileName,
+    RTI_RoutingServiceEnvironment * env);
+
+/*****************************************************************************/
+
+void RTIRS_MappedFile_close(struct RTIRS_MappedFile * self);
+
+/*****************************************************************************/
+
+char * RTIRS_MappedFile_read_line(
+    struct RTIRS_MappedFile * self,
+    char * buffer,
+    int maxSampleSize);
+
+/*****************************************************************************/
+
+int RTIRS_MappedFile_eof(const struct RTIRS_MappedFile * self);
+
+/*****************************************************************************/
+
+void RTIRS_MappedFile_rewind(struct RTIRS_MappedFile * self);
+
+#endif
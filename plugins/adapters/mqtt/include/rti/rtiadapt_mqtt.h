@@ -501,6 +501,24 @@
 #define RTI_MQTT_PROPERTY_CLIENT_PASSWORD \
         RTI_MQTT_PROPERTY_PREFIX_CLIENT "password"
 
+/**
+ * @brief Configuration property to specify how many `RTI_MQTT_Client`
+ * instances are created by each connection of the MQTT Adapter.
+ * 
+ * Subscriptions and publications are assigned to one of the clients
+ * based on a hash of their topic, publications without a configured
+ * topic are assigned in turn. Every client after the first one
+ * connects to the MQTT Broker using the configured "client id" followed
+ * by "_&lt;index&gt;". If the "client id" is empty, every client connects
+ * with an empty id, and the MQTT Broker assigns a unique one to it.
+ *
+ * Changing the pool size reassigns most topics to a different client.
+ * When persistent sessions are used, the subscriptions stored by the
+ * MQTT Broker for the previous client id are not resumed by the new one.
+ */
+#define RTI_MQTT_PROPERTY_CLIENT_POOL_SIZE \
+        RTI_MQTT_PROPERTY_PREFIX_CLIENT "pool_size"
+
 #if RTI_MQTT_USE_SSL
 /**
  * @defgroup RtiMqtt_Properties_Client_Ssl SSL/TLS Configuration
@@ -606,6 +624,49 @@
 #define RTI_MQTT_PROPERTY_SUBSCRIPTION_QUEUE_SIZE \
         RTI_MQTT_PROPERTY_PREFIX_SUBSCRIPTION "queue_size"
 
+/**
+ * @brief Configuration property to control whether an
+ * `RTI_MQTT_Subscription` should keep received messages in the buffers
+ * allocated by the MQTT client library, and only convert them into samples
+ * when they are read.
+ * 
+ * Messages which are dropped from the queue before being read are never
+ * converted into samples.
+ */
+#define RTI_MQTT_PROPERTY_SUBSCRIPTION_DEFER_CONVERSION \
+        RTI_MQTT_PROPERTY_PREFIX_SUBSCRIPTION "defer_conversion"
+
+/**
+ * @brief Configuration property to control whether the message queue of
+ * an `RTI_MQTT_Subscription` should be implemented as a lock-free ring,
+ * which the MQTT client library and the reader can access concurrently.
+ * 
+ * The ring requires a bounded queue, i.e. a queue size greater than 0.
+ */
+#define RTI_MQTT_PROPERTY_SUBSCRIPTION_LOCK_FREE_QUEUE \
+        RTI_MQTT_PROPERTY_PREFIX_SUBSCRIPTION "lock_free_queue"
+
+/**
+ * @brief Configuration property to control how many messages an
+ * `RTI_MQTT_Subscription` may receive before notifying its reader again,
+ * while the reader has not yet read the previously notified ones.
+ * 
+ * The first message received after each read is always notified. A value
+ * of 0 disables notifications based on the number of messages.
+ */
+#define RTI_MQTT_PROPERTY_SUBSCRIPTION_NOTIFY_MAX_MESSAGES \
+        RTI_MQTT_PROPERTY_PREFIX_SUBSCRIPTION "notify_max_messages"
+
+/**
+ * @brief Configuration property to control how long (in microseconds) an
+ * `RTI_MQTT_Subscription` may wait before notifying its reader again,
+ * while the reader has not yet read the previously notified messages.
+ * 
+ * A value of 0 disables notifications based on time.
+ */
+#define RTI_MQTT_PROPERTY_SUBSCRIPTION_NOTIFY_MAX_DELAY_USEC \
+        RTI_MQTT_PROPERTY_PREFIX_SUBSCRIPTION "notify_max_delay_usec"
+
 
 /**
  * @}
@@ -672,6 +733,18 @@
 #define RTI_MQTT_PROPERTY_PUBLICATION_MAX_WAIT_TIME_NANOSECONDS \
         RTI_MQTT_PROPERTY_PUBLICATION_MAX_WAIT_TIME ".nanosec"
 
+/**
+ * @brief Configuration property to control whether an `RTI_MQTT_Publication`
+ * should return from a write as soon as a message has been handed to the
+ * MQTT library, instead of waiting for the Broker to acknowledge it.
+ * 
+ * Up to `client.max_unack_messages` messages may be in flight at any time
+ * on an asynchronous publication. Writes will block when this limit is
+ * reached, until one of the outstanding messages is completed.
+ */
+#define RTI_MQTT_PROPERTY_PUBLICATION_ASYNC_WRITE \
+        RTI_MQTT_PROPERTY_PREFIX_PUBLICATION "async_write"
+
 
 /** @} */
 
@@ -721,6 +794,9 @@
  * @brief Compiler flag that enables trace-level output from the logging 
  * module.
  * 
+ * Trace-level output, including function calls, is only compiled in debug
+ * builds (i.e. if `NDEBUG` is not defined).
+ * 
  * @see RTI_MQTT_USE_TRACE RTI_MQTT_ENABLE_LOG
  * 
  */
@@ -746,7 +822,7 @@
 #define RTI_MQTT_USE_LOG                    1
 #endif
 
-#ifndef RTI_MQTT_ENABLE_TRACE
+#if !defined(RTI_MQTT_ENABLE_TRACE) || defined(NDEBUG)
 #define RTI_MQTT_USE_TRACE                  0
 #else
 /**
@@ -265,7 +265,11 @@ extern const RTI_MQTT_SubscriptionConfig RTI_MQTT_SubscriptionConfig_DEFAULT;
 { \
     DDS_SEQUENCE_INITIALIZER, /* topic_filters */ \
     RTI_MQTT_QosLevel_TWO,    /* max_qos */ \
-    0                         /* message_queue_size */ \
+    0,                        /* message_queue_size */ \
+    DDS_BOOLEAN_FALSE,        /* defer_conversion */ \
+    DDS_BOOLEAN_FALSE,        /* lock_free_queue */ \
+    1,                        /* notify_max_messages */ \
+    0                         /* notify_max_delay_usec */ \
 }
 
 /**
@@ -340,7 +344,8 @@ extern const RTI_MQTT_PublicationConfig RTI_MQTT_PublicationConfig_DEFAULT;
     RTI_MQTT_QosLevel_ZERO,         /* qos */ \
     DDS_BOOLEAN_FALSE,              /* retained */ \
     DDS_BOOLEAN_FALSE,              /* use_message_info */ \
-    RTI_MQTT_Time_INITIALIZER(10,0) /* max_wait_time */ \
+    RTI_MQTT_Time_INITIALIZER(10,0), /* max_wait_time */ \
+    DDS_BOOLEAN_FALSE               /* async_write */ \
 }
 
 /**
@@ -722,6 +727,11 @@ RTI_MQTT_Subscription_return_loan(
  * `message`'s `info` field, if `use_message_info` is enabled. In this case,
  * the operatio will fail if `message.info` is empty.
  * 
+ * If the `RTI_MQTT_Publication` was configured with `async_write`, this
+ * operation will return as soon as the message has been handed to the MQTT
+ * client library, and the result of the publication will only be reflected
+ * in the `RTI_MQTT_Publication`'s message status.
+ * 
  * @param self the `RTI_MQTT_Publication` used to write the MQTT message.
  * @param message The message to write.
  * @return DDS_ReturnCode_t `DDS_RETCODE_OK` if the message was successfully
@@ -32,6 +32,69 @@
 #define RTI_MQTT_XSTR(x_)           #x_
 #define RTI_MQTT_STRINGIFY(x_)      RTI_MQTT_XSTR(x_)
 
+/*****************************************************************************
+ *
+ *****************************************************************************/
+
+/*
+ * Messages which are compiled in are filtered at run-time against a cached
+ * verbosity level. A filtered message only costs a comparison with the
+ * level, and its arguments are never formatted. The level is loaded when
+ * the plugin is created, from the RTI_MQTT_LOG_LEVEL environment variable.
+ */
+#define RTI_MQTT_LOG_LEVEL_SILENT           0
+#define RTI_MQTT_LOG_LEVEL_ERROR            1
+#define RTI_MQTT_LOG_LEVEL_WARNING          2
+#define RTI_MQTT_LOG_LEVEL_INFO             3
+#define RTI_MQTT_LOG_LEVEL_TRACE            4
+
+#define RTI_MQTT_LOG_LEVEL_ENV              "RTI_MQTT_LOG_LEVEL"
+
+#define RTI_MQTT_LOG_ASYNC_ENV              "RTI_MQTT_LOG_ASYNC"
+
+#if RTI_MQTT_USE_TRACE
+#define RTI_MQTT_LOG_LEVEL_DEFAULT          RTI_MQTT_LOG_LEVEL_TRACE
+#else
+#define RTI_MQTT_LOG_LEVEL_DEFAULT          RTI_MQTT_LOG_LEVEL_INFO
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int RTI_MQTT_Log_level;
+
+/*
+ * Load the verbosity level from the environment, and start the asynchronous
+ * backend if it is enabled. The level can be one of SILENT, ERROR, WARNING,
+ * INFO or TRACE. Plugins call this function when they are created, and
+ * RTI_MQTT_Log_finalize() when they are deleted.
+ */
+void
+RTI_MQTT_Log_initialize(void);
+
+void
+RTI_MQTT_Log_finalize(void);
+
+/*
+ * Write a message to the log. Messages are written to stdout by the calling
+ * thread, unless the RTI_MQTT_LOG_ASYNC environment variable is set to
+ * the path of a file, or to "stdout". In that case, the MQTT client threads
+ * only copy `fmt` and its arguments into a preallocated record, and the
+ * adapter's drain thread formats and writes it. `fmt` must be a string
+ * literal. Messages logged while all records are in use are dropped, and
+ * counted.
+ */
+void
+RTI_MQTT_Log_printf(const char *fmt, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define RTI_MQTT_LOG_ENABLED(lvl_) \
+    (RTI_MQTT_Log_level >= (lvl_))
+
 /*****************************************************************************
  *
  *****************************************************************************/
@@ -51,100 +114,144 @@
 #if RTI_MQTT_USE_LOG
 
 #define RTI_MQTT_LOG(msg_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s\n", RTI_MQTT_LOG_ARGS, (msg_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s\n", RTI_MQTT_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_MQTT_LOG_1(msg_,fmt_,a1_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_)); \
+    }
 
 #define RTI_MQTT_LOG_2(msg_,fmt_,a1_,a2_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_MQTT_LOG_3(msg_,fmt_,a1_,a2_,a3_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_)); \
+    }
 
 #define RTI_MQTT_LOG_4(msg_,fmt_,a1_,a2_,a3_,a4_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_)); \
+    }
 
 #define RTI_MQTT_LOG_5(msg_,fmt_,a1_,a2_,a3_,a4_,a5_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_)); \
+    }
 
 #define RTI_MQTT_LOG_6(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_)); \
+    }
 
 #define RTI_MQTT_LOG_7(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_)); \
+    }
 
 #define RTI_MQTT_LOG_8(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_)); \
+    }
 
 #define RTI_MQTT_LOG_9(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), (a9_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), (a9_)); \
+    }
 
 #define RTI_MQTT_LOG_10(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_)); \
+    }
 
 #define RTI_MQTT_LOG_11(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_)); \
+    }
 
 #define RTI_MQTT_LOG_12(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_)); \
+    }
 
 #define RTI_MQTT_LOG_13(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_,a13_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_), \
-            (a13_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_), \
+                (a13_)); \
+    }
 
 #define RTI_MQTT_LOG_16(msg_,fmt_,\
                    a1_,a2_,a3_,a4_,\
                    a5_,a6_,a7_,a8_,\
                    a9_,a10_,a11_,a12_,\
                    a13_,a14_,a15_,a16_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_), \
-            (a13_), (a14_), (a15_), (a16_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_), \
+                (a13_), (a14_), (a15_), (a16_)); \
+    }
 
 #define RTI_MQTT_WARNING(msg_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_WARNING "%s\n", RTI_MQTT_LOG_ARGS, (msg_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_WARNING)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_WARNING "%s\n", RTI_MQTT_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_MQTT_ERROR(msg_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_ERROR "%s\n", RTI_MQTT_LOG_ARGS, (msg_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_ERROR)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_ERROR "%s\n", RTI_MQTT_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_MQTT_ERROR_1(msg_,fmt_,a1_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_ERROR)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_)); \
+    }
 
 #define RTI_MQTT_ERROR_2(msg_,fmt_,a1_,a2_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_ERROR)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_MQTT_ERROR_3(msg_,fmt_,a1_,a2_,a3_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_), (a3_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_ERROR)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_), (a3_)); \
+    }
 
 #define RTI_MQTT_ERROR_4(msg_,fmt_,a1_,a2_,a3_,a4_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_ERROR)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_)); \
+    }
 
 #define RTI_MQTT_ERROR_5(msg_,fmt_,a1_,a2_,a3_,a4_,a5_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_), (a5_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_ERROR)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_ERROR "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_), (a5_)); \
+    }
 
 #else
 
@@ -190,62 +297,90 @@
 #if RTI_MQTT_USE_TRACE
 
 #define RTI_MQTT_TRACE(msg_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s\n",RTI_MQTT_LOG_ARGS, (msg_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s\n",RTI_MQTT_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_MQTT_TRACE_1(msg_,fmt_,a1_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_)); \
+    }
 
 #define RTI_MQTT_TRACE_2(msg_,fmt_,a1_,a2_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_MQTT_TRACE_3(msg_,fmt_,a1_,a2_,a3_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_)); \
+    }
 
 #define RTI_MQTT_TRACE_4(msg_,fmt_,a1_,a2_,a3_,a4_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_)); \
+    }
 
 #define RTI_MQTT_TRACE_5(msg_,fmt_,a1_,a2_,a3_,a4_,a5_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_)); \
+    }
 
 #define RTI_MQTT_TRACE_6(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_)); \
+    }
 
 #define RTI_MQTT_TRACE_7(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_)); \
+    }
 
 #define RTI_MQTT_TRACE_8(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_)); \
+    }
 
 #define RTI_MQTT_TRACE_9(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_)); \
+    }
 
 #define RTI_MQTT_TRACE_10(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_)); \
+    }
 
 #define RTI_MQTT_TRACE_11(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_), (a11_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_), (a11_)); \
+    }
 
 #define RTI_MQTT_TRACE_12(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_)); \
+    }
 
 #define RTI_MQTT_TRACE_13(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_,a13_) \
-    fprintf(stdout,RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_), \
-            (a13_));
+    if (RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_TRACE)) { \
+        RTI_MQTT_Log_printf(RTI_MQTT_LOG_HEAD "%s " fmt_ "\n", RTI_MQTT_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_), \
+                (a13_)); \
+    }
 
 #else
 
@@ -170,6 +170,11 @@
     RTI_MQTT_ERROR_2("failed to match subscription:",\
         "client=%p, sub=%p",(c_),(s_))
 
+#define RTI_MQTT_LOG_CLIENT_INDEX_TOPIC_FILTER_FAILED(c_,s_,f_) \
+    RTI_MQTT_ERROR_3("failed to index topic filter:",\
+        "client=%p, sub=%p, filter=%s",(c_),(s_),\
+        ((f_) == NULL)?"<null>":(f_))
+
 #define RTI_MQTT_LOG_CLIENT_SUBSCRIPTION_RECEIVE_FAILED(c_,s_) \
     RTI_MQTT_ERROR_2("failed to deliver data to subscription:",\
         "client=%p, sub=%p",(c_),(s_))
@@ -268,6 +273,14 @@
     RTI_MQTT_ERROR("failed to initialize RTI_MQTT_MessageReceiveQueue " \
                    "as an unbounded buffer")
 
+#define RTI_MQTT_LOG_MSG_RECV_QUEUE_INIT_LOCK_FREE_FAILED(q_) \
+    RTI_MQTT_ERROR("failed to initialize RTI_MQTT_MessageReceiveQueue " \
+                   "as a lock-free ring")
+
+#define RTI_MQTT_LOG_MSG_RECV_QUEUE_LOCK_FREE_UNBOUNDED(q_) \
+    RTI_MQTT_ERROR_1("a lock-free RTI_MQTT_MessageReceiveQueue " \
+                     "requires a queue size > 0:","queue=%p",(q_))
+
 #define RTI_MQTT_LOG_MSG_RECV_QUEUE_FINALIZE_FAILED(q_) \
     RTI_MQTT_ERROR_1("failed to finalize RTI_MQTT_MessageReceiveQueue:",\
         "%p",(q_))
@@ -280,6 +293,10 @@
     RTI_MQTT_ERROR_1("failed to receive in unbounded " \
                      "RTI_MQTT_MessageReceiveQueue:","%p",(q_))
 
+#define RTI_MQTT_LOG_MSG_RECV_QUEUE_RECEIVE_LOCK_FREE_FAILED(q_) \
+    RTI_MQTT_ERROR_1("failed to receive in lock-free " \
+                     "RTI_MQTT_MessageReceiveQueue:","%p",(q_))
+
 #define RTI_MQTT_LOG_MSG_RECV_QUEUE_READ_UNEXPECTED_MESSAGE_BUFFER(q_) \
     RTI_MQTT_ERROR_1("unexpected message buffer passed to " \
                      "RTI_MQTT_MessageReceiveQueue_read:",\
@@ -303,6 +320,10 @@
     RTI_MQTT_ERROR_1("failed to read messages from unbounded " \
                      "RTI_MQTT_MessageReceiveQueue:","%p",(q_))
 
+#define RTI_MQTT_LOG_MSG_RECV_QUEUE_READ_LOCK_FREE_FAILED(q_) \
+    RTI_MQTT_ERROR_1("failed to read messages from lock-free " \
+                     "RTI_MQTT_MessageReceiveQueue:","%p",(q_))
+
 #define RTI_MQTT_LOG_MSG_RECV_QUEUE_MESSAGE_LOST(q_,m_) \
     RTI_MQTT_ERROR_2("message lost by RTI_MQTT_MessageReceiveQueue:",\
                      "queue=%p, topic=%s",\
@@ -385,12 +406,6 @@
     RTI_MQTT_ERROR_3("failed to create message queue for subscription:",\
         "sub=%p, size=%u, state=%p",(s_), (sz_), (st_))
 
-#define RTI_MQTT_LOG_SUBSCRIPTION_TOPIC_MATCH_FAILED(s_,f_,t_) \
-    RTI_MQTT_ERROR_3("failed to match topic:",\
-        "sub=%p, filter=%s, topic=%s",(s_), \
-        ((f_) == NULL)?"<null>":(f_),\
-        ((t_) == NULL)?"<null>":(t_))
-
 #define RTI_MQTT_LOG_SUBSCRIPTION_ADD_TO_QUEUE_FAILED(s_,msg_) \
     RTI_MQTT_ERROR_2("failed to add message to subscription queue:",\
         "sub=%p, msg=%p",(s_), (msg_))
@@ -15,6 +15,273 @@
 
 #define RTI_MQTT_LOG_ARGS       "RTI::MQTT::RS::Connection"
 
+/* Maximum number of characters appended to the client id of pool members */
+#define RTI_RS_MQTT_CLIENT_ID_SUFFIX_MAX_LEN        11
+
+/*
+ * Store the ids of all the clients in the pool, separated by commas, so
+ * that to_string() can describe the whole connection.
+ */
+static DDS_ReturnCode_t
+RTI_RS_MQTT_BrokerConnection_print_clients(
+    struct RTI_RS_MQTT_BrokerConnection *self)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong str_len = 0,
+                     id_len = 0,
+                     i = 0;
+    const char *id = NULL;
+    char *str_end = NULL;
+
+    RTI_MQTT_LOG_FN(RTI_RS_MQTT_BrokerConnection_print_clients)
+
+    for (i = 0; i < self->clients_len; i++)
+    {
+        id = RTI_MQTT_Client_get_id(self->clients[i]);
+        str_len += (id != NULL)? RTI_MQTT_String_length(id) : 0;
+        str_len += (i > 0)? 1 : 0;
+    }
+
+    self->clients_str = DDS_String_alloc(str_len);
+    if (self->clients_str == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    str_end = self->clients_str;
+    for (i = 0; i < self->clients_len; i++)
+    {
+        if (i > 0)
+        {
+            *str_end = ',';
+            str_end += 1;
+        }
+        id = RTI_MQTT_Client_get_id(self->clients[i]);
+        if (id != NULL)
+        {
+            id_len = RTI_MQTT_String_length(id);
+            RTI_MQTT_Memory_copy(str_end, id, id_len);
+            str_end += id_len;
+        }
+    }
+    *str_end = '\0';
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+static DDS_ReturnCode_t
+RTI_RS_MQTT_BrokerConnection_create_clients(
+    struct RTI_RS_MQTT_BrokerConnection *self)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    RTI_MQTT_ClientConfig *member_config = NULL;
+    DDS_UnsignedLong pool_size = self->config->client_pool_size,
+                     id_len = 0,
+                     i = 0;
+    char *member_id = NULL;
+    int printed = 0;
+
+    RTI_MQTT_LOG_FN(RTI_RS_MQTT_BrokerConnection_create_clients)
+
+    if (pool_size == 0)
+    {
+        pool_size = 1;
+    }
+
+    self->clients = (struct RTI_MQTT_Client**)
+        RTI_MQTT_Heap_allocate(sizeof(struct RTI_MQTT_Client*) * pool_size);
+    if (self->clients == NULL)
+    {
+        RTI_MQTT_HEAP_ALLOCATE_FAILED(
+            sizeof(struct RTI_MQTT_Client*) * pool_size)
+        goto done;
+    }
+    for (i = 0; i < pool_size; i++)
+    {
+        self->clients[i] = NULL;
+    }
+    self->clients_len = pool_size;
+
+    /* The first client uses the configuration as is */
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_Client_new(&self->config->client, &self->clients[0]))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (pool_size == 1)
+    {
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    /* An empty id asks the broker to assign a unique one to each client,
+       so it is kept empty for every member of the pool */
+    if (self->config->client.id == NULL ||
+        self->config->client.id[0] == '\0')
+    {
+        for (i = 1; i < pool_size; i++)
+        {
+            if (DDS_RETCODE_OK !=
+                    RTI_MQTT_Client_new(
+                        &self->config->client, &self->clients[i]))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+        }
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    /* Every other client must connect to the broker with a distinct id,
+       which is derived from the configured one by appending "_<index>" */
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_ClientConfig_new(DDS_BOOLEAN_FALSE, &member_config))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (!RTI_MQTT_ClientConfig_copy(member_config, &self->config->client))
+    {
+        RTI_MQTT_LOG_COPY_DATA_FAILED("RTI_MQTT_ClientConfig",
+                                        &self->config->client, member_config)
+        goto done;
+    }
+
+    id_len = RTI_MQTT_String_length(self->config->client.id) +
+                RTI_RS_MQTT_CLIENT_ID_SUFFIX_MAX_LEN;
+    member_id = DDS_String_alloc(id_len);
+    if (member_id == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    DDS_String_free(member_config->id);
+    member_config->id = member_id;
+
+    for (i = 1; i < pool_size; i++)
+    {
+        printed = RTI_MQTT_String_print_n(member_id, id_len + 1, "%s_%lu",
+                    self->config->client.id, (unsigned long)i);
+        if (printed < 0 || (DDS_UnsignedLong)printed > id_len)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_Client_new(member_config, &self->clients[i]))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (member_config != NULL)
+    {
+        RTI_MQTT_ClientConfig_delete(member_config);
+    }
+    return retval;
+}
+
+static DDS_ReturnCode_t
+RTI_RS_MQTT_BrokerConnection_connect_clients(
+    struct RTI_RS_MQTT_BrokerConnection *self)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong i = 0;
+
+    RTI_MQTT_LOG_FN(RTI_RS_MQTT_BrokerConnection_connect_clients)
+
+    for (i = 0; i < self->clients_len; i++)
+    {
+        if (DDS_RETCODE_OK != RTI_MQTT_Client_connect(self->clients[i]))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+static void
+RTI_RS_MQTT_BrokerConnection_delete_clients(
+    struct RTI_RS_MQTT_BrokerConnection *self)
+{
+    DDS_UnsignedLong i = 0;
+
+    RTI_MQTT_LOG_FN(RTI_RS_MQTT_BrokerConnection_delete_clients)
+
+    if (self->clients == NULL)
+    {
+        return;
+    }
+
+    for (i = 0; i < self->clients_len; i++)
+    {
+        if (self->clients[i] == NULL)
+        {
+            continue;
+        }
+        if (DDS_RETCODE_OK != RTI_MQTT_Client_disconnect(self->clients[i]))
+        {
+            /* TODO Log error */
+        }
+        RTI_MQTT_Client_delete(self->clients[i]);
+        self->clients[i] = NULL;
+    }
+
+    RTI_MQTT_Heap_free(self->clients);
+    self->clients = NULL;
+    self->clients_len = 0;
+
+    if (self->clients_str != NULL)
+    {
+        DDS_String_free(self->clients_str);
+        self->clients_str = NULL;
+    }
+}
+
+struct RTI_MQTT_Client*
+RTI_RS_MQTT_BrokerConnection_select_client(
+    struct RTI_RS_MQTT_BrokerConnection *self,
+    const char *topic)
+{
+    DDS_UnsignedLong hash = 5381;
+    const char *c = NULL;
+
+    if (self->clients_len <= 1)
+    {
+        return self->clients[0];
+    }
+
+    if (topic == NULL)
+    {
+        return self->clients[
+            (RTI_MQTT_Atomic_increment(&self->clients_next) - 1) %
+                self->clients_len];
+    }
+
+    /* djb2 */
+    for (c = topic; *c != '\0'; c++)
+    {
+        hash = ((hash << 5) + hash) + (unsigned char)*c;
+    }
+
+    return self->clients[hash % self->clients_len];
+}
+
 DDS_ReturnCode_t 
 RTI_RS_MQTT_BrokerConnection_new(
     const struct RTI_RoutingServiceStreamReaderListener *input_stream_discovery_listener,
@@ -38,7 +305,10 @@ RTI_RS_MQTT_BrokerConnection_new(
         goto done;
     }
 
-    conn->client = NULL;
+    conn->clients = NULL;
+    conn->clients_len = 0;
+    conn->clients_next = 0;
+    conn->clients_str = NULL;
     conn->config = NULL;
 
     conn->tc_message = NULL;
@@ -86,8 +356,13 @@ RTI_RS_MQTT_BrokerConnection_new(
         goto done;
     }
 
-    if (DDS_RETCODE_OK !=
-            RTI_MQTT_Client_new(&conn->config->client,&conn->client))
+    if (DDS_RETCODE_OK != RTI_RS_MQTT_BrokerConnection_create_clients(conn))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK != RTI_RS_MQTT_BrokerConnection_print_clients(conn))
     {
         /* TODO Log error */
         goto done;
@@ -105,7 +380,7 @@ RTI_RS_MQTT_BrokerConnection_new(
         goto done;
     }
 
-    if (DDS_RETCODE_OK != RTI_MQTT_Client_connect(conn->client))
+    if (DDS_RETCODE_OK != RTI_RS_MQTT_BrokerConnection_connect_clients(conn))
     {
         /* TODO Log error */
         goto done;
@@ -132,12 +407,6 @@ RTI_RS_MQTT_BrokerConnection_delete(struct RTI_RS_MQTT_BrokerConnection *self)
 {
     RTI_MQTT_LOG_FN(RTI_RS_MQTT_BrokerConnection_delete)
 
-    if (self->client != NULL &&
-        DDS_RETCODE_OK != RTI_MQTT_Client_disconnect(self->client))
-    {
-        /* TODO Log error */
-    }
-
     if (self->disc_reader_in != NULL)
     {
         RTI_RS_MQTT_MessageReader_delete(self->disc_reader_in);
@@ -146,14 +415,11 @@ RTI_RS_MQTT_BrokerConnection_delete(struct RTI_RS_MQTT_BrokerConnection *self)
     {
         RTI_RS_MQTT_MessageReader_delete(self->disc_reader_out);
     }
+    RTI_RS_MQTT_BrokerConnection_delete_clients(self);
     if (self->config != NULL)
     {
         RTI_RS_MQTT_BrokerConnectionConfig_delete(self->config);
     }
-    if (self->client != NULL)
-    {
-        RTI_MQTT_Client_delete(self->client);
-    }
     if (self->tc_message != NULL)
     {
         /* Nothing to finalize */
@@ -514,7 +780,7 @@ RTI_RS_MQTT_BrokerConnection_to_string(
 
     RTI_MQTT_LOG_FN(RTI_RS_MQTT_BrokerConnection_to_string)
 
-    return RTI_MQTT_Client_get_id(self->client);
+    return self->clients_str;
 }
 
 RTI_RoutingServiceSession
@@ -529,7 +795,7 @@ RTI_RS_MQTT_BrokerConnection_create_session(
 
     RTI_MQTT_LOG_FN(RTI_RS_MQTT_BrokerConnection_create_session)
 
-    if (DDS_RETCODE_OK != RTI_MQTT_Client_connect(self->client))
+    if (DDS_RETCODE_OK != RTI_RS_MQTT_BrokerConnection_connect_clients(self))
     {
         /* TODO Log error */
         goto done;
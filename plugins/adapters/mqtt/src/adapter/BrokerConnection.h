@@ -14,6 +14,7 @@
 #define BrokerConnection_h
 
 #include "rtiadapt_mqtt.h"
+#include "Infrastructure.h"
 
 #include "MessageReader.h"
 #include "MessageWriter.h"
@@ -21,7 +22,10 @@
 struct RTI_RS_MQTT_BrokerConnection 
 {
     RTI_RS_MQTT_BrokerConnectionConfig  *config;
-    struct RTI_MQTT_Client *client;
+    struct RTI_MQTT_Client **clients;
+    DDS_UnsignedLong clients_len;
+    RTI_MQTT_AtomicCounter clients_next;
+    char *clients_str;
     struct RTI_RS_MQTT_MessageReaderPtrSeq readers;
     struct RTI_RS_MQTT_MessageWriterPtrSeq writers;
     const struct RTI_RoutingServiceStreamReaderListener 
@@ -33,6 +37,20 @@ struct RTI_RS_MQTT_BrokerConnection
     struct RTI_RS_MQTT_MessageReader *disc_reader_out;
 };
 
+/*
+ * Select the client, out of the connection's pool, which will carry a
+ * subscription or publication on the specified topic (or topic filter).
+ * The same topic is always assigned to the same client, as long as the
+ * size of the pool doesn't change: a different pool size maps most topics
+ * to a different client, and so to a different broker session.
+ * Without a topic (e.g. publications which take it from each message),
+ * clients are assigned in turn.
+ */
+struct RTI_MQTT_Client*
+RTI_RS_MQTT_BrokerConnection_select_client(
+    struct RTI_RS_MQTT_BrokerConnection *self,
+    const char *topic);
+
 void
 RTI_RS_MQTT_BrokerConnection_delete(struct RTI_RS_MQTT_BrokerConnection *self);
 
@@ -66,6 +66,7 @@ RTI_RS_MQTT_MessageReader_new_internal(
     reader->info_ptr_seq = def_info_ptr_seq;
     reader->listener = listener;
     reader->connection = connection;
+    reader->client = NULL;
 
     if (DDS_RETCODE_OK != 
             RTI_RS_MQTT_MessageReaderConfig_parse_from_properties(
@@ -77,8 +78,16 @@ RTI_RS_MQTT_MessageReader_new_internal(
 
     if (!discovery)
     {
+        /* Subscriptions are assigned to the connection's clients based on
+           their first topic filter */
+        reader->client = RTI_RS_MQTT_BrokerConnection_select_client(
+            reader->connection,
+            (DDS_StringSeq_get_length(&reader->config->sub.topic_filters) > 0)?
+                *DDS_StringSeq_get_reference(
+                    &reader->config->sub.topic_filters, 0) : NULL);
+
         if (DDS_RETCODE_OK !=
-                RTI_MQTT_Client_subscribe(reader->connection->client,
+                RTI_MQTT_Client_subscribe(reader->client,
                                         &reader->config->sub,
                                         &reader->sub))
         {
@@ -110,7 +119,7 @@ done:
         }
         if (reader->sub != NULL)
         {
-            RTI_MQTT_Client_unsubscribe(reader->connection->client,reader->sub);
+            RTI_MQTT_Client_unsubscribe(reader->client,reader->sub);
         }
 
         RTI_MQTT_Heap_free(reader);
@@ -167,7 +176,7 @@ RTI_RS_MQTT_MessageReader_delete(struct RTI_RS_MQTT_MessageReader *reader)
     }
     if (reader->sub != NULL)
     {
-        RTI_MQTT_Client_unsubscribe(reader->connection->client,reader->sub);
+        RTI_MQTT_Client_unsubscribe(reader->client,reader->sub);
     }
 
     if (!DDS_SampleInfoSeq_finalize(&reader->info_seq))
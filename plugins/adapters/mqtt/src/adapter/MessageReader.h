@@ -21,6 +21,7 @@ struct RTI_RS_MQTT_MessageReader
 {
     RTI_RS_MQTT_MessageReaderConfig                     *config;
     struct RTI_RS_MQTT_BrokerConnection                 *connection;
+    struct RTI_MQTT_Client                              *client;
     const struct RTI_RoutingServiceStreamReaderListener *listener;
     struct RTI_MQTT_Subscription                        *sub;
     struct DDS_SampleInfoSeq                            info_seq;
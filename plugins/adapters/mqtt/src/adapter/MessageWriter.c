@@ -43,6 +43,7 @@ RTI_RS_MQTT_MessageWriter_new(
     writer->config = NULL;
 
     writer->connection = connection;
+    writer->client = NULL;
 
     if (DDS_RETCODE_OK != 
             RTI_RS_MQTT_MessageWriterConfig_parse_from_properties(
@@ -52,8 +53,11 @@ RTI_RS_MQTT_MessageWriter_new(
         goto done;
     }
 
+    writer->client = RTI_RS_MQTT_BrokerConnection_select_client(
+                        writer->connection, writer->config->pub.topic);
+
     if (DDS_RETCODE_OK !=
-            RTI_MQTT_Client_publish(writer->connection->client,
+            RTI_MQTT_Client_publish(writer->client,
                                     &writer->config->pub,
                                     &writer->pub))
     {
@@ -88,7 +92,7 @@ RTI_RS_MQTT_MessageWriter_delete(struct RTI_RS_MQTT_MessageWriter *writer)
     }
     if (writer->pub != NULL)
     {
-        RTI_MQTT_Client_unpublish(writer->connection->client,writer->pub);
+        RTI_MQTT_Client_unpublish(writer->client,writer->pub);
     }
 
     RTI_MQTT_Heap_free(writer);
@@ -19,6 +19,7 @@ struct RTI_RS_MQTT_MessageWriter
 {
     RTI_RS_MQTT_MessageWriterConfig                     *config;
     struct RTI_RS_MQTT_BrokerConnection                 *connection;
+    struct RTI_MQTT_Client                              *client;
     struct RTI_MQTT_Publication                         *pub;
 };
 
@@ -161,6 +161,8 @@ RTI_RS_MQTT_AdapterPlugin_delete(
 
     RTI_MQTT_Heap_free(self);
 
+    RTI_MQTT_Log_finalize();
+
     retval = DDS_BOOLEAN_TRUE;
 
 done:
@@ -181,6 +183,8 @@ RTI_RS_MQTT_AdapterPlugin_create(
 
     RTI_MQTT_LOG_FN(RTI_RS_MQTT_AdapterPlugin_create)
 
+    RTI_MQTT_Log_initialize();
+
     if (DDS_RETCODE_OK != 
             RTI_RS_MQTT_AdapterPlugin_new(properties, env, &plugin))
     {
@@ -198,9 +202,10 @@ done:
     }
     else
     {
+        RTI_MQTT_Log_finalize();
         return NULL;
     }
-    
+
 }
 
 
@@ -13,6 +13,8 @@
 #include "Properties.h"
 #include "Infrastructure.h"
 
+#include <errno.h>
+
 #define RTI_MQTT_LOG_ARGS       "RTI::MQTT::RS::Infrastructure"
 
 const RTI_RS_MQTT_BrokerConnectionConfig 
@@ -320,6 +322,27 @@ DDS_Boolean_from_string(const char *str, DDS_Boolean *bool_out)
     return DDS_RETCODE_ERROR;
 }
 
+/*
+ * Parse an unsigned 32-bit value. Unlike a bare strtol(), the whole string
+ * must be a number, and negative or out of range values are rejected.
+ */
+static DDS_ReturnCode_t
+DDS_UnsignedLong_from_string(const char *str, DDS_UnsignedLong *value_out)
+{
+    char *str_end = NULL;
+    long value = 0;
+
+    errno = 0;
+    value = RTI_MQTT_String_to_long(str, &str_end, 0);
+    if (str_end == str || *str_end != '\0' || errno == ERANGE ||
+        value < 0 || (unsigned long)value > 0xFFFFFFFFUL)
+    {
+        return DDS_RETCODE_ERROR;
+    }
+    *value_out = (DDS_UnsignedLong)value;
+    return DDS_RETCODE_OK;
+}
+
 #define RTI_RS_MQTT_lookup_property(pp_, p_, set_) \
 {\
     const char *pval = \
@@ -813,6 +836,22 @@ RTI_RS_MQTT_BrokerConnectionConfig_parse_from_properties(
         goto done;
     }
 
+    RTI_RS_MQTT_lookup_property(properties, 
+        RTI_MQTT_PROPERTY_CLIENT_POOL_SIZE,
+        if (DDS_RETCODE_OK != 
+                DDS_UnsignedLong_from_string(
+                                pval, &config->client_pool_size))
+        {
+            /* TODO Log error */
+            goto done;
+        })
+
+    if (config->client_pool_size == 0)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
     *config_out = config;
 
     retval = DDS_RETCODE_OK;
@@ -981,6 +1020,44 @@ RTI_MQTT_SubscriptionConfig_parse_from_properties(
         config->message_queue_size = 
                     RTI_MQTT_String_to_long(pval,NULL,0);)
 
+    RTI_RS_MQTT_lookup_property(properties,
+        RTI_MQTT_PROPERTY_SUBSCRIPTION_DEFER_CONVERSION,
+        if (DDS_RETCODE_OK != 
+                DDS_Boolean_from_string(pval,&config->defer_conversion))
+        {
+            /* TODO Log error */
+            goto done;
+        })
+
+    RTI_RS_MQTT_lookup_property(properties,
+        RTI_MQTT_PROPERTY_SUBSCRIPTION_LOCK_FREE_QUEUE,
+        if (DDS_RETCODE_OK != 
+                DDS_Boolean_from_string(pval,&config->lock_free_queue))
+        {
+            /* TODO Log error */
+            goto done;
+        })
+
+    RTI_RS_MQTT_lookup_property(properties, 
+        RTI_MQTT_PROPERTY_SUBSCRIPTION_NOTIFY_MAX_MESSAGES,
+        if (DDS_RETCODE_OK != 
+                DDS_UnsignedLong_from_string(
+                                pval, &config->notify_max_messages))
+        {
+            /* TODO Log error */
+            goto done;
+        })
+
+    RTI_RS_MQTT_lookup_property(properties, 
+        RTI_MQTT_PROPERTY_SUBSCRIPTION_NOTIFY_MAX_DELAY_USEC,
+        if (DDS_RETCODE_OK != 
+                DDS_UnsignedLong_from_string(
+                                pval, &config->notify_max_delay_usec))
+        {
+            /* TODO Log error */
+            goto done;
+        })
+
     *config_out = config;
 
     retval = DDS_RETCODE_OK;
@@ -1206,6 +1283,15 @@ RTI_MQTT_PublicationConfig_parse_from_properties(
         config->max_wait_time.nanoseconds = 
                     RTI_MQTT_String_to_long(pval,NULL,0);)
 
+    RTI_RS_MQTT_lookup_property(properties,
+        RTI_MQTT_PROPERTY_PUBLICATION_ASYNC_WRITE,
+        if (DDS_RETCODE_OK != 
+                DDS_Boolean_from_string(pval,&config->async_write))
+        {
+            /* TODO Log error */
+            goto done;
+        })
+
     *config_out = config;
 
     retval = DDS_RETCODE_OK;
@@ -24,7 +24,8 @@ extern const RTI_RS_MQTT_MessageWriterConfig
 
 #define RTI_RS_MQTT_BrokerConnectionConfig_INITIALIZER \
 { \
-    RTI_MQTT_ClientConfig_INITIALIZER           /* client */\
+    RTI_MQTT_ClientConfig_INITIALIZER,          /* client */\
+    1                                           /* client_pool_size */\
 }
 
 #define RTI_RS_MQTT_MessageReaderConfig_INITIALIZER \
@@ -86,6 +86,11 @@ RTI_MQTT_Client_on_write_delivery_result(
     struct RTI_MQTT_PendingRequest *req,
     DDS_ReturnCode_t result);
 
+static void
+RTI_MQTT_Client_on_async_write_result(
+    struct RTI_MQTT_PendingRequest *req,
+    DDS_ReturnCode_t result);
+
 static void
 RTI_MQTT_Client_on_subscription_result(
     struct RTI_MQTT_PendingRequest *req,
@@ -134,6 +139,33 @@ RTI_MQTT_Client_delete_subscription_requests(
     struct RTI_MQTT_Client *self,
     struct RTI_MQTT_Subscription *sub);
 
+static DDS_ReturnCode_t
+RTI_MQTT_Client_acquire_write_slot(
+    struct RTI_MQTT_Client *self,
+    struct RTI_MQTT_Publication *pub,
+    RTI_MQTT_QosLevel qos,
+    struct RTI_MQTT_PublicationWriteSlot **slot_out);
+
+static DDS_ReturnCode_t
+RTI_MQTT_Client_wait_for_pending_writes(
+    struct RTI_MQTT_Client *self,
+    struct RTI_MQTT_Publication *pub);
+
+static DDS_ReturnCode_t
+RTI_MQTT_Client_new_subscription_index(
+    struct RTI_MQTT_Client *self,
+    struct RTI_MQTT_Subscription *exclude_sub,
+    struct RTI_MQTT_TopicFilterIndex **index_out);
+
+static void
+RTI_MQTT_Client_delete_subscription_index(
+    struct RTI_MQTT_TopicFilterIndex *index);
+
+static void
+RTI_MQTT_Client_replace_subscription_index(
+    struct RTI_MQTT_Client *self,
+    struct RTI_MQTT_TopicFilterIndex *old_index);
+
 static DDS_ReturnCode_t
 RTI_MQTT_Client_add_subscription(
     struct RTI_MQTT_Client *self,
@@ -487,6 +519,10 @@ RTI_MQTT_Client_create_publication_requests(
     struct RTI_MQTT_Publication *pub)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_PublicationWriteSlot 
+        def_slot = RTI_MQTT_PublicationWriteSlot_INITIALIZER;
+    DDS_UnsignedLong slots_len = 0,
+                     i = 0;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_Client_create_publication_requests)
     
@@ -506,6 +542,48 @@ RTI_MQTT_Client_create_publication_requests(
         goto done;
     }
 
+    if (!pub->data->config->async_write)
+    {
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    /* Asynchronous publications may have up to max_unack_messages writes
+       in flight. Each one is tracked by a dedicated slot, and the
+       publication's own request is only used to wait for slots to become
+       available when the window is full. */
+    slots_len = self->data->config->max_unack_messages;
+    if (slots_len == 0)
+    {
+        slots_len = 1;
+    }
+
+    pub->write_slots = (struct RTI_MQTT_PublicationWriteSlot*)
+            RTI_MQTT_Heap_allocate(
+                sizeof(struct RTI_MQTT_PublicationWriteSlot) * slots_len);
+    if (pub->write_slots == NULL)
+    {
+        RTI_MQTT_HEAP_ALLOCATE_FAILED(
+            sizeof(struct RTI_MQTT_PublicationWriteSlot) * slots_len)
+        goto done;
+    }
+    pub->write_slots_len = slots_len;
+
+    for (i = 0; i < slots_len; i++)
+    {
+        struct RTI_MQTT_PublicationWriteSlot *slot = &pub->write_slots[i];
+
+        *slot = def_slot;
+        slot->pub = pub;
+        slot->req.client = self;
+        slot->req.context = slot;
+        slot->req.timeout = self->data->config->max_reply_timeout;
+        slot->req.result_handler = RTI_MQTT_Client_on_async_write_result;
+        slot->next_free = (i + 1 < slots_len)? &pub->write_slots[i + 1] : NULL;
+    }
+    pub->write_slots_free = &pub->write_slots[0];
+    pub->write_inflight = 0;
+
     retcode = DDS_RETCODE_OK;
     
 done:
@@ -582,11 +660,46 @@ RTI_MQTT_Client_delete_publication_requests(
     struct RTI_MQTT_Publication *pub)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_Boolean drained = DDS_BOOLEAN_TRUE;
+    DDS_UnsignedLong i = 0;
     
     RTI_MQTT_LOG_FN(RTI_MQTT_Client_delete_publication_requests)
 
+    /* Wait for all asynchronous writes to complete before releasing the
+       slots which the MQTT library will use to notify their results. */
+    if (pub->write_slots != NULL && pub->req != NULL &&
+        DDS_RETCODE_OK != RTI_MQTT_Client_wait_for_pending_writes(self, pub))
+    {
+        RTI_MQTT_LOG_CLIENT_WAIT_FOR_WRITE_RESULTS_FAILED(self, pub)
+        drained = DDS_BOOLEAN_FALSE;
+    }
+
     RTI_MQTT_Mutex_assert(&self->pub_lock);
 
+    if (pub->write_slots != NULL)
+    {
+        if (drained)
+        {
+            RTI_MQTT_Heap_free(pub->write_slots);
+        }
+        else
+        {
+            /* The MQTT library may still notify the writes which never
+               completed, so the client keeps the slots until it deletes
+               the library's client. The result handler ignores slots
+               without a publication. */
+            for (i = 0; i < pub->write_slots_len; i++)
+            {
+                pub->write_slots[i].pub = NULL;
+            }
+            pub->write_slots[0].next_orphans = self->orphan_slots;
+            self->orphan_slots = pub->write_slots;
+        }
+        pub->write_slots = NULL;
+        pub->write_slots_len = 0;
+        pub->write_slots_free = NULL;
+    }
+
     if (DDS_RETCODE_OK != RTI_MQTT_Client_delete_request(self, &pub->req))
     {
         /* TODO Log error */
@@ -706,62 +819,73 @@ done:
 DDS_ReturnCode_t
 RTI_MQTT_Client_on_message_arrived(
     struct RTI_MQTT_Client *self,
-    const char *topic,
-    const char *buffer,
-    DDS_UnsignedLong buffer_len,
-    RTI_MQTT_MessageInfo *msg_info)
+    struct RTI_MQTT_ReceivedPayload *payload)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
     
-    DDS_Boolean match = DDS_BOOLEAN_FALSE;
     DDS_UnsignedLong seq_len = 0,
                      i = 0;
+    struct RTI_MQTT_TopicFilterIndex *index = NULL;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_Client_on_message_arrived)
 
     RTI_MQTT_TRACE_2("message RECEIVED:","topic=%s, size=%u",
-            topic, buffer_len)
+            payload->topic, payload->buffer_len)
 
-    RTI_MQTT_Mutex_assert(&self->sub_lock);
+    /* Announce the delivery before loading the index, so that a thread
+       replacing it waits for this delivery to complete before deleting
+       the index that was loaded. No lock is taken on this path. */
+    (void)RTI_MQTT_Atomic_increment(&self->sub_readers);
+    index = (struct RTI_MQTT_TopicFilterIndex*)
+                RTI_MQTT_Atomic_load_ptr(&self->sub_index);
 
-    seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(&self->subscriptions);
+    if (index == NULL)
+    {
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    /* Find all matching subscriptions with a single lookup in the index
+       of topic filters, instead of matching each subscription's filters */
+    if (!RTI_MQTT_SubscriptionPtrSeq_set_length(&self->sub_matches, 0))
+    {
+        RTI_MQTT_LOG_SET_SEQUENCE_LENGTH_FAILED(&self->sub_matches, 0)
+        goto done;
+    }
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_TopicFilterIndex_match(
+                    index, payload->topic, &self->sub_matches))
+    {
+        RTI_MQTT_LOG_CLIENT_MATCH_SUBSCRIPTION_FAILED(self,NULL)
+        goto done;
+    }
+
+    seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(&self->sub_matches);
     for (i = 0; i < seq_len; i++)
     {
         struct RTI_MQTT_Subscription *sub =
             *RTI_MQTT_SubscriptionPtrSeq_get_reference(
-                    &self->subscriptions, i);
+                    &self->sub_matches, i);
 
-        if (DDS_RETCODE_OK != RTI_MQTT_Subscription_match(sub, topic, &match))
+        RTI_MQTT_TRACE_3("DELIVER message:",
+                         "client=%p sub=%p, topic=%s",
+                         self, sub, payload->topic)
+        
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_Subscription_receive(
+                        sub,
+                        payload,
+                        NULL /* dropped */,
+                        NULL /* lost */))
         {
-            RTI_MQTT_LOG_CLIENT_MATCH_SUBSCRIPTION_FAILED(self,sub)
+            RTI_MQTT_LOG_CLIENT_SUBSCRIPTION_RECEIVE_FAILED(self,sub)
             goto done;
         }
-
-        if (match)
-        {
-            RTI_MQTT_TRACE_3("DELIVER message:",
-                             "client=%p sub=%p, topic=%s",
-                             self, sub, topic)
-            
-            if (DDS_RETCODE_OK !=
-                    RTI_MQTT_Subscription_receive(
-                            sub,
-                            buffer,
-                            buffer_len,
-                            topic,
-                            msg_info,
-                            NULL /* dropped */,
-                            NULL /* lost */))
-            {
-                RTI_MQTT_LOG_CLIENT_SUBSCRIPTION_RECEIVE_FAILED(self,sub)
-                goto done;
-            }
-        }
     }
 
     retcode = DDS_RETCODE_OK;
 done:
-    RTI_MQTT_Mutex_release(&self->sub_lock);
+    (void)RTI_MQTT_Atomic_decrement(&self->sub_readers);
 
     if (retcode != DDS_RETCODE_OK)
     {
@@ -790,11 +914,26 @@ RTI_MQTT_Client_write_message(
     RTI_MQTT_WriteParams *params)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_PublicationWriteSlot *slot = NULL;
+    struct RTI_MQTT_PendingRequest *req = pub->req;
+    DDS_Boolean notify = DDS_BOOLEAN_FALSE;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_Client_write_message)
 
-    RTI_MQTT_Mutex_assert(&self->pub_lock);
-    
+    /* Reserve a slot in the publication's window. Only the publication
+       is locked while waiting, so a full window doesn't block others. */
+    if (pub->write_slots != NULL)
+    {
+        if (DDS_RETCODE_OK != 
+                RTI_MQTT_Client_acquire_write_slot(
+                        self, pub, params->qos_level, &slot))
+        {
+            /* TODO Log error */
+            return DDS_RETCODE_ERROR;
+        }
+        req = &slot->req;
+    }
+
     if (DDS_RETCODE_OK != 
             RTI_MQTT_ClientMqttApi_write_message(
                     self,
@@ -802,7 +941,7 @@ RTI_MQTT_Client_write_message(
                     buffer_len,
                     topic,
                     params,
-                    pub->req))
+                    req))
     {
         /* TODO Log error */
         goto done;
@@ -810,7 +949,20 @@ RTI_MQTT_Client_write_message(
 
     retval = DDS_RETCODE_OK;
 done:
-    RTI_MQTT_Mutex_release(&self->pub_lock);
+    if (retval != DDS_RETCODE_OK && slot != NULL)
+    {
+        /* No result will ever be notified for a message that couldn't be
+           sent, so the slot can be reused right away */
+        if (DDS_RETCODE_OK != 
+                RTI_MQTT_Publication_release_write_slot(pub, slot, &notify))
+        {
+            /* TODO Log error */
+        }
+        if (notify)
+        {
+            RTI_MQTT_Client_handle_request_result(pub->req, DDS_RETCODE_OK);
+        }
+    }
     
     return retval;
 }
@@ -839,6 +991,85 @@ done:
     return retval;
 }
 
+static DDS_ReturnCode_t
+RTI_MQTT_Client_acquire_write_slot(
+    struct RTI_MQTT_Client *self,
+    struct RTI_MQTT_Publication *pub,
+    RTI_MQTT_QosLevel qos,
+    struct RTI_MQTT_PublicationWriteSlot **slot_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_PublicationWriteSlot *slot = NULL;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Client_acquire_write_slot)
+
+    *slot_out = NULL;
+
+    while (slot == NULL)
+    {
+        if (DDS_RETCODE_OK != 
+                RTI_MQTT_Publication_acquire_write_slot(pub, qos, &slot))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        if (slot != NULL)
+        {
+            break;
+        }
+
+        RTI_MQTT_TRACE_2("write window FULL:","client=%p, pub=%p",self,pub)
+
+        /* The trigger on the publication's request is persistent, so a
+           completion notified before we start waiting is not lost. */
+        if (DDS_RETCODE_OK != RTI_MQTT_Client_wait_for_request(self, pub->req))
+        {
+            RTI_MQTT_LOG_CLIENT_WAIT_FAILED(self,"write slot")
+            goto done;
+        }
+    }
+
+    *slot_out = slot;
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+static DDS_ReturnCode_t
+RTI_MQTT_Client_wait_for_pending_writes(
+    struct RTI_MQTT_Client *self,
+    struct RTI_MQTT_Publication *pub)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_Boolean pending = DDS_BOOLEAN_TRUE;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Client_wait_for_pending_writes)
+
+    while (pending)
+    {
+        if (DDS_RETCODE_OK != 
+                RTI_MQTT_Publication_has_pending_writes(pub, &pending))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        if (!pending)
+        {
+            break;
+        }
+        if (DDS_RETCODE_OK != RTI_MQTT_Client_wait_for_request(self, pub->req))
+        {
+            RTI_MQTT_LOG_CLIENT_WAIT_FAILED(self,"pending writes")
+            goto done;
+        }
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
 /*****************************************************************************
  *                     RTI_MQTT_PendingRequest Result Handlers
  *****************************************************************************/
@@ -1029,6 +1260,61 @@ done:
     }
 }
 
+static void
+RTI_MQTT_Client_on_async_write_result(
+    struct RTI_MQTT_PendingRequest *req,
+    DDS_ReturnCode_t result)
+{
+    struct RTI_MQTT_Client *self = req->client;
+    struct RTI_MQTT_PublicationWriteSlot *slot =
+            (struct RTI_MQTT_PublicationWriteSlot*) req->context;
+    struct RTI_MQTT_Publication *pub = NULL;
+    DDS_Boolean notify = DDS_BOOLEAN_FALSE;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Client_on_async_write_result)
+
+    /* Keep the publication from being deleted while its result is
+       accounted for */
+    RTI_MQTT_Mutex_assert(&self->pub_lock);
+    pub = slot->pub;
+    if (pub == NULL)
+    {
+        /* Late result of a publication deleted before its writes
+           completed */
+        RTI_MQTT_Mutex_release(&self->pub_lock);
+        return;
+    }
+
+#if RTI_MQTT_USE_LOG
+    if (result != DDS_RETCODE_OK)
+    {
+        RTI_MQTT_ERROR_4("async write ERROR", 
+                "client=%p, pub=%p, token=%d, result=%d",
+                self, pub, req->token, result)
+    }
+    else
+    {
+        RTI_MQTT_TRACE_3("async write OK", "client=%p, pub=%p, token=%d",
+                self, pub, req->token)
+    }
+#endif /* RTI_MQTT_USE_LOG */
+
+    if (DDS_RETCODE_OK != 
+            RTI_MQTT_Publication_on_async_write_result(
+                    pub, slot, result, &notify))
+    {
+        RTI_MQTT_LOG_CLIENT_NOTIFY_WRITE_RESULTS_FAILED(self,pub)
+    }
+
+    /* Wake up a writer waiting for the window to drain */
+    if (notify)
+    {
+        RTI_MQTT_Client_handle_request_result(pub->req, DDS_RETCODE_OK);
+    }
+
+    RTI_MQTT_Mutex_release(&self->pub_lock);
+}
+
 /*****************************************************************************
  *                          Public API Implementation
  *****************************************************************************/
@@ -1322,6 +1608,14 @@ RTI_MQTT_Client_subscribe(struct RTI_MQTT_Client *self,
     }
     RTI_MQTT_LOG_1("  - qos:","%d",sub->data->config->max_qos)
     RTI_MQTT_LOG_1("  - queue_size:","%d",sub->data->config->message_queue_size)
+    RTI_MQTT_LOG_1("  - defer_conversion:","%d",
+                    sub->data->config->defer_conversion)
+    RTI_MQTT_LOG_1("  - lock_free_queue:","%d",
+                    sub->data->config->lock_free_queue)
+    RTI_MQTT_LOG_1("  - notify_max_messages:","%u",
+                    sub->data->config->notify_max_messages)
+    RTI_MQTT_LOG_1("  - notify_max_delay_usec:","%u",
+                    sub->data->config->notify_max_delay_usec)
     RTI_MQTT_Mutex_release(&self->sub_lock);
 #endif /* RTI_MQTT_USE_LOG */
 
@@ -1342,6 +1636,9 @@ done:
                     RTI_MQTT_Client_remove_subscription(self, sub))
             {
                 /* TODO Log error */
+                /* Still reachable from the index, it will be deleted
+                   with the client */
+                sub = NULL;
             }
         }
         if (sub != NULL)
@@ -1379,12 +1676,18 @@ done:
 
     if (sub != NULL)
     {
+        /* A subscription which is still reachable from the index of
+           topic filters can't be deleted */
         if (DDS_RETCODE_OK !=
                 RTI_MQTT_Client_remove_subscription(self, sub))
         {
             /* TODO Log error */
+            retval = DDS_RETCODE_ERROR;
+        }
+        else
+        {
+            RTI_MQTT_Subscription_delete(sub);
         }
-        RTI_MQTT_Subscription_delete(sub);
     }
 
     return retval;
@@ -1441,6 +1744,9 @@ RTI_MQTT_Client_publish(struct RTI_MQTT_Client *self,
     RTI_MQTT_LOG_2("  - max wait time:","%ds %uns", 
             pub->data->config->max_wait_time.seconds,
             pub->data->config->max_wait_time.nanoseconds)
+    RTI_MQTT_LOG_2("  - async write:","%d (window=%u)", 
+            pub->data->config->async_write,
+            pub->write_slots_len)
     RTI_MQTT_Mutex_release(&self->pub_lock);
 #endif /* RTI_MQTT_USE_LOG */
 
@@ -1516,6 +1822,7 @@ RTI_MQTT_Client_initialize(struct RTI_MQTT_Client *self,
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
     struct RTI_MQTT_Client def_self = RTI_MQTT_Client_INITIALIZER;
+    struct RTI_MQTT_TopicFilterIndex *index = NULL;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_Client_initialize)
 
@@ -1579,6 +1886,20 @@ RTI_MQTT_Client_initialize(struct RTI_MQTT_Client *self,
         goto done;
     }
 
+    if (!RTI_MQTT_SubscriptionPtrSeq_initialize(&self->sub_matches))
+    {
+        RTI_MQTT_LOG_INITIALIZE_SEQUENCE_FAILED(&self->sub_matches)
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_Client_new_subscription_index(self, NULL, &index))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    (void)RTI_MQTT_Atomic_exchange_ptr(&self->sub_index, index);
+
     if (!RTI_MQTT_PublicationPtrSeq_initialize(&self->publications))
     {
         RTI_MQTT_LOG_INITIALIZE_SEQUENCE_FAILED(&self->publications)
@@ -1661,6 +1982,7 @@ RTI_MQTT_Client_finalize(struct RTI_MQTT_Client *self)
     DDS_UnsignedLong seq_len = 0,
                      i = 0;
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndex *index = NULL;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_Client_finalize)
 
@@ -1698,6 +2020,16 @@ RTI_MQTT_Client_finalize(struct RTI_MQTT_Client *self)
         goto done;
     }
 
+    if (!RTI_MQTT_SubscriptionPtrSeq_finalize(&self->sub_matches))
+    {
+        RTI_MQTT_LOG_FINALIZE_SEQUENCE_FAILED(&self->sub_matches)
+        goto done;
+    }
+
+    index = (struct RTI_MQTT_TopicFilterIndex*)
+                RTI_MQTT_Atomic_exchange_ptr(&self->sub_index, NULL);
+    RTI_MQTT_Client_replace_subscription_index(self, index);
+
     if (!RTI_MQTT_PublicationPtrSeq_finalize(&self->publications))
     {
         RTI_MQTT_LOG_FINALIZE_SEQUENCE_FAILED(&self->publications)
@@ -1711,6 +2043,14 @@ RTI_MQTT_Client_finalize(struct RTI_MQTT_Client *self)
         goto done;
     }
 
+    while (self->orphan_slots != NULL)
+    {
+        struct RTI_MQTT_PublicationWriteSlot *slots = self->orphan_slots;
+
+        self->orphan_slots = slots[0].next_orphans;
+        RTI_MQTT_Heap_free(slots);
+    }
+
     if (self->req_connect != NULL)
     {
         if (DDS_RETCODE_OK != 
@@ -2203,6 +2543,143 @@ done:
 }
 
 
+/*
+ * The index of topic filters used to dispatch messages is never modified
+ * once published in `sub_index`. Every time a subscription is added or
+ * removed, a new index is built from the list of subscriptions (leaving
+ * out `exclude_sub`, if not NULL), and it is atomically swapped with the
+ * current one. The delivery thread never takes a lock to load the index,
+ * and it keeps dispatching messages with the previous index while a new
+ * one is being built.
+ */
+static DDS_ReturnCode_t
+RTI_MQTT_Client_new_subscription_index(
+    struct RTI_MQTT_Client *self,
+    struct RTI_MQTT_Subscription *exclude_sub,
+    struct RTI_MQTT_TopicFilterIndex **index_out)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndex *index = NULL;
+    struct RTI_MQTT_TopicFilterIndex def_index =
+                RTI_MQTT_TopicFilterIndex_INITIALIZER;
+    DDS_UnsignedLong seq_len = 0,
+                     filters_len = 0,
+                     i = 0,
+                     j = 0;
+    DDS_Boolean locked = DDS_BOOLEAN_FALSE;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Client_new_subscription_index)
+
+    *index_out = NULL;
+
+    index = (struct RTI_MQTT_TopicFilterIndex*)
+        RTI_MQTT_Heap_allocate(sizeof(struct RTI_MQTT_TopicFilterIndex));
+    if (index == NULL)
+    {
+        RTI_MQTT_HEAP_ALLOCATE_FAILED(
+            sizeof(struct RTI_MQTT_TopicFilterIndex))
+        goto done;
+    }
+    *index = def_index;
+
+    if (DDS_RETCODE_OK != RTI_MQTT_TopicFilterIndex_initialize(index))
+    {
+        /* TODO Log error */
+        RTI_MQTT_Heap_free(index);
+        index = NULL;
+        goto done;
+    }
+
+    RTI_MQTT_Mutex_assert_w_state(&self->sub_lock,&locked);
+    seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(&self->subscriptions);
+    for (i = 0; i < seq_len; i++)
+    {
+        struct RTI_MQTT_Subscription *sub =
+            *RTI_MQTT_SubscriptionPtrSeq_get_reference(
+                    &self->subscriptions, i);
+
+        if (sub == exclude_sub)
+        {
+            continue;
+        }
+
+        filters_len =
+            DDS_StringSeq_get_length(&sub->data->config->topic_filters);
+        for (j = 0; j < filters_len; j++)
+        {
+            const char *filter = *DDS_StringSeq_get_reference(
+                                &sub->data->config->topic_filters, j);
+
+            if (DDS_RETCODE_OK !=
+                    RTI_MQTT_TopicFilterIndex_add(index, filter, sub))
+            {
+                RTI_MQTT_LOG_CLIENT_INDEX_TOPIC_FILTER_FAILED(
+                    self, sub, filter)
+                goto done;
+            }
+        }
+    }
+    RTI_MQTT_Mutex_release_w_state(&self->sub_lock,&locked);
+
+    *index_out = index;
+
+    retcode = DDS_RETCODE_OK;
+done:
+    RTI_MQTT_Mutex_release_from_state(&self->sub_lock,&locked);
+
+    if (retcode != DDS_RETCODE_OK && index != NULL)
+    {
+        RTI_MQTT_Client_delete_subscription_index(index);
+    }
+    return retcode;
+}
+
+static void
+RTI_MQTT_Client_delete_subscription_index(
+    struct RTI_MQTT_TopicFilterIndex *index)
+{
+    RTI_MQTT_LOG_FN(RTI_MQTT_Client_delete_subscription_index)
+
+    if (DDS_RETCODE_OK != RTI_MQTT_TopicFilterIndex_finalize(index))
+    {
+        /* TODO Log error */
+    }
+    RTI_MQTT_Heap_free(index);
+}
+
+/*
+ * Delete an index after it was swapped out of `sub_index`. A delivery
+ * might still be using it, so deletion is delayed until no delivery is in
+ * progress: any delivery starting after the swap loads the new index.
+ * Messages of a client are delivered by a single thread, so the number of
+ * readers drops to zero as soon as the current message is dispatched.
+ * This must be called without holding `sub_lock`, and never from the
+ * delivery thread.
+ */
+static void
+RTI_MQTT_Client_replace_subscription_index(
+    struct RTI_MQTT_Client *self,
+    struct RTI_MQTT_TopicFilterIndex *old_index)
+{
+    struct DDS_Duration_t period = { 0, RTI_MQTT_CLIENT_INDEX_WAIT_PERIOD_NS };
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Client_replace_subscription_index)
+
+    if (old_index == NULL)
+    {
+        return;
+    }
+
+    /* The compare-and-swap is a full barrier, so it can't be reordered
+       with the swap of `sub_index` */
+    while (!RTI_MQTT_Atomic_compare_and_swap(&self->sub_readers, 0, 0))
+    {
+        NDDS_Utility_sleep(&period);
+    }
+
+    RTI_MQTT_Client_delete_subscription_index(old_index);
+}
+
 static DDS_ReturnCode_t
 RTI_MQTT_Client_add_subscription(
     struct RTI_MQTT_Client *self,
@@ -2211,12 +2688,15 @@ RTI_MQTT_Client_add_subscription(
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
     DDS_UnsignedLong seq_len = 0;
     struct RTI_MQTT_Subscription **sub_ref = NULL;
+    struct RTI_MQTT_TopicFilterIndex *index = NULL,
+                                     *old_index = NULL;
+    DDS_Boolean added = DDS_BOOLEAN_FALSE;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_Client_add_subscription)
 
     RTI_MQTT_Mutex_assert(&self->sub_lock);
     seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(&self->subscriptions);
-    
+
     if (!RTI_MQTT_SubscriptionPtrSeq_ensure_length(
             &self->subscriptions, seq_len + 1, seq_len + 1))
     {
@@ -2224,15 +2704,39 @@ RTI_MQTT_Client_add_subscription(
                     &self->subscriptions, seq_len + 1, seq_len + 1)
         goto done;
     }
+    added = DDS_BOOLEAN_TRUE;
 
     sub_ref = RTI_MQTT_SubscriptionPtrSeq_get_reference(
                         &self->subscriptions, seq_len);
     *sub_ref = sub;
-    
+
+    /* If a new index can't be built, the previous one stays in use */
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_Client_new_subscription_index(self, NULL, &index))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    old_index = (struct RTI_MQTT_TopicFilterIndex*)
+                    RTI_MQTT_Atomic_exchange_ptr(&self->sub_index, index);
+
     retcode = DDS_RETCODE_OK;
-    
+
 done:
+    if (retcode != DDS_RETCODE_OK && added)
+    {
+        if (!RTI_MQTT_SubscriptionPtrSeq_set_length(
+                &self->subscriptions, seq_len))
+        {
+            RTI_MQTT_LOG_SET_SEQUENCE_LENGTH_FAILED(
+                        &self->subscriptions, seq_len)
+        }
+    }
     RTI_MQTT_Mutex_release(&self->sub_lock);
+
+    RTI_MQTT_Client_replace_subscription_index(self, old_index);
+
     return retcode;
 }
 
@@ -2247,7 +2751,9 @@ RTI_MQTT_Client_remove_subscription(
                      rm_i = 0;
     DDS_Boolean rm_sub = DDS_BOOLEAN_FALSE;
     struct RTI_MQTT_Subscription **sub_ref = NULL;
-    
+    struct RTI_MQTT_TopicFilterIndex *index = NULL,
+                                     *old_index = NULL;
+
     RTI_MQTT_LOG_FN(RTI_MQTT_Client_remove_subscription)
 
     RTI_MQTT_Mutex_assert(&self->sub_lock);
@@ -2272,10 +2778,23 @@ RTI_MQTT_Client_remove_subscription(
         goto done;
     }
 
+    /* The caller deletes the subscription, so it must not be reachable
+       from the index anymore. If a new index can't be built, the previous
+       one stays in use, and the subscription stays registered, so that the
+       caller doesn't delete it. */
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_Client_new_subscription_index(self, sub, &index))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    old_index = (struct RTI_MQTT_TopicFilterIndex*)
+                    RTI_MQTT_Atomic_exchange_ptr(&self->sub_index, index);
+
     for (i = rm_i; i + 1 < seq_len; i++)
     {
         *RTI_MQTT_SubscriptionPtrSeq_get_reference(
-                        &self->subscriptions, i) = 
+                        &self->subscriptions, i) =
             *RTI_MQTT_SubscriptionPtrSeq_get_reference(
                         &self->subscriptions, i + 1);
     }
@@ -2293,11 +2812,14 @@ RTI_MQTT_Client_remove_subscription(
                     &self->subscriptions, seq_len - 1)
         goto done;
     }
-    
+
     retcode = DDS_RETCODE_OK;
-    
+
 done:
     RTI_MQTT_Mutex_release(&self->sub_lock)
+
+    RTI_MQTT_Client_replace_subscription_index(self, old_index);
+
     return retcode;
 }
 
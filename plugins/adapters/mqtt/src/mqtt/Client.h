@@ -19,6 +19,10 @@
 #include "Publication.h"
 #include "Infrastructure.h"
 #include "ClientApi.h"
+#include "TopicFilterIndex.h"
+
+/* How often a replaced index is checked for pending deliveries */
+#define RTI_MQTT_CLIENT_INDEX_WAIT_PERIOD_NS    100000
 
 struct RTI_MQTT_Client 
 {
@@ -31,7 +35,18 @@ struct RTI_MQTT_Client
     struct RTI_MQTT_SubscriptionRequestContext req_ctx_sub;
     struct RTI_MQTT_SubscriptionParamsSeq   params_sub;
     struct RTI_MQTT_SubscriptionPtrSeq      subscriptions;
+    /* Only accessed with RTI_MQTT_Atomic_*_ptr() */
+    struct RTI_MQTT_TopicFilterIndex        *sub_index;
+    /* Number of deliveries which might be using `sub_index` */
+    RTI_MQTT_AtomicCounter                  sub_readers;
+    struct RTI_MQTT_SubscriptionPtrSeq      sub_matches;
     struct RTI_MQTT_PublicationPtrSeq       publications;
+    /*
+     * Write slots of deleted publications whose writes never completed,
+     * chained through `next_orphans`. They are freed once the MQTT client
+     * library can't notify any more results.
+     */
+    struct RTI_MQTT_PublicationWriteSlot    *orphan_slots;
     RTI_MQTT_Mutex                          cfg_lock;
     RTI_MQTT_Mutex                          mqtt_lock;
     RTI_MQTT_Mutex                          sub_lock;
@@ -49,7 +64,11 @@ struct RTI_MQTT_Client
     RTI_MQTT_SubscriptionRequestContext_INITIALIZER, /* req_ctx_sub */ \
     DDS_SEQUENCE_INITIALIZER, /* params_sub */ \
     DDS_SEQUENCE_INITIALIZER, /* subscriptions */ \
+    NULL, /* sub_index */ \
+    0, /* sub_readers */ \
+    DDS_SEQUENCE_INITIALIZER, /* sub_matches */ \
     DDS_SEQUENCE_INITIALIZER, /* publications */ \
+    NULL, /* orphan_slots */ \
     RTI_MQTT_Mutex_INITIALIZER /* lock */ \
 }
 
@@ -73,9 +92,6 @@ RTI_MQTT_Client_on_connection_lost(struct RTI_MQTT_Client *self);
 DDS_ReturnCode_t
 RTI_MQTT_Client_on_message_arrived(
     struct RTI_MQTT_Client *self,
-    const char *topic,
-    const char *buffer,
-    DDS_UnsignedLong buffer_len,
-    RTI_MQTT_MessageInfo *msg_info);
+    struct RTI_MQTT_ReceivedPayload *payload);
 
 #endif /* Client_h */
\ No newline at end of file
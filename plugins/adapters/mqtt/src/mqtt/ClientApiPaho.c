@@ -22,6 +22,10 @@ RTI_MQTT_ClientMqttApi_Paho_on_success(
 {
     struct RTI_MQTT_PendingRequest *req =
             (struct RTI_MQTT_PendingRequest*)ctx;
+    if (response != NULL)
+    {
+        req->token = response->token;
+    }
     RTI_MQTT_PendingRequest_handle_result(req, DDS_RETCODE_OK);
 }
 
@@ -31,6 +35,10 @@ RTI_MQTT_ClientMqttApi_Paho_on_failure(
 {
     struct RTI_MQTT_PendingRequest *req =
             (struct RTI_MQTT_PendingRequest*)ctx;
+    if (response != NULL)
+    {
+        req->token = response->token;
+    }
     RTI_MQTT_PendingRequest_handle_result(req, DDS_RETCODE_ERROR);
 }
 
@@ -673,31 +681,51 @@ RTI_MQTT_ClientMqttApi_Paho_on_message_arrived(
     void *ctx, char *topic_name, int topic_len, MQTTAsync_message *message)
 {
     DDS_Boolean retval = DDS_BOOLEAN_FALSE;
-    RTI_MQTT_MessageInfo msg_info;
     struct RTI_MQTT_Client *self = (struct RTI_MQTT_Client*)ctx;
+    struct RTI_MQTT_ClientMqttApi_Paho_ReceivedPayload *payload = NULL;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_ClientMqttApi_Paho_on_message_arrived)
 
     RTI_MQTT_TRACE_1("message RECEIVED:","topic=%s",topic_name)
 
+    payload = (struct RTI_MQTT_ClientMqttApi_Paho_ReceivedPayload*)
+                RTI_MQTT_Heap_allocate(
+                    sizeof(struct RTI_MQTT_ClientMqttApi_Paho_ReceivedPayload));
+    if (payload == NULL)
+    {
+        RTI_MQTT_HEAP_ALLOCATE_FAILED(
+            sizeof(struct RTI_MQTT_ClientMqttApi_Paho_ReceivedPayload))
+        goto done;
+    }
+
+    /* The payload takes ownership of Paho's message, which will be
+       freed when the last reference to it is released */
+    payload->message = message;
+    payload->topic_name = topic_name;
+    payload->base.topic = topic_name;
+    payload->base.buffer = (const char*)message->payload;
+    payload->base.buffer_len = message->payloadlen;
+    payload->base.ref_count = 1;
+    payload->base.release = RTI_MQTT_ClientMqttApi_Paho_release_payload;
+    message = NULL;
+    topic_name = NULL;
+
+    payload->base.info.id = payload->message->msgid;
     if (DDS_RETCODE_OK != 
                 RTI_MQTT_QosLevel_from_mqtt_qos(
-                        message->qos,&msg_info.qos_level))
+                        payload->message->qos,
+                        &payload->base.info.qos_level))
     {
         /* TODO Log error */
         goto done;
     }
-    msg_info.retained = 
-        (message->retained)? DDS_BOOLEAN_TRUE : DDS_BOOLEAN_FALSE;
-    msg_info.duplicate = 
-        (message->dup)? DDS_BOOLEAN_TRUE : DDS_BOOLEAN_FALSE;
+    payload->base.info.retained = 
+        (payload->message->retained)? DDS_BOOLEAN_TRUE : DDS_BOOLEAN_FALSE;
+    payload->base.info.duplicate = 
+        (payload->message->dup)? DDS_BOOLEAN_TRUE : DDS_BOOLEAN_FALSE;
 
     if (DDS_RETCODE_OK != 
-            RTI_MQTT_Client_on_message_arrived(self, 
-                                               topic_name,
-                                               message->payload,
-                                               message->payloadlen,
-                                               &msg_info))
+            RTI_MQTT_Client_on_message_arrived(self, &payload->base))
     {
         /* TODO Log error */
         goto done;
@@ -706,11 +734,30 @@ RTI_MQTT_ClientMqttApi_Paho_on_message_arrived(
     retval = DDS_BOOLEAN_TRUE;
 done:
 
-    MQTTAsync_freeMessage(&message);
-    MQTTAsync_free(topic_name);
+    if (payload != NULL)
+    {
+        RTI_MQTT_ReceivedPayload_release(&payload->base);
+    }
+    else
+    {
+        MQTTAsync_freeMessage(&message);
+        MQTTAsync_free(topic_name);
+    }
 
     return retval;
 }
 
+void
+RTI_MQTT_ClientMqttApi_Paho_release_payload(
+    struct RTI_MQTT_ReceivedPayload *payload)
+{
+    struct RTI_MQTT_ClientMqttApi_Paho_ReceivedPayload *self =
+        (struct RTI_MQTT_ClientMqttApi_Paho_ReceivedPayload*)payload;
+
+    MQTTAsync_freeMessage(&self->message);
+    MQTTAsync_free(self->topic_name);
+    RTI_MQTT_Heap_free(self);
+}
+
 
 #endif /* MQTT_CLIENT_API */
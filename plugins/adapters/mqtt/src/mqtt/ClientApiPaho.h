@@ -99,6 +99,21 @@ RTI_MQTT_ClientMqttApi_Paho_on_message_arrived(
     int topic_len,
     MQTTAsync_message *message);
 
+/*
+ * A received message whose buffers are still owned by Paho. They are
+ * released once no RTI_MQTT_MessageReceiveQueue references them anymore.
+ */
+struct RTI_MQTT_ClientMqttApi_Paho_ReceivedPayload
+{
+    struct RTI_MQTT_ReceivedPayload     base;
+    MQTTAsync_message                   *message;
+    char                                *topic_name;
+};
+
+void
+RTI_MQTT_ClientMqttApi_Paho_release_payload(
+    struct RTI_MQTT_ReceivedPayload *payload);
+
 #endif /* MQTT_CLIENT_API */
 
 
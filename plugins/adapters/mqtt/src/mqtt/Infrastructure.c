@@ -16,6 +16,7 @@
 
 #if RTI_MQTT_PLATFORM == RTI_MQTT_PLATFORM_POSIX
     #include <pthread.h>
+    #include <time.h>
 #elif RTI_MQTT_PLATFORM == RTI_MQTT_PLATFORM_WINDOWS
     #include <windows.h>
     #include <process.h>
@@ -270,150 +271,163 @@ done:
 }
 
 DDS_ReturnCode_t
-RTI_MQTT_TopicFilter_match(const char *filter,
-                             const char *value,
-                             DDS_Boolean *match_out)
+RTI_MQTT_Clock_get_microseconds(DDS_UnsignedLongLong *usec_out)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
-    DDS_UnsignedLong f_i = 0,
-                     v_i = 0,
-                     value_len = 0,
-                     filter_len = 0;
-    char f_ch = '\0',
-         f_ch_next = '\0',
-         v_ch = '\0';
-    DDS_Boolean match = DDS_BOOLEAN_TRUE,
-                match_done = DDS_BOOLEAN_FALSE;
+#if RTI_MQTT_PLATFORM == RTI_MQTT_PLATFORM_POSIX
+    struct timespec now;
 
-    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilter_match)
+    if (0 != clock_gettime(CLOCK_MONOTONIC, &now))
+    {
+        /* TODO Log error */
+        goto done;
+    }
 
-    *match_out = DDS_BOOLEAN_FALSE;
+    *usec_out = ((DDS_UnsignedLongLong)now.tv_sec * 1000000) +
+                    (now.tv_nsec / 1000);
 
-    filter_len = RTI_MQTT_String_length(filter);
-    value_len = RTI_MQTT_String_length(value);
+#elif RTI_MQTT_PLATFORM == RTI_MQTT_PLATFORM_WINDOWS
+    LARGE_INTEGER now,
+                  freq;
 
-    for (f_i = 0, v_i = 0; 
-         match && !match_done && 
-            f_i < filter_len && v_i < value_len; 
-         f_i++, v_i++)
+    if (!QueryPerformanceCounter(&now) || !QueryPerformanceFrequency(&freq))
     {
-        f_ch = filter[f_i];
-        f_ch_next = filter[f_i + 1];
-        v_ch = value[v_i];
+        /* TODO Log error */
+        goto done;
+    }
 
-        switch (f_ch)
-        {
-        case '#':
-        {
-            /* Consume '#', assume next character in `filter`
-               is either `/' or '\0' */
-            if (f_ch_next != '/' && f_ch_next != '\0')
-            {
-                /* Invalid filter */
-                goto done;
-            }
+    *usec_out = ((DDS_UnsignedLongLong)(now.QuadPart / freq.QuadPart) *
+                    1000000) +
+                (((now.QuadPart % freq.QuadPart) * 1000000) / freq.QuadPart);
+#endif
 
-            f_i++;
-            f_ch = f_ch_next;
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
 
-            /* The current character in `value` should not be a `/`
-               (assuming empty path elements are not allowed, nor
-               leading or trailing slashes e.g. "foo//bar/baz", "/foo/bar",
-               "foo/bar/"). */
-            if (v_ch == '/')
-            {
-#if 0
-                match = DDS_BOOLEAN_FALSE;
-                match_done = DDS_BOOLEAN_FALSE;
-                break;
-#endif
-                goto done;
-            }
+/*
+ * Check that wildcards occupy an entire level of `filter`, and that '#'
+ * only appears as its last level.
+ */
+static DDS_Boolean
+RTI_MQTT_TopicFilter_is_valid(const char *filter)
+{
+    const char *level = filter;
+    DDS_UnsignedLong level_len = 0,
+                     filter_len = 0,
+                     i = 0;
+    DDS_Boolean last = DDS_BOOLEAN_FALSE;
 
-            /* If we're at the end of `filter`, then we consume the
-               rest of `value`. Basically, we're done, and it's a match. */
-            if (f_ch == '\0')
+    filter_len = RTI_MQTT_String_length(filter);
+    if (filter_len == 0 || filter_len > MQTT_TOPIC_NAME_MAX_LEN)
+    {
+        return DDS_BOOLEAN_FALSE;
+    }
+
+    while (!last)
+    {
+        RTI_MQTT_TopicLevel_length(level, &level_len)
+        last = (level[level_len] == '\0');
+
+        if (RTI_MQTT_TopicLevel_is_wildcard(level, level_len, '#'))
+        {
+            if (!last)
             {
-                v_i = value_len - 1;
-                match_done = DDS_BOOLEAN_TRUE;
+                return DDS_BOOLEAN_FALSE;
             }
-            else
+        }
+        else if (!RTI_MQTT_TopicLevel_is_wildcard(level, level_len, '+'))
+        {
+            for (i = 0; i < level_len; i++)
             {
-                /* Consume `value` until we encounter '/' or 
-                   we consume it all */
-                while (v_ch != '/' && v_i + 1 < value_len)
+                if (level[i] == '#' || level[i] == '+')
                 {
-                    v_i++;
-                    v_ch = value[v_i];
+                    return DDS_BOOLEAN_FALSE;
                 }
-                /* If we consumed all of `value` without finding '/' then
-                   we're done, it's not a match. Otherwise we can movo on
-                   to the next character in `filter` and `value` */
-                match = (v_ch == '/');
-                match_done = !match;
             }
-            break;
         }
-        case '+':
-        {
-            /* Consume '+', assume next character in `filter`
-               is either `/' or '\0' */
-            if (f_ch_next != '/' && f_ch_next != '\0')
-            {
-                /* Invalid filter */
-                goto done;
-            }
 
-            f_i++;
-            f_ch = f_ch_next;
+        level += level_len + 1;
+    }
 
-            /* The current character in `value` should not be a `/`
-               (assuming empty path elements are not allowed, nor
-               leading or trailing slashes e.g. "foo//bar/baz", "/foo/bar",
-               "foo/bar/"). */
-            if (v_ch == '/')
-            {
-                match = DDS_BOOLEAN_FALSE;
-                match_done = DDS_BOOLEAN_TRUE;
-                break;
-            }
-            /* Consume `value` until we find `/` or reach the end
-               of the string */
-            while (v_ch != '/' && v_ch != '\0')
-            {
-                v_i++;
-                v_ch = value[v_i];
-            }
-            
-            if (f_ch == '\0')
-            {
-                match = (v_ch == '\0');
-                match_done = DDS_BOOLEAN_TRUE;
-            }
-            else
-            {
-                match = (v_ch == '/');
-                match_done = !match;
-            }
-            
-            break;
+    return DDS_BOOLEAN_TRUE;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilter_match(const char *filter,
+                             const char *value,
+                             DDS_Boolean *match_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    const char *f_level = filter,
+               *v_level = value;
+    DDS_UnsignedLong f_len = 0,
+                     v_len = 0;
+    DDS_Boolean match = DDS_BOOLEAN_FALSE,
+                match_done = DDS_BOOLEAN_FALSE;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilter_match)
+
+    *match_out = DDS_BOOLEAN_FALSE;
+
+    if (filter == NULL || value == NULL ||
+        !RTI_MQTT_TopicFilter_is_valid(filter))
+    {
+        /* Invalid filter */
+        goto done;
+    }
+
+    /* Topics starting with '$' (e.g. "$SYS/...") are not matched by
+       filters starting with a wildcard (MQTT 3.1.1, section 4.7.2) */
+    if (value[0] == '$' && (filter[0] == '#' || filter[0] == '+'))
+    {
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    /* A NULL `v_level` means that all levels of `value` have been
+       consumed, while an empty level is still a level to match */
+    while (!match_done)
+    {
+        RTI_MQTT_TopicLevel_length(f_level, &f_len)
+
+        if (RTI_MQTT_TopicLevel_is_wildcard(f_level, f_len, '#'))
+        {
+            /* '#' matches the parent level, and any levels below it */
+            match = DDS_BOOLEAN_TRUE;
+            match_done = DDS_BOOLEAN_TRUE;
+            continue;
         }
-        default:
+
+        if (v_level == NULL)
         {
-            /* Current character in `filter` must be equal to current
-               character in `value` */
-            match = (f_ch == v_ch)? DDS_BOOLEAN_TRUE : DDS_BOOLEAN_FALSE;
-            match_done = !match;
-            break;
+            match_done = DDS_BOOLEAN_TRUE;
+            continue;
         }
 
+        RTI_MQTT_TopicLevel_length(v_level, &v_len)
+
+        if (!RTI_MQTT_TopicLevel_is_wildcard(f_level, f_len, '+') &&
+            (f_len != v_len ||
+                RTI_MQTT_Memory_compare(f_level, v_level, f_len) != 0))
+        {
+            match_done = DDS_BOOLEAN_TRUE;
+            continue;
         }
 
+        v_level = (v_level[v_len] == '\0')? NULL : v_level + v_len + 1;
+
+        if (f_level[f_len] == '\0')
+        {
+            /* We must have consumed all of `value` */
+            match = (v_level == NULL);
+            match_done = DDS_BOOLEAN_TRUE;
+            continue;
+        }
+        f_level += f_len + 1;
     }
 
-    /* We must have consumed all of `value` */
-    match = match && (v_i == value_len);
-    
     *match_out = match;
 
     retval = DDS_RETCODE_OK;
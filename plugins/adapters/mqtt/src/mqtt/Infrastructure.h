@@ -22,6 +22,12 @@
 #define RTI_MQTT_String_compare               strcmp
 #define RTI_MQTT_String_to_long               strtol
 #define RTI_MQTT_String_find_substring        strstr
+#define RTI_MQTT_String_print                 sprintf
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define RTI_MQTT_String_print_n               _snprintf
+#else
+#define RTI_MQTT_String_print_n               snprintf
+#endif
 #define RTI_MQTT_Heap_allocate                malloc
 
 #if 0
@@ -41,6 +47,91 @@
 #define RTI_MQTT_Memory_move                  memmove
 #endif
 
+/*
+ * Atomic operations on the counters of lock-free data structures. Loads
+ * have acquire semantics, stores have release semantics, and all
+ * read-modify-write operations are full barriers. Increment and decrement
+ * return the new value of a 64-bit counter. The pointer variants are used
+ * to publish immutable objects to concurrent readers.
+ */
+typedef DDS_UnsignedLongLong RTI_MQTT_AtomicCounter;
+
+#if RTI_MQTT_PLATFORM == RTI_MQTT_PLATFORM_POSIX
+
+#if defined(__ATOMIC_ACQUIRE)
+#define RTI_MQTT_Atomic_load(p_) \
+    __atomic_load_n((p_), __ATOMIC_ACQUIRE)
+#define RTI_MQTT_Atomic_store(p_,v_) \
+    __atomic_store_n((p_), (v_), __ATOMIC_RELEASE)
+#else
+#define RTI_MQTT_Atomic_load(p_) \
+    __sync_fetch_and_add((p_), 0)
+#define RTI_MQTT_Atomic_store(p_,v_) \
+{\
+    __sync_synchronize(); \
+    *(p_) = (v_); \
+}
+#endif
+
+#define RTI_MQTT_Atomic_compare_and_swap(p_,o_,n_) \
+    __sync_bool_compare_and_swap((p_), (o_), (n_))
+
+#define RTI_MQTT_Atomic_add(p_,v_) \
+    ((void)__sync_fetch_and_add((p_), (v_)))
+
+#define RTI_MQTT_Atomic_subtract(p_,v_) \
+    ((void)__sync_fetch_and_sub((p_), (v_)))
+
+#define RTI_MQTT_Atomic_increment(p_) \
+    __sync_add_and_fetch((p_), 1)
+
+#define RTI_MQTT_Atomic_decrement(p_) \
+    __sync_sub_and_fetch((p_), 1)
+
+#if defined(__ATOMIC_ACQUIRE)
+#define RTI_MQTT_Atomic_load_ptr(p_) \
+    __atomic_load_n((p_), __ATOMIC_ACQUIRE)
+#define RTI_MQTT_Atomic_exchange_ptr(p_,v_) \
+    __atomic_exchange_n((p_), (v_), __ATOMIC_SEQ_CST)
+#else
+#define RTI_MQTT_Atomic_load_ptr(p_) \
+    __sync_fetch_and_add((p_), 0)
+#define RTI_MQTT_Atomic_exchange_ptr(p_,v_) \
+    (__sync_synchronize(), __sync_lock_test_and_set((p_), (v_)))
+#endif
+
+#elif RTI_MQTT_PLATFORM == RTI_MQTT_PLATFORM_WINDOWS
+
+#define RTI_MQTT_Atomic_load(p_) \
+    ((RTI_MQTT_AtomicCounter)InterlockedCompareExchange64(\
+        (volatile LONG64*)(p_), 0, 0))
+#define RTI_MQTT_Atomic_store(p_,v_) \
+    ((void)InterlockedExchange64((volatile LONG64*)(p_), (LONG64)(v_)))
+
+#define RTI_MQTT_Atomic_compare_and_swap(p_,o_,n_) \
+    (InterlockedCompareExchange64(\
+        (volatile LONG64*)(p_), (LONG64)(n_), (LONG64)(o_)) == (LONG64)(o_))
+
+/* Only used on the 32-bit counters of message status structures */
+#define RTI_MQTT_Atomic_add(p_,v_) \
+    ((void)InterlockedExchangeAdd((volatile LONG*)(p_), (LONG)(v_)))
+
+#define RTI_MQTT_Atomic_subtract(p_,v_) \
+    ((void)InterlockedExchangeAdd((volatile LONG*)(p_), -((LONG)(v_))))
+
+#define RTI_MQTT_Atomic_increment(p_) \
+    ((RTI_MQTT_AtomicCounter)InterlockedIncrement64((volatile LONG64*)(p_)))
+
+#define RTI_MQTT_Atomic_decrement(p_) \
+    ((RTI_MQTT_AtomicCounter)InterlockedDecrement64((volatile LONG64*)(p_)))
+
+#define RTI_MQTT_Atomic_load_ptr(p_) \
+    InterlockedCompareExchangePointer((PVOID volatile*)(p_), NULL, NULL)
+#define RTI_MQTT_Atomic_exchange_ptr(p_,v_) \
+    InterlockedExchangePointer((PVOID volatile*)(p_), (PVOID)(v_))
+
+#endif
+
 #define MQTT_TOPIC_NAME_MAX_LEN         65535
 
 #define RTI_MQTT_String_is_equal(s_,o_) \
@@ -62,6 +153,12 @@ DDS_ReturnCode_t
 RTI_MQTT_Time_to_dds_duration(
     RTI_MQTT_Time *self, struct DDS_Duration_t *dur_out);
 
+/*
+ * Read a monotonic clock, in microseconds from an unspecified origin.
+ */
+DDS_ReturnCode_t
+RTI_MQTT_Clock_get_microseconds(DDS_UnsignedLongLong *usec_out);
+
 #define RTI_MQTT_Time_is_zero(t_) \
     ((t_)->seconds == 0 && (t_)->nanoseconds == 0)
 
@@ -75,6 +172,27 @@ DDS_ReturnCode_t
 RTI_MQTT_DDS_OctetSeq_to_string(struct DDS_OctetSeq *self, char **str_out);
 
 
+/* Length of the topic level starting at `level_`, i.e. the number of
+   characters before the next '/' or the end of the string. */
+#define RTI_MQTT_TopicLevel_length(level_,len_out_) \
+{\
+    *(len_out_) = 0;\
+    while ((level_)[*(len_out_)] != '/' && (level_)[*(len_out_)] != '\0')\
+    {\
+        *(len_out_) += 1;\
+    }\
+}
+
+#define RTI_MQTT_TopicLevel_is_wildcard(level_,len_,wc_) \
+    ((len_) == 1 && (level_)[0] == (wc_))
+
+/*
+ * Match a topic name against a single topic filter, following the same
+ * rules as RTI_MQTT_TopicFilterIndex: levels are compared one by one,
+ * empty levels included, '+' matches exactly one level, and a trailing '#'
+ * matches its parent level and any number of levels below it. An error is
+ * returned if `filter` is not a valid topic filter.
+ */
 DDS_ReturnCode_t
 RTI_MQTT_TopicFilter_match(const char *filter,
                              const char *value,
@@ -170,6 +288,7 @@ struct RTI_MQTT_PendingRequest
     RTI_MQTT_Time           timeout;
     RTI_MQTT_PendingRequest_ResultHandlerFn result_handler;
     struct DDS_ConditionSeq cond_seq;
+    DDS_Long                token;
 };
 
 #define RTI_MQTT_PendingRequest_INITIALIZER \
@@ -181,7 +300,8 @@ struct RTI_MQTT_PendingRequest
     DDS_RETCODE_ERROR, /* result */ \
     RTI_MQTT_Time_INITIALIZER(0,0), /* timeout */ \
     NULL, /* result_handler */ \
-    DDS_SEQUENCE_INITIALIZER /* cond_seq */ \
+    DDS_SEQUENCE_INITIALIZER, /* cond_seq */ \
+    0 /* token */ \
 }
 
 #define RTI_MQTT_PendingRequest_handle_result(r_,res_) \
@@ -0,0 +1,158 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#include "LockFreeRing.h"
+
+#define RTI_MQTT_LOG_ARGS       "RTI::MQTT::LockFreeRing"
+
+DDS_ReturnCode_t
+RTI_MQTT_LockFreeRing_initialize(
+    struct RTI_MQTT_LockFreeRing *self,
+    DDS_UnsignedLong capacity)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong i = 0;
+
+    self->capacity = 0;
+    self->cells = NULL;
+    self->push_pos = 0;
+    self->pop_pos = 0;
+
+    if (capacity == 0)
+    {
+        RTI_MQTT_INTERNAL_ERROR(
+            "RTI_MQTT_LockFreeRing_initialize can only be "
+            "called with capacity > 0")
+        goto done;
+    }
+
+    self->cells = (struct RTI_MQTT_LockFreeRingCell*)
+            RTI_MQTT_Heap_allocate(
+                sizeof(struct RTI_MQTT_LockFreeRingCell) * capacity);
+    if (self->cells == NULL)
+    {
+        RTI_MQTT_HEAP_ALLOCATE_FAILED(
+            sizeof(struct RTI_MQTT_LockFreeRingCell) * capacity)
+        goto done;
+    }
+
+    for (i = 0; i < capacity; i++)
+    {
+        self->cells[i].seq = i;
+        self->cells[i].value = NULL;
+    }
+    self->capacity = capacity;
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_LockFreeRing_finalize(struct RTI_MQTT_LockFreeRing *self)
+{
+    if (self->cells != NULL)
+    {
+        RTI_MQTT_Heap_free(self->cells);
+        self->cells = NULL;
+    }
+    self->capacity = 0;
+    self->push_pos = 0;
+    self->pop_pos = 0;
+
+    return DDS_RETCODE_OK;
+}
+
+DDS_Boolean
+RTI_MQTT_LockFreeRing_push(
+    struct RTI_MQTT_LockFreeRing *self,
+    void *value)
+{
+    struct RTI_MQTT_LockFreeRingCell *cell = NULL;
+    RTI_MQTT_AtomicCounter pos = 0,
+                           seq = 0;
+    DDS_LongLong diff = 0;
+
+    pos = RTI_MQTT_Atomic_load(&self->push_pos);
+    for (;;)
+    {
+        cell = &self->cells[pos % self->capacity];
+        seq = RTI_MQTT_Atomic_load(&cell->seq);
+        diff = (DDS_LongLong)(seq - pos);
+
+        if (diff == 0)
+        {
+            if (RTI_MQTT_Atomic_compare_and_swap(
+                    &self->push_pos, pos, pos + 1))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* The cell still holds the value pushed one lap ago. The ring
+               is full, unless that value is being popped right now, in
+               which case the cell will be released shortly. */
+            if ((DDS_LongLong)(pos - RTI_MQTT_Atomic_load(&self->pop_pos))
+                    >= (DDS_LongLong)self->capacity)
+            {
+                return DDS_BOOLEAN_FALSE;
+            }
+        }
+        pos = RTI_MQTT_Atomic_load(&self->push_pos);
+    }
+
+    cell->value = value;
+    RTI_MQTT_Atomic_store(&cell->seq, pos + 1);
+
+    return DDS_BOOLEAN_TRUE;
+}
+
+DDS_Boolean
+RTI_MQTT_LockFreeRing_pop(
+    struct RTI_MQTT_LockFreeRing *self,
+    void **value_out)
+{
+    struct RTI_MQTT_LockFreeRingCell *cell = NULL;
+    RTI_MQTT_AtomicCounter pos = 0,
+                           seq = 0;
+    DDS_LongLong diff = 0;
+
+    pos = RTI_MQTT_Atomic_load(&self->pop_pos);
+    for (;;)
+    {
+        cell = &self->cells[pos % self->capacity];
+        seq = RTI_MQTT_Atomic_load(&cell->seq);
+        diff = (DDS_LongLong)(seq - (pos + 1));
+
+        if (diff == 0)
+        {
+            if (RTI_MQTT_Atomic_compare_and_swap(
+                    &self->pop_pos, pos, pos + 1))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            return DDS_BOOLEAN_FALSE;
+        }
+        pos = RTI_MQTT_Atomic_load(&self->pop_pos);
+    }
+
+    *value_out = cell->value;
+    cell->value = NULL;
+    /* Release the cell for the push one lap ahead */
+    RTI_MQTT_Atomic_store(&cell->seq, pos + self->capacity);
+
+    return DDS_BOOLEAN_TRUE;
+}
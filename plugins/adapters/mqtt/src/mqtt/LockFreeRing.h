@@ -0,0 +1,78 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#ifndef LockFreeRing_h
+#define LockFreeRing_h
+
+#include "rtiadapt_mqtt.h"
+
+#include "Infrastructure.h"
+
+/*
+ * A slot of an RTI_MQTT_LockFreeRing. The sequence number tells whether the
+ * slot is ready to be pushed into (seq == position) or popped from
+ * (seq == position + 1) at a certain position of the ring.
+ */
+struct RTI_MQTT_LockFreeRingCell
+{
+    RTI_MQTT_AtomicCounter  seq;
+    void                    *value;
+};
+
+/*
+ * A bounded ring of pointers which can be pushed to and popped from
+ * concurrently without locks. Any number of threads may push or pop, which
+ * lets the single producer of a queue also pop the oldest value from it
+ * to make room for a new one, while its single consumer is reading.
+ */
+struct RTI_MQTT_LockFreeRing
+{
+    DDS_UnsignedLong                    capacity;
+    struct RTI_MQTT_LockFreeRingCell    *cells;
+    RTI_MQTT_AtomicCounter              push_pos;
+    RTI_MQTT_AtomicCounter              pop_pos;
+};
+
+#define RTI_MQTT_LockFreeRing_INITIALIZER \
+{\
+    0, /* capacity */ \
+    NULL, /* cells */ \
+    0, /* push_pos */ \
+    0 /* pop_pos */ \
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_LockFreeRing_initialize(
+    struct RTI_MQTT_LockFreeRing *self,
+    DDS_UnsignedLong capacity);
+
+DDS_ReturnCode_t
+RTI_MQTT_LockFreeRing_finalize(struct RTI_MQTT_LockFreeRing *self);
+
+/*
+ * Append `value` to the ring. Returns DDS_BOOLEAN_FALSE if the ring is full.
+ */
+DDS_Boolean
+RTI_MQTT_LockFreeRing_push(
+    struct RTI_MQTT_LockFreeRing *self,
+    void *value);
+
+/*
+ * Remove the oldest value from the ring. Returns DDS_BOOLEAN_FALSE if the
+ * ring is empty, or if the oldest value is still being pushed.
+ */
+DDS_Boolean
+RTI_MQTT_LockFreeRing_pop(
+    struct RTI_MQTT_LockFreeRing *self,
+    void **value_out);
+
+#endif /* LockFreeRing_h */
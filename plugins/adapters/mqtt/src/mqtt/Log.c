@@ -0,0 +1,635 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#include "Log.h"
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RTI_MQTT_LOG_ARGS       "RTI::MQTT::Log"
+
+int RTI_MQTT_Log_level = RTI_MQTT_LOG_LEVEL_DEFAULT;
+
+/*
+ * Number of adapter plugins which initialized the log. Adapter plugins are
+ * created and deleted by a single Routing Service thread.
+ */
+static DDS_UnsignedLong RTI_MQTT_Log_users = 0;
+
+/*
+ * The backend is read by every logging thread, so it is only accessed with
+ * RTI_MQTT_Atomic_*_ptr(). Each call to RTI_MQTT_Log_printf() is counted in
+ * `RTI_MQTT_Log_writers` while it might be using the backend, and a backend
+ * is only deleted after it was unpublished and that count dropped to zero.
+ */
+static struct RTI_MQTT_LogBackend *RTI_MQTT_Log_backend = NULL;
+
+static RTI_MQTT_AtomicCounter RTI_MQTT_Log_writers = 0;
+
+static void
+RTI_MQTT_Log_load_level(void)
+{
+    static const char *level_names[] =
+    {
+        "SILENT", "ERROR", "WARNING", "INFO", "TRACE"
+    };
+    const char *level_str = getenv(RTI_MQTT_LOG_LEVEL_ENV);
+    int i = 0;
+
+    if (level_str == NULL)
+    {
+        return;
+    }
+    for (i = RTI_MQTT_LOG_LEVEL_SILENT; i <= RTI_MQTT_LOG_LEVEL_TRACE; i++)
+    {
+        if (strcmp(level_str, level_names[i]) == 0)
+        {
+            RTI_MQTT_Log_level = i;
+            return;
+        }
+    }
+    RTI_MQTT_WARNING("unknown log level in " RTI_MQTT_LOG_LEVEL_ENV)
+}
+
+/*
+ * Parse the conversion specification which follows a '%' in a format.
+ * Only the conversions used by the adapter's messages are supported, i.e.
+ * no '*' width or precision, and no length modifier other than "h", "hh",
+ * "l", "ll" and "z".
+ */
+static DDS_Boolean
+RTI_MQTT_LogRecord_parse_spec(
+    const char *spec,
+    RTI_MQTT_LogArgKind *kind_out,
+    DDS_UnsignedLong *spec_len_out)
+{
+    DDS_UnsignedLong i = 0;
+    int longs = 0;
+    DDS_Boolean is_size = DDS_BOOLEAN_FALSE;
+
+    while (spec[i] == '-' || spec[i] == '+' || spec[i] == ' ' ||
+            spec[i] == '#' || spec[i] == '0')
+    {
+        i += 1;
+    }
+    while (spec[i] >= '0' && spec[i] <= '9')
+    {
+        i += 1;
+    }
+    if (spec[i] == '.')
+    {
+        i += 1;
+        while (spec[i] >= '0' && spec[i] <= '9')
+        {
+            i += 1;
+        }
+    }
+    if (spec[i] == 'h')
+    {
+        i += (spec[i + 1] == 'h')? 2 : 1;
+    }
+    else if (spec[i] == 'l')
+    {
+        longs = (spec[i + 1] == 'l')? 2 : 1;
+        i += longs;
+    }
+    else if (spec[i] == 'z')
+    {
+        is_size = DDS_BOOLEAN_TRUE;
+        i += 1;
+    }
+
+    switch (spec[i])
+    {
+    case 'd':
+    case 'i':
+    case 'c':
+        *kind_out = (is_size)? RTI_MQTT_LogArgKind_SIZE :
+                    (longs == 2)? RTI_MQTT_LogArgKind_LONGLONG :
+                    (longs == 1)? RTI_MQTT_LogArgKind_LONG :
+                    RTI_MQTT_LogArgKind_INT;
+        break;
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        *kind_out = (is_size)? RTI_MQTT_LogArgKind_SIZE :
+                    (longs == 2)? RTI_MQTT_LogArgKind_ULONGLONG :
+                    (longs == 1)? RTI_MQTT_LogArgKind_ULONG :
+                    RTI_MQTT_LogArgKind_UINT;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+        *kind_out = RTI_MQTT_LogArgKind_DOUBLE;
+        break;
+    case 'p':
+        *kind_out = RTI_MQTT_LogArgKind_POINTER;
+        break;
+    case 's':
+        if (longs > 0)
+        {
+            return DDS_BOOLEAN_FALSE;
+        }
+        *kind_out = RTI_MQTT_LogArgKind_STRING;
+        break;
+    default:
+        return DDS_BOOLEAN_FALSE;
+    }
+
+    /* '%', the specification, and a terminator must fit in a buffer */
+    *spec_len_out = i + 1;
+    return (*spec_len_out + 2 <= RTI_MQTT_LOG_SPEC_MAX_LEN);
+}
+
+/*
+ * Store a message in a record without formatting it: the kinds of the
+ * arguments are parsed from the format, and then each argument is copied
+ * as a raw value. Returns DDS_BOOLEAN_FALSE, before consuming any argument,
+ * if the format can't be captured.
+ */
+static DDS_Boolean
+RTI_MQTT_LogRecord_capture(
+    struct RTI_MQTT_LogRecord *self,
+    const char *fmt,
+    va_list args)
+{
+    const char *cur = fmt,
+               *str = NULL;
+    RTI_MQTT_LogArgKind kind = RTI_MQTT_LogArgKind_INT;
+    DDS_UnsignedLong spec_len = 0,
+                     avail = 0,
+                     len = 0,
+                     i = 0;
+    union RTI_MQTT_LogArg *arg = NULL;
+
+    self->args_len = 0;
+    self->strings_len = 0;
+
+    while ((cur = strchr(cur, '%')) != NULL)
+    {
+        if (cur[1] == '%')
+        {
+            cur += 2;
+            continue;
+        }
+        if (self->args_len == RTI_MQTT_LOG_RECORD_MAX_ARGS ||
+            !RTI_MQTT_LogRecord_parse_spec(cur + 1, &kind, &spec_len))
+        {
+            return DDS_BOOLEAN_FALSE;
+        }
+        self->kinds[self->args_len] = (unsigned char)kind;
+        self->args_len += 1;
+        cur += 1 + spec_len;
+    }
+
+    for (i = 0; i < self->args_len; i++)
+    {
+        arg = &self->args[i];
+        switch ((RTI_MQTT_LogArgKind)self->kinds[i])
+        {
+        case RTI_MQTT_LogArgKind_INT:
+            arg->as_signed = va_arg(args, int);
+            break;
+        case RTI_MQTT_LogArgKind_LONG:
+            arg->as_signed = va_arg(args, long);
+            break;
+        case RTI_MQTT_LogArgKind_LONGLONG:
+            arg->as_signed = va_arg(args, long long);
+            break;
+        case RTI_MQTT_LogArgKind_UINT:
+            arg->as_unsigned = va_arg(args, unsigned int);
+            break;
+        case RTI_MQTT_LogArgKind_ULONG:
+            arg->as_unsigned = va_arg(args, unsigned long);
+            break;
+        case RTI_MQTT_LogArgKind_ULONGLONG:
+            arg->as_unsigned = va_arg(args, unsigned long long);
+            break;
+        case RTI_MQTT_LogArgKind_SIZE:
+            arg->as_unsigned = va_arg(args, size_t);
+            break;
+        case RTI_MQTT_LogArgKind_DOUBLE:
+            arg->as_double = va_arg(args, double);
+            break;
+        case RTI_MQTT_LogArgKind_POINTER:
+            arg->as_pointer = va_arg(args, void*);
+            break;
+        case RTI_MQTT_LogArgKind_STRING:
+            str = va_arg(args, const char*);
+            if (str == NULL)
+            {
+                str = "(null)";
+            }
+            /* Long strings are truncated, and the last string of a full
+               record is empty */
+            arg->as_string = self->strings_len;
+            avail = RTI_MQTT_LOG_RECORD_STRINGS_LEN - self->strings_len;
+            if (avail == 0)
+            {
+                arg->as_string = self->strings_len - 1;
+                break;
+            }
+            for (len = 0; len + 1 < avail && str[len] != '\0'; len++)
+            {
+                self->strings[self->strings_len + len] = str[len];
+            }
+            self->strings[self->strings_len + len] = '\0';
+            self->strings_len += len + 1;
+            break;
+        }
+    }
+
+    self->fmt = fmt;
+    return DDS_BOOLEAN_TRUE;
+}
+
+/*
+ * Format a record to the output. This is the only place where messages
+ * logged through the backend are formatted, and it only runs on the drain
+ * thread.
+ */
+static void
+RTI_MQTT_LogRecord_write(
+    const struct RTI_MQTT_LogRecord *self,
+    FILE *output)
+{
+    char spec[RTI_MQTT_LOG_SPEC_MAX_LEN];
+    const char *cur = self->fmt,
+               *next = NULL;
+    const union RTI_MQTT_LogArg *arg = NULL;
+    RTI_MQTT_LogArgKind kind = RTI_MQTT_LogArgKind_INT;
+    DDS_UnsignedLong spec_len = 0,
+                     i = 0;
+
+    if (self->fmt == NULL)
+    {
+        fputs(self->strings, output);
+        return;
+    }
+
+    while ((next = strchr(cur, '%')) != NULL)
+    {
+        fwrite(cur, 1, (size_t)(next - cur), output);
+        if (next[1] == '%')
+        {
+            fputc('%', output);
+            cur = next + 2;
+            continue;
+        }
+
+        /* The format was already validated when it was captured */
+        (void)RTI_MQTT_LogRecord_parse_spec(next + 1, &kind, &spec_len);
+        RTI_MQTT_Memory_copy(spec, next, spec_len + 1);
+        spec[spec_len + 1] = '\0';
+        cur = next + 1 + spec_len;
+
+        arg = &self->args[i];
+        switch ((RTI_MQTT_LogArgKind)self->kinds[i])
+        {
+        case RTI_MQTT_LogArgKind_INT:
+            fprintf(output, spec, (int)arg->as_signed);
+            break;
+        case RTI_MQTT_LogArgKind_LONG:
+            fprintf(output, spec, (long)arg->as_signed);
+            break;
+        case RTI_MQTT_LogArgKind_LONGLONG:
+            fprintf(output, spec, (long long)arg->as_signed);
+            break;
+        case RTI_MQTT_LogArgKind_UINT:
+            fprintf(output, spec, (unsigned int)arg->as_unsigned);
+            break;
+        case RTI_MQTT_LogArgKind_ULONG:
+            fprintf(output, spec, (unsigned long)arg->as_unsigned);
+            break;
+        case RTI_MQTT_LogArgKind_ULONGLONG:
+            fprintf(output, spec, (unsigned long long)arg->as_unsigned);
+            break;
+        case RTI_MQTT_LogArgKind_SIZE:
+            fprintf(output, spec, (size_t)arg->as_unsigned);
+            break;
+        case RTI_MQTT_LogArgKind_DOUBLE:
+            fprintf(output, spec, arg->as_double);
+            break;
+        case RTI_MQTT_LogArgKind_POINTER:
+            fprintf(output, spec, (void*)arg->as_pointer);
+            break;
+        case RTI_MQTT_LogArgKind_STRING:
+            fprintf(output, spec, self->strings + arg->as_string);
+            break;
+        }
+        i += 1;
+    }
+    fputs(cur, output);
+}
+
+static void
+RTI_MQTT_LogBackend_count_dropped(struct RTI_MQTT_LogBackend *self)
+{
+    RTI_MQTT_AtomicCounter dropped = 0;
+
+    do
+    {
+        dropped = RTI_MQTT_Atomic_load(&self->dropped);
+    } while (!RTI_MQTT_Atomic_compare_and_swap(
+                &self->dropped, dropped, dropped + 1));
+}
+
+/*
+ * Write all the records which are ready, and report messages which were
+ * dropped since the last call. Returns DDS_BOOLEAN_TRUE if anything was
+ * written to the output.
+ */
+static DDS_Boolean
+RTI_MQTT_LogBackend_drain(
+    struct RTI_MQTT_LogBackend *self,
+    RTI_MQTT_AtomicCounter *reported_dropped)
+{
+    struct RTI_MQTT_LogRecord *record = NULL;
+    RTI_MQTT_AtomicCounter dropped = 0;
+    DDS_Boolean written = DDS_BOOLEAN_FALSE;
+
+    while (RTI_MQTT_LockFreeRing_pop(&self->records, (void**)&record))
+    {
+        RTI_MQTT_LogRecord_write(record, self->output);
+        written = DDS_BOOLEAN_TRUE;
+
+        /* The ring of free records has room for all of them */
+        (void)RTI_MQTT_LockFreeRing_push(&self->free_records, record);
+    }
+
+    dropped = RTI_MQTT_Atomic_load(&self->dropped);
+    if (dropped != *reported_dropped)
+    {
+        fprintf(self->output,
+            RTI_MQTT_LOG_HEAD_WARNING "%llu log messages DROPPED\n",
+            RTI_MQTT_LOG_ARGS,
+            (unsigned long long)(dropped - *reported_dropped));
+        *reported_dropped = dropped;
+        written = DDS_BOOLEAN_TRUE;
+    }
+
+    if (written)
+    {
+        fflush(self->output);
+    }
+    return written;
+}
+
+static void*
+RTI_MQTT_LogBackend_drain_thread(void *arg)
+{
+    struct RTI_MQTT_LogBackend *self = (struct RTI_MQTT_LogBackend*)arg;
+    struct DDS_Duration_t period = { 0, RTI_MQTT_LOG_DRAIN_PERIOD_NS };
+    RTI_MQTT_AtomicCounter reported_dropped = 0;
+    DDS_Boolean stopped = DDS_BOOLEAN_FALSE;
+
+    do
+    {
+        /* Check the flag before draining, so that the records pushed
+           before the backend was stopped are always written */
+        stopped = (RTI_MQTT_Atomic_load(&self->stopped) != 0);
+
+        if (!RTI_MQTT_LogBackend_drain(self, &reported_dropped) && !stopped)
+        {
+            NDDS_Utility_sleep(&period);
+        }
+    } while (!stopped);
+
+    return NULL;
+}
+
+static void
+RTI_MQTT_LogBackend_delete(struct RTI_MQTT_LogBackend *self)
+{
+    if (self->thread != NULL)
+    {
+        RTI_MQTT_Atomic_store(&self->stopped, 1);
+        if (DDS_RETCODE_OK != RTI_MQTT_Thread_join(self->thread, NULL))
+        {
+            /* The drain thread might still be using the backend */
+            RTI_MQTT_ERROR("failed to join log drain thread")
+            return;
+        }
+        RTI_MQTT_Heap_free(self->thread);
+    }
+    if (self->output != NULL && self->output != stdout)
+    {
+        fclose(self->output);
+    }
+    (void)RTI_MQTT_LockFreeRing_finalize(&self->records);
+    (void)RTI_MQTT_LockFreeRing_finalize(&self->free_records);
+    if (self->record_pool != NULL)
+    {
+        RTI_MQTT_Heap_free(self->record_pool);
+    }
+    RTI_MQTT_Heap_free(self);
+}
+
+static DDS_ReturnCode_t
+RTI_MQTT_LogBackend_new(
+    const char *output,
+    struct RTI_MQTT_LogBackend **backend_out)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_LogBackend *backend = NULL;
+    struct RTI_MQTT_LogBackend def_backend =
+                RTI_MQTT_LogBackend_INITIALIZER;
+    DDS_UnsignedLong i = 0;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_LogBackend_new)
+
+    backend = (struct RTI_MQTT_LogBackend*)
+        RTI_MQTT_Heap_allocate(sizeof(struct RTI_MQTT_LogBackend));
+    if (backend == NULL)
+    {
+        RTI_MQTT_HEAP_ALLOCATE_FAILED(sizeof(struct RTI_MQTT_LogBackend))
+        goto done;
+    }
+    *backend = def_backend;
+
+    backend->record_pool = (struct RTI_MQTT_LogRecord*)
+        RTI_MQTT_Heap_allocate(
+            sizeof(struct RTI_MQTT_LogRecord) * RTI_MQTT_LOG_RING_CAPACITY);
+    if (backend->record_pool == NULL)
+    {
+        RTI_MQTT_HEAP_ALLOCATE_FAILED(
+            sizeof(struct RTI_MQTT_LogRecord) * RTI_MQTT_LOG_RING_CAPACITY)
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_LockFreeRing_initialize(
+                &backend->records, RTI_MQTT_LOG_RING_CAPACITY) ||
+        DDS_RETCODE_OK !=
+            RTI_MQTT_LockFreeRing_initialize(
+                &backend->free_records, RTI_MQTT_LOG_RING_CAPACITY))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    for (i = 0; i < RTI_MQTT_LOG_RING_CAPACITY; i++)
+    {
+        (void)RTI_MQTT_LockFreeRing_push(
+                &backend->free_records, &backend->record_pool[i]);
+    }
+
+    if (strcmp(output, "stdout") == 0)
+    {
+        backend->output = stdout;
+    }
+    else
+    {
+        backend->output = fopen(output, "a");
+        if (backend->output == NULL)
+        {
+            RTI_MQTT_ERROR_1("failed to open log file:","%s",output)
+            goto done;
+        }
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_Thread_spawn(
+                RTI_MQTT_LogBackend_drain_thread, backend, &backend->thread))
+    {
+        /* TODO Log error */
+        backend->thread = NULL;
+        goto done;
+    }
+
+    *backend_out = backend;
+
+    retcode = DDS_RETCODE_OK;
+done:
+    if (retcode != DDS_RETCODE_OK && backend != NULL)
+    {
+        RTI_MQTT_LogBackend_delete(backend);
+    }
+    return retcode;
+}
+
+void
+RTI_MQTT_Log_initialize(void)
+{
+    const char *output = NULL;
+    struct RTI_MQTT_LogBackend *backend = NULL;
+
+    RTI_MQTT_Log_load_level();
+
+    RTI_MQTT_Log_users += 1;
+    if (RTI_MQTT_Log_users > 1)
+    {
+        return;
+    }
+
+    output = getenv(RTI_MQTT_LOG_ASYNC_ENV);
+    if (output == NULL)
+    {
+        return;
+    }
+    if (DDS_RETCODE_OK != RTI_MQTT_LogBackend_new(output, &backend))
+    {
+        /* Messages will keep being written synchronously */
+        RTI_MQTT_ERROR_1("failed to start asynchronous log:","output=%s",
+            output)
+        return;
+    }
+    (void)RTI_MQTT_Atomic_exchange_ptr(&RTI_MQTT_Log_backend, backend);
+}
+
+void
+RTI_MQTT_Log_finalize(void)
+{
+    struct RTI_MQTT_LogBackend *backend = NULL;
+    struct DDS_Duration_t period = { 0, RTI_MQTT_LOG_QUIESCE_PERIOD_NS };
+
+    if (RTI_MQTT_Log_users == 0)
+    {
+        return;
+    }
+    RTI_MQTT_Log_users -= 1;
+    if (RTI_MQTT_Log_users > 0)
+    {
+        return;
+    }
+
+    backend = (struct RTI_MQTT_LogBackend*)
+        RTI_MQTT_Atomic_exchange_ptr(&RTI_MQTT_Log_backend, NULL);
+    if (backend == NULL)
+    {
+        return;
+    }
+
+    /* Threads which loaded the backend before it was unpublished might
+       still be pushing records. Logging never blocks, so they complete
+       quickly, and the compare-and-swap is a full barrier. */
+    while (!RTI_MQTT_Atomic_compare_and_swap(&RTI_MQTT_Log_writers, 0, 0))
+    {
+        NDDS_Utility_sleep(&period);
+    }
+    RTI_MQTT_LogBackend_delete(backend);
+}
+
+void
+RTI_MQTT_Log_printf(const char *fmt, ...)
+{
+    struct RTI_MQTT_LogBackend *backend = NULL;
+    struct RTI_MQTT_LogRecord *record = NULL;
+    va_list args;
+    int len = 0;
+
+    (void)RTI_MQTT_Atomic_increment(&RTI_MQTT_Log_writers);
+    backend = (struct RTI_MQTT_LogBackend*)
+        RTI_MQTT_Atomic_load_ptr(&RTI_MQTT_Log_backend);
+
+    va_start(args, fmt);
+
+    if (backend == NULL)
+    {
+        vfprintf(stdout, fmt, args);
+    }
+    else if (!RTI_MQTT_LockFreeRing_pop(
+                    &backend->free_records, (void**)&record))
+    {
+        /* Never wait for the drain thread to catch up */
+        RTI_MQTT_LogBackend_count_dropped(backend);
+    }
+    else
+    {
+        if (!RTI_MQTT_LogRecord_capture(record, fmt, args))
+        {
+            record->fmt = NULL;
+            len = vsnprintf(record->strings,
+                    RTI_MQTT_LOG_RECORD_STRINGS_LEN, fmt, args);
+            if (len < 0)
+            {
+                record->strings[0] = '\0';
+            }
+            else if (len >= RTI_MQTT_LOG_RECORD_STRINGS_LEN)
+            {
+                /* The drain thread doesn't add a line break */
+                record->strings[RTI_MQTT_LOG_RECORD_STRINGS_LEN - 2] = '\n';
+            }
+        }
+
+        /* The ring has room for all records */
+        (void)RTI_MQTT_LockFreeRing_push(&backend->records, record);
+    }
+
+    va_end(args);
+
+    (void)RTI_MQTT_Atomic_decrement(&RTI_MQTT_Log_writers);
+}
@@ -0,0 +1,105 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#ifndef Log_h
+#define Log_h
+
+#include "rtiadapt_mqtt.h"
+
+#include "Infrastructure.h"
+#include "LockFreeRing.h"
+
+#define RTI_MQTT_LOG_RECORD_MAX_ARGS        12
+
+#define RTI_MQTT_LOG_RECORD_STRINGS_LEN     256
+
+#define RTI_MQTT_LOG_SPEC_MAX_LEN           16
+
+#define RTI_MQTT_LOG_RING_CAPACITY          4096
+
+#define RTI_MQTT_LOG_DRAIN_PERIOD_NS        10000000
+
+#define RTI_MQTT_LOG_QUIESCE_PERIOD_NS      100000
+
+typedef enum RTI_MQTT_LogArgKind
+{
+    RTI_MQTT_LogArgKind_INT,
+    RTI_MQTT_LogArgKind_LONG,
+    RTI_MQTT_LogArgKind_LONGLONG,
+    RTI_MQTT_LogArgKind_UINT,
+    RTI_MQTT_LogArgKind_ULONG,
+    RTI_MQTT_LogArgKind_ULONGLONG,
+    RTI_MQTT_LogArgKind_SIZE,
+    RTI_MQTT_LogArgKind_DOUBLE,
+    RTI_MQTT_LogArgKind_POINTER,
+    RTI_MQTT_LogArgKind_STRING
+} RTI_MQTT_LogArgKind;
+
+union RTI_MQTT_LogArg
+{
+    DDS_LongLong            as_signed;
+    DDS_UnsignedLongLong    as_unsigned;
+    double                  as_double;
+    const void              *as_pointer;
+    /* offset of a string argument in the record's `strings` */
+    DDS_UnsignedLong        as_string;
+};
+
+/*
+ * A message logged by a plugin thread, waiting to be formatted and written
+ * by the drain thread. The record keeps the format, which is always a
+ * literal built by the RTI_MQTT_LOG_* macros, and a raw copy of the
+ * arguments. String arguments (e.g. topic names) are copied into `strings`,
+ * since they are usually released once the logging call returns. If the
+ * format uses a conversion which can't be captured, the message is
+ * formatted into `strings` by the logging thread, and `fmt` is NULL.
+ */
+struct RTI_MQTT_LogRecord
+{
+    const char              *fmt;
+    DDS_UnsignedLong        args_len;
+    DDS_UnsignedLong        strings_len;
+    unsigned char           kinds[RTI_MQTT_LOG_RECORD_MAX_ARGS];
+    union RTI_MQTT_LogArg   args[RTI_MQTT_LOG_RECORD_MAX_ARGS];
+    char                    strings[RTI_MQTT_LOG_RECORD_STRINGS_LEN];
+};
+
+/*
+ * The asynchronous backend of the logging module. Records are preallocated,
+ * and they move between two rings: logging threads pop a record from
+ * `free_records`, capture a message in it, and push it to `records`. The
+ * drain thread pops records from `records`, formats them to `output`, and
+ * returns them to `free_records`.
+ */
+struct RTI_MQTT_LogBackend
+{
+    struct RTI_MQTT_LockFreeRing    records;
+    struct RTI_MQTT_LockFreeRing    free_records;
+    struct RTI_MQTT_LogRecord       *record_pool;
+    FILE                            *output;
+    void                            *thread;
+    RTI_MQTT_AtomicCounter          stopped;
+    RTI_MQTT_AtomicCounter          dropped;
+};
+
+#define RTI_MQTT_LogBackend_INITIALIZER \
+{\
+    RTI_MQTT_LockFreeRing_INITIALIZER, /* records */ \
+    RTI_MQTT_LockFreeRing_INITIALIZER, /* free_records */ \
+    NULL, /* record_pool */ \
+    NULL, /* output */ \
+    NULL, /* thread */ \
+    0, /* stopped */ \
+    0 /* dropped */ \
+}
+
+#endif /* Log_h */
@@ -16,6 +16,73 @@
 
 #define RTI_MQTT_LOG_ARGS       "RTI::MQTT::Message"
 
+void
+RTI_MQTT_ReceivedPayload_retain(
+        struct RTI_MQTT_ReceivedPayload *self)
+{
+    (void)RTI_MQTT_Atomic_increment(&self->ref_count);
+}
+
+void
+RTI_MQTT_ReceivedPayload_release(
+        struct RTI_MQTT_ReceivedPayload *self)
+{
+    if (RTI_MQTT_Atomic_decrement(&self->ref_count) == 0)
+    {
+        self->release(self);
+    }
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_ReceivedPayload_to_dynamic_data(
+        struct RTI_MQTT_ReceivedPayload *self,
+        const struct RTI_MQTT_MessageMembers *members,
+        DDS_DynamicData *sample)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    RTI_MQTT_Message msg_static;
+
+    msg_static.topic = (char*) self->topic;
+    msg_static.info = &self->info;
+
+    if (!DDS_OctetSeq_initialize(&msg_static.payload.data))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (!DDS_OctetSeq_loan_contiguous(
+                    &msg_static.payload.data,
+                    (DDS_Octet*)self->buffer,
+                    self->buffer_len,
+                    self->buffer_len))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (members != NULL)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_Message_to_dynamic_data_w_members(
+                            &msg_static, members, sample))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+    }
+    else if (DDS_RETCODE_OK !=
+                RTI_MQTT_Message_to_dynamic_data(&msg_static, sample))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
 DDS_ReturnCode_t
 RTI_MQTT_ReceivedMessage_new(
         struct RTI_MQTT_ReceivedMessage **msg_out)
@@ -73,6 +140,7 @@ RTI_MQTT_ReceivedMessage_initialize(
         struct RTI_MQTT_ReceivedMessage *self)
 {
     self->message = NULL;
+    self->payload = NULL;
     self->read = DDS_BOOLEAN_FALSE;
     return DDS_RETCODE_OK;
 }
@@ -84,7 +152,7 @@ RTI_MQTT_ReceivedMessage_finalize(
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
 
     /* Data must have already been deleted */
-    if (self->message != NULL)
+    if (self->message != NULL || self->payload != NULL)
     {
         /* TODO Log error */
         goto done;
@@ -146,9 +214,242 @@ RTI_MQTT_ReceivedMessagePtr_copy(
                     (q_)->msg_status->lost_count) \
 }
 
+/*
+ * Take a sample from the queue's pool of free samples, and only allocate a
+ * new one from the type support if the pool is empty.
+ * Must be called with self->lock held, unless the queue is lock-free.
+ */
+static
+DDS_ReturnCode_t
+RTI_MQTT_MessageReceiveQueue_take_sample(
+    struct RTI_MQTT_MessageReceiveQueue *self,
+    DDS_DynamicData **sample_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong pool_len = 0;
+    DDS_DynamicData *sample = NULL;
+    void *free_sample = NULL;
+
+    if (self->lock_free)
+    {
+        if (RTI_MQTT_LockFreeRing_pop(&self->free_samples, &free_sample))
+        {
+            sample = (DDS_DynamicData*)free_sample;
+        }
+    }
+    else
+    {
+        pool_len =
+            RTI_MQTT_DDS_DynamicDataPtrSeq_get_length(&self->sample_pool);
+        if (pool_len > 0)
+        {
+            DDS_DynamicData **sample_ref =
+                RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
+                                        &self->sample_pool, pool_len - 1);
+            sample = *sample_ref;
+            *sample_ref = NULL;
+            if (!RTI_MQTT_DDS_DynamicDataPtrSeq_set_length(
+                        &self->sample_pool, pool_len - 1))
+            {
+                RTI_MQTT_LOG_SET_SEQUENCE_LENGTH_FAILED(
+                        &self->sample_pool, pool_len - 1)
+                *sample_ref = sample;
+                goto done;
+            }
+        }
+    }
+
+    if (sample == NULL)
+    {
+        sample = DDS_DynamicDataTypeSupport_create_data(self->dyn_data);
+        if (sample == NULL)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+    }
+
+    *sample_out = sample;
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+/*
+ * Clear a sample and put it back into the queue's pool of free samples.
+ * The pool grows as needed, so samples are only deleted if they cannot be
+ * cleared or added to it. Lock-free queues have a fixed size pool, which
+ * only overflows if more samples were allocated on demand.
+ * Must be called with self->lock held, unless the queue is lock-free.
+ */
+static
+DDS_ReturnCode_t
+RTI_MQTT_MessageReceiveQueue_return_sample(
+    struct RTI_MQTT_MessageReceiveQueue *self,
+    DDS_DynamicData *sample)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong pool_len = 0,
+                     pool_max = 0;
+
+    if (DDS_RETCODE_OK != DDS_DynamicData_clear_all_members(sample))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (self->lock_free)
+    {
+        if (RTI_MQTT_LockFreeRing_push(&self->free_samples, sample))
+        {
+            retval = DDS_RETCODE_OK;
+        }
+        goto done;
+    }
+
+    pool_len = RTI_MQTT_DDS_DynamicDataPtrSeq_get_length(&self->sample_pool);
+    pool_max = RTI_MQTT_DDS_DynamicDataPtrSeq_get_maximum(&self->sample_pool);
+
+    if (pool_len == pool_max)
+    {
+        pool_max = (pool_max > 0)? pool_max * 2 : 1;
+    }
+
+    if (!RTI_MQTT_DDS_DynamicDataPtrSeq_ensure_length(
+                &self->sample_pool, pool_len + 1, pool_max))
+    {
+        RTI_MQTT_LOG_SET_SEQUENCE_ENSURE_LENGTH_FAILED(
+                &self->sample_pool, pool_len + 1, pool_max)
+        goto done;
+    }
+
+    *RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
+                &self->sample_pool, pool_len) = sample;
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (retval != DDS_RETCODE_OK)
+    {
+        DDS_DynamicDataTypeSupport_delete_data(self->dyn_data, sample);
+    }
+    return retval;
+}
+
+/*
+ * Hand over a queued message to a reader, either by loaning its sample
+ * through `sample_out`, or by copying it into `dst`. Messages whose
+ * conversion was deferred are converted directly into `dst`, or into a
+ * sample taken from the pool. Must be called with self->lock held, unless
+ * the queue is lock-free.
+ */
+static
+DDS_ReturnCode_t
+RTI_MQTT_MessageReceiveQueue_take_message(
+    struct RTI_MQTT_MessageReceiveQueue *self,
+    struct RTI_MQTT_ReceivedMessage *rcvd_msg,
+    DDS_DynamicData *dst,
+    DDS_DynamicData **sample_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_DynamicData *sample = NULL;
+
+    if (rcvd_msg->payload != NULL)
+    {
+        if (sample_out != NULL)
+        {
+            if (DDS_RETCODE_OK !=
+                    RTI_MQTT_MessageReceiveQueue_take_sample(self, &sample))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+            dst = sample;
+        }
+        /* The reader's own samples may be of a different type than the
+           queue's, in which case their members must be resolved */
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_ReceivedPayload_to_dynamic_data(
+                    rcvd_msg->payload,
+                    (DDS_DynamicData_get_type(dst) == self->members.type)?
+                        &self->members : NULL,
+                    dst))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        RTI_MQTT_ReceivedPayload_release(rcvd_msg->payload);
+        rcvd_msg->payload = NULL;
+        rcvd_msg->message = sample;
+        sample = NULL;
+    }
+    else if (sample_out == NULL)
+    {
+        if (!DDS_DynamicDataTypeSupport_copy_data(
+                self->dyn_data, dst, rcvd_msg->message))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_return_sample(
+                        self, rcvd_msg->message))
+        {
+            /* TODO Log error */
+        }
+        rcvd_msg->message = NULL;
+    }
+
+    if (sample_out != NULL)
+    {
+        *sample_out = rcvd_msg->message;
+        rcvd_msg->message = NULL;
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (sample != NULL)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_return_sample(self, sample))
+        {
+            /* TODO Log error */
+        }
+    }
+    return retval;
+}
+
+static
+void
+RTI_MQTT_MessageReceiveQueue_delete_sample_pool(
+    struct RTI_MQTT_MessageReceiveQueue *self)
+{
+    DDS_UnsignedLong pool_len = 0,
+                     i = 0;
+
+    pool_len = RTI_MQTT_DDS_DynamicDataPtrSeq_get_length(&self->sample_pool);
+    for (i = 0; i < pool_len; i++)
+    {
+        DDS_DynamicData **sample_ref =
+            RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
+                                    &self->sample_pool, i);
+        if (*sample_ref != NULL)
+        {
+            DDS_DynamicDataTypeSupport_delete_data(
+                                self->dyn_data, *sample_ref);
+            *sample_ref = NULL;
+        }
+    }
+
+    if (!RTI_MQTT_DDS_DynamicDataPtrSeq_set_length(&self->sample_pool, 0))
+    {
+        RTI_MQTT_LOG_SET_SEQUENCE_LENGTH_FAILED(&self->sample_pool, 0)
+    }
+}
+
 DDS_ReturnCode_t
 RTI_MQTT_MessageReceiveQueue_new(
-    DDS_UnsignedLong size,
+    const RTI_MQTT_SubscriptionConfig *config,
     RTI_MQTT_SubscriptionMessageStatus *msg_status,
     struct RTI_MQTT_MessageReceiveQueue **queue_out)
 {
@@ -167,9 +468,10 @@ RTI_MQTT_MessageReceiveQueue_new(
 
     if (DDS_RETCODE_OK != 
             RTI_MQTT_MessageReceiveQueue_initialize(
-                                queue, size, msg_status))
+                                queue, config, msg_status))
     {
-        RTI_MQTT_LOG_MSG_RECV_QUEUE_INIT_FAILED(queue,size,msg_status)
+        RTI_MQTT_LOG_MSG_RECV_QUEUE_INIT_FAILED(
+                queue,config->message_queue_size,msg_status)
         goto done;
     }
 
@@ -269,7 +571,29 @@ RTI_MQTT_MessageReceiveQueue_initialize_circular(
 
         initd_msgs += 1;
     }
-    
+
+    /* Preallocate one sample for each slot in the queue, so that
+     * messages can be received without allocating new samples */
+    if (!RTI_MQTT_DDS_DynamicDataPtrSeq_ensure_length(
+                &self->sample_pool, self->capacity, self->capacity))
+    {
+        RTI_MQTT_LOG_SET_SEQUENCE_ENSURE_LENGTH_FAILED(
+                &self->sample_pool, self->capacity, self->capacity)
+        goto done;
+    }
+
+    for (i = 0; i < self->capacity; i++)
+    {
+        DDS_DynamicData *sample =
+            DDS_DynamicDataTypeSupport_create_data(self->dyn_data);
+        if (sample == NULL)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        *RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
+                                &self->sample_pool, i) = sample;
+    }
 
     retval = DDS_RETCODE_OK;
 done:
@@ -288,6 +612,7 @@ done:
             }
             RTI_MQTT_ReceivedMessage_delete(msg);
         }
+        RTI_MQTT_MessageReceiveQueue_delete_sample_pool(self);
         if (read_buffer_initd)
         {
             if (!RTI_MQTT_DDS_DynamicDataPtrSeq_finalize(&self->read_buffer))
@@ -330,54 +655,223 @@ done:
     return retval;
 }
 
+/*
+ * Delete all the samples (and release all the payloads) still held by the
+ * rings of a lock-free queue, and finalize the rings.
+ */
+static
+void
+RTI_MQTT_MessageReceiveQueue_delete_rings(
+    struct RTI_MQTT_MessageReceiveQueue *self)
+{
+    void *value = NULL;
+
+    if (self->ring.cells != NULL)
+    {
+        while (RTI_MQTT_LockFreeRing_pop(&self->ring, &value))
+        {
+            if (self->defer_conversion)
+            {
+                RTI_MQTT_ReceivedPayload_release(
+                    (struct RTI_MQTT_ReceivedPayload*)value);
+            }
+            else
+            {
+                DDS_DynamicDataTypeSupport_delete_data(
+                    self->dyn_data, (DDS_DynamicData*)value);
+            }
+        }
+    }
+    if (self->free_samples.cells != NULL)
+    {
+        while (RTI_MQTT_LockFreeRing_pop(&self->free_samples, &value))
+        {
+            DDS_DynamicDataTypeSupport_delete_data(
+                self->dyn_data, (DDS_DynamicData*)value);
+        }
+    }
 
+    if (DDS_RETCODE_OK != RTI_MQTT_LockFreeRing_finalize(&self->ring))
+    {
+        /* TODO Log error */
+    }
+    if (DDS_RETCODE_OK != RTI_MQTT_LockFreeRing_finalize(&self->free_samples))
+    {
+        /* TODO Log error */
+    }
+}
 
 DDS_ReturnCode_t
-RTI_MQTT_MessageReceiveQueue_initialize(
-    struct RTI_MQTT_MessageReceiveQueue *self,
-    DDS_UnsignedLong size,
-    RTI_MQTT_SubscriptionMessageStatus *msg_status)
+RTI_MQTT_MessageReceiveQueue_initialize_lock_free(
+    struct RTI_MQTT_MessageReceiveQueue *self)
 {
-    DDS_Boolean queue_initd = DDS_BOOLEAN_FALSE,
-                lock_initd = DDS_BOOLEAN_FALSE;
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
-    DDS_UnsignedLong i = 0,
-                     initd_msgs = 0;
+    DDS_UnsignedLong i = 0;
+    DDS_Boolean read_buffer_initd = DDS_BOOLEAN_FALSE;
 
-    self->capacity = size;
-    self->size = 0;
-    self->head = 0;
-    self->next = 0;
-    self->next_unread = 0;
-    self->listener_data_avail = NULL;
-    self->listener_data_avail_arg = NULL;
-    self->dyn_data = NULL;
-    self->msg_status = msg_status;
+    if (self->capacity == 0)
+    {
+        RTI_MQTT_LOG_MSG_RECV_QUEUE_LOCK_FREE_UNBOUNDED(self)
+        goto done;
+    }
 
-    if (DDS_RETCODE_OK != RTI_MQTT_Mutex_initialize(&self->lock))
+    if (!RTI_MQTT_DDS_DynamicDataPtrSeq_initialize(&self->read_buffer))
     {
         /* TODO Log error */
         goto done;
     }
-    lock_initd = DDS_BOOLEAN_TRUE;
+    read_buffer_initd = DDS_BOOLEAN_TRUE;
 
-    if (!RTI_MQTT_ReceivedMessagePtrSeq_initialize(&self->queue))
+    if (!RTI_MQTT_DDS_DynamicDataPtrSeq_set_maximum(
+                &self->read_buffer, self->capacity))
     {
-        RTI_MQTT_LOG_INITIALIZE_SEQUENCE_FAILED(&self->queue)
+        /* TODO Log error */
         goto done;
     }
-    queue_initd = DDS_BOOLEAN_TRUE;
 
-    self->dyn_data = DDS_DynamicDataTypeSupport_new(
-                                RTI_MQTT_Message_get_typecode(),
+    self->read_buffer_loaned = DDS_BOOLEAN_FALSE;
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_LockFreeRing_initialize(&self->ring, self->capacity))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    /* Free samples may be held by the producer, by the unread messages,
+     * and by the reader (both loaned and being converted), so the pool
+     * is sized to hold all of them */
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_LockFreeRing_initialize(
+                &self->free_samples, (2 * self->capacity) + 2))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    /* Preallocate one sample for each slot in the ring, and one for the
+     * message being received */
+    for (i = 0; i < self->capacity + 1; i++)
+    {
+        DDS_DynamicData *sample =
+            DDS_DynamicDataTypeSupport_create_data(self->dyn_data);
+        if (sample == NULL)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        if (!RTI_MQTT_LockFreeRing_push(&self->free_samples, sample))
+        {
+            DDS_DynamicDataTypeSupport_delete_data(self->dyn_data, sample);
+            /* TODO Log error */
+            goto done;
+        }
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (DDS_RETCODE_OK != retval)
+    {
+        RTI_MQTT_MessageReceiveQueue_delete_rings(self);
+        if (read_buffer_initd)
+        {
+            if (!RTI_MQTT_DDS_DynamicDataPtrSeq_finalize(&self->read_buffer))
+            {
+                /* TODO Log error */
+            }
+        }
+    }
+
+    return retval;
+}
+
+
+
+DDS_ReturnCode_t
+RTI_MQTT_MessageReceiveQueue_initialize(
+    struct RTI_MQTT_MessageReceiveQueue *self,
+    const RTI_MQTT_SubscriptionConfig *config,
+    RTI_MQTT_SubscriptionMessageStatus *msg_status)
+{
+    DDS_Boolean queue_initd = DDS_BOOLEAN_FALSE,
+                lock_initd = DDS_BOOLEAN_FALSE,
+                pool_initd = DDS_BOOLEAN_FALSE;
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong i = 0,
+                     initd_msgs = 0;
+    struct RTI_MQTT_MessageMembers def_members =
+            RTI_MQTT_MessageMembers_INITIALIZER;
+    struct RTI_MQTT_LockFreeRing def_ring = RTI_MQTT_LockFreeRing_INITIALIZER;
+
+    self->capacity = config->message_queue_size;
+    self->defer_conversion = config->defer_conversion;
+    self->lock_free = config->lock_free_queue;
+    self->ring = def_ring;
+    self->free_samples = def_ring;
+    self->size = 0;
+    self->head = 0;
+    self->next = 0;
+    self->next_unread = 0;
+    self->listener_data_avail = NULL;
+    self->listener_data_avail_arg = NULL;
+    self->notify_max_messages = config->notify_max_messages;
+    self->notify_max_delay_usec = config->notify_max_delay_usec;
+    self->notify_pending = 0;
+    self->notify_last_usec = 0;
+    self->notify_reader_waiting = 1;
+    self->dyn_data = NULL;
+    self->msg_status = msg_status;
+    self->members = def_members;
+
+    if (DDS_RETCODE_OK != RTI_MQTT_Mutex_initialize(&self->lock))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    lock_initd = DDS_BOOLEAN_TRUE;
+
+    if (!RTI_MQTT_ReceivedMessagePtrSeq_initialize(&self->queue))
+    {
+        RTI_MQTT_LOG_INITIALIZE_SEQUENCE_FAILED(&self->queue)
+        goto done;
+    }
+    queue_initd = DDS_BOOLEAN_TRUE;
+
+    if (!RTI_MQTT_DDS_DynamicDataPtrSeq_initialize(&self->sample_pool))
+    {
+        RTI_MQTT_LOG_INITIALIZE_SEQUENCE_FAILED(&self->sample_pool)
+        goto done;
+    }
+    pool_initd = DDS_BOOLEAN_TRUE;
+
+    self->dyn_data = DDS_DynamicDataTypeSupport_new(
+                                RTI_MQTT_Message_get_typecode(),
                                 &DDS_DYNAMIC_DATA_TYPE_PROPERTY_DEFAULT);
     if (self->dyn_data == NULL)
     {
         /* TODO Log error */
         goto done;
     }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_resolve(
+                &self->members,
+                DDS_DynamicDataTypeSupport_get_data_type(self->dyn_data)))
+    {
+        /* TODO Log error */
+        goto done;
+    }
     
-    if (self->capacity > 0)
+    if (self->lock_free)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_initialize_lock_free(self))
+        {
+            RTI_MQTT_LOG_MSG_RECV_QUEUE_INIT_LOCK_FREE_FAILED(self)
+            goto done;
+        }
+    }
+    else if (self->capacity > 0)
     {
         if (DDS_RETCODE_OK !=
                 RTI_MQTT_MessageReceiveQueue_initialize_circular(self))
@@ -413,6 +907,15 @@ done:
                 {
                     RTI_MQTT_LOG_FINALIZE_SEQUENCE_FAILED(&self->queue)
                 }
+                if (pool_initd)
+                {
+                    if (!RTI_MQTT_DDS_DynamicDataPtrSeq_finalize(
+                                &self->sample_pool))
+                    {
+                        RTI_MQTT_LOG_FINALIZE_SEQUENCE_FAILED(
+                                &self->sample_pool)
+                    }
+                }
                 if (self->dyn_data != NULL)
                 {
                     DDS_DynamicDataTypeSupport_delete(self->dyn_data);
@@ -444,6 +947,11 @@ RTI_MQTT_MessageReceiveQueue_finalize(
                                 self->dyn_data, msg->message);
             msg->message = NULL;
         }
+        if (msg->payload != NULL)
+        {
+            RTI_MQTT_ReceivedPayload_release(msg->payload);
+            msg->payload = NULL;
+        }
         RTI_MQTT_ReceivedMessage_delete(msg);
     }
     
@@ -457,6 +965,17 @@ RTI_MQTT_MessageReceiveQueue_finalize(
         RTI_MQTT_LOG_FINALIZE_SEQUENCE_FAILED(&self->read_buffer)
     }
 
+    if (self->lock_free)
+    {
+        RTI_MQTT_MessageReceiveQueue_delete_rings(self);
+    }
+
+    RTI_MQTT_MessageReceiveQueue_delete_sample_pool(self);
+    if (!RTI_MQTT_DDS_DynamicDataPtrSeq_finalize(&self->sample_pool))
+    {
+        RTI_MQTT_LOG_FINALIZE_SEQUENCE_FAILED(&self->sample_pool)
+    }
+
     if (self->dyn_data != NULL)
     {
         DDS_DynamicDataTypeSupport_delete(self->dyn_data);
@@ -478,12 +997,15 @@ DDS_ReturnCode_t
 RTI_MQTT_MessageReceiveQueue_receive_circular(
     struct RTI_MQTT_MessageReceiveQueue *self,
     DDS_DynamicData *msg,
+    struct RTI_MQTT_ReceivedPayload *payload,
     DDS_DynamicData **dropped_out,
+    struct RTI_MQTT_ReceivedPayload **dropped_payload_out,
     DDS_Boolean *lost_out)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
     DDS_Boolean lost = DDS_BOOLEAN_FALSE;
     DDS_DynamicData *dropped = NULL;
+    struct RTI_MQTT_ReceivedPayload *dropped_payload = NULL;
     struct RTI_MQTT_ReceivedMessage *msg_new = NULL;
     DDS_UnsignedLong seq_len = 0,
                      i = 0;
@@ -497,7 +1019,13 @@ RTI_MQTT_MessageReceiveQueue_receive_circular(
         dropped = msg_new->message;
         lost = dropped != NULL;
     }
+    if (msg_new->payload != NULL)
+    {
+        dropped_payload = msg_new->payload;
+        lost = DDS_BOOLEAN_TRUE;
+    }
     msg_new->message = msg;
+    msg_new->payload = payload;
 
     if (self->size < self->capacity)
     {
@@ -515,11 +1043,6 @@ RTI_MQTT_MessageReceiveQueue_receive_circular(
         self->next_unread = (self->next_unread + 1) % self->capacity;
     }
 
-    if (self->listener_data_avail != NULL)
-    {
-        self->listener_data_avail(self,self->listener_data_avail_arg);
-    }
-
     if (lost_out != NULL)
     {
         *lost_out = lost;
@@ -528,6 +1051,10 @@ RTI_MQTT_MessageReceiveQueue_receive_circular(
     {
         *dropped_out = dropped;
     }
+    if (dropped_payload_out != NULL)
+    {
+        *dropped_payload_out = dropped_payload;
+    }
 
     retval = DDS_RETCODE_OK;
 
@@ -540,7 +1067,9 @@ DDS_ReturnCode_t
 RTI_MQTT_MessageReceiveQueue_receive_unbounded(
     struct RTI_MQTT_MessageReceiveQueue *self,
     DDS_DynamicData *msg,
+    struct RTI_MQTT_ReceivedPayload *payload,
     DDS_DynamicData **dropped_out,
+    struct RTI_MQTT_ReceivedPayload **dropped_payload_out,
     DDS_Boolean *lost_out)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
@@ -573,6 +1102,7 @@ RTI_MQTT_MessageReceiveQueue_receive_unbounded(
     }
 
     (*msg_ref)->message = msg;
+    (*msg_ref)->payload = payload;
 
     retval = DDS_RETCODE_OK;
 done:
@@ -582,13 +1112,9 @@ done:
         {
             if (*msg_ref != NULL)
             {
-                if ((*msg_ref)->message != NULL)
-                {
-                    DDS_DynamicDataTypeSupport_delete_data(
-                            self->dyn_data, (*msg_ref)->message);
-                    (*msg_ref)->message = NULL;
-                }
-                
+                /* The sample is still owned by the caller */
+                (*msg_ref)->message = NULL;
+                (*msg_ref)->payload = NULL;
                 RTI_MQTT_ReceivedMessage_delete(*msg_ref);
             }
         }
@@ -608,21 +1134,127 @@ done:
     return retval;
 }
 
+/*
+ * Push a sample (or, if conversion is deferred, a payload) into the ring of
+ * a lock-free queue. If the ring is full, the oldest unread message is
+ * popped and returned through `dropped_out` (or `dropped_payload_out`),
+ * like a circular queue would overwrite it, unless the reader popped it
+ * first. Since only the client's callback pushes into the ring, at most one
+ * message is ever dropped. Dropped messages are returned even on failure,
+ * so that the caller can dispose of them.
+ */
+static
 DDS_ReturnCode_t
-RTI_MQTT_MessageReceiveQueue_receive(
+RTI_MQTT_MessageReceiveQueue_receive_lock_free(
     struct RTI_MQTT_MessageReceiveQueue *self,
-    const char *buffer,
-    DDS_UnsignedLong buffer_len,
-    const char *topic,
-    RTI_MQTT_MessageInfo *msg_info,
+    DDS_DynamicData *msg,
+    struct RTI_MQTT_ReceivedPayload *payload,
     DDS_DynamicData **dropped_out,
+    struct RTI_MQTT_ReceivedPayload **dropped_payload_out,
     DDS_Boolean *lost_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_Boolean lost = DDS_BOOLEAN_FALSE;
+    void *value = NULL,
+         *dropped = NULL;
+
+    value = (self->defer_conversion)? (void*)payload : (void*)msg;
+
+    while (!RTI_MQTT_LockFreeRing_push(&self->ring, value))
+    {
+        if (lost)
+        {
+            RTI_MQTT_INTERNAL_ERROR(
+                "RTI_MQTT_MessageReceiveQueue_receive_lock_free can only be "
+                "called by a single producer")
+            goto done;
+        }
+        lost = RTI_MQTT_LockFreeRing_pop(&self->ring, &dropped);
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (self->defer_conversion)
+    {
+        *dropped_payload_out = (struct RTI_MQTT_ReceivedPayload*)dropped;
+    }
+    else
+    {
+        *dropped_out = (DDS_DynamicData*)dropped;
+    }
+    *lost_out = lost;
+    return retval;
+}
+
+/*
+ * Decide whether readers should be notified of a message which was just
+ * added to the queue. Only the client's callback adds messages to a queue,
+ * so the notification state can be accessed without locks, except for the
+ * flag set by the reader once it has read all the messages it could.
+ */
+static
+DDS_Boolean
+RTI_MQTT_MessageReceiveQueue_coalesce_notification(
+    struct RTI_MQTT_MessageReceiveQueue *self)
+{
+    DDS_Boolean notify = DDS_BOOLEAN_FALSE;
+    DDS_UnsignedLongLong now = 0;
+
+    self->notify_pending += 1;
+
+    if (RTI_MQTT_Atomic_compare_and_swap(
+            &self->notify_reader_waiting, 1, 0))
+    {
+        notify = DDS_BOOLEAN_TRUE;
+    }
+    else if (self->notify_max_messages > 0 &&
+                self->notify_pending >= self->notify_max_messages)
+    {
+        notify = DDS_BOOLEAN_TRUE;
+    }
+
+    if (self->notify_max_delay_usec > 0)
+    {
+        if (DDS_RETCODE_OK != RTI_MQTT_Clock_get_microseconds(&now))
+        {
+            /* Better to notify than to delay the message indefinitely */
+            notify = DDS_BOOLEAN_TRUE;
+        }
+        else if (now - self->notify_last_usec >= self->notify_max_delay_usec)
+        {
+            notify = DDS_BOOLEAN_TRUE;
+        }
+        if (notify)
+        {
+            self->notify_last_usec = now;
+        }
+    }
+
+    if (notify)
+    {
+        self->notify_pending = 0;
+    }
+
+    return notify;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_MessageReceiveQueue_receive(
+    struct RTI_MQTT_MessageReceiveQueue *self,
+    struct RTI_MQTT_ReceivedPayload *payload,
+    DDS_DynamicData **dropped_out,
+    DDS_Boolean *lost_out,
+    DDS_Boolean *notify_out)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
     DDS_Boolean lost = DDS_BOOLEAN_FALSE,
                 locked = DDS_BOOLEAN_FALSE;
-    DDS_DynamicData *msg = NULL;
-    RTI_MQTT_Message msg_static;
+    DDS_DynamicData *msg = NULL,
+                    *dropped = NULL;
+    struct RTI_MQTT_ReceivedPayload *retained = NULL,
+                                    *dropped_payload = NULL;
+    RTI_MQTT_MessageReceiveQueue_OnDataAvailableCallback listener = NULL;
+    void *listener_arg = NULL;
 
     if (dropped_out != NULL)
     {
@@ -632,47 +1264,68 @@ RTI_MQTT_MessageReceiveQueue_receive(
     {
         *lost_out = DDS_BOOLEAN_FALSE;
     }
-
-    msg = DDS_DynamicDataTypeSupport_create_data(self->dyn_data);
-    if (msg == NULL)
+    if (notify_out != NULL)
     {
-        /* TODO Log error */
-        goto done;
+        *notify_out = DDS_BOOLEAN_FALSE;
     }
-    msg_static.topic = (char*) topic;
 
-    if (!DDS_OctetSeq_initialize(&msg_static.payload.data))
+    if (self->defer_conversion)
     {
-        /* TODO Log error */
-        goto done;
+        /* Keep a reference to the client library's buffers, and only
+           convert the message into a sample when it is read */
+        RTI_MQTT_ReceivedPayload_retain(payload);
+        retained = payload;
     }
-
-    if (!DDS_OctetSeq_loan_contiguous(
-                    &msg_static.payload.data,
-                    (char*)buffer,
-                    buffer_len,
-                    buffer_len))
+    else
     {
-        /* TODO Log error */
-        goto done;
+        if (!self->lock_free)
+        {
+            RTI_MQTT_Mutex_assert_w_state(&self->lock,&locked);
+        }
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_take_sample(self, &msg))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        /* Don't hold the lock while the message is converted into
+           the sample */
+        RTI_MQTT_Mutex_release_from_state(&self->lock,&locked);
+
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_ReceivedPayload_to_dynamic_data(
+                        payload, &self->members, msg))
+        {
+            /* TODO Log error */
+            goto done;
+        }
     }
-    msg_static.info = msg_info;
 
-    if (DDS_RETCODE_OK != RTI_MQTT_Message_to_dynamic_data(&msg_static, msg))
+    if (self->lock_free)
     {
-        /* TODO Log error */
-        goto done;
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_receive_lock_free(
+                                    self,
+                                    msg,
+                                    retained,
+                                    &dropped,
+                                    &dropped_payload,
+                                    &lost))
+        {
+            RTI_MQTT_LOG_MSG_RECV_QUEUE_RECEIVE_LOCK_FREE_FAILED(self)
+            goto done;
+        }
     }
-
-    RTI_MQTT_Mutex_assert_w_state(&self->lock,&locked);
-
-    if (self->capacity > 0) 
+    else if (self->capacity > 0) 
     {
+        RTI_MQTT_Mutex_assert_w_state(&self->lock,&locked);
         if (DDS_RETCODE_OK !=
                 RTI_MQTT_MessageReceiveQueue_receive_circular(
                                     self,
                                     msg,
-                                    dropped_out,
+                                    retained,
+                                    &dropped,
+                                    &dropped_payload,
                                     &lost))
         {
             RTI_MQTT_LOG_MSG_RECV_QUEUE_RECEIVE_CIRCULAR_FAILED(self)
@@ -681,25 +1334,53 @@ RTI_MQTT_MessageReceiveQueue_receive(
     }
     else
     {
+        RTI_MQTT_Mutex_assert_w_state(&self->lock,&locked);
         if (DDS_RETCODE_OK !=
                 RTI_MQTT_MessageReceiveQueue_receive_unbounded(
                                     self,
                                     msg,
-                                    dropped_out,
+                                    retained,
+                                    &dropped,
+                                    &dropped_payload,
                                     &lost))
         {
             RTI_MQTT_LOG_MSG_RECV_QUEUE_RECEIVE_UNBOUNDED_FAILED(self)
             goto done;
         }
     }
+    /* The sample (or the payload) is now owned by the queue */
+    msg = NULL;
+    retained = NULL;
+
+    if (dropped != NULL && dropped_out != NULL)
+    {
+        *dropped_out = dropped;
+        dropped = NULL;
+    }
 
     /* Update message state */
-    self->msg_status->received_count += 1;
-    self->msg_status->unread_count += 1;
-    if (lost)
+    if (self->lock_free)
+    {
+        /* The reader updates the counters concurrently */
+        RTI_MQTT_Atomic_add(&self->msg_status->received_count, 1);
+        if (lost)
+        {
+            RTI_MQTT_Atomic_add(&self->msg_status->lost_count, 1);
+        }
+        else
+        {
+            RTI_MQTT_Atomic_add(&self->msg_status->unread_count, 1);
+        }
+    }
+    else
     {
-        self->msg_status->lost_count += 1;
-        self->msg_status->unread_count -= 1;
+        self->msg_status->received_count += 1;
+        self->msg_status->unread_count += 1;
+        if (lost)
+        {
+            self->msg_status->lost_count += 1;
+            self->msg_status->unread_count -= 1;
+        }
     }
 
     if (lost_out != NULL)
@@ -707,8 +1388,48 @@ RTI_MQTT_MessageReceiveQueue_receive(
         *lost_out = lost;
     }
 
+    if (RTI_MQTT_MessageReceiveQueue_coalesce_notification(self))
+    {
+        /* The listener is only called once the queue's lock is released,
+           since it may read from the queue */
+        listener = self->listener_data_avail;
+        listener_arg = self->listener_data_avail_arg;
+        if (notify_out != NULL)
+        {
+            *notify_out = DDS_BOOLEAN_TRUE;
+        }
+    }
+
     retval = DDS_RETCODE_OK;
 done:
+    if (!self->lock_free && !locked && (msg != NULL || dropped != NULL))
+    {
+        RTI_MQTT_Mutex_assert_w_state(&self->lock,&locked);
+    }
+    if (msg != NULL)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_return_sample(self, msg))
+        {
+            /* TODO Log error */
+        }
+    }
+    if (dropped != NULL)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_return_sample(self, dropped))
+        {
+            /* TODO Log error */
+        }
+    }
+    if (retained != NULL)
+    {
+        RTI_MQTT_ReceivedPayload_release(retained);
+    }
+    if (dropped_payload != NULL)
+    {
+        RTI_MQTT_ReceivedPayload_release(dropped_payload);
+    }
     
     if (locked)
     {
@@ -716,6 +1437,11 @@ done:
         RTI_MQTT_Mutex_release_w_state(&self->lock,&locked);
     }
 
+    if (listener != NULL)
+    {
+        listener(self, listener_arg);
+    }
+
     return retval;
 }
 
@@ -802,31 +1528,219 @@ RTI_MQTT_MessageReceiveQueue_read_circular(
         
         rcvd_msg = *rcvd_msg_ref;
         
-        if (loan)
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_take_message(
+                    self,
+                    rcvd_msg,
+                    (loan)?
+                        NULL : DDS_DynamicDataSeq_get_reference(messages,i),
+                    (loan)?
+                        RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
+                                &self->read_buffer,i) : NULL))
         {
-            *RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
-                    &self->read_buffer,i) = rcvd_msg->message;
-            rcvd_msg->message = NULL;
+            /* TODO Log error */
+            goto done;
         }
-        else
+
+        tot_messages += 1;
+    }
+
+    if (loan)
+    {
+        if (tot_messages > 0)
         {
-            if (!DDS_DynamicDataTypeSupport_copy_data(
-                    self->dyn_data,
-                    DDS_DynamicDataSeq_get_reference(messages,i),
-                    rcvd_msg->message))
+            if (!DDS_DynamicDataSeq_loan_discontiguous(
+                    messages,
+                    RTI_MQTT_DDS_DynamicDataPtrSeq_get_contiguous_buffer(
+                                            &self->read_buffer),
+                    tot_messages, 
+                    tot_messages))
             {
                 /* TODO Log error */
                 goto done;
             }
-            if (!DDS_DynamicDataTypeSupport_delete_data(
-                    self->dyn_data,
-                    rcvd_msg->message))
+            
+            self->read_buffer_loaned = DDS_BOOLEAN_TRUE;
+        }
+    }
+    else
+    {
+        if (!DDS_DynamicDataSeq_set_length(messages, tot_messages))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+    }
+
+    self->next_unread = idx;
+    self->size -= tot_messages;
+    self->head = (self->head + tot_messages) % self->capacity;
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (retval != DDS_RETCODE_OK)
+    {
+        if (self->read_buffer_loaned)
+        {
+            self->msg_status->lost_count += tot_messages;
+            if (DDS_RETCODE_OK !=
+                    RTI_MQTT_MessageReceiveQueue_return_loan(self,messages))
+            {
+                /* TODO Log error */
+            }
+        }
+        else if (loan)
+        {
+            for (i = 0; i < tot_messages; i++)
+            {
+                DDS_DynamicData **msg_ref = 
+                    RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
+                                        &self->read_buffer,i);
+                if (*msg_ref != NULL)
+                {
+                    if (DDS_RETCODE_OK !=
+                            RTI_MQTT_MessageReceiveQueue_return_sample(
+                                    self, *msg_ref))
+                    {
+                        /* TODO Log error */
+                    }
+                    *msg_ref = NULL;
+                }
+            }
+        }
+        else if (rcvd_msg != NULL && rcvd_msg->message != NULL)
+        {
+            if (DDS_RETCODE_OK !=
+                    RTI_MQTT_MessageReceiveQueue_return_sample(
+                            self, rcvd_msg->message))
             {
                 /* TODO Log error */
-                goto done;
             }
             rcvd_msg->message = NULL;
         }
+    }
+
+    return retval;
+}
+
+
+static
+DDS_ReturnCode_t
+RTI_MQTT_MessageReceiveQueue_read_lock_free(
+    struct RTI_MQTT_MessageReceiveQueue *self,
+    DDS_UnsignedLong max_messages,
+    struct DDS_DynamicDataSeq *messages)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong i = 0, 
+                     tot_messages = 0,
+                     messages_max = 0;
+    DDS_Boolean loan = DDS_BOOLEAN_FALSE,
+                waiting = DDS_BOOLEAN_FALSE;
+    struct RTI_MQTT_ReceivedMessage rcvd_msg;
+    void *value = NULL;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_MessageReceiveQueue_read_lock_free)
+
+    rcvd_msg.message = NULL;
+    rcvd_msg.payload = NULL;
+    rcvd_msg.read = DDS_BOOLEAN_FALSE;
+
+    messages_max = DDS_DynamicDataSeq_get_maximum(messages);
+    
+    if (messages_max > 0)
+    {
+        /* We only support passing an empty sequence with 
+         * max_messages == UNLIMITED */
+        if (max_messages == RTI_MQTT_SUBSCRIPTION_READ_LENGTH_UNLIMITED)
+        {
+            RTI_MQTT_LOG_MSG_RECV_QUEUE_READ_UNEXPECTED_MESSAGE_BUFFER(self)
+            goto done;
+        }
+
+        if (messages_max < max_messages)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+
+        if (!DDS_DynamicDataSeq_set_length(messages, max_messages))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+    }
+    else
+    {
+        /* When passing an empty sequence, on max_messages == UNLIMITED
+         * is supported */
+        if (max_messages != RTI_MQTT_SUBSCRIPTION_READ_LENGTH_UNLIMITED)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+
+        if (self->read_buffer_loaned)
+        {
+            RTI_MQTT_LOG_MSG_RECV_QUEUE_READ_ALREADY_IN_PROGRESS(self)
+            goto done;
+        }
+        loan = DDS_BOOLEAN_TRUE;
+        max_messages = 
+            RTI_MQTT_DDS_DynamicDataPtrSeq_get_maximum(&self->read_buffer);
+        if (!RTI_MQTT_DDS_DynamicDataPtrSeq_set_length(
+                        &self->read_buffer, max_messages))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        if (!DDS_DynamicDataSeq_set_length(messages, 0))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+    }
+
+    while (tot_messages < max_messages)
+    {
+        if (!RTI_MQTT_LockFreeRing_pop(&self->ring, &value))
+        {
+            if (waiting)
+            {
+                break;
+            }
+            /* Let the client's callback know that the next message must
+             * be notified, then look again, in case a message was pushed
+             * (and not notified) after the ring was found empty */
+            (void)RTI_MQTT_Atomic_compare_and_swap(
+                    &self->notify_reader_waiting, 0, 1);
+            waiting = DDS_BOOLEAN_TRUE;
+            continue;
+        }
+        i = tot_messages;
+
+        if (self->defer_conversion)
+        {
+            rcvd_msg.payload = (struct RTI_MQTT_ReceivedPayload*)value;
+        }
+        else
+        {
+            rcvd_msg.message = (DDS_DynamicData*)value;
+        }
+
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_take_message(
+                    self,
+                    &rcvd_msg,
+                    (loan)?
+                        NULL : DDS_DynamicDataSeq_get_reference(messages,i),
+                    (loan)?
+                        RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
+                                &self->read_buffer,i) : NULL))
+        {
+            /* TODO Log error */
+            goto done;
+        }
 
         tot_messages += 1;
     }
@@ -858,17 +1772,33 @@ RTI_MQTT_MessageReceiveQueue_read_circular(
         }
     }
 
-    self->next_unread = idx;
-    self->size -= tot_messages;
-    self->head = (self->head + tot_messages) % self->capacity;
-
     retval = DDS_RETCODE_OK;
 done:
     if (retval != DDS_RETCODE_OK)
     {
+        /* The message which failed to be taken was already popped from
+           the ring, so it is lost */
+        if (rcvd_msg.message != NULL || rcvd_msg.payload != NULL)
+        {
+            RTI_MQTT_Atomic_subtract(&self->msg_status->unread_count, 1);
+            RTI_MQTT_Atomic_add(&self->msg_status->lost_count, 1);
+            if (rcvd_msg.message != NULL)
+            {
+                if (DDS_RETCODE_OK !=
+                        RTI_MQTT_MessageReceiveQueue_return_sample(
+                                self, rcvd_msg.message))
+                {
+                    /* TODO Log error */
+                }
+            }
+            if (rcvd_msg.payload != NULL)
+            {
+                RTI_MQTT_ReceivedPayload_release(rcvd_msg.payload);
+            }
+        }
         if (self->read_buffer_loaned)
         {
-            self->msg_status->lost_count += tot_messages;
+            RTI_MQTT_Atomic_add(&self->msg_status->lost_count, tot_messages);
             if (DDS_RETCODE_OK !=
                     RTI_MQTT_MessageReceiveQueue_return_loan(self,messages))
             {
@@ -884,8 +1814,9 @@ done:
                                         &self->read_buffer,i);
                 if (*msg_ref != NULL)
                 {
-                    if (!DDS_DynamicDataTypeSupport_delete_data(
-                                self->dyn_data, *msg_ref))
+                    if (DDS_RETCODE_OK !=
+                            RTI_MQTT_MessageReceiveQueue_return_sample(
+                                    self, *msg_ref))
                     {
                         /* TODO Log error */
                     }
@@ -893,23 +1824,11 @@ done:
                 }
             }
         }
-        else if (rcvd_msg != NULL && rcvd_msg->message != NULL)
-        {
-            if (!DDS_DynamicDataTypeSupport_delete_data(
-                    self->dyn_data,
-                    rcvd_msg->message))
-            {
-                /* TODO Log error */
-                goto done;
-            }
-            rcvd_msg->message = NULL;
-        }
     }
 
     return retval;
 }
 
-
 static
 DDS_ReturnCode_t
 RTI_MQTT_MessageReceiveQueue_read_unbounded(
@@ -1006,30 +1925,18 @@ RTI_MQTT_MessageReceiveQueue_read_unbounded(
         
         rcvd_msg = *rcvd_msg_ref;
 
-        if (loan)
-        {
-            *RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
-                &self->read_buffer,i) = rcvd_msg->message;
-            rcvd_msg->message = NULL;
-        }
-        else
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_take_message(
+                    self,
+                    rcvd_msg,
+                    (loan)?
+                        NULL : DDS_DynamicDataSeq_get_reference(messages,i),
+                    (loan)?
+                        RTI_MQTT_DDS_DynamicDataPtrSeq_get_reference(
+                                &self->read_buffer,i) : NULL))
         {
-            if (!DDS_DynamicDataTypeSupport_copy_data(
-                    self->dyn_data,
-                    DDS_DynamicDataSeq_get_reference(messages,i),
-                    rcvd_msg->message))
-            {
-                /* TODO Log error */
-                goto done;
-            }
-            if (!DDS_DynamicDataTypeSupport_delete_data(
-                                        self->dyn_data,
-                                        rcvd_msg->message))
-            {
-                /* TODO Log error */
-                goto done;
-            }
-            rcvd_msg->message = NULL;
+            /* TODO Log error */
+            goto done;
         }
 
         RTI_MQTT_ReceivedMessage_delete(rcvd_msg);
@@ -1105,8 +2012,9 @@ done:
                                         &self->read_buffer,i);
                 if (*msg_ref != NULL)
                 {
-                    if (!DDS_DynamicDataTypeSupport_delete_data(
-                                self->dyn_data, *msg_ref))
+                    if (DDS_RETCODE_OK !=
+                            RTI_MQTT_MessageReceiveQueue_return_sample(
+                                    self, *msg_ref))
                     {
                         /* TODO Log error */
                     }
@@ -1131,10 +2039,32 @@ RTI_MQTT_MessageReceiveQueue_read(
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
     DDS_UnsignedLong messages_len =  0;
+    DDS_Boolean locked = DDS_BOOLEAN_FALSE;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_MessageReceiveQueue_read)
 
-    RTI_MQTT_Mutex_assert(&self->lock);
+    if (self->lock_free)
+    {
+        if (DDS_RETCODE_OK != 
+                RTI_MQTT_MessageReceiveQueue_read_lock_free(
+                    self, max_messages, messages))
+        {
+            RTI_MQTT_LOG_MSG_RECV_QUEUE_READ_LOCK_FREE_FAILED(self)
+            goto done;
+        }
+
+        messages_len =  DDS_DynamicDataSeq_get_length(messages);
+
+        /* The client's callback updates the counters concurrently */
+        RTI_MQTT_Atomic_subtract(
+                &self->msg_status->unread_count, messages_len);
+        RTI_MQTT_Atomic_add(&self->msg_status->read_count, messages_len);
+
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    RTI_MQTT_Mutex_assert_w_state(&self->lock,&locked);
 
     if (self->capacity > 0) 
     {
@@ -1165,8 +2095,13 @@ RTI_MQTT_MessageReceiveQueue_read(
 
     retval = DDS_RETCODE_OK;
 done:
+    /* The reader has read all the messages it could, so the next message
+     * must be notified, even if some are still queued */
+    (void)RTI_MQTT_Atomic_compare_and_swap(
+            &self->notify_reader_waiting, 0, 1);
+
     RTI_MQTT_MessageReceiveQueue_log_message_state(self);
-    RTI_MQTT_Mutex_release(&self->lock);
+    RTI_MQTT_Mutex_release_from_state(&self->lock,&locked);
 
     return retval;
 }
@@ -1179,10 +2114,16 @@ RTI_MQTT_MessageReceiveQueue_return_loan(
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
     DDS_UnsignedLong i = 0,
                      messages_len = 0;
+    DDS_Boolean locked = DDS_BOOLEAN_FALSE;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_MessageReceiveQueue_return_loan)
 
-    RTI_MQTT_Mutex_assert(&self->lock);
+    /* Lock-free queues are only read by a single consumer, which is also
+       the only one accessing the read buffer */
+    if (!self->lock_free)
+    {
+        RTI_MQTT_Mutex_assert_w_state(&self->lock,&locked);
+    }
     
     if (!self->read_buffer_loaned)
     {
@@ -1219,7 +2160,11 @@ RTI_MQTT_MessageReceiveQueue_return_loan(
             continue;
         }
 
-        DDS_DynamicDataTypeSupport_delete_data(self->dyn_data,*msg);
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_MessageReceiveQueue_return_sample(self, *msg))
+        {
+            /* TODO Log error */
+        }
         *msg = NULL;
     }
     
@@ -1234,7 +2179,7 @@ RTI_MQTT_MessageReceiveQueue_return_loan(
     retval = DDS_RETCODE_OK;
 done:
     RTI_MQTT_MessageReceiveQueue_log_message_state(self);
-    RTI_MQTT_Mutex_release(&self->lock);
+    RTI_MQTT_Mutex_release_from_state(&self->lock,&locked);
 
     return retval;
 }
@@ -1251,22 +2196,159 @@ RTI_MQTT_MessageReceiveQueue_set_listener(
 }
 
 
+static
 DDS_ReturnCode_t
-RTI_MQTT_Message_to_dynamic_data(RTI_MQTT_Message *self,
-                                 DDS_DynamicData *sample)
+RTI_MQTT_MessageMembers_find_member(
+        const DDS_TypeCode *type,
+        const char *name,
+        DDS_DynamicDataMemberId *id_out,
+        const DDS_TypeCode **type_out)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
+    DDS_UnsignedLong member_idx = 0;
+    const DDS_TypeCode *member_type = NULL;
 
-    RTI_MQTT_LOG_FN(RTI_MQTT_Message_to_dynamic_data)
+    member_idx = DDS_TypeCode_find_member_by_name(type, name, &ex);
+    if (ex != DDS_NO_EXCEPTION_CODE)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    *id_out = DDS_TypeCode_member_id(type, member_idx, &ex);
+    if (ex != DDS_NO_EXCEPTION_CODE)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (type_out != NULL)
+    {
+        member_type = DDS_TypeCode_member_type(type, member_idx, &ex);
+        if (ex != DDS_NO_EXCEPTION_CODE)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        while (DDS_TypeCode_kind(member_type, &ex) == DDS_TK_ALIAS &&
+                ex == DDS_NO_EXCEPTION_CODE)
+        {
+            member_type = DDS_TypeCode_content_type(member_type, &ex);
+            if (ex != DDS_NO_EXCEPTION_CODE)
+            {
+                /* TODO Log error */
+                goto done;
+            }
+        }
+        if (ex != DDS_NO_EXCEPTION_CODE)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        *type_out = member_type;
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_MessageMembers_resolve(
+        struct RTI_MQTT_MessageMembers *self,
+        const DDS_TypeCode *type)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_MessageMembers members =
+            RTI_MQTT_MessageMembers_INITIALIZER;
+    const DDS_TypeCode *info_type = NULL,
+                       *payload_type = NULL;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_MessageMembers_resolve)
+
+    if (type == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (self->type == type)
+    {
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_find_member(
+                type, "topic", &members.topic, NULL) ||
+        DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_find_member(
+                type, "info", &members.info, &info_type) ||
+        DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_find_member(
+                type, "payload", &members.payload, &payload_type))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_find_member(
+                info_type, "id", &members.info_id, NULL) ||
+        DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_find_member(
+                info_type, "qos_level", &members.info_qos_level, NULL) ||
+        DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_find_member(
+                info_type, "retained", &members.info_retained, NULL) ||
+        DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_find_member(
+                info_type, "duplicate", &members.info_duplicate, NULL) ||
+        DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_find_member(
+                payload_type, "data", &members.payload_data, NULL))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    members.type = type;
+    *self = members;
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_Message_to_dynamic_data_w_members(
+        RTI_MQTT_Message *self,
+        const struct RTI_MQTT_MessageMembers *members,
+        DDS_DynamicData *sample)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_DynamicData nested;
+    DDS_Boolean nested_initd = DDS_BOOLEAN_FALSE,
+                nested_bound = DDS_BOOLEAN_FALSE;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Message_to_dynamic_data_w_members)
+
+    /* Nested members are set through a binding, which is cheaper than
+     * resolving a "member.nested" name on every access */
+    if (!DDS_DynamicData_initialize(
+                &nested, NULL, &DDS_DYNAMIC_DATA_PROPERTY_DEFAULT))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    nested_initd = DDS_BOOLEAN_TRUE;
 
     if (self->topic != NULL) 
     {
         if (DDS_RETCODE_OK !=
                 DDS_DynamicData_set_string(
-                    sample, 
-                    "topic", 
-                    DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
-                    self->topic))
+                    sample, NULL, members->topic, self->topic))
         {
             /* TODO Log error */
             goto done;
@@ -1275,12 +2357,18 @@ RTI_MQTT_Message_to_dynamic_data(RTI_MQTT_Message *self,
 
     if (self->info != NULL)
     {
+        if (DDS_RETCODE_OK !=
+                DDS_DynamicData_bind_complex_member(
+                    sample, &nested, NULL, members->info))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        nested_bound = DDS_BOOLEAN_TRUE;
+
         if (DDS_RETCODE_OK !=
                 DDS_DynamicData_set_long(
-                    sample, 
-                    "info.id", 
-                    DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
-                    self->info->id))
+                    &nested, NULL, members->info_id, self->info->id))
         {
             /* TODO Log error */
             goto done;
@@ -1288,9 +2376,9 @@ RTI_MQTT_Message_to_dynamic_data(RTI_MQTT_Message *self,
 
         if (DDS_RETCODE_OK !=
                 DDS_DynamicData_set_long(
-                    sample, 
-                    "info.qos_level", 
-                    DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
+                    &nested,
+                    NULL,
+                    members->info_qos_level,
                     self->info->qos_level))
         {
             /* TODO Log error */
@@ -1299,9 +2387,9 @@ RTI_MQTT_Message_to_dynamic_data(RTI_MQTT_Message *self,
 
         if (DDS_RETCODE_OK !=
                 DDS_DynamicData_set_boolean(
-                    sample, 
-                    "info.retained", 
-                    DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
+                    &nested,
+                    NULL,
+                    members->info_retained,
                     self->info->retained))
         {
             /* TODO Log error */
@@ -1310,22 +2398,44 @@ RTI_MQTT_Message_to_dynamic_data(RTI_MQTT_Message *self,
 
         if (DDS_RETCODE_OK !=
                 DDS_DynamicData_set_boolean(
-                    sample, 
-                    "info.duplicate", 
-                    DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
+                    &nested,
+                    NULL,
+                    members->info_duplicate,
                     self->info->duplicate))
         {
             /* TODO Log error */
             goto done;
         }
+
+        nested_bound = DDS_BOOLEAN_FALSE;
+        if (DDS_RETCODE_OK !=
+                DDS_DynamicData_unbind_complex_member(sample, &nested))
+        {
+            /* TODO Log error */
+            goto done;
+        }
     }
 
+    if (DDS_RETCODE_OK !=
+            DDS_DynamicData_bind_complex_member(
+                sample, &nested, NULL, members->payload))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    nested_bound = DDS_BOOLEAN_TRUE;
+
     if (DDS_RETCODE_OK !=
             DDS_DynamicData_set_octet_seq(
-                sample, 
-                "payload.data", 
-                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
-                &self->payload.data))
+                &nested, NULL, members->payload_data, &self->payload.data))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    nested_bound = DDS_BOOLEAN_FALSE;
+    if (DDS_RETCODE_OK !=
+            DDS_DynamicData_unbind_complex_member(sample, &nested))
     {
         /* TODO Log error */
         goto done;
@@ -1334,49 +2444,74 @@ RTI_MQTT_Message_to_dynamic_data(RTI_MQTT_Message *self,
     retval = DDS_RETCODE_OK;
 
 done:
+    if (nested_bound)
+    {
+        DDS_DynamicData_unbind_complex_member(sample, &nested);
+    }
+    if (nested_initd)
+    {
+        DDS_DynamicData_finalize(&nested);
+    }
 
     return retval;
 }
 
 DDS_ReturnCode_t
-RTI_MQTT_Message_from_dynamic_data(RTI_MQTT_Message *self,
-                                   DDS_DynamicData *sample)
+RTI_MQTT_Message_from_dynamic_data_w_members(
+        RTI_MQTT_Message *self,
+        const struct RTI_MQTT_MessageMembers *members,
+        DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
-    DDS_Boolean allocd_info = DDS_BOOLEAN_FALSE;
+    DDS_Boolean allocd_info = DDS_BOOLEAN_FALSE,
+                nested_initd = DDS_BOOLEAN_FALSE,
+                nested_bound = DDS_BOOLEAN_FALSE;
     DDS_UnsignedLong str_len = 0;
     char *str_val = NULL;
+    DDS_DynamicData nested;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Message_from_dynamic_data_w_members)
+
+    if (!DDS_DynamicData_initialize(
+                &nested, NULL, &DDS_DYNAMIC_DATA_PROPERTY_DEFAULT))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    nested_initd = DDS_BOOLEAN_TRUE;
 
     if (self->info == NULL)
     {
         self->info = RTI_MQTT_MessageInfoPluginSupport_create_data();
         allocd_info = DDS_BOOLEAN_TRUE;
     }
-    
+
+    str_len = 0;
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_get_long(
-                sample, 
-                &self->info->id,
-                "info.id", 
-                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+            DDS_DynamicData_get_string(
+                sample, &str_val, &str_len, NULL, members->topic))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    if (NULL == DDS_String_replace(&self->topic, str_val))
     {
         /* TODO Log error */
         goto done;
     }
 
-    str_len = 0;
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_get_string(
-                sample,
-                &str_val,
-                &str_len,
-                "topic", 
-                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+            DDS_DynamicData_bind_complex_member(
+                sample, &nested, NULL, members->info))
     {
         /* TODO Log error */
         goto done;
     }
-    if (NULL == DDS_String_replace(&self->topic, str_val))
+    nested_bound = DDS_BOOLEAN_TRUE;
+    
+    if (DDS_RETCODE_OK !=
+            DDS_DynamicData_get_long(
+                &nested, &self->info->id, NULL, members->info_id))
     {
         /* TODO Log error */
         goto done;
@@ -1384,10 +2519,10 @@ RTI_MQTT_Message_from_dynamic_data(RTI_MQTT_Message *self,
 
     if (DDS_RETCODE_OK !=
             DDS_DynamicData_get_long(
-                sample, 
+                &nested,
                 (DDS_Long*)&self->info->qos_level,
-                "info.qos_level", 
-                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                NULL,
+                members->info_qos_level))
     {
         /* TODO Log error */
         goto done;
@@ -1395,10 +2530,10 @@ RTI_MQTT_Message_from_dynamic_data(RTI_MQTT_Message *self,
 
     if (DDS_RETCODE_OK !=
             DDS_DynamicData_get_boolean(
-                sample, 
+                &nested,
                 &self->info->retained,
-                "info.retained", 
-                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                NULL,
+                members->info_retained))
     {
         /* TODO Log error */
         goto done;
@@ -1406,21 +2541,43 @@ RTI_MQTT_Message_from_dynamic_data(RTI_MQTT_Message *self,
 
     if (DDS_RETCODE_OK !=
             DDS_DynamicData_get_boolean(
-                sample, 
+                &nested,
                 &self->info->duplicate,
-                "info.duplicate", 
-                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                NULL,
+                members->info_duplicate))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    nested_bound = DDS_BOOLEAN_FALSE;
+    if (DDS_RETCODE_OK !=
+            DDS_DynamicData_unbind_complex_member(sample, &nested))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            DDS_DynamicData_bind_complex_member(
+                sample, &nested, NULL, members->payload))
     {
         /* TODO Log error */
         goto done;
     }
+    nested_bound = DDS_BOOLEAN_TRUE;
 
     if (DDS_RETCODE_OK !=
             DDS_DynamicData_get_octet_seq(
-                sample,
-                &self->payload.data,
-                "payload.data", 
-                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                &nested, &self->payload.data, NULL, members->payload_data))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    nested_bound = DDS_BOOLEAN_FALSE;
+    if (DDS_RETCODE_OK !=
+            DDS_DynamicData_unbind_complex_member(sample, &nested))
     {
         /* TODO Log error */
         goto done;
@@ -1429,6 +2586,14 @@ RTI_MQTT_Message_from_dynamic_data(RTI_MQTT_Message *self,
     retval = DDS_RETCODE_OK;
 
 done:
+    if (nested_bound)
+    {
+        DDS_DynamicData_unbind_complex_member(sample, &nested);
+    }
+    if (nested_initd)
+    {
+        DDS_DynamicData_finalize(&nested);
+    }
 
     if (str_val != NULL)
     {
@@ -1447,4 +2612,66 @@ done:
     return retval;
 }
 
+DDS_ReturnCode_t
+RTI_MQTT_Message_to_dynamic_data(RTI_MQTT_Message *self,
+                                 DDS_DynamicData *sample)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_MessageMembers members =
+            RTI_MQTT_MessageMembers_INITIALIZER;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Message_to_dynamic_data)
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_resolve(
+                &members, DDS_DynamicData_get_type(sample)))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_Message_to_dynamic_data_w_members(
+                self, &members, sample))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    retval = DDS_RETCODE_OK;
+
+done:
+
+    return retval;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_Message_from_dynamic_data(RTI_MQTT_Message *self,
+                                   DDS_DynamicData *sample)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_MessageMembers members =
+            RTI_MQTT_MessageMembers_INITIALIZER;
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_resolve(
+                &members, DDS_DynamicData_get_type(sample)))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_Message_from_dynamic_data_w_members(
+                self, &members, sample))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    retval = DDS_RETCODE_OK;
+
+done:
 
+    return retval;
+}
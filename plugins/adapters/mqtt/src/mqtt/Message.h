@@ -16,11 +16,104 @@
 #include "rtiadapt_mqtt.h"
 
 #include "Infrastructure.h"
+#include "LockFreeRing.h"
+
+/*
+ * The ids of the members of RTI::MQTT::Message (or of any type with the
+ * same members, like RTI::MQTT::KeyedMessage), resolved once for a type,
+ * so that samples can be accessed without looking up members by name.
+ * Nested members are accessed by binding "info" and "payload" by id.
+ */
+struct RTI_MQTT_MessageMembers
+{
+    const DDS_TypeCode          *type;
+    DDS_DynamicDataMemberId     topic;
+    DDS_DynamicDataMemberId     info;
+    DDS_DynamicDataMemberId     info_id;
+    DDS_DynamicDataMemberId     info_qos_level;
+    DDS_DynamicDataMemberId     info_retained;
+    DDS_DynamicDataMemberId     info_duplicate;
+    DDS_DynamicDataMemberId     payload;
+    DDS_DynamicDataMemberId     payload_data;
+};
+
+#define RTI_MQTT_MessageMembers_INITIALIZER \
+{\
+    NULL, /* type */ \
+    0, /* topic */ \
+    0, /* info */ \
+    0, /* info_id */ \
+    0, /* info_qos_level */ \
+    0, /* info_retained */ \
+    0, /* info_duplicate */ \
+    0, /* payload */ \
+    0 /* payload_data */ \
+}
+
+/*
+ * Resolve the member ids of `type`. Nothing is done if the ids were already
+ * resolved for the same type.
+ */
+DDS_ReturnCode_t
+RTI_MQTT_MessageMembers_resolve(
+        struct RTI_MQTT_MessageMembers *self,
+        const DDS_TypeCode *type);
+
+DDS_ReturnCode_t
+RTI_MQTT_Message_to_dynamic_data_w_members(
+        RTI_MQTT_Message *self,
+        const struct RTI_MQTT_MessageMembers *members,
+        DDS_DynamicData *sample);
+
+DDS_ReturnCode_t
+RTI_MQTT_Message_from_dynamic_data_w_members(
+        RTI_MQTT_Message *self,
+        const struct RTI_MQTT_MessageMembers *members,
+        DDS_DynamicData *sample);
+
+struct RTI_MQTT_ReceivedPayload;
+
+typedef void
+(*RTI_MQTT_ReceivedPayload_ReleaseFn)(
+    struct RTI_MQTT_ReceivedPayload *payload);
+
+/*
+ * A message received by the MQTT client library. The buffers are owned by
+ * the client library, and they are passed to `release` once the last
+ * reference to the payload is dropped. Queues which defer conversion of
+ * messages retain the payload until the message is read.
+ */
+struct RTI_MQTT_ReceivedPayload
+{
+    const char                          *topic;
+    const char                          *buffer;
+    DDS_UnsignedLong                    buffer_len;
+    RTI_MQTT_MessageInfo                info;
+    /* Updated with atomic operations, by the MQTT client library's thread
+       and by the readers of the queues holding the payload */
+    RTI_MQTT_AtomicCounter              ref_count;
+    RTI_MQTT_ReceivedPayload_ReleaseFn  release;
+};
+
+void
+RTI_MQTT_ReceivedPayload_retain(
+        struct RTI_MQTT_ReceivedPayload *self);
+
+void
+RTI_MQTT_ReceivedPayload_release(
+        struct RTI_MQTT_ReceivedPayload *self);
+
+DDS_ReturnCode_t
+RTI_MQTT_ReceivedPayload_to_dynamic_data(
+        struct RTI_MQTT_ReceivedPayload *self,
+        const struct RTI_MQTT_MessageMembers *members,
+        DDS_DynamicData *sample);
 
 struct RTI_MQTT_ReceivedMessage 
 {
 
     DDS_DynamicData  *message;
+    struct RTI_MQTT_ReceivedPayload *payload;
     DDS_Boolean read;
 };
 
@@ -73,13 +166,31 @@ struct RTI_MQTT_MessageReceiveQueue
     DDS_UnsignedLong                        next;
     DDS_UnsignedLong                        next_unread;
     struct RTI_MQTT_DDS_DynamicDataPtrSeq   read_buffer;
+    struct RTI_MQTT_DDS_DynamicDataPtrSeq   sample_pool;
     struct DDS_DynamicDataTypeSupport       *dyn_data;
     DDS_Boolean                             read_buffer_loaned;
+    DDS_Boolean                             defer_conversion;
+    struct RTI_MQTT_MessageMembers          members;
     struct RTI_MQTT_ReceivedMessagePtrSeq   queue;
+    /* Only used by lock-free queues, which hold unread samples (or, if
+       conversion is deferred, payloads) in `ring`, and free samples in
+       `free_samples`, instead of `queue` and `sample_pool` */
+    DDS_Boolean                             lock_free;
+    struct RTI_MQTT_LockFreeRing            ring;
+    struct RTI_MQTT_LockFreeRing            free_samples;
     RTI_MQTT_MessageReceiveQueue_OnDataAvailableCallback
                                             listener_data_avail;
     void                                    *listener_data_avail_arg;
     RTI_MQTT_SubscriptionMessageStatus      *msg_status;
+    /* Notifications of new data are coalesced: the first message received
+       after a read is always notified, while the following ones are only
+       notified every `notify_max_messages` messages, or after
+       `notify_max_delay_usec` from the previous notification. */
+    DDS_UnsignedLong                        notify_max_messages;
+    DDS_UnsignedLongLong                    notify_max_delay_usec;
+    DDS_UnsignedLong                        notify_pending;
+    DDS_UnsignedLongLong                    notify_last_usec;
+    RTI_MQTT_AtomicCounter                  notify_reader_waiting;
 };
 
 #define RTI_MQTT_LOG_MESSAGE_QUEUE_STATE(msg_,q_) \
@@ -96,7 +207,7 @@ RTI_MQTT_TRACE_8((msg_),\
 
 DDS_ReturnCode_t
 RTI_MQTT_MessageReceiveQueue_new(
-    DDS_UnsignedLong size,
+    const RTI_MQTT_SubscriptionConfig *config,
     RTI_MQTT_SubscriptionMessageStatus *msg_status,
     struct RTI_MQTT_MessageReceiveQueue **queue_out);
 
@@ -107,22 +218,24 @@ RTI_MQTT_MessageReceiveQueue_delete(
 DDS_ReturnCode_t
 RTI_MQTT_MessageReceiveQueue_initialize(
     struct RTI_MQTT_MessageReceiveQueue *self,
-    DDS_UnsignedLong size,
+    const RTI_MQTT_SubscriptionConfig *config,
     RTI_MQTT_SubscriptionMessageStatus *msg_status);
 
 DDS_ReturnCode_t
 RTI_MQTT_MessageReceiveQueue_finalize(
     struct RTI_MQTT_MessageReceiveQueue *self);
 
+/*
+ * Add a received message to the queue. `notify_out` is set if readers
+ * should be notified of new data available in the queue.
+ */
 DDS_ReturnCode_t
 RTI_MQTT_MessageReceiveQueue_receive(
     struct RTI_MQTT_MessageReceiveQueue *self,
-    const char *buffer,
-    DDS_UnsignedLong buffer_len,
-    const char *topic,
-    RTI_MQTT_MessageInfo *msg_info,
+    struct RTI_MQTT_ReceivedPayload *payload,
     DDS_DynamicData **dropped_out,
-    DDS_Boolean *lost_out);
+    DDS_Boolean *lost_out,
+    DDS_Boolean *notify_out);
 
 DDS_ReturnCode_t
 RTI_MQTT_MessageReceiveQueue_read(
@@ -107,58 +107,63 @@ RTI_MQTT_Publication_write(
          *topic = NULL;
     DDS_UnsignedLong topic_len = 0,
                      payload_len = 0;
-    struct DDS_OctetSeq payload = DDS_SEQUENCE_INITIALIZER;
     DDS_Boolean use_message_info = DDS_BOOLEAN_FALSE,
-                locked = DDS_BOOLEAN_FALSE;
+                nested_bound = DDS_BOOLEAN_FALSE;
+    DDS_DynamicData *nested = &self->msg_nested;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_Publication_write)
 
-    /* TODO RM Mutex: only used to protect self->data->config */
-    RTI_MQTT_Mutex_assert_w_state(&self->client->pub_lock,&locked);
-
+    /* The configuration is copied when the publication is created, and
+       never modified afterwards, so it can be accessed without locking.
+       The configured topic was stored in the request context then */
     use_message_info = self->data->config->use_message_info;
 
     if (!use_message_info)
     {
-        if (DDS_RETCODE_OK != 
-                RTI_MQTT_Publication_store_topic(
-                        self,self->data->config->topic))
-        {
-            /* TODO Log error */
-            goto done;
-        }
         params.retained = self->data->config->retained;
         params.qos_level = self->data->config->qos;
     }
 
-    /* TODO RM Mutex: only used to protect self->data->config */
-    RTI_MQTT_Mutex_release_w_state(&self->client->pub_lock,&locked);
-
     if (use_message_info)
     {
         if (!DDS_DynamicData_member_exists(
-                message, "info", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                message, NULL, self->msg_members.info))
         {
             RTI_MQTT_LOG_PUBLICATION_WRITE_MESSAGE_INFO_NOT_FOUND(
                     self, message)
             goto done;
         }
+        if (DDS_RETCODE_OK !=
+                DDS_DynamicData_bind_complex_member(
+                    message, nested, NULL, self->msg_members.info))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        nested_bound = DDS_BOOLEAN_TRUE;
         if (DDS_RETCODE_OK !=
                 DDS_DynamicData_get_long(
-                    message,
+                    nested,
                     (DDS_Long*)&params.qos_level, 
-                    "info.qos_level",
-                    DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                    NULL,
+                    self->msg_members.info_qos_level))
         {
             /* TODO Log error */
             goto done;
         }
         if (DDS_RETCODE_OK !=
                 DDS_DynamicData_get_boolean(
-                    message, 
+                    nested, 
                     &params.retained, 
-                    "info.retained",
-                    DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                    NULL,
+                    self->msg_members.info_retained))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        nested_bound = DDS_BOOLEAN_FALSE;
+        if (DDS_RETCODE_OK !=
+                DDS_DynamicData_unbind_complex_member(message, nested))
         {
             /* TODO Log error */
             goto done;
@@ -168,8 +173,8 @@ RTI_MQTT_Publication_write(
                     message, 
                     &topic, 
                     &topic_len,
-                    "topic",
-                    DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                    NULL,
+                    self->msg_members.topic))
         {
             /* TODO Log error */
             goto done;
@@ -183,18 +188,31 @@ RTI_MQTT_Publication_write(
         self->req_ctx.topic_len = topic_len;
     }
 
+    if (DDS_RETCODE_OK !=
+            DDS_DynamicData_bind_complex_member(
+                message, nested, NULL, self->msg_members.payload))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    nested_bound = DDS_BOOLEAN_TRUE;
+
+    /* Get the payload directly into the request's buffer, which is
+       reused across writes */
     if (DDS_RETCODE_OK !=
             DDS_DynamicData_get_octet_seq(
-                    message,
-                    &payload, 
-                    "payload.data",
-                    DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                    nested,
+                    &self->req_ctx.payload, 
+                    NULL,
+                    self->msg_members.payload_data))
     {
         /* TODO Log error */
         goto done;
     }
 
-    if (!DDS_OctetSeq_copy(&self->req_ctx.payload, &payload))
+    nested_bound = DDS_BOOLEAN_FALSE;
+    if (DDS_RETCODE_OK !=
+            DDS_DynamicData_unbind_complex_member(message, nested))
     {
         /* TODO Log error */
         goto done;
@@ -217,16 +235,13 @@ RTI_MQTT_Publication_write(
 
     retval = DDS_RETCODE_OK;
 done:
-    /* TODO RM Mutex: only used to protect self->data->config */
-    RTI_MQTT_Mutex_release_from_state(&self->client->pub_lock,&locked);
-
-    if (topic != NULL)
+    if (nested_bound)
     {
-        DDS_String_free(topic);
+        DDS_DynamicData_unbind_complex_member(message, nested);
     }
-    if (!DDS_OctetSeq_finalize(&payload))
+    if (topic != NULL)
     {
-        /* TODO Log error */
+        DDS_String_free(topic);
     }
 
     return retval;
@@ -239,9 +254,12 @@ RTI_MQTT_Publication_on_write_result(
         DDS_ReturnCode_t result)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_Boolean locked = DDS_BOOLEAN_FALSE;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_Publication_on_write_result)
 
+    RTI_MQTT_Mutex_assert_w_state(&self->write_lock,&locked);
+
     switch (self->req_ctx.last_write_qos)
     {
     case RTI_MQTT_QosLevel_ZERO:
@@ -276,6 +294,7 @@ RTI_MQTT_Publication_on_write_result(
 
     retval = DDS_RETCODE_OK;
 done:
+    RTI_MQTT_Mutex_release_from_state(&self->write_lock,&locked);
     return retval;
 }
 
@@ -285,9 +304,12 @@ RTI_MQTT_Publication_on_write_delivery_result(
         DDS_ReturnCode_t result)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_Boolean locked = DDS_BOOLEAN_FALSE;
     
     RTI_MQTT_LOG_FN(RTI_MQTT_Publication_on_write_delivery_result)
 
+    RTI_MQTT_Mutex_assert_w_state(&self->write_lock,&locked);
+
     /* This callback should be called only for messages with Qos 2*/
     if (self->req_ctx.last_write_qos != RTI_MQTT_QosLevel_TWO)
     {
@@ -315,6 +337,138 @@ RTI_MQTT_Publication_on_write_delivery_result(
         self->data->message_status->error_count += 1;
     }
 
+    retval = DDS_RETCODE_OK;
+done:
+    RTI_MQTT_Mutex_release_from_state(&self->write_lock,&locked);
+    return retval;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_Publication_acquire_write_slot(
+        struct RTI_MQTT_Publication *self,
+        RTI_MQTT_QosLevel qos,
+        struct RTI_MQTT_PublicationWriteSlot **slot_out)
+{
+    struct RTI_MQTT_PublicationWriteSlot *slot = NULL;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Publication_acquire_write_slot)
+
+    *slot_out = NULL;
+
+    RTI_MQTT_Mutex_assert(&self->write_lock);
+
+    slot = self->write_slots_free;
+    if (slot != NULL)
+    {
+        self->write_slots_free = slot->next_free;
+        self->write_inflight += 1;
+        slot->next_free = NULL;
+        slot->qos = qos;
+    }
+    else
+    {
+        /* The window is full: ask the next completion to wake us up */
+        self->write_waiting = DDS_BOOLEAN_TRUE;
+    }
+
+    RTI_MQTT_Mutex_release(&self->write_lock);
+
+    *slot_out = slot;
+
+    return DDS_RETCODE_OK;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_Publication_release_write_slot(
+        struct RTI_MQTT_Publication *self,
+        struct RTI_MQTT_PublicationWriteSlot *slot,
+        DDS_Boolean *notify_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_Boolean locked = DDS_BOOLEAN_FALSE;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Publication_release_write_slot)
+
+    *notify_out = DDS_BOOLEAN_FALSE;
+
+    RTI_MQTT_Mutex_assert_w_state(&self->write_lock,&locked);
+
+    if (self->write_inflight == 0)
+    {
+        RTI_MQTT_LOG_PUBLICATION_NO_PENDING_MESSAGES_FOUND(self)
+        goto done;
+    }
+
+    slot->qos = RTI_MQTT_QosLevel_UNKNOWN;
+    slot->next_free = self->write_slots_free;
+    self->write_slots_free = slot;
+    self->write_inflight -= 1;
+
+    *notify_out = self->write_waiting;
+    self->write_waiting = DDS_BOOLEAN_FALSE;
+
+    retval = DDS_RETCODE_OK;
+done:
+    RTI_MQTT_Mutex_release_from_state(&self->write_lock,&locked);
+    return retval;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_Publication_has_pending_writes(
+        struct RTI_MQTT_Publication *self,
+        DDS_Boolean *pending_out)
+{
+    RTI_MQTT_LOG_FN(RTI_MQTT_Publication_has_pending_writes)
+
+    RTI_MQTT_Mutex_assert(&self->write_lock);
+
+    *pending_out = (self->write_inflight > 0);
+    if (*pending_out)
+    {
+        self->write_waiting = DDS_BOOLEAN_TRUE;
+    }
+
+    RTI_MQTT_Mutex_release(&self->write_lock);
+
+    return DDS_RETCODE_OK;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_Publication_on_async_write_result(
+        struct RTI_MQTT_Publication *self,
+        struct RTI_MQTT_PublicationWriteSlot *slot,
+        DDS_ReturnCode_t result,
+        DDS_Boolean *notify_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_Publication_on_async_write_result)
+
+    /* The MQTT library notifies completion of a publish operation only once
+       all acknowledgements required by its QoS have been received, so the
+       message can be accounted for here regardless of its QoS level. */
+    RTI_MQTT_Mutex_assert(&self->write_lock);
+
+    self->data->message_status->pending_count -= 1;
+
+    if (DDS_RETCODE_OK == result)
+    {
+        self->data->message_status->ok_count += 1;
+    }
+    else
+    {
+        self->data->message_status->error_count += 1;
+    }
+
+    RTI_MQTT_Mutex_release(&self->write_lock);
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_Publication_release_write_slot(self, slot, notify_out))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
     retval = DDS_RETCODE_OK;
 done:
     return retval;
@@ -359,6 +513,7 @@ RTI_MQTT_Publication_initialize(
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
     struct RTI_MQTT_Publication def_self = RTI_MQTT_Publication_INITIALIZER;
+    DDS_Boolean lock_initd = DDS_BOOLEAN_FALSE;
 
     RTI_MQTT_LOG_FN(RTI_MQTT_Publication_initialize)
 
@@ -366,6 +521,13 @@ RTI_MQTT_Publication_initialize(
     
     self->client = client;
 
+    if (DDS_RETCODE_OK != RTI_MQTT_Mutex_initialize(&self->write_lock))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    lock_initd = DDS_BOOLEAN_TRUE;
+
     if (!config->use_message_info &&
         !RTI_MQTT_Publication_is_configuration_valid(
                 self, config->qos, config->topic))
@@ -394,7 +556,9 @@ RTI_MQTT_Publication_initialize(
         goto done;
     }
 
-    if (self->data->config->use_message_info &&
+    /* The configured topic is only stored once, writes that take their
+       topic from the message info replace it */
+    if (self->data->config->topic != NULL &&
         DDS_RETCODE_OK != 
                 RTI_MQTT_Publication_store_topic(
                         self, self->data->config->topic))
@@ -403,11 +567,35 @@ RTI_MQTT_Publication_initialize(
         goto done;
     }
 
+    /* Samples are either RTI_MQTT_Message or RTI_MQTT_KeyedMessage, which
+       declare the same members in the same order, so the member ids and the
+       DynamicData bound to nested members are prepared once here */
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_MessageMembers_resolve(
+                &self->msg_members, RTI_MQTT_Message_get_typecode()))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (!DDS_DynamicData_initialize(
+                &self->msg_nested, NULL, &DDS_DYNAMIC_DATA_PROPERTY_DEFAULT))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    self->msg_nested_initd = DDS_BOOLEAN_TRUE;
+
     retval = DDS_RETCODE_OK;
 done:
     if (DDS_RETCODE_OK != retval)
     {
-        if (DDS_RETCODE_OK != RTI_MQTT_Publication_finalize(self))
+        if (!lock_initd)
+        {
+            /* Nothing else was initialized */
+            *self = def_self;
+        }
+        else if (DDS_RETCODE_OK != RTI_MQTT_Publication_finalize(self))
         {
             /* TODO Log error */
         }
@@ -429,6 +617,12 @@ RTI_MQTT_Publication_finalize(struct RTI_MQTT_Publication *self)
         self->data = NULL;
     }
 
+    if (self->msg_nested_initd)
+    {
+        DDS_DynamicData_finalize(&self->msg_nested);
+        self->msg_nested_initd = DDS_BOOLEAN_FALSE;
+    }
+
     if (!DDS_OctetSeq_finalize(&self->req_ctx.payload))
     {
         RTI_MQTT_LOG_FINALIZE_SEQUENCE_FAILED(&self->req_ctx.payload)
@@ -441,6 +635,11 @@ RTI_MQTT_Publication_finalize(struct RTI_MQTT_Publication *self)
         self->req_ctx.topic_len = 0;
     }
 
+    if (DDS_RETCODE_OK != RTI_MQTT_Mutex_finalize(&self->write_lock))
+    {
+        /* TODO Log error */
+    }
+
     *self = def_self;
 
     retval = DDS_RETCODE_OK;
@@ -467,8 +666,10 @@ RTI_MQTT_Publication_write_w_params(
         goto done;
     }
 
+    RTI_MQTT_Mutex_assert(&self->write_lock);
     self->req_ctx.last_write_qos = params->qos_level;
     self->data->message_status->pending_count += 1;
+    RTI_MQTT_Mutex_release(&self->write_lock);
 
     if (DDS_RETCODE_OK !=
             RTI_MQTT_Client_write_message(self->client, 
@@ -480,11 +681,24 @@ RTI_MQTT_Publication_write_w_params(
     {
         RTI_MQTT_LOG_PUBLICATION_WRITE_MESSAGE_FAILED(
                 self,topic,params->qos_level,params->retained,buffer)
+        RTI_MQTT_Mutex_assert(&self->write_lock);
         self->data->message_status->pending_count -= 1;
+        RTI_MQTT_Mutex_release(&self->write_lock);
         goto done;
     }
 
+    RTI_MQTT_Mutex_assert(&self->write_lock);
     self->data->message_status->sent_count += 1;
+    RTI_MQTT_Mutex_release(&self->write_lock);
+
+    /* Asynchronous publications don't wait for the Broker to acknowledge
+       each message: results are accounted for as they are delivered to the
+       write slot that was used to send the message. */
+    if (self->write_slots != NULL)
+    {
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
 
     if (DDS_RETCODE_OK !=
             RTI_MQTT_Client_wait_for_write_result(self->client, self))
@@ -16,6 +16,7 @@
 #include "rtiadapt_mqtt.h"
 
 #include "Infrastructure.h"
+#include "Message.h"
 
 struct RTI_MQTT_Publication;
 
@@ -37,12 +38,48 @@ struct RTI_MQTT_PublicationRequestContext
     DDS_SEQUENCE_INITIALIZER /* payload */ \
 }
 
+/*
+ * A slot in the window of messages written asynchronously by an
+ * RTI_MQTT_Publication. Each slot embeds the request whose address is
+ * passed to the MQTT library as the completion context of a single
+ * publish operation, so that results can be correlated with the
+ * publication without any lookup.
+ */
+struct RTI_MQTT_PublicationWriteSlot
+{
+    struct RTI_MQTT_PendingRequest          req;
+    struct RTI_MQTT_Publication             *pub;
+    RTI_MQTT_QosLevel                       qos;
+    struct RTI_MQTT_PublicationWriteSlot    *next_free;
+    /* Only set in the first slot of an array handed over to the client */
+    struct RTI_MQTT_PublicationWriteSlot    *next_orphans;
+};
+
+#define RTI_MQTT_PublicationWriteSlot_INITIALIZER \
+{\
+    RTI_MQTT_PendingRequest_INITIALIZER, /* req */ \
+    NULL, /* pub */ \
+    RTI_MQTT_QosLevel_UNKNOWN, /* qos */ \
+    NULL, /* next_free */ \
+    NULL /* next_orphans */ \
+}
+
 struct RTI_MQTT_Publication 
 {
     RTI_MQTT_PublicationStatus                  *data;
     struct RTI_MQTT_Client                      *client;
     struct RTI_MQTT_PendingRequest              *req;
     struct RTI_MQTT_PublicationRequestContext   req_ctx;
+    struct RTI_MQTT_PublicationWriteSlot        *write_slots;
+    DDS_UnsignedLong                            write_slots_len;
+    struct RTI_MQTT_PublicationWriteSlot        *write_slots_free;
+    DDS_UnsignedLong                            write_inflight;
+    DDS_Boolean                                 write_waiting;
+    RTI_MQTT_Mutex                              write_lock;
+    /* Resolved when the publication is created, and reused by every write */
+    struct RTI_MQTT_MessageMembers              msg_members;
+    DDS_DynamicData                             msg_nested;
+    DDS_Boolean                                 msg_nested_initd;
 };
 
 #define RTI_MQTT_Publication_INITIALIZER \
@@ -51,6 +88,15 @@ struct RTI_MQTT_Publication
     NULL, /* client */ \
     NULL, /* req_publish */ \
     RTI_MQTT_PublicationRequestContext_INITIALIZER, /* req_ctx */ \
+    NULL, /* write_slots */ \
+    0, /* write_slots_len */ \
+    NULL, /* write_slots_free */ \
+    0, /* write_inflight */ \
+    DDS_BOOLEAN_FALSE, /* write_waiting */ \
+    RTI_MQTT_Mutex_INITIALIZER, /* write_lock */ \
+    RTI_MQTT_MessageMembers_INITIALIZER, /* msg_members */ \
+    DDS_DynamicData_INITIALIZER, /* msg_nested */ \
+    DDS_BOOLEAN_FALSE /* msg_nested_initd */ \
 }
 
 DDS_ReturnCode_t
@@ -72,6 +118,30 @@ RTI_MQTT_Publication_on_write_delivery_result(
         struct RTI_MQTT_Publication *self,
         DDS_ReturnCode_t result);
 
+DDS_ReturnCode_t
+RTI_MQTT_Publication_acquire_write_slot(
+        struct RTI_MQTT_Publication *self,
+        RTI_MQTT_QosLevel qos,
+        struct RTI_MQTT_PublicationWriteSlot **slot_out);
+
+DDS_ReturnCode_t
+RTI_MQTT_Publication_release_write_slot(
+        struct RTI_MQTT_Publication *self,
+        struct RTI_MQTT_PublicationWriteSlot *slot,
+        DDS_Boolean *notify_out);
+
+DDS_ReturnCode_t
+RTI_MQTT_Publication_has_pending_writes(
+        struct RTI_MQTT_Publication *self,
+        DDS_Boolean *pending_out);
+
+DDS_ReturnCode_t
+RTI_MQTT_Publication_on_async_write_result(
+        struct RTI_MQTT_Publication *self,
+        struct RTI_MQTT_PublicationWriteSlot *slot,
+        DDS_ReturnCode_t result,
+        DDS_Boolean *notify_out);
+
 DDS_SEQUENCE(RTI_MQTT_PublicationPtrSeq, struct RTI_MQTT_Publication*);
 
 #endif /* Publication_h */
\ No newline at end of file
@@ -86,74 +86,30 @@ RTI_MQTT_Subscription_delete(struct RTI_MQTT_Subscription *self)
     RTI_MQTT_Heap_free(self);
 }
 
-DDS_ReturnCode_t
-RTI_MQTT_Subscription_match(
-    struct RTI_MQTT_Subscription *self, 
-    const char *topic_name,
-    DDS_Boolean *match_out)
-{
-    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
-    DDS_UnsignedLong seq_len = 0,
-                     i = 0;
-    DDS_Boolean match = DDS_BOOLEAN_FALSE;
-
-    RTI_MQTT_LOG_FN(RTI_MQTT_Subscription_match)
-
-    /* TODO RM Mutex: only used to protect self->data->config */
-    RTI_MQTT_Mutex_assert(&self->client->sub_lock);
-
-    seq_len = DDS_StringSeq_get_length(&self->data->config->topic_filters);
-    for (i = 0; i < seq_len && !match; i++)
-    {
-        const char *topic_filter =
-            *DDS_StringSeq_get_reference(&self->data->config->topic_filters,i);
-        
-        if (DDS_RETCODE_OK !=
-                RTI_MQTT_TopicFilter_match(topic_filter, topic_name, &match))
-        {
-            RTI_MQTT_LOG_SUBSCRIPTION_TOPIC_MATCH_FAILED(
-                self, topic_filter, topic_name)
-            goto done;
-        }
-    }
-
-    *match_out = match;
-
-    retval = DDS_RETCODE_OK;
-done:
-    /* TODO RM Mutex: only used to protect self->data->config */
-    RTI_MQTT_Mutex_release(&self->client->sub_lock);
-    return retval;
-}
-
 DDS_ReturnCode_t
 RTI_MQTT_Subscription_receive(
     struct RTI_MQTT_Subscription *self,
-    const char *buffer,
-    DDS_UnsignedLong buffer_len,
-    const char *topic,
-    RTI_MQTT_MessageInfo *msg_info,
+    struct RTI_MQTT_ReceivedPayload *payload,
     DDS_DynamicData **dropped_out,
     DDS_Boolean *lost_out)
 {
     DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_Boolean notify = DDS_BOOLEAN_FALSE;
     
     RTI_MQTT_LOG_FN(RTI_MQTT_Subscription_receive)
 
     if (DDS_RETCODE_OK != 
             RTI_MQTT_MessageReceiveQueue_receive(self->queue,
-                                                 buffer,
-                                                 buffer_len,
-                                                 topic,
-                                                 msg_info,
+                                                 payload,
                                                  dropped_out,
-                                                 lost_out))
+                                                 lost_out,
+                                                 &notify))
     {
-        RTI_MQTT_LOG_SUBSCRIPTION_ADD_TO_QUEUE_FAILED(self,buffer)
+        RTI_MQTT_LOG_SUBSCRIPTION_ADD_TO_QUEUE_FAILED(self,payload)
         goto done;
     }
 
-    if (self->data_avail_listener != NULL)
+    if (notify && self->data_avail_listener != NULL)
     {
         self->data_avail_listener(self->data_avail_listener_data, self);
     }
@@ -252,7 +208,7 @@ RTI_MQTT_Subscription_initialize(struct RTI_MQTT_Subscription *self,
 
     if (DDS_RETCODE_OK != 
             RTI_MQTT_MessageReceiveQueue_new(
-                    self->data->config->message_queue_size,
+                    self->data->config,
                     self->data->message_status,
                     &self->queue))
     {
@@ -63,19 +63,10 @@ RTI_MQTT_Subscription_new(struct RTI_MQTT_Client *client,
 void
 RTI_MQTT_Subscription_delete(struct RTI_MQTT_Subscription *self);
 
-DDS_ReturnCode_t
-RTI_MQTT_Subscription_match(
-    struct RTI_MQTT_Subscription *self, 
-    const char *topic_name,
-    DDS_Boolean *match_out);
-
 DDS_ReturnCode_t
 RTI_MQTT_Subscription_receive(
     struct RTI_MQTT_Subscription *self,
-    const char *buffer,
-    DDS_UnsignedLong buffer_len,
-    const char *topic,
-    RTI_MQTT_MessageInfo *msg_info,
+    struct RTI_MQTT_ReceivedPayload *payload,
     DDS_DynamicData **dropped_out,
     DDS_Boolean *lost_out);
 
@@ -0,0 +1,932 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#include "TopicFilterIndex.h"
+
+#define RTI_MQTT_LOG_ARGS       "RTI::MQTT::TopicFilterIndex"
+
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndexNode_new(
+    struct RTI_MQTT_TopicFilterIndexNode *parent,
+    const char *level,
+    DDS_UnsignedLong level_len,
+    struct RTI_MQTT_TopicFilterIndexNode **node_out);
+
+static void
+RTI_MQTT_TopicFilterIndexNode_delete(
+    struct RTI_MQTT_TopicFilterIndexNode *self);
+
+static DDS_Boolean
+RTI_MQTT_TopicFilterIndexNode_is_empty(
+    struct RTI_MQTT_TopicFilterIndexNode *self);
+
+static DDS_Boolean
+RTI_MQTT_TopicFilterIndexNode_find_child(
+    struct RTI_MQTT_TopicFilterIndexNode *self,
+    const char *level,
+    DDS_UnsignedLong level_len,
+    DDS_UnsignedLong *index_out);
+
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndexNode_get_child(
+    struct RTI_MQTT_TopicFilterIndexNode *self,
+    const char *level,
+    DDS_UnsignedLong level_len,
+    DDS_Boolean create,
+    struct RTI_MQTT_TopicFilterIndexNode **child_out);
+
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndexNode_detach_child(
+    struct RTI_MQTT_TopicFilterIndexNode *self,
+    struct RTI_MQTT_TopicFilterIndexNode *child);
+
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndexNode_match(
+    struct RTI_MQTT_TopicFilterIndexNode *self,
+    const char *level,
+    struct RTI_MQTT_SubscriptionPtrSeq *matches);
+
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_find_node(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    const char *filter,
+    DDS_Boolean create,
+    struct RTI_MQTT_TopicFilterIndexNode **node_out);
+
+static void
+RTI_MQTT_TopicFilterIndex_prune(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    struct RTI_MQTT_TopicFilterIndexNode *node);
+
+static DDS_ReturnCode_t
+RTI_MQTT_SubscriptionPtrSeq_append(
+    struct RTI_MQTT_SubscriptionPtrSeq *self,
+    struct RTI_MQTT_Subscription *sub);
+
+static DDS_ReturnCode_t
+RTI_MQTT_SubscriptionPtrSeq_add_unique(
+    struct RTI_MQTT_SubscriptionPtrSeq *self,
+    struct RTI_MQTT_Subscription *sub);
+
+static void
+RTI_MQTT_SubscriptionPtrSeq_remove_duplicates(
+    struct RTI_MQTT_SubscriptionPtrSeq *self,
+    DDS_UnsignedLong start);
+
+/*****************************************************************************
+ *                     RTI_MQTT_TopicFilterIndexNodePtrSeq
+ *****************************************************************************/
+static RTIBool
+RTI_MQTT_TopicFilterIndexNodePtr_initialize_w_params(
+    struct RTI_MQTT_TopicFilterIndexNode **self,
+    const struct DDS_TypeAllocationParams_t * allocParams)
+{
+    *self = NULL;
+    return RTI_TRUE;
+}
+
+static RTIBool
+RTI_MQTT_TopicFilterIndexNodePtr_finalize_w_params(
+    struct RTI_MQTT_TopicFilterIndexNode **self,
+    const struct DDS_TypeDeallocationParams_t * deallocParams)
+{
+    *self = NULL;
+    return RTI_TRUE;
+}
+
+static RTIBool
+RTI_MQTT_TopicFilterIndexNodePtr_copy(
+    struct RTI_MQTT_TopicFilterIndexNode **dst,
+    const struct RTI_MQTT_TopicFilterIndexNode **src)
+{
+    *dst = (struct RTI_MQTT_TopicFilterIndexNode*)*src;
+    return RTI_TRUE;
+}
+
+#define T                       struct RTI_MQTT_TopicFilterIndexNode*
+#define TSeq                    RTI_MQTT_TopicFilterIndexNodePtrSeq
+#define T_initialize_w_params   RTI_MQTT_TopicFilterIndexNodePtr_initialize_w_params
+#define T_finalize_w_params     RTI_MQTT_TopicFilterIndexNodePtr_finalize_w_params
+#define T_copy                  RTI_MQTT_TopicFilterIndexNodePtr_copy
+#include "dds_c/generic/dds_c_sequence_TSeq.gen"
+#undef T_copy
+#undef T_finalize_w_params
+#undef T_initialize_w_params
+#undef TSeq
+#undef T
+
+/*****************************************************************************
+ *                     RTI_MQTT_TopicFilterIndex
+ *****************************************************************************/
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_initialize(struct RTI_MQTT_TopicFilterIndex *self)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndex
+        def_self = RTI_MQTT_TopicFilterIndex_INITIALIZER;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilterIndex_initialize)
+
+    *self = def_self;
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_TopicFilterIndexNode_new(NULL, "", 0, &self->root))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_finalize(struct RTI_MQTT_TopicFilterIndex *self)
+{
+    struct RTI_MQTT_TopicFilterIndex
+        def_self = RTI_MQTT_TopicFilterIndex_INITIALIZER;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilterIndex_finalize)
+
+    if (self->root != NULL)
+    {
+        RTI_MQTT_TopicFilterIndexNode_delete(self->root);
+    }
+
+    *self = def_self;
+
+    return DDS_RETCODE_OK;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_add(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    const char *filter,
+    struct RTI_MQTT_Subscription *sub)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndexNode *node = NULL;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilterIndex_add)
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_TopicFilterIndex_find_node(
+                    self, filter, DDS_BOOLEAN_TRUE, &node))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_SubscriptionPtrSeq_add_unique(&node->subscriptions, sub))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (retval != DDS_RETCODE_OK && node != NULL)
+    {
+        RTI_MQTT_TopicFilterIndex_prune(self, node);
+    }
+    return retval;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_remove(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    const char *filter,
+    struct RTI_MQTT_Subscription *sub)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndexNode *node = NULL;
+    DDS_UnsignedLong seq_len = 0,
+                     i = 0;
+    struct RTI_MQTT_Subscription **sub_ref = NULL;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilterIndex_remove)
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_TopicFilterIndex_find_node(
+                    self, filter, DDS_BOOLEAN_FALSE, &node))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    if (node == NULL)
+    {
+        /* Nothing to do, e.g. the filter was listed more than once by
+           the subscription, and it has already been removed. */
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(&node->subscriptions);
+    for (i = 0; i < seq_len; i++)
+    {
+        sub_ref = RTI_MQTT_SubscriptionPtrSeq_get_reference(
+                        &node->subscriptions, i);
+        if (*sub_ref == sub)
+        {
+            break;
+        }
+    }
+    for (; i + 1 < seq_len; i++)
+    {
+        *RTI_MQTT_SubscriptionPtrSeq_get_reference(&node->subscriptions, i) =
+            *RTI_MQTT_SubscriptionPtrSeq_get_reference(
+                        &node->subscriptions, i + 1);
+    }
+    if (i < seq_len &&
+        !RTI_MQTT_SubscriptionPtrSeq_set_length(
+                &node->subscriptions, seq_len - 1))
+    {
+        RTI_MQTT_LOG_SET_SEQUENCE_LENGTH_FAILED(
+                    &node->subscriptions, seq_len - 1)
+        goto done;
+    }
+
+    RTI_MQTT_TopicFilterIndex_prune(self, node);
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_match(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    const char *topic,
+    struct RTI_MQTT_SubscriptionPtrSeq *matches)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndexNode *child = NULL;
+    const char *next_level = NULL;
+    DDS_UnsignedLong level_len = 0,
+                     index = 0,
+                     start = 0;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilterIndex_match)
+
+    if (topic == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    start = RTI_MQTT_SubscriptionPtrSeq_get_length(matches);
+
+    if (topic[0] == '$')
+    {
+        /* Topics starting with '$' (e.g. "$SYS/...") are not matched by
+           filters starting with a wildcard (MQTT 3.1.1, section 4.7.2),
+           so only the literal children of the root are considered */
+        RTI_MQTT_TopicLevel_length(topic, &level_len)
+        next_level = (topic[level_len] == '\0')? NULL : topic + level_len + 1;
+
+        if (RTI_MQTT_TopicFilterIndexNode_find_child(
+                    self->root, topic, level_len, &index))
+        {
+            child = *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                                &self->root->children, index);
+            if (DDS_RETCODE_OK !=
+                    RTI_MQTT_TopicFilterIndexNode_match(
+                            child, next_level, matches))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+        }
+    }
+    else if (DDS_RETCODE_OK !=
+            RTI_MQTT_TopicFilterIndexNode_match(self->root, topic, matches))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    /* A subscription is collected once for each of its matching filters */
+    RTI_MQTT_SubscriptionPtrSeq_remove_duplicates(matches, start);
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+/*
+ * Look up the node corresponding to the last level of `filter`, creating
+ * all missing nodes along the way if `create` is true. If `create` is
+ * false, and no such node exists, `node_out` will be set to NULL.
+ */
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_find_node(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    const char *filter,
+    DDS_Boolean create,
+    struct RTI_MQTT_TopicFilterIndexNode **node_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndexNode *node = self->root,
+                                         *child = NULL;
+    const char *level = filter;
+    DDS_UnsignedLong level_len = 0,
+                     filter_len = 0,
+                     i = 0;
+    DDS_Boolean last = DDS_BOOLEAN_FALSE;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilterIndex_find_node)
+
+    *node_out = NULL;
+
+    filter_len = (filter != NULL)? RTI_MQTT_String_length(filter) : 0;
+    if (filter_len == 0 || filter_len > MQTT_TOPIC_NAME_MAX_LEN)
+    {
+        /* Invalid filter */
+        goto done;
+    }
+
+    while (!last && node != NULL)
+    {
+        RTI_MQTT_TopicLevel_length(level, &level_len)
+        last = (level[level_len] == '\0');
+
+        if (RTI_MQTT_TopicLevel_is_wildcard(level, level_len, '#'))
+        {
+            /* '#' must be the last level of a filter */
+            if (!last)
+            {
+                goto done;
+            }
+            if (node->hash_child == NULL && create &&
+                DDS_RETCODE_OK !=
+                    RTI_MQTT_TopicFilterIndexNode_new(
+                            node, level, level_len, &node->hash_child))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+            child = node->hash_child;
+        }
+        else if (RTI_MQTT_TopicLevel_is_wildcard(level, level_len, '+'))
+        {
+            if (node->plus_child == NULL && create &&
+                DDS_RETCODE_OK !=
+                    RTI_MQTT_TopicFilterIndexNode_new(
+                            node, level, level_len, &node->plus_child))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+            child = node->plus_child;
+        }
+        else
+        {
+            /* Wildcards must occupy an entire level */
+            for (i = 0; i < level_len; i++)
+            {
+                if (level[i] == '#' || level[i] == '+')
+                {
+                    goto done;
+                }
+            }
+            if (DDS_RETCODE_OK !=
+                    RTI_MQTT_TopicFilterIndexNode_get_child(
+                            node, level, level_len, create, &child))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+        }
+
+        node = child;
+        level += level_len + 1;
+    }
+
+    *node_out = node;
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (retval != DDS_RETCODE_OK && create && node != NULL)
+    {
+        RTI_MQTT_TopicFilterIndex_prune(self, node);
+    }
+    return retval;
+}
+
+/*
+ * Remove `node`, and all of its ancestors, from the index until a node which
+ * is still in use is found. The root node is never removed.
+ */
+static void
+RTI_MQTT_TopicFilterIndex_prune(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    struct RTI_MQTT_TopicFilterIndexNode *node)
+{
+    struct RTI_MQTT_TopicFilterIndexNode *parent = NULL;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilterIndex_prune)
+
+    while (node != self->root &&
+            RTI_MQTT_TopicFilterIndexNode_is_empty(node))
+    {
+        parent = node->parent;
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_TopicFilterIndexNode_detach_child(parent, node))
+        {
+            /* TODO Log error */
+            return;
+        }
+        RTI_MQTT_TopicFilterIndexNode_delete(node);
+        node = parent;
+    }
+}
+
+/*****************************************************************************
+ *                     RTI_MQTT_TopicFilterIndexNode
+ *****************************************************************************/
+
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndexNode_new(
+    struct RTI_MQTT_TopicFilterIndexNode *parent,
+    const char *level,
+    DDS_UnsignedLong level_len,
+    struct RTI_MQTT_TopicFilterIndexNode **node_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndexNode *node = NULL,
+                def_node = RTI_MQTT_TopicFilterIndexNode_INITIALIZER;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilterIndexNode_new)
+
+    *node_out = NULL;
+
+    node = (struct RTI_MQTT_TopicFilterIndexNode*)
+            RTI_MQTT_Heap_allocate(
+                    sizeof(struct RTI_MQTT_TopicFilterIndexNode));
+    if (node == NULL)
+    {
+        RTI_MQTT_HEAP_ALLOCATE_FAILED(
+            sizeof(struct RTI_MQTT_TopicFilterIndexNode))
+        goto done;
+    }
+
+    *node = def_node;
+    node->parent = parent;
+
+    node->level = DDS_String_alloc(level_len);
+    if (node->level == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    RTI_MQTT_Memory_copy(node->level, level, sizeof(char) * level_len);
+    node->level[level_len] = '\0';
+    node->level_len = level_len;
+
+    if (!RTI_MQTT_TopicFilterIndexNodePtrSeq_initialize(&node->children))
+    {
+        RTI_MQTT_LOG_INITIALIZE_SEQUENCE_FAILED(&node->children)
+        goto done;
+    }
+    if (!RTI_MQTT_SubscriptionPtrSeq_initialize(&node->subscriptions))
+    {
+        RTI_MQTT_LOG_INITIALIZE_SEQUENCE_FAILED(&node->subscriptions)
+        goto done;
+    }
+
+    *node_out = node;
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (retval != DDS_RETCODE_OK && node != NULL)
+    {
+        RTI_MQTT_TopicFilterIndexNode_delete(node);
+    }
+    return retval;
+}
+
+static void
+RTI_MQTT_TopicFilterIndexNode_delete(
+    struct RTI_MQTT_TopicFilterIndexNode *self)
+{
+    DDS_UnsignedLong seq_len = 0,
+                     i = 0;
+
+    RTI_MQTT_LOG_FN(RTI_MQTT_TopicFilterIndexNode_delete)
+
+    seq_len = RTI_MQTT_TopicFilterIndexNodePtrSeq_get_length(&self->children);
+    for (i = 0; i < seq_len; i++)
+    {
+        RTI_MQTT_TopicFilterIndexNode_delete(
+            *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                    &self->children, i));
+    }
+    if (self->plus_child != NULL)
+    {
+        RTI_MQTT_TopicFilterIndexNode_delete(self->plus_child);
+    }
+    if (self->hash_child != NULL)
+    {
+        RTI_MQTT_TopicFilterIndexNode_delete(self->hash_child);
+    }
+
+    if (!RTI_MQTT_TopicFilterIndexNodePtrSeq_finalize(&self->children))
+    {
+        RTI_MQTT_LOG_FINALIZE_SEQUENCE_FAILED(&self->children)
+    }
+    if (!RTI_MQTT_SubscriptionPtrSeq_finalize(&self->subscriptions))
+    {
+        RTI_MQTT_LOG_FINALIZE_SEQUENCE_FAILED(&self->subscriptions)
+    }
+    if (self->level != NULL)
+    {
+        DDS_String_free(self->level);
+    }
+
+    RTI_MQTT_Heap_free(self);
+}
+
+static DDS_Boolean
+RTI_MQTT_TopicFilterIndexNode_is_empty(
+    struct RTI_MQTT_TopicFilterIndexNode *self)
+{
+    return (self->plus_child == NULL &&
+            self->hash_child == NULL &&
+            RTI_MQTT_TopicFilterIndexNodePtrSeq_get_length(
+                    &self->children) == 0 &&
+            RTI_MQTT_SubscriptionPtrSeq_get_length(
+                    &self->subscriptions) == 0);
+}
+
+/*
+ * Binary search of a literal child. If no child is found for `level`,
+ * `index_out` will be set to the position where it should be inserted.
+ */
+static DDS_Boolean
+RTI_MQTT_TopicFilterIndexNode_find_child(
+    struct RTI_MQTT_TopicFilterIndexNode *self,
+    const char *level,
+    DDS_UnsignedLong level_len,
+    DDS_UnsignedLong *index_out)
+{
+    DDS_UnsignedLong lo = 0,
+                     hi = 0,
+                     mid = 0,
+                     min_len = 0;
+    int cmp = 0;
+    struct RTI_MQTT_TopicFilterIndexNode *child = NULL;
+
+    hi = RTI_MQTT_TopicFilterIndexNodePtrSeq_get_length(&self->children);
+
+    while (lo < hi)
+    {
+        mid = lo + (hi - lo) / 2;
+        child = *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                        &self->children, mid);
+
+        min_len = (child->level_len < level_len)?
+                        child->level_len : level_len;
+        cmp = RTI_MQTT_Memory_compare(child->level, level, min_len);
+        if (cmp == 0)
+        {
+            cmp = (child->level_len < level_len)? -1 :
+                    (child->level_len > level_len)? 1 : 0;
+        }
+
+        if (cmp == 0)
+        {
+            *index_out = mid;
+            return DDS_BOOLEAN_TRUE;
+        }
+        else if (cmp < 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    *index_out = lo;
+    return DDS_BOOLEAN_FALSE;
+}
+
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndexNode_get_child(
+    struct RTI_MQTT_TopicFilterIndexNode *self,
+    const char *level,
+    DDS_UnsignedLong level_len,
+    DDS_Boolean create,
+    struct RTI_MQTT_TopicFilterIndexNode **child_out)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndexNode *child = NULL;
+    DDS_UnsignedLong index = 0,
+                     seq_len = 0,
+                     seq_max = 0,
+                     i = 0;
+
+    *child_out = NULL;
+
+    if (RTI_MQTT_TopicFilterIndexNode_find_child(
+                self, level, level_len, &index))
+    {
+        *child_out = *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                                &self->children, index);
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    if (!create)
+    {
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_MQTT_TopicFilterIndexNode_new(
+                    self, level, level_len, &child))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    seq_len = RTI_MQTT_TopicFilterIndexNodePtrSeq_get_length(&self->children);
+    seq_max = RTI_MQTT_TopicFilterIndexNodePtrSeq_get_maximum(&self->children);
+    if (seq_len + 1 > seq_max)
+    {
+        seq_max = (seq_max == 0)? 1 : seq_max * 2;
+    }
+    if (!RTI_MQTT_TopicFilterIndexNodePtrSeq_ensure_length(
+            &self->children, seq_len + 1, seq_max))
+    {
+        RTI_MQTT_LOG_SET_SEQUENCE_ENSURE_LENGTH_FAILED(
+                    &self->children, seq_len + 1, seq_max)
+        goto done;
+    }
+
+    for (i = seq_len; i > index; i--)
+    {
+        *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                &self->children, i) =
+            *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                &self->children, i - 1);
+    }
+    *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                &self->children, index) = child;
+
+    *child_out = child;
+
+    retval = DDS_RETCODE_OK;
+done:
+    if (retval != DDS_RETCODE_OK && child != NULL)
+    {
+        RTI_MQTT_TopicFilterIndexNode_delete(child);
+    }
+    return retval;
+}
+
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndexNode_detach_child(
+    struct RTI_MQTT_TopicFilterIndexNode *self,
+    struct RTI_MQTT_TopicFilterIndexNode *child)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong index = 0,
+                     seq_len = 0;
+
+    if (self->plus_child == child)
+    {
+        self->plus_child = NULL;
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+    if (self->hash_child == child)
+    {
+        self->hash_child = NULL;
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    if (!RTI_MQTT_TopicFilterIndexNode_find_child(
+                self, child->level, child->level_len, &index))
+    {
+        RTI_MQTT_INTERNAL_ERROR(
+            "child not found in RTI_MQTT_TopicFilterIndexNode_detach_child")
+        goto done;
+    }
+
+    seq_len = RTI_MQTT_TopicFilterIndexNodePtrSeq_get_length(&self->children);
+    for (; index + 1 < seq_len; index++)
+    {
+        *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                &self->children, index) =
+            *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                &self->children, index + 1);
+    }
+    if (!RTI_MQTT_TopicFilterIndexNodePtrSeq_set_length(
+            &self->children, seq_len - 1))
+    {
+        RTI_MQTT_LOG_SET_SEQUENCE_LENGTH_FAILED(
+                    &self->children, seq_len - 1)
+        goto done;
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+/*
+ * Collect the subscriptions matching the topic levels starting at `level`.
+ * A NULL `level` means that all levels of the topic have been consumed.
+ */
+static DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndexNode_match(
+    struct RTI_MQTT_TopicFilterIndexNode *self,
+    const char *level,
+    struct RTI_MQTT_SubscriptionPtrSeq *matches)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    struct RTI_MQTT_TopicFilterIndexNode *child = NULL;
+    struct RTI_MQTT_SubscriptionPtrSeq *subs = NULL;
+    const char *next_level = NULL;
+    DDS_UnsignedLong level_len = 0,
+                     seq_len = 0,
+                     index = 0,
+                     i = 0;
+
+    /* A '#' matches the parent level and any number of levels below it */
+    if (self->hash_child != NULL)
+    {
+        subs = &self->hash_child->subscriptions;
+        seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(subs);
+        for (i = 0; i < seq_len; i++)
+        {
+            if (DDS_RETCODE_OK !=
+                    RTI_MQTT_SubscriptionPtrSeq_append(matches,
+                        *RTI_MQTT_SubscriptionPtrSeq_get_reference(subs, i)))
+            {
+                goto done;
+            }
+        }
+    }
+
+    if (level == NULL)
+    {
+        subs = &self->subscriptions;
+        seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(subs);
+        for (i = 0; i < seq_len; i++)
+        {
+            if (DDS_RETCODE_OK !=
+                    RTI_MQTT_SubscriptionPtrSeq_append(matches,
+                        *RTI_MQTT_SubscriptionPtrSeq_get_reference(subs, i)))
+            {
+                goto done;
+            }
+        }
+        retval = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    RTI_MQTT_TopicLevel_length(level, &level_len)
+    next_level = (level[level_len] == '\0')? NULL : level + level_len + 1;
+
+    if (RTI_MQTT_TopicFilterIndexNode_find_child(
+                self, level, level_len, &index))
+    {
+        child = *RTI_MQTT_TopicFilterIndexNodePtrSeq_get_reference(
+                            &self->children, index);
+        if (DDS_RETCODE_OK !=
+                RTI_MQTT_TopicFilterIndexNode_match(
+                        child, next_level, matches))
+        {
+            goto done;
+        }
+    }
+
+    if (self->plus_child != NULL &&
+        DDS_RETCODE_OK !=
+            RTI_MQTT_TopicFilterIndexNode_match(
+                    self->plus_child, next_level, matches))
+    {
+        goto done;
+    }
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+static DDS_ReturnCode_t
+RTI_MQTT_SubscriptionPtrSeq_add_unique(
+    struct RTI_MQTT_SubscriptionPtrSeq *self,
+    struct RTI_MQTT_Subscription *sub)
+{
+    DDS_UnsignedLong seq_len = 0,
+                     i = 0;
+
+    seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(self);
+    for (i = 0; i < seq_len; i++)
+    {
+        if (*RTI_MQTT_SubscriptionPtrSeq_get_reference(self, i) == sub)
+        {
+            return DDS_RETCODE_OK;
+        }
+    }
+
+    return RTI_MQTT_SubscriptionPtrSeq_append(self, sub);
+}
+
+static DDS_ReturnCode_t
+RTI_MQTT_SubscriptionPtrSeq_append(
+    struct RTI_MQTT_SubscriptionPtrSeq *self,
+    struct RTI_MQTT_Subscription *sub)
+{
+    DDS_ReturnCode_t retval = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong seq_len = 0,
+                     seq_max = 0;
+
+    seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(self);
+    seq_max = RTI_MQTT_SubscriptionPtrSeq_get_maximum(self);
+    if (seq_len + 1 > seq_max)
+    {
+        seq_max = (seq_max == 0)? 1 : seq_max * 2;
+    }
+    if (!RTI_MQTT_SubscriptionPtrSeq_ensure_length(
+            self, seq_len + 1, seq_max))
+    {
+        RTI_MQTT_LOG_SET_SEQUENCE_ENSURE_LENGTH_FAILED(
+                    self, seq_len + 1, seq_max)
+        goto done;
+    }
+    *RTI_MQTT_SubscriptionPtrSeq_get_reference(self, seq_len) = sub;
+
+    retval = DDS_RETCODE_OK;
+done:
+    return retval;
+}
+
+static int
+RTI_MQTT_SubscriptionPtr_compare(const void *left, const void *right)
+{
+    const struct RTI_MQTT_Subscription
+        *l = *(struct RTI_MQTT_Subscription* const*)left,
+        *r = *(struct RTI_MQTT_Subscription* const*)right;
+
+    return (l < r)? -1 : (l > r)? 1 : 0;
+}
+
+/*
+ * Remove the duplicates among the elements following `start`, by sorting
+ * them, so that a topic matching many filters of the same subscriptions
+ * doesn't require a quadratic number of comparisons.
+ */
+static void
+RTI_MQTT_SubscriptionPtrSeq_remove_duplicates(
+    struct RTI_MQTT_SubscriptionPtrSeq *self,
+    DDS_UnsignedLong start)
+{
+    struct RTI_MQTT_Subscription **subs = NULL;
+    DDS_UnsignedLong seq_len = 0,
+                     unique_len = 0,
+                     i = 0;
+
+    seq_len = RTI_MQTT_SubscriptionPtrSeq_get_length(self);
+    if (seq_len < start + 2)
+    {
+        return;
+    }
+
+    subs = RTI_MQTT_SubscriptionPtrSeq_get_reference(self, start);
+    qsort(subs,
+        seq_len - start,
+        sizeof(struct RTI_MQTT_Subscription*),
+        RTI_MQTT_SubscriptionPtr_compare);
+
+    unique_len = 1;
+    for (i = 1; i < seq_len - start; i++)
+    {
+        if (subs[i] != subs[unique_len - 1])
+        {
+            subs[unique_len] = subs[i];
+            unique_len += 1;
+        }
+    }
+
+    /* Shrinking a sequence never fails */
+    (void)RTI_MQTT_SubscriptionPtrSeq_set_length(self, start + unique_len);
+}
@@ -0,0 +1,99 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#ifndef TopicFilterIndex_h
+#define TopicFilterIndex_h
+
+#include "rtiadapt_mqtt.h"
+
+#include "Infrastructure.h"
+#include "Subscription.h"
+
+struct RTI_MQTT_TopicFilterIndexNode;
+
+DDS_SEQUENCE(RTI_MQTT_TopicFilterIndexNodePtrSeq,
+             struct RTI_MQTT_TopicFilterIndexNode*);
+
+/*
+ * A node of the topic filter index, representing one level of one or more
+ * topic filters. Literal children are kept sorted by level, so that they
+ * can be looked up with a binary search. The single-level ("+") and
+ * multi-level ("#") wildcards are stored as dedicated children.
+ */
+struct RTI_MQTT_TopicFilterIndexNode
+{
+    struct RTI_MQTT_TopicFilterIndexNode        *parent;
+    char                                        *level;
+    DDS_UnsignedLong                            level_len;
+    struct RTI_MQTT_TopicFilterIndexNodePtrSeq  children;
+    struct RTI_MQTT_TopicFilterIndexNode        *plus_child;
+    struct RTI_MQTT_TopicFilterIndexNode        *hash_child;
+    struct RTI_MQTT_SubscriptionPtrSeq          subscriptions;
+};
+
+#define RTI_MQTT_TopicFilterIndexNode_INITIALIZER \
+{\
+    NULL, /* parent */ \
+    NULL, /* level */ \
+    0, /* level_len */ \
+    DDS_SEQUENCE_INITIALIZER, /* children */ \
+    NULL, /* plus_child */ \
+    NULL, /* hash_child */ \
+    DDS_SEQUENCE_INITIALIZER /* subscriptions */ \
+}
+
+/*
+ * An index of the topic filters of all the subscriptions of an
+ * RTI_MQTT_Client, which allows all the subscriptions matching a topic to
+ * be found with a single pass over the topic's levels.
+ */
+struct RTI_MQTT_TopicFilterIndex
+{
+    struct RTI_MQTT_TopicFilterIndexNode    *root;
+};
+
+#define RTI_MQTT_TopicFilterIndex_INITIALIZER \
+{\
+    NULL /* root */ \
+}
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_initialize(struct RTI_MQTT_TopicFilterIndex *self);
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_finalize(struct RTI_MQTT_TopicFilterIndex *self);
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_add(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    const char *filter,
+    struct RTI_MQTT_Subscription *sub);
+
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_remove(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    const char *filter,
+    struct RTI_MQTT_Subscription *sub);
+
+/*
+ * Append all the subscriptions with at least one filter matching `topic`
+ * to `matches`. Each subscription is reported only once, even if more
+ * than one of its filters match. As required by MQTT, topics starting with
+ * '$' are not matched by filters starting with a wildcard.
+ */
+DDS_ReturnCode_t
+RTI_MQTT_TopicFilterIndex_match(
+    struct RTI_MQTT_TopicFilterIndex *self,
+    const char *topic,
+    struct RTI_MQTT_SubscriptionPtrSeq *matches);
+
+#endif /* TopicFilterIndex_h */
@@ -73,6 +73,10 @@ mqtt_infrastructure_subscription_config_compare(
     assert_string_seq_equal(&a->topic_filters, &a->topic_filters);
     assert_int_equal(a->max_qos, b->max_qos);
     assert_int_equal(a->message_queue_size, b->message_queue_size);
+    assert_int_equal(a->defer_conversion, b->defer_conversion);
+    assert_int_equal(a->lock_free_queue, b->lock_free_queue);
+    assert_int_equal(a->notify_max_messages, b->notify_max_messages);
+    assert_int_equal(a->notify_max_delay_usec, b->notify_max_delay_usec);
 }
 
 void
@@ -114,6 +118,7 @@ mqtt_infrastructure_publication_config_compare(
     assert_int_equal(a->retained, b->retained);
     assert_int_equal(a->use_message_info, b->use_message_info);
     assert_time_equal(&a->max_wait_time,&b->max_wait_time);
+    assert_int_equal(a->async_write, b->async_write);
 }
 
 
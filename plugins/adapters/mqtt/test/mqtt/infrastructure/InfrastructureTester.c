@@ -12,6 +12,7 @@
 #include "TestFramework.h"
 #include "InfrastructureTester.h"
 #include "Infrastructure.h"
+#include "Log.h"
 
 #define RTI_MQTT_LOG_ARGS       "InfrastructureTester"
 
@@ -178,14 +179,104 @@ mqtt_infrastructure_test_message_to_dyndata(void **state)
     
 }
 
+void
+mqtt_infrastructure_test_log_level(void **state)
+{
+    static char env_warning[] = RTI_MQTT_LOG_LEVEL_ENV "=WARNING";
+    static char env_silent[] = RTI_MQTT_LOG_LEVEL_ENV "=SILENT";
+    static char env_unknown[] = RTI_MQTT_LOG_LEVEL_ENV "=VERBOSE";
+    int def_level = RTI_MQTT_Log_level;
+
+    assert_int_equal(0, putenv(env_warning));
+    RTI_MQTT_Log_initialize();
+    RTI_MQTT_Log_finalize();
+    assert_int_equal(RTI_MQTT_LOG_LEVEL_WARNING, RTI_MQTT_Log_level);
+    assert_true(RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_ERROR));
+    assert_false(RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_INFO));
+
+    assert_int_equal(0, putenv(env_silent));
+    RTI_MQTT_Log_initialize();
+    RTI_MQTT_Log_finalize();
+    assert_int_equal(RTI_MQTT_LOG_LEVEL_SILENT, RTI_MQTT_Log_level);
+    assert_false(RTI_MQTT_LOG_ENABLED(RTI_MQTT_LOG_LEVEL_ERROR));
+
+    /* Unknown values leave the current level unchanged */
+    assert_int_equal(0, putenv(env_unknown));
+    RTI_MQTT_Log_initialize();
+    RTI_MQTT_Log_finalize();
+    assert_int_equal(RTI_MQTT_LOG_LEVEL_SILENT, RTI_MQTT_Log_level);
+
+    RTI_MQTT_Log_level = def_level;
+}
+
+void
+mqtt_infrastructure_test_log_async(void **state)
+{
+    static char env_async[] =
+        RTI_MQTT_LOG_ASYNC_ENV "=mqtt_infrastructure_test_log_async.txt";
+    char line[RTI_MQTT_LOG_RECORD_STRINGS_LEN + 16];
+    char topic[32];
+    FILE *log_file = NULL;
+    int i = 0,
+        lines = 0;
+
+    (void)remove("mqtt_infrastructure_test_log_async.txt");
+
+    assert_int_equal(0, putenv(env_async));
+    RTI_MQTT_Log_initialize();
+    for (i = 0; i < 100; i++)
+    {
+        /* Records keep a copy of string arguments, since the buffer is
+           reused before the drain thread formats the message */
+        sprintf(topic, "topic/%d", i);
+        RTI_MQTT_Log_printf("async message %d: topic=%s, len=%lu, %%=%.1f\n",
+            i, topic, (unsigned long)strlen(topic), 0.5);
+    }
+    /* Conversions which can't be captured are formatted by the caller */
+    RTI_MQTT_Log_printf("async message %*d\n", 3, 100);
+    /* Deleting the backend writes all pending records */
+    RTI_MQTT_Log_finalize();
+
+    log_file = fopen("mqtt_infrastructure_test_log_async.txt", "r");
+    assert_non_null(log_file);
+    while (fgets(line, sizeof(line), log_file) != NULL)
+    {
+        char expected[96];
+        if (lines < 100)
+        {
+            sprintf(topic, "topic/%d", lines);
+            sprintf(expected,
+                "async message %d: topic=%s, len=%lu, %%=0.5\n",
+                lines, topic, (unsigned long)strlen(topic));
+        }
+        else
+        {
+            sprintf(expected, "async message 100\n");
+        }
+        assert_string_equal(expected, line);
+        lines += 1;
+    }
+    fclose(log_file);
+    assert_int_equal(101, lines);
+
+    (void)remove("mqtt_infrastructure_test_log_async.txt");
+}
 
 int main(void) {
     const struct CMUnitTest tests[] = {
         cmocka_unit_test(mqtt_infrastructure_test_topic_filter_match),
+        cmocka_unit_test(mqtt_infrastructure_test_topic_filter_index),
+        cmocka_unit_test(
+            mqtt_infrastructure_test_topic_filter_index_consistency),
+        cmocka_unit_test(mqtt_infrastructure_test_lock_free_ring),
+        cmocka_unit_test(mqtt_infrastructure_test_lock_free_ring_concurrent),
+        cmocka_unit_test(mqtt_infrastructure_test_publication_write_window),
         cmocka_unit_test(mqtt_infrastructure_test_client_config_default),
         cmocka_unit_test(mqtt_infrastructure_test_subscription_config_default),
         cmocka_unit_test(mqtt_infrastructure_test_publication_config_default),
-        cmocka_unit_test(mqtt_infrastructure_test_message_to_dyndata)
+        cmocka_unit_test(mqtt_infrastructure_test_message_to_dyndata),
+        cmocka_unit_test(mqtt_infrastructure_test_log_level),
+        cmocka_unit_test(mqtt_infrastructure_test_log_async)
     };
     return cmocka_run_group_tests(tests, NULL, NULL);
 }
\ No newline at end of file
@@ -13,6 +13,8 @@
 #define InfrastructureTester_h
 
 #include "TopicFilterTester.h"
+#include "LockFreeRingTester.h"
+#include "PublicationWindowTester.h"
 #include "ConfigTester.h"
 
 #endif /* InfrastructureTester_h */
\ No newline at end of file
@@ -0,0 +1,189 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+#include "TestFramework.h"
+#include "LockFreeRingTester.h"
+#include "Infrastructure.h"
+#include "LockFreeRing.h"
+
+
+void
+mqtt_infrastructure_test_lock_free_ring(void **state)
+{
+    struct RTI_MQTT_LockFreeRing ring = RTI_MQTT_LockFreeRing_INITIALIZER;
+    void *value = NULL;
+    DDS_UnsignedLong i = 0,
+                     lap = 0;
+
+#define test_ring_push(v_) \
+    assert_true(RTI_MQTT_LockFreeRing_push(&ring, (void*)(v_)))
+#define test_ring_pop(v_) \
+{\
+    value = NULL; \
+    assert_true(RTI_MQTT_LockFreeRing_pop(&ring, &value)); \
+    assert_ptr_equal(value, (void*)(v_)); \
+}
+
+    assert_retcode_err(RTI_MQTT_LockFreeRing_initialize(&ring, 0));
+    assert_retcode_ok(RTI_MQTT_LockFreeRing_initialize(&ring, 3));
+
+    assert_false(RTI_MQTT_LockFreeRing_pop(&ring, &value));
+
+    test_ring_push(1);
+    test_ring_push(2);
+    test_ring_push(3);
+    assert_false(RTI_MQTT_LockFreeRing_push(&ring, (void*)4));
+
+    /* Overwrite the oldest value, like a full queue would */
+    test_ring_pop(1);
+    test_ring_push(4);
+    assert_false(RTI_MQTT_LockFreeRing_push(&ring, (void*)5));
+
+    test_ring_pop(2);
+    test_ring_pop(3);
+    test_ring_pop(4);
+    assert_false(RTI_MQTT_LockFreeRing_pop(&ring, &value));
+
+    /* Values keep their order across many laps of a ring whose capacity
+       is not a power of two */
+    for (lap = 0; lap < 100; lap++)
+    {
+        for (i = 1; i <= 2; i++)
+        {
+            test_ring_push(lap * 2 + i);
+        }
+        for (i = 1; i <= 2; i++)
+        {
+            test_ring_pop(lap * 2 + i);
+        }
+    }
+    assert_false(RTI_MQTT_LockFreeRing_pop(&ring, &value));
+
+    assert_retcode_ok(RTI_MQTT_LockFreeRing_finalize(&ring));
+}
+
+#define MQTT_TEST_RING_CAPACITY         4
+#define MQTT_TEST_RING_VALUES           200000
+/* Values pushed before the consumer starts, which overflow the ring */
+#define MQTT_TEST_RING_PRELOAD          (MQTT_TEST_RING_CAPACITY * 4)
+
+struct mqtt_test_ring_state
+{
+    struct RTI_MQTT_LockFreeRing ring;
+    RTI_MQTT_AtomicCounter started;
+    RTI_MQTT_AtomicCounter stopped;
+    /* Written only by the consumer thread */
+    DDS_Octet *received;
+    DDS_UnsignedLong received_count;
+    DDS_UnsignedLong out_of_order;
+};
+
+static void*
+mqtt_test_ring_consumer(void *arg)
+{
+    struct mqtt_test_ring_state *s = (struct mqtt_test_ring_state*)arg;
+    void *value = NULL;
+    DDS_UnsignedLong v = 0,
+                     last = 0;
+    DDS_Boolean stopped = DDS_BOOLEAN_FALSE;
+
+    while (RTI_MQTT_Atomic_load(&s->started) == 0)
+    {
+        /* Wait for the producer to fill the ring */
+    }
+
+    do
+    {
+        /* Check the flag before popping, so that the values pushed before
+           the producer stopped are always received */
+        stopped = (RTI_MQTT_Atomic_load(&s->stopped) != 0);
+
+        while (RTI_MQTT_LockFreeRing_pop(&s->ring, &value))
+        {
+            v = (DDS_UnsignedLong)(size_t)value;
+            if (v <= last || v > MQTT_TEST_RING_VALUES)
+            {
+                s->out_of_order += 1;
+                continue;
+            }
+            s->received[v] += 1;
+            s->received_count += 1;
+            last = v;
+        }
+    } while (!stopped);
+
+    return NULL;
+}
+
+void
+mqtt_infrastructure_test_lock_free_ring_concurrent(void **state)
+{
+    struct mqtt_test_ring_state s;
+    DDS_Octet *lost = NULL;
+    DDS_UnsignedLong v = 0,
+                     last_lost = 0,
+                     lost_count = 0;
+    void *dropped = NULL,
+         *consumer = NULL;
+
+    RTI_MQTT_Memory_zero(&s, sizeof(s));
+    s.received = (DDS_Octet*) RTI_MQTT_Heap_allocate(MQTT_TEST_RING_VALUES + 1);
+    lost = (DDS_Octet*) RTI_MQTT_Heap_allocate(MQTT_TEST_RING_VALUES + 1);
+    assert_non_null(s.received);
+    assert_non_null(lost);
+    RTI_MQTT_Memory_zero(s.received, MQTT_TEST_RING_VALUES + 1);
+    RTI_MQTT_Memory_zero(lost, MQTT_TEST_RING_VALUES + 1);
+
+    assert_retcode_ok(
+        RTI_MQTT_LockFreeRing_initialize(&s.ring, MQTT_TEST_RING_CAPACITY));
+    assert_retcode_ok(
+        RTI_MQTT_Thread_spawn(mqtt_test_ring_consumer, &s, &consumer));
+
+    /* A single producer which makes room for a new value by popping the
+       oldest one when the ring is full, and counts it as lost, like
+       RTI_MQTT_MessageReceiveQueue does. The consumer may pop the oldest
+       value first, in which case nothing is lost. */
+    for (v = 1; v <= MQTT_TEST_RING_VALUES; v++)
+    {
+        while (!RTI_MQTT_LockFreeRing_push(&s.ring, (void*)(size_t)v))
+        {
+            if (RTI_MQTT_LockFreeRing_pop(&s.ring, &dropped))
+            {
+                assert_true((size_t)dropped > last_lost);
+                last_lost = (DDS_UnsignedLong)(size_t)dropped;
+                lost[last_lost] += 1;
+                lost_count += 1;
+            }
+        }
+        if (v == MQTT_TEST_RING_PRELOAD)
+        {
+            RTI_MQTT_Atomic_store(&s.started, 1);
+        }
+    }
+    RTI_MQTT_Atomic_store(&s.stopped, 1);
+
+    assert_retcode_ok(RTI_MQTT_Thread_join(consumer, NULL));
+    RTI_MQTT_Heap_free(consumer);
+
+    /* Every value was either received or lost, exactly once */
+    assert_int_equal(0, s.out_of_order);
+    assert_true(lost_count >= MQTT_TEST_RING_PRELOAD - MQTT_TEST_RING_CAPACITY);
+    assert_int_equal(MQTT_TEST_RING_VALUES, s.received_count + lost_count);
+    for (v = 1; v <= MQTT_TEST_RING_VALUES; v++)
+    {
+        assert_int_equal(1, s.received[v] + lost[v]);
+    }
+    assert_false(RTI_MQTT_LockFreeRing_pop(&s.ring, &dropped));
+
+    assert_retcode_ok(RTI_MQTT_LockFreeRing_finalize(&s.ring));
+    RTI_MQTT_Heap_free(lost);
+    RTI_MQTT_Heap_free(s.received);
+}
@@ -0,0 +1,21 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+#ifndef LockFreeRingTester_h
+#define LockFreeRingTester_h
+
+void
+mqtt_infrastructure_test_lock_free_ring(void **state);
+
+void
+mqtt_infrastructure_test_lock_free_ring_concurrent(void **state);
+
+#endif /* LockFreeRingTester_h */
@@ -0,0 +1,126 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+#include "TestFramework.h"
+#include "PublicationWindowTester.h"
+#include "Infrastructure.h"
+#include "Publication.h"
+
+#define TEST_WINDOW_LEN         3
+
+void
+mqtt_infrastructure_test_publication_write_window(void **state)
+{
+    struct RTI_MQTT_Publication pub = RTI_MQTT_Publication_INITIALIZER;
+    struct RTI_MQTT_PublicationWriteSlot
+            slots[TEST_WINDOW_LEN] =
+            {
+                RTI_MQTT_PublicationWriteSlot_INITIALIZER,
+                RTI_MQTT_PublicationWriteSlot_INITIALIZER,
+                RTI_MQTT_PublicationWriteSlot_INITIALIZER
+            };
+    struct RTI_MQTT_PublicationWriteSlot
+            *acquired[TEST_WINDOW_LEN] = { NULL, NULL, NULL },
+            *slot = NULL;
+    DDS_Boolean notify = DDS_BOOLEAN_FALSE,
+                pending = DDS_BOOLEAN_FALSE;
+    DDS_UnsignedLong i = 0,
+                     lap = 0;
+
+    /* Chain the slots like RTI_MQTT_Client_create_publication_requests() */
+    for (i = 0; i < TEST_WINDOW_LEN; i++)
+    {
+        slots[i].pub = &pub;
+        slots[i].next_free = (i + 1 < TEST_WINDOW_LEN)? &slots[i + 1] : NULL;
+    }
+    pub.write_slots = slots;
+    pub.write_slots_len = TEST_WINDOW_LEN;
+    pub.write_slots_free = &slots[0];
+    assert_retcode_ok(RTI_MQTT_Mutex_initialize(&pub.write_lock));
+
+    /* Fill the window */
+    for (i = 0; i < TEST_WINDOW_LEN; i++)
+    {
+        assert_retcode_ok(
+            RTI_MQTT_Publication_acquire_write_slot(
+                &pub, RTI_MQTT_QosLevel_ONE, &acquired[i]));
+        assert_non_null(acquired[i]);
+        assert_int_equal(acquired[i]->qos, RTI_MQTT_QosLevel_ONE);
+    }
+    assert_int_equal(pub.write_inflight, TEST_WINDOW_LEN);
+    assert_ptr_not_equal(acquired[0], acquired[1]);
+    assert_ptr_not_equal(acquired[1], acquired[2]);
+    assert_ptr_not_equal(acquired[0], acquired[2]);
+
+    /* A full window asks the next completion to wake up the writer */
+    assert_retcode_ok(
+        RTI_MQTT_Publication_acquire_write_slot(
+            &pub, RTI_MQTT_QosLevel_ONE, &slot));
+    assert_null(slot);
+    assert_true(pub.write_waiting);
+
+    assert_retcode_ok(
+        RTI_MQTT_Publication_release_write_slot(&pub, acquired[1], &notify));
+    assert_true(notify);
+    assert_false(pub.write_waiting);
+    assert_int_equal(acquired[1]->qos, RTI_MQTT_QosLevel_UNKNOWN);
+
+    /* The released slot is reused by the next write */
+    assert_retcode_ok(
+        RTI_MQTT_Publication_acquire_write_slot(
+            &pub, RTI_MQTT_QosLevel_TWO, &slot));
+    assert_ptr_equal(slot, acquired[1]);
+    assert_int_equal(slot->qos, RTI_MQTT_QosLevel_TWO);
+
+    /* Drain the window, like RTI_MQTT_Client_wait_for_pending_writes() */
+    assert_retcode_ok(RTI_MQTT_Publication_has_pending_writes(&pub, &pending));
+    assert_true(pending);
+    assert_true(pub.write_waiting);
+    for (i = 0; i < TEST_WINDOW_LEN; i++)
+    {
+        assert_retcode_ok(
+            RTI_MQTT_Publication_release_write_slot(
+                &pub, acquired[i], &notify));
+        /* Only the first completion wakes up the waiting thread */
+        assert_int_equal(notify, (i == 0));
+    }
+    assert_int_equal(pub.write_inflight, 0);
+    assert_retcode_ok(RTI_MQTT_Publication_has_pending_writes(&pub, &pending));
+    assert_false(pending);
+
+    /* A result with no write in flight is an error */
+    assert_retcode_err(
+        RTI_MQTT_Publication_release_write_slot(&pub, acquired[0], &notify));
+    assert_false(notify);
+
+    /* The same slots are reused by every lap over the window */
+    for (lap = 0; lap < 100; lap++)
+    {
+        for (i = 0; i < TEST_WINDOW_LEN; i++)
+        {
+            assert_retcode_ok(
+                RTI_MQTT_Publication_acquire_write_slot(
+                    &pub, RTI_MQTT_QosLevel_ZERO, &acquired[i]));
+            assert_true(acquired[i] >= &slots[0] &&
+                        acquired[i] < &slots[TEST_WINDOW_LEN]);
+        }
+        assert_null(pub.write_slots_free);
+        for (i = 0; i < TEST_WINDOW_LEN; i++)
+        {
+            assert_retcode_ok(
+                RTI_MQTT_Publication_release_write_slot(
+                    &pub, acquired[TEST_WINDOW_LEN - 1 - i], &notify));
+        }
+        assert_int_equal(pub.write_inflight, 0);
+    }
+
+    assert_retcode_ok(RTI_MQTT_Mutex_finalize(&pub.write_lock));
+}
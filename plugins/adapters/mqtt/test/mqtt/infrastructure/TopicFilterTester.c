@@ -12,6 +12,7 @@
 #include "TestFramework.h"
 #include "TopicFilterTester.h"
 #include "Infrastructure.h"
+#include "TopicFilterIndex.h"
 
 
 void
@@ -41,6 +42,160 @@ mqtt_infrastructure_test_topic_filter_match(void **state)
     test_filter_n("bar/#","foo");
     test_filter_n("bar/+/+/baz","bar/foo/foo/foo/baz");
     test_filter_y("/bar/#","/bar/foo");
+    test_filter_y("foo/bar","foo/bar");
+    test_filter_n("foo/bar","foo/bar/baz");
+    test_filter_n("foo/bar/baz","foo/bar");
+    test_filter_n("foo/bar","foo/ba");
+    test_filter_y("+","foo");
+    test_filter_n("+","foo/bar");
+    test_filter_n("foo/+","foo");
+    /* '#' also matches its parent level */
+    test_filter_y("bar/#","bar");
+    test_filter_y("bar/#","bar/");
+    /* Empty levels are matched like any other level */
+    test_filter_y("/bar/#","/bar//foo");
+    test_filter_y("a/+/b","a//b");
+    test_filter_y("a/+","a/");
+    test_filter_y("+/+","/foo");
+    test_filter_y("/+","/foo");
+    test_filter_n("+","/foo");
+    test_filter_n("a/b","a//b");
+    /* Topics starting with '$' are not matched by a leading wildcard */
+    test_filter_n("#","$SYS/foo");
+    test_filter_n("+/foo","$SYS/foo");
+    test_filter_y("$SYS/#","$SYS/foo");
+    test_filter_y("$SYS/+","$SYS/foo");
+    test_filter_y("foo/+","foo/$bar");
     test_filter_err("/bar/#foo","/bar/foo");
-    test_filter_err("/bar/#","/bar//foo")
+    test_filter_err("a/#/b","a/b");
+    test_filter_err("a/b+","a/b");
+    test_filter_err("","a");
+}
+
+void
+mqtt_infrastructure_test_topic_filter_index_consistency(void **state)
+{
+    struct RTI_MQTT_TopicFilterIndex index =
+            RTI_MQTT_TopicFilterIndex_INITIALIZER;
+    struct RTI_MQTT_SubscriptionPtrSeq matches = DDS_SEQUENCE_INITIALIZER;
+    const char *filters[] = {
+        "#", "+", "bar", "bar/#", "bar/+", "bar/+/baz", "+/+", "/+", "/#",
+        "a/+/b", "a//b", "a/", "a/+", "+/#", "+/+/+", "$SYS/#", "$SYS/+"
+    };
+    const char *topics[] = {
+        "bar", "bar/", "bar/foo", "bar/foo/baz", "bar//baz", "/foo", "/",
+        "a/b", "a//b", "a/", "a", "foo/bar/baz", "//", "$SYS", "$SYS/foo",
+        "bar/$foo"
+    };
+    DDS_UnsignedLong i = 0,
+                     j = 0;
+    DDS_Boolean match = DDS_BOOLEAN_FALSE;
+
+    /* The index and RTI_MQTT_TopicFilter_match must agree on every
+       combination of filter and topic */
+    for (i = 0; i < sizeof(filters) / sizeof(filters[0]); i++)
+    {
+        assert_retcode_ok(RTI_MQTT_TopicFilterIndex_initialize(&index));
+        assert_retcode_ok(
+            RTI_MQTT_TopicFilterIndex_add(
+                &index, filters[i], (struct RTI_MQTT_Subscription*)1));
+
+        for (j = 0; j < sizeof(topics) / sizeof(topics[0]); j++)
+        {
+            assert_true(RTI_MQTT_SubscriptionPtrSeq_set_length(&matches, 0));
+            assert_retcode_ok(
+                RTI_MQTT_TopicFilterIndex_match(&index, topics[j], &matches));
+            assert_retcode_ok(
+                RTI_MQTT_TopicFilter_match(filters[i], topics[j], &match));
+            assert_int_equal(
+                RTI_MQTT_SubscriptionPtrSeq_get_length(&matches),
+                (match)? 1 : 0);
+        }
+
+        assert_retcode_ok(RTI_MQTT_TopicFilterIndex_finalize(&index));
+    }
+
+    assert_true(RTI_MQTT_SubscriptionPtrSeq_finalize(&matches));
+}
+
+void
+mqtt_infrastructure_test_topic_filter_index(void **state)
+{
+    struct RTI_MQTT_TopicFilterIndex index =
+            RTI_MQTT_TopicFilterIndex_INITIALIZER;
+    struct RTI_MQTT_SubscriptionPtrSeq matches = DDS_SEQUENCE_INITIALIZER;
+    /* Subscriptions are only stored by the index, never dereferenced */
+    struct RTI_MQTT_Subscription *sub_1 = (struct RTI_MQTT_Subscription*)1,
+                                 *sub_2 = (struct RTI_MQTT_Subscription*)2,
+                                 *sub_3 = (struct RTI_MQTT_Subscription*)3,
+                                 *sub_4 = (struct RTI_MQTT_Subscription*)4;
+
+#define test_index_match(t_,len_) \
+{\
+    assert_true(RTI_MQTT_SubscriptionPtrSeq_set_length(&matches, 0)); \
+    assert_retcode_ok(\
+        RTI_MQTT_TopicFilterIndex_match(&index, (t_), &matches)); \
+    assert_int_equal( \
+        RTI_MQTT_SubscriptionPtrSeq_get_length(&matches), (len_)); \
+}
+#define test_index_matched(s_) \
+{\
+    DDS_UnsignedLong i = 0; \
+    DDS_Boolean found = DDS_BOOLEAN_FALSE; \
+    for (i = 0; i < RTI_MQTT_SubscriptionPtrSeq_get_length(&matches); i++) \
+    {\
+        if (*RTI_MQTT_SubscriptionPtrSeq_get_reference(&matches, i) == (s_)) \
+        {\
+            found = DDS_BOOLEAN_TRUE; \
+        }\
+    }\
+    assert_true(found); \
+}
+
+    assert_retcode_ok(RTI_MQTT_TopicFilterIndex_initialize(&index));
+
+    assert_retcode_ok(RTI_MQTT_TopicFilterIndex_add(&index, "bar/#", sub_1));
+    assert_retcode_ok(
+        RTI_MQTT_TopicFilterIndex_add(&index, "bar/+/+/+/baz", sub_2));
+    assert_retcode_ok(RTI_MQTT_TopicFilterIndex_add(&index, "#", sub_3));
+    assert_retcode_ok(RTI_MQTT_TopicFilterIndex_add(&index, "foo/bar", sub_4));
+    assert_retcode_ok(RTI_MQTT_TopicFilterIndex_add(&index, "foo/+", sub_4));
+
+    assert_retcode_err(
+        RTI_MQTT_TopicFilterIndex_add(&index, "/bar/#foo", sub_1));
+    assert_retcode_err(RTI_MQTT_TopicFilterIndex_add(&index, "a/#/b", sub_1));
+    assert_retcode_err(RTI_MQTT_TopicFilterIndex_add(&index, "a/b+", sub_1));
+    assert_retcode_err(RTI_MQTT_TopicFilterIndex_add(&index, "", sub_1));
+
+    test_index_match("bar/foo/foo/foo/baz", 3);
+    test_index_matched(sub_1);
+    test_index_matched(sub_2);
+    test_index_matched(sub_3);
+    test_index_match("bar", 2);
+    test_index_matched(sub_1);
+    test_index_matched(sub_3);
+    test_index_match("foo/really *$()@any12312 character, even +", 2);
+    test_index_matched(sub_3);
+    test_index_matched(sub_4);
+    /* sub_4 matches with both of its filters, but is reported only once */
+    test_index_match("foo/bar", 2);
+    test_index_matched(sub_4);
+    test_index_match("foo/bar/baz", 1);
+    test_index_matched(sub_3);
+    /* "#" doesn't match topics starting with '$' */
+    test_index_match("$SYS/foo", 0);
+
+    assert_retcode_ok(RTI_MQTT_TopicFilterIndex_remove(&index, "#", sub_3));
+    assert_retcode_ok(RTI_MQTT_TopicFilterIndex_remove(&index, "foo/+", sub_4));
+    test_index_match("foo/baz", 0);
+    test_index_match("foo/bar", 1);
+    test_index_matched(sub_4);
+    assert_retcode_ok(
+        RTI_MQTT_TopicFilterIndex_remove(&index, "foo/bar", sub_4));
+    test_index_match("foo/bar", 0);
+    test_index_match("bar/foo", 1);
+    test_index_matched(sub_1);
+
+    assert_true(RTI_MQTT_SubscriptionPtrSeq_finalize(&matches));
+    assert_retcode_ok(RTI_MQTT_TopicFilterIndex_finalize(&index));
 }
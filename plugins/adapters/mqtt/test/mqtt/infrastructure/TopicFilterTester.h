@@ -15,4 +15,10 @@
 void
 mqtt_infrastructure_test_topic_filter_match(void **state);
 
+void
+mqtt_infrastructure_test_topic_filter_index(void **state);
+
+void
+mqtt_infrastructure_test_topic_filter_index_consistency(void **state);
+
 #endif /* TopicFilterTester_h */
\ No newline at end of file
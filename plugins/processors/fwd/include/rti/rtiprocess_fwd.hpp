@@ -23,25 +23,220 @@ namespace rti { namespace prcs { namespace fwd {
 
     struct InternalMatchingTableEntry {
         bool match(const char *in_key);
+        bool match(int64_t value) const;
 
         InternalMatchingTableEntry(
                 const char *in_key,
                 const char *out_name);
 
+        InternalMatchingTableEntry(const fwd::MatchingTableEntry& entry);
+
+        fwd::MatchingTableEntryKind kind;
         std::string in_key;
         std::string out_name;
+        bool is_glob;
+        int64_t range_min;
+        int64_t range_max;
+        /* sorted, so that INTEGER_SET entries can be searched */
+        std::vector<int64_t> values;
+        /* every output of the entry, starting with out_name */
+        std::vector<std::string> out_names;
+        std::vector<fwd::FilterCondition> filter;
     };
 
+    /*
+     * Entries are matched in the order in which they were added, and the
+     * first one matching a key is returned. Entries without any wildcard
+     * are indexed by their key, so that they can be found without matching
+     * every entry. Entries with a pattern, or matching integer values, are
+     * kept in `glob_entries`. The entry resolved for keys which may also be
+     * matched by those is cached, up to MAX_CACHED_KEYS distinct keys,
+     * after which one cached key is evicted for every new one.
+     */
     struct InternalMatchingTable {
+        static const std::size_t MAX_CACHED_KEYS;
+        static const std::size_t NO_ENTRY;
+
         InternalMatchingTableEntry& find(const char *in_key);
+        InternalMatchingTableEntry& find(const std::string& in_key);
+        /* Like find(), but returns nullptr if no entry matches the key */
+        InternalMatchingTableEntry* lookup(const std::string& in_key);
         InternalMatchingTableEntry& add(
                 const char *in_key,
                 const char *out_name);
+        InternalMatchingTableEntry& add(const fwd::MatchingTableEntry& entry);
+        InternalMatchingTableEntry& add(const InternalMatchingTableEntry& entry);
 
         std::vector<InternalMatchingTableEntry> entries;
+        std::unordered_map<std::string, std::size_t> literal_entries;
+        std::vector<std::size_t> glob_entries;
+        std::unordered_map<std::string, std::size_t> resolved_keys;
 
         static InternalMatchingTable from_matching_table(
                 const fwd::MatchingTable& table);
+
+    protected:
+        std::size_t resolve(const std::string& in_key);
+    };
+
+    struct IntegerMatchingSegment {
+        int64_t min;
+        int64_t max;
+        std::size_t entry;
+    };
+
+    /*
+     * An InternalMatchingTable compiled for an integer, or enumeration,
+     * input member. Every entry is converted to the ranges of values that
+     * it matches, and these are merged into disjoint segments, each one
+     * mapped to the first entry matching it. If the segments span less than
+     * MAX_DENSE_LEN values, they are expanded into a flat array indexed by
+     * value, otherwise they are binary searched.
+     */
+    struct IntegerMatchingTable {
+        static const std::size_t MAX_DENSE_LEN;
+
+        IntegerMatchingTable();
+
+        /*
+         * Fails if the table contains entries whose key is a pattern, or
+         * can't be converted to a value. Keys are converted using
+         * `enum_values`, if not NULL, or parsed as integers otherwise.
+         */
+        bool compile(
+                const InternalMatchingTable& table,
+                const std::unordered_map<std::string,int64_t> *enum_values);
+
+        std::size_t find(int64_t value) const;
+
+        std::vector<IntegerMatchingSegment> segments;
+        std::vector<std::size_t> dense;
+        int64_t dense_min;
+    };
+
+    /*
+     * A FilterCondition compiled for the type of an input's samples: the
+     * member is resolved once, and then accessed by index.
+     */
+    struct FilterPredicate {
+        FilterPredicate(
+                const fwd::FilterCondition& condition,
+                const dds::core::xtypes::DynamicData& data);
+
+        bool evaluate(const dds::core::xtypes::DynamicData& data) const;
+
+        uint32_t member_index;
+        dds::core::xtypes::TypeKind::type member_kind;
+        fwd::FilterOperatorKind op;
+        fwd::FilterValueKind value_kind;
+        int64_t integer_value;
+        double float_value;
+        std::string string_value;
+    };
+
+    /*
+     * A counter aligned to, and padded to the size of, a cache line, so that
+     * counters updated by the data path never share a line.
+     */
+    struct alignas(64) MetricsCounter {
+        std::atomic<uint64_t> value;
+
+        MetricsCounter() : value(0) { }
+
+        void add(uint64_t count)
+        {
+            value.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        uint64_t get() const
+        {
+            return value.load(std::memory_order_relaxed);
+        }
+    };
+
+    /*
+     * Bucket i counts latencies lower than 2^i microseconds, the last one
+     * counts all the others.
+     */
+    struct MetricsHistogram {
+        static const std::size_t BUCKETS = 24;
+
+        void record(uint64_t usec, uint64_t count);
+
+        MetricsCounter buckets[BUCKETS];
+    };
+
+    /*
+     * Heap allocation for the metrics of inputs and outputs. C++11's global
+     * operator new only guarantees alignof(std::max_align_t), which is less
+     * than the alignment of MetricsCounter.
+     */
+    struct MetricsAllocation {
+        static void* operator new(std::size_t size);
+
+        static void operator delete(void *ptr);
+    };
+
+    /* Metrics of the samples forwarded from an input to an output */
+    struct OutputMetrics : MetricsAllocation {
+        std::string input_name;
+        std::string output_name;
+        MetricsCounter forwarded;
+        MetricsCounter failed;
+        MetricsHistogram latency;
+    };
+
+    struct InputMetrics : MetricsAllocation {
+        std::string name;
+        MetricsCounter taken;
+        MetricsCounter filtered;
+        MetricsCounter unmatched;
+        MetricsCounter failed;
+        /* Indexed by output slot, only accessed by the data path */
+        std::vector<OutputMetrics*> outputs;
+    };
+
+    /*
+     * Metrics are only updated by the data path, with relaxed atomic
+     * increments. The mutex only protects the registration of new inputs
+     * and outputs, which happens once for each of them, from the thread
+     * which periodically writes a JSON snapshot of all the metrics.
+     */
+    class ForwardingMetrics {
+    public:
+        ForwardingMetrics(const std::string& file, uint32_t period_ms);
+
+        ~ForwardingMetrics();
+
+        InputMetrics* input(const std::string& input_name);
+
+        OutputMetrics* output(
+                InputMetrics& input,
+                std::size_t slot,
+                const std::string& output_name);
+
+        void write_snapshot();
+
+    private:
+        void run();
+
+        std::string file;
+        std::chrono::milliseconds period;
+        std::mutex lock;
+        std::condition_variable stop_cond;
+        bool stopped;
+        std::vector<std::unique_ptr<InputMetrics>> inputs;
+        std::vector<std::unique_ptr<OutputMetrics>> outputs;
+        std::thread thread;
+    };
+
+    /*
+     * The tables of a ForwardingEngine, parsed from its properties when the
+     * Processor is updated.
+     */
+    struct ForwardingTables {
+        InternalMatchingTable fwd_table;
+        InternalMatchingTable input_members;
     };
 
     class ForwardingEngine : public rti::routing::processor::NoOpProcessor {
@@ -49,16 +244,97 @@ namespace rti { namespace prcs { namespace fwd {
         void on_data_available(
                 rti::routing::processor::Route&);
 
-        ForwardingEngine(ForwardingEngineConfiguration& config);
+        void update(const rti::routing::PropertySet& properties) override;
+
+        ForwardingEngine(
+                ForwardingEngineConfiguration& config,
+                const rti::routing::PropertySet& properties);
+
+        virtual ~ForwardingEngine();
 
     protected:
         InternalMatchingTable fwd_table;
+        /* Properties of the last configuration, updates are merged in */
+        rti::routing::PropertySet properties;
+        /*
+         * Tables built by update(), and not yet installed. The data path
+         * exchanges them for NULL and installs them between two takes, so
+         * it never waits for an update. Tables replaced by a newer update
+         * before being installed are deleted by update().
+         */
+        std::atomic<ForwardingTables*> pending_tables;
+        /* NULL if metrics are disabled */
+        std::unique_ptr<ForwardingMetrics> metrics;
+        std::unordered_map<std::string, InputMetrics*> input_metrics;
+        /* Metrics of the input being processed */
+        InputMetrics *cur_input_metrics;
+        std::chrono::steady_clock::time_point cur_take_time;
+        /*
+         * Samples which match no entry are reported at most once per
+         * second, with the number of samples not reported since the last
+         * warning.
+         */
+        std::chrono::steady_clock::time_point unmatched_warning_time;
+        uint64_t unmatched_suppressed;
+        /* Reused for every sample, to avoid allocating a new key */
+        std::string fwd_key;
+
+        /*
+         * Samples taken from an input are queued for the outputs of their
+         * entry in fwd_table, and written to each output in a group, after
+         * the whole take has been processed. Outputs are resolved once for
+         * each entry, and their handles are cached.
+         * A group is not written with a single call: TypedOutput only
+         * writes one sample at a time, so grouping saves the lookup of the
+         * output, and keeps the writes to an output consecutive.
+         */
+        std::vector<std::vector<std::size_t>> entry_outputs;
+        std::unordered_map<std::string, std::size_t> output_slots;
+        std::vector<rti::routing::processor::TypedOutput<dds::core::xtypes::DynamicData>> outputs;
+        std::vector<std::vector<const dds::core::xtypes::DynamicData*>> output_queues;
+        /* The filters of each entry, compiled for each input's type */
+        std::unordered_map<std::string, std::vector<std::vector<FilterPredicate>>> input_filters;
 
         void forward_data(
                 rti::routing::processor::Route& route,
                 rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input,
                 const dds::core::xtypes::DynamicData& data);
 
+        const std::vector<std::size_t>& resolve_outputs(
+                rti::routing::processor::Route& route,
+                std::size_t entry_i);
+
+        bool filter_data(
+                rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input,
+                std::size_t entry_i,
+                const dds::core::xtypes::DynamicData& data);
+
+        void write_queued_data(
+                rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input);
+
+        void clear_queued_data();
+
+        void install_pending_tables();
+
+        InputMetrics* find_input_metrics(
+                rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input);
+
+        void record_output_metrics(
+                std::size_t slot,
+                std::size_t written,
+                std::size_t failed);
+
+        virtual void install_tables(ForwardingTables& tables);
+
+        virtual void parse_tables(
+                const rti::routing::PropertySet& properties,
+                ForwardingTables& tables_out) = 0;
+
+        /* Returns nullptr if no entry of the table matches the sample */
+        virtual InternalMatchingTableEntry* find_forwarding_entry(
+                rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input,
+                const dds::core::xtypes::DynamicData& data);
+
         virtual void get_forwarding_key(
                 rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input,
                 const dds::core::xtypes::DynamicData& data,
@@ -68,9 +344,14 @@ namespace rti { namespace prcs { namespace fwd {
     class ByInputNameForwardingEngine : public ForwardingEngine {
     public:
         ByInputNameForwardingEngine(
-            ByInputNameForwardingEngineConfiguration& config);
+            ByInputNameForwardingEngineConfiguration& config,
+            const rti::routing::PropertySet& properties);
 
     protected:
+        void parse_tables(
+                const rti::routing::PropertySet& properties,
+                ForwardingTables& tables_out);
+
         void get_forwarding_key(
                 rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input,
                 const dds::core::xtypes::DynamicData& data,
@@ -78,7 +359,14 @@ namespace rti { namespace prcs { namespace fwd {
     };
 
 
+    /*
+     * The member of an input's samples used as forwarding key. The member
+     * is resolved when the first sample is received, and afterwards it is
+     * accessed by index, and its value formatted into a reusable buffer.
+     */
     struct InputMemberValue {
+        /* Large enough for any double printed with "%f" */
+        static const std::size_t FORMAT_BUFFER_MAX_LEN = 320;
         static const char *FORMAT_BOOLEAN;
         static const char *FORMAT_UINT8;
         static const char *FORMAT_UINT16;
@@ -94,36 +382,56 @@ namespace rti { namespace prcs { namespace fwd {
         std::string name;
         dds::core::optional<rti::core::xtypes::DynamicDataMemberInfo> info;
         std::string string_format;
+        uint32_t member_index;
+        char format_buffer[FORMAT_BUFFER_MAX_LEN];
+        /* labels of an enumeration member, indexed by ordinal */
+        std::unordered_map<int64_t,std::string> enum_labels;
+        /* valid only if the forwarding table could be compiled */
+        IntegerMatchingTable integer_table;
+        bool has_integer_table;
 
         InputMemberValue();
 
         InputMemberValue(
             const char *name,
-            const dds::core::xtypes::DynamicData& data);
+            const dds::core::xtypes::DynamicData& data,
+            const InternalMatchingTable& fwd_table);
         
         void to_string(const dds::core::xtypes::DynamicData& data, std::string& str_out);
+
+        bool to_integer(
+            const dds::core::xtypes::DynamicData& data,
+            int64_t& value_out);
     };
 
     class ByInputValueForwardingEngine : public ForwardingEngine {
     public:
         ByInputValueForwardingEngine(
-            ByInputValueForwardingEngineConfiguration& config);
+            ByInputValueForwardingEngineConfiguration& config,
+            const rti::routing::PropertySet& properties);
 
     protected:
-        std::map<std::string,std::map<std::string,InputMemberValue>> input_members_cache;
+        void parse_tables(
+                const rti::routing::PropertySet& properties,
+                ForwardingTables& tables_out);
+
+        void install_tables(ForwardingTables& tables);
+
+        std::unordered_map<std::string,InputMemberValue> input_members_cache;
         InternalMatchingTable input_members;
 
         void get_forwarding_key(
             rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input,
             const dds::core::xtypes::DynamicData& data,
             std::string& fwd_key_out);
+
+        InternalMatchingTableEntry* find_forwarding_entry(
+            rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input,
+            const dds::core::xtypes::DynamicData& data);
         
         InputMemberValue& cache_input_member(
             rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input,
             const dds::core::xtypes::DynamicData& data);
-        
-        std::map<std::string,InputMemberValue>& get_input_map(
-            rti::routing::processor::TypedInput<dds::core::xtypes::DynamicData>& input);
     };
 
     class ByInputNameForwardingEnginePlugin :
@@ -139,6 +447,7 @@ namespace rti { namespace prcs { namespace fwd {
                 rti::routing::processor::Processor *processor) override;
 
         ByInputNameForwardingEnginePlugin(const rti::routing::PropertySet&);
+        ~ByInputNameForwardingEnginePlugin();
     };
 
     class ByInputValueForwardingEnginePlugin :
@@ -154,6 +463,7 @@ namespace rti { namespace prcs { namespace fwd {
                 rti::routing::processor::Processor *processor) override;
 
         ByInputValueForwardingEnginePlugin(const rti::routing::PropertySet&);
+        ~ByInputValueForwardingEnginePlugin();
     };
 
 } // namespace fwd
@@ -27,7 +27,9 @@
 #define RTI_PRCS_FWD_USE_LOG                    1
 #endif
 
-#ifndef RTI_PRCS_FWD_ENABLE_TRACE
+/* Trace messages, including function calls, are never compiled in a
+   release build, even if RTI_PRCS_FWD_ENABLE_TRACE is defined */
+#if !defined(RTI_PRCS_FWD_ENABLE_TRACE) || defined(NDEBUG)
 #define RTI_PRCS_FWD_USE_TRACE                  0
 #else
 #define RTI_PRCS_FWD_USE_TRACE                  1
@@ -36,6 +38,62 @@
 #define RTI_PRCS_FWD_XSTR(x_)           #x_
 #define RTI_PRCS_FWD_STRINGIFY(x_)      RTI_PRCS_FWD_XSTR(x_)
 
+/*****************************************************************************
+ *
+ *****************************************************************************/
+
+/*
+ * Messages which are compiled in are filtered at run-time against a cached
+ * verbosity level. A filtered message only costs a comparison with the
+ * level, and its arguments are never formatted. The level is loaded when
+ * the plugin is created, from the RTI_PRCS_FWD_LOG_LEVEL environment
+ * variable.
+ */
+#define RTI_PRCS_FWD_LOG_LEVEL_SILENT           0
+#define RTI_PRCS_FWD_LOG_LEVEL_ERROR            1
+#define RTI_PRCS_FWD_LOG_LEVEL_WARNING          2
+#define RTI_PRCS_FWD_LOG_LEVEL_INFO             3
+#define RTI_PRCS_FWD_LOG_LEVEL_TRACE            4
+
+#define RTI_PRCS_FWD_LOG_LEVEL_ENV              "RTI_PRCS_FWD_LOG_LEVEL"
+
+#define RTI_PRCS_FWD_LOG_ASYNC_ENV              "RTI_PRCS_FWD_LOG_ASYNC"
+
+#if RTI_PRCS_FWD_USE_TRACE
+#define RTI_PRCS_FWD_LOG_LEVEL_DEFAULT          RTI_PRCS_FWD_LOG_LEVEL_TRACE
+#else
+#define RTI_PRCS_FWD_LOG_LEVEL_DEFAULT          RTI_PRCS_FWD_LOG_LEVEL_INFO
+#endif
+
+extern int RTI_PRCS_FWD_Log_level;
+
+/*
+ * Load the verbosity level from the environment, and start the asynchronous
+ * backend if it is enabled. The level can be one of SILENT, ERROR, WARNING,
+ * INFO or TRACE. Plugins call this function when they are created, and
+ * RTI_PRCS_FWD_Log_finalize() when they are deleted.
+ */
+void
+RTI_PRCS_FWD_Log_initialize(void);
+
+void
+RTI_PRCS_FWD_Log_finalize(void);
+
+/*
+ * Write a message to the log. Messages are written to stdout by the calling
+ * thread, unless the RTI_PRCS_FWD_LOG_ASYNC environment variable is set to
+ * the path of a file, or to "stdout". In that case, route threads store
+ * `fmt`, which must outlive the plugin (the logging macros pass literals),
+ * and a copy of its arguments in a lock-free ring, and a background thread
+ * formats and writes the messages. Messages which don't fit in the ring are
+ * dropped, and counted.
+ */
+void
+RTI_PRCS_FWD_Log_printf(const char *fmt, ...);
+
+#define RTI_PRCS_FWD_LOG_ENABLED(lvl_) \
+    (RTI_PRCS_FWD_Log_level >= (lvl_))
+
 /*****************************************************************************
  *
  *****************************************************************************/
@@ -55,100 +113,149 @@
 #if RTI_PRCS_FWD_USE_LOG
 
 #define RTI_PRCS_FWD_LOG(msg_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s\n", RTI_PRCS_FWD_LOG_ARGS, (msg_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s\n", RTI_PRCS_FWD_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_1(msg_,fmt_,a1_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_2(msg_,fmt_,a1_,a2_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_3(msg_,fmt_,a1_,a2_,a3_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_4(msg_,fmt_,a1_,a2_,a3_,a4_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_5(msg_,fmt_,a1_,a2_,a3_,a4_,a5_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_6(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_7(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_8(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_9(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), (a9_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), (a9_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_10(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_11(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_12(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_13(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_,a13_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_), \
-            (a13_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_), \
+                (a13_)); \
+    }
 
 #define RTI_PRCS_FWD_LOG_16(msg_,fmt_,\
                    a1_,a2_,a3_,a4_,\
                    a5_,a6_,a7_,a8_,\
                    a9_,a10_,a11_,a12_,\
                    a13_,a14_,a15_,a16_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_), \
-            (a13_), (a14_), (a15_), (a16_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_INFO)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_), \
+                (a13_), (a14_), (a15_), (a16_)); \
+    }
 
 #define RTI_PRCS_FWD_WARNING(msg_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_WARNING "%s\n", RTI_PRCS_FWD_LOG_ARGS, (msg_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_WARNING)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_WARNING "%s\n", RTI_PRCS_FWD_LOG_ARGS, (msg_)); \
+    }
+
+#define RTI_PRCS_FWD_WARNING_2(msg_,fmt_,a1_,a2_) \
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_WARNING)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_WARNING "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_PRCS_FWD_ERROR(msg_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_ERROR "%s\n", RTI_PRCS_FWD_LOG_ARGS, (msg_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_ERROR)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_ERROR "%s\n", RTI_PRCS_FWD_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_PRCS_FWD_ERROR_1(msg_,fmt_,a1_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_ERROR)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_)); \
+    }
 
 #define RTI_PRCS_FWD_ERROR_2(msg_,fmt_,a1_,a2_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_ERROR)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_PRCS_FWD_ERROR_3(msg_,fmt_,a1_,a2_,a3_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_), (a3_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_ERROR)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_), (a3_)); \
+    }
 
 #define RTI_PRCS_FWD_ERROR_4(msg_,fmt_,a1_,a2_,a3_,a4_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_ERROR)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_)); \
+    }
 
 #define RTI_PRCS_FWD_ERROR_5(msg_,fmt_,a1_,a2_,a3_,a4_,a5_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_), (a5_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_ERROR)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_), (a5_)); \
+    }
 
 #else
 
@@ -172,6 +279,7 @@
                    a9_,a10_,a11_,a12_,\
                    a13_,a14_,a15_,a16_)
 #define RTI_PRCS_FWD_WARNING(msg_)
+#define RTI_PRCS_FWD_WARNING_2(msg_,fmt_,a1_,a2_)
 #define RTI_PRCS_FWD_ERROR(msg_)
 #define RTI_PRCS_FWD_ERROR_1(msg_,fmt_,a1_)
 #define RTI_PRCS_FWD_ERROR_2(msg_,fmt_,a1_,a2_)
@@ -194,62 +302,90 @@
 #if RTI_PRCS_FWD_USE_TRACE
 
 #define RTI_PRCS_FWD_TRACE(msg_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s\n",RTI_PRCS_FWD_LOG_ARGS, (msg_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s\n",RTI_PRCS_FWD_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_1(msg_,fmt_,a1_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_2(msg_,fmt_,a1_,a2_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_3(msg_,fmt_,a1_,a2_,a3_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_4(msg_,fmt_,a1_,a2_,a3_,a4_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_5(msg_,fmt_,a1_,a2_,a3_,a4_,a5_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_6(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_7(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_8(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_9(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_10(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_11(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_), (a11_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_), (a11_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_12(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_)); \
+    }
 
 #define RTI_PRCS_FWD_TRACE_13(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_,a13_) \
-    fprintf(stdout,RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_), \
-            (a13_));
+    if (RTI_PRCS_FWD_LOG_ENABLED(RTI_PRCS_FWD_LOG_LEVEL_TRACE)) { \
+        RTI_PRCS_FWD_Log_printf(RTI_PRCS_FWD_LOG_HEAD "%s " fmt_ "\n", RTI_PRCS_FWD_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_), \
+                (a13_)); \
+    }
 
 #else
 
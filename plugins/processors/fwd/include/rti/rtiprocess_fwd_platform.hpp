@@ -13,10 +13,33 @@
 #ifndef rtiprocess_fwd_platform_hpp
 #define rtiprocess_fwd_platform_hpp
 
+#include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <type_traits>
+#include <algorithm>
+#include <set>
+#include <limits>
+#include <cerrno>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(_MSC_VER) || defined(WIN32)
+#include <malloc.h>
+#endif
+
 #include <dds/core/corefwd.hpp>
 #include <rti/routing/processor/ProcessorPlugin.hpp>
 #include <rti/routing/processor/Processor.hpp>
 #include <dds/core/xtypes/DynamicData.hpp>
+#include <dds/core/xtypes/StructType.hpp>
+#include <dds/core/xtypes/EnumType.hpp>
 #include <rti/core/xtypes/DynamicDataMemberInfo.hpp>
 
 #include <rtiprocess_fwd_types.hpp>
@@ -20,9 +20,19 @@ namespace rti { namespace prcs { namespace fwd { namespace property {
     extern const std::string PREFIX;
     extern const std::string FORWARDING_TABLE;
     extern const std::string INPUT_MEMBERS_TABLE;
+    extern const std::string METRICS_FILE;
+    extern const std::string METRICS_PERIOD_MS;
+    extern const uint32_t METRICS_PERIOD_MS_DEFAULT;
 
     extern const std::string FORWARDING_TABLE_KEY_IN_KEY;
     extern const std::string FORWARDING_TABLE_KEY_OUT_NAME;
+    extern const std::string FORWARDING_TABLE_KEY_RANGE;
+    extern const std::string FORWARDING_TABLE_KEY_VALUES;
+    extern const std::string FORWARDING_TABLE_KEY_FILTER;
+
+    extern const std::string FILTER_KEY_MEMBER;
+    extern const std::string FILTER_KEY_OPERATOR;
+    extern const std::string FILTER_KEY_VALUE;
 
     extern const std::string INPUT_MEMBERS_TABLE_KEY_IN_KEY;
     extern const std::string INPUT_MEMBERS_TABLE_KEY_OUT_NAME;
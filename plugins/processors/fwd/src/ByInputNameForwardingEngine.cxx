@@ -21,11 +21,27 @@ using namespace rti::routing::adapter;
 using namespace rti::prcs::fwd;
 
 ByInputNameForwardingEngine::ByInputNameForwardingEngine(
-    ByInputNameForwardingEngineConfiguration& config) : ForwardingEngine(config)
+    ByInputNameForwardingEngineConfiguration& config,
+    const PropertySet& properties) : ForwardingEngine(config, properties)
 {
     RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputNameForwardingEngine::ByInputNameForwardingEngine)
 }
 
+void
+ByInputNameForwardingEngine::parse_tables(
+    const PropertySet& properties,
+    ForwardingTables& tables_out)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputNameForwardingEngine::parse_tables)
+
+    ByInputNameForwardingEngineConfiguration config;
+
+    property::parse_config(properties,config);
+
+    tables_out.fwd_table =
+        InternalMatchingTable::from_matching_table(config.fwd_table());
+}
+
 void
 ByInputNameForwardingEngine::get_forwarding_key(
     TypedInput<DynamicData>& input,
@@ -52,7 +68,7 @@ ByInputNameForwardingEnginePlugin::create_processor(
 
     property::parse_config(properties,config);
     
-    return new ByInputNameForwardingEngine(config);
+    return new ByInputNameForwardingEngine(config, properties);
 }
 
 void 
@@ -68,6 +84,15 @@ ByInputNameForwardingEnginePlugin::ByInputNameForwardingEnginePlugin(
     const rti::routing::PropertySet&)
 {
     RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputNameForwardingEnginePlugin::ByInputNameForwardingEnginePlugin)
+
+    RTI_PRCS_FWD_Log_initialize();
+}
+
+ByInputNameForwardingEnginePlugin::~ByInputNameForwardingEnginePlugin()
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputNameForwardingEnginePlugin::~ByInputNameForwardingEnginePlugin)
+
+    RTI_PRCS_FWD_Log_finalize();
 }
 
 struct RTI_RoutingServiceProcessorPlugin *
@@ -33,37 +33,98 @@ const char *InputMemberValue::FORMAT_FLOAT32 = "%f";
 const char *InputMemberValue::FORMAT_FLOAT64 = "%f";
 const char *InputMemberValue::FORMAT_STRING = "%s";
 
+const std::size_t InputMemberValue::FORMAT_BUFFER_MAX_LEN;
+
+/*
+ * Format an integer in decimal notation, producing the same output as the
+ * printf() conversions in FORMAT_*, but without parsing a format string.
+ */
 template<class T>
-std::string
-print_input_field(const std::string& format, const T& val)
+std::size_t
+format_integer_field(char *buffer, std::size_t buffer_len, T val)
 {
-    RTI_PRCS_FWD_LOG_FN(print_input_field)
+    typedef typename std::make_unsigned<T>::type U;
 
-    size_t print_size = snprintf(nullptr, 0, format.c_str(), val);
-    
-    if (print_size <= 0)
+    char digits[24];
+    std::size_t digits_len = 0,
+                len = 0;
+    U uval = static_cast<U>(val);
+
+    if (val < 0)
+    {
+        uval = static_cast<U>(0) - uval;
+    }
+
+    do
+    {
+        digits[digits_len++] = static_cast<char>('0' + (uval % 10));
+        uval /= 10;
+    } while (uval != 0);
+
+    if (digits_len + ((val < 0)? 1 : 0) > buffer_len)
     {
         throw dds::core::InvalidArgumentError("cannot format value");
     }
-    
-    std::unique_ptr<char[]> print_buffer(new char[print_size + 1]); 
 
-    snprintf(print_buffer.get(), print_size + 1, format.c_str(), val);
+    if (val < 0)
+    {
+        buffer[len++] = '-';
+    }
+    while (digits_len > 0)
+    {
+        buffer[len++] = digits[--digits_len];
+    }
+
+    return len;
+}
+
+template<class T>
+std::size_t
+format_float_field(
+    char *buffer,
+    std::size_t buffer_len,
+    const std::string& format,
+    T val)
+{
+    int print_size = snprintf(buffer, buffer_len, format.c_str(), val);
+
+    if (print_size <= 0 || static_cast<std::size_t>(print_size) >= buffer_len)
+    {
+        throw dds::core::InvalidArgumentError("cannot format value");
+    }
 
-    return std::string(
-                print_buffer.get(),
-                print_buffer.get() + print_size);
+    return static_cast<std::size_t>(print_size);
 }
 
 template<class T>
-std::string
+void
 format_primitive_field(
     InputMemberValue *mapping,
-    const DynamicData& data)
+    const DynamicData& data,
+    std::string& str_out)
 {
     RTI_PRCS_FWD_LOG_FN(format_primitive_field)
-    return print_input_field<T>(
-                mapping->string_format, data.value<T>(mapping->name));
+    std::size_t len = format_integer_field<T>(
+                mapping->format_buffer,
+                InputMemberValue::FORMAT_BUFFER_MAX_LEN,
+                data.value<T>(mapping->member_index));
+    str_out.assign(mapping->format_buffer, len);
+}
+
+template<class T>
+void
+format_float_primitive_field(
+    InputMemberValue *mapping,
+    const DynamicData& data,
+    std::string& str_out)
+{
+    RTI_PRCS_FWD_LOG_FN(format_float_primitive_field)
+    std::size_t len = format_float_field<T>(
+                mapping->format_buffer,
+                InputMemberValue::FORMAT_BUFFER_MAX_LEN,
+                mapping->string_format,
+                data.value<T>(mapping->member_index));
+    str_out.assign(mapping->format_buffer, len);
 }
 
 static std::string
@@ -109,6 +170,7 @@ default_input_member_format(const TypeKind& tk)
         input_fmt = InputMemberValue::FORMAT_FLOAT64;
         break;
     case TypeKind::STRING_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
         input_fmt = InputMemberValue::FORMAT_STRING;
         break;
     default:
@@ -118,7 +180,28 @@ default_input_member_format(const TypeKind& tk)
     return input_fmt;
 }
 
+static bool
+is_integer_member_kind(const TypeKind& tk)
+{
+    switch (tk.underlying())
+    {
+    case TypeKind::UINT_8_TYPE:
+    case TypeKind::UINT_16_TYPE:
+    case TypeKind::UINT_32_TYPE:
+    case TypeKind::UINT_64_TYPE:
+    case TypeKind::INT_16_TYPE:
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::INT_64_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        return true;
+    default:
+        return false;
+    }
+}
+
 InputMemberValue::InputMemberValue()
+    : member_index(0),
+      has_integer_table(false)
 {
 
 }
@@ -126,14 +209,102 @@ InputMemberValue::InputMemberValue()
 
 InputMemberValue::InputMemberValue(
     const char *name,
-    const dds::core::xtypes::DynamicData& data)
+    const dds::core::xtypes::DynamicData& data,
+    const InternalMatchingTable& fwd_table)
+    : has_integer_table(false)
 {
     RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::InputMemberValue::InputMemberValue)
 
     this->name = name;
-    this->info.set(data.member_info(this->name));
+    this->member_index = data.member_index(this->name);
+    this->info.set(data.member_info(this->member_index));
     this->string_format =
             default_input_member_format(this->info.get().member_kind());
+
+    if (!is_integer_member_kind(this->info.get().member_kind()))
+    {
+        return;
+    }
+
+    std::unordered_map<std::string,int64_t> enum_values;
+
+    if (this->info.get().member_kind() == TypeKind::ENUMERATION_TYPE)
+    {
+        const StructType& struct_type =
+                static_cast<const StructType&>(
+                    rti::core::xtypes::resolve_alias(data.type()));
+        const EnumType& enum_type =
+                static_cast<const EnumType&>(
+                    rti::core::xtypes::resolve_alias(
+                        struct_type.member(this->name).type()));
+
+        for (uint32_t i = 0; i < enum_type.member_count(); i++)
+        {
+            const EnumMember& enum_member = enum_type.member(i);
+            enum_values[enum_member.name()] = enum_member.ordinal();
+            this->enum_labels[enum_member.ordinal()] = enum_member.name();
+        }
+    }
+
+    /* Tables containing patterns still require the value to be formatted
+       and matched as a string */
+    this->has_integer_table = this->integer_table.compile(
+            fwd_table,
+            (this->enum_labels.empty())? nullptr : &enum_values);
+
+    RTI_PRCS_FWD_LOG_2("input member VALUE:", "member=%s, integer_table=%d",
+        this->name.c_str(), this->has_integer_table)
+}
+
+bool
+InputMemberValue::to_integer(const DynamicData& data, int64_t& value_out)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::InputMemberValue::to_integer)
+
+    if (!data.member_exists(this->member_index))
+    {
+        throw dds::core::InvalidArgumentError(
+                        "input member not found in sample: "+this->name);
+    }
+
+    switch (this->info.get().member_kind().underlying())
+    {
+    case TypeKind::UINT_8_TYPE:
+        value_out = data.value<uint8_t>(this->member_index);
+        break;
+    case TypeKind::UINT_16_TYPE:
+        value_out = data.value<uint16_t>(this->member_index);
+        break;
+    case TypeKind::UINT_32_TYPE:
+        value_out = data.value<uint32_t>(this->member_index);
+        break;
+    case TypeKind::UINT_64_TYPE:
+    {
+        uint64_t value = data.value<uint64_t>(this->member_index);
+        if (value > static_cast<uint64_t>(
+                        std::numeric_limits<int64_t>::max()))
+        {
+            /* can only be matched as a string */
+            return false;
+        }
+        value_out = static_cast<int64_t>(value);
+        break;
+    }
+    case TypeKind::INT_16_TYPE:
+        value_out = data.value<int16_t>(this->member_index);
+        break;
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        value_out = data.value<int32_t>(this->member_index);
+        break;
+    case TypeKind::INT_64_TYPE:
+        value_out = data.value<int64_t>(this->member_index);
+        break;
+    default:
+        return false;
+    }
+
+    return true;
 }
 
 void
@@ -141,7 +312,7 @@ InputMemberValue::to_string(const DynamicData& data, std::string& str_out)
 {
     RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::InputMemberValue::to_string)
 
-    if (!data.member_exists(this->name))
+    if (!data.member_exists(this->member_index))
     {
         throw dds::core::InvalidArgumentError(
                         "input member not found in sample: "+this->name);
@@ -156,41 +327,56 @@ InputMemberValue::to_string(const DynamicData& data, std::string& str_out)
     switch (this->info.get().member_kind().underlying())
     {
     case TypeKind::BOOLEAN_TYPE:
-        str_out = format_primitive_field<bool>(this,data);
+        this->format_buffer[0] =
+            (data.value<bool>(this->member_index))? '1' : '0';
+        str_out.assign(this->format_buffer, 1);
         break;
     case TypeKind::UINT_8_TYPE:
-        str_out = format_primitive_field<uint8_t>(this,data);
+        format_primitive_field<uint8_t>(this,data,str_out);
         break;
     case TypeKind::UINT_16_TYPE:
-        str_out = format_primitive_field<uint16_t>(this,data);
+        format_primitive_field<uint16_t>(this,data,str_out);
         break;
     case TypeKind::UINT_32_TYPE:
-        str_out = format_primitive_field<uint32_t>(this,data);
+        format_primitive_field<uint32_t>(this,data,str_out);
         break;
     case TypeKind::UINT_64_TYPE:
-        str_out = format_primitive_field<uint64_t>(this,data);
+        format_primitive_field<uint64_t>(this,data,str_out);
         break;
     case TypeKind::CHAR_8_TYPE:
-        str_out = format_primitive_field<char>(this,data);
+        this->format_buffer[0] = data.value<char>(this->member_index);
+        str_out.assign(this->format_buffer, 1);
         break;
     case TypeKind::INT_16_TYPE:
-        str_out = format_primitive_field<int16_t>(this,data);
+        format_primitive_field<int16_t>(this,data,str_out);
         break;
     case TypeKind::INT_32_TYPE:
-        str_out = format_primitive_field<int32_t>(this,data);
+        format_primitive_field<int32_t>(this,data,str_out);
         break;
     case TypeKind::INT_64_TYPE:
-        str_out = format_primitive_field<int64_t>(this,data);
+        format_primitive_field<int64_t>(this,data,str_out);
         break;
     case TypeKind::FLOAT_32_TYPE:
-        str_out = format_primitive_field<float>(this,data);
+        format_float_primitive_field<float>(this,data,str_out);
         break;
     case TypeKind::FLOAT_64_TYPE:
-        str_out = format_primitive_field<double>(this,data);
+        format_float_primitive_field<double>(this,data,str_out);
         break;
     case TypeKind::STRING_TYPE:
-        str_out = data.value<std::string>(this->name);
+        str_out = data.value<std::string>(this->member_index);
+        break;
+    case TypeKind::ENUMERATION_TYPE:
+    {
+        auto label_it =
+            this->enum_labels.find(data.value<int32_t>(this->member_index));
+        if (label_it == this->enum_labels.end())
+        {
+            throw dds::core::InvalidArgumentError(
+                    "unknown enumerator for input member: "+this->name);
+        }
+        str_out = label_it->second;
         break;
+    }
     default:
         /* Should never get here */
         throw dds::core::InvalidArgumentError("unexpected input member type");
@@ -199,7 +385,8 @@ InputMemberValue::to_string(const DynamicData& data, std::string& str_out)
 }
 
 ByInputValueForwardingEngine::ByInputValueForwardingEngine(
-    ByInputValueForwardingEngineConfiguration& config) : ForwardingEngine(config)
+    ByInputValueForwardingEngineConfiguration& config,
+    const PropertySet& properties) : ForwardingEngine(config, properties)
 {
     RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputValueForwardingEngine::ByInputValueForwardingEngine)
 
@@ -207,6 +394,34 @@ ByInputValueForwardingEngine::ByInputValueForwardingEngine(
         InternalMatchingTable::from_matching_table(config.input_members());
 }
 
+void
+ByInputValueForwardingEngine::parse_tables(
+    const PropertySet& properties,
+    ForwardingTables& tables_out)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputValueForwardingEngine::parse_tables)
+
+    ByInputValueForwardingEngineConfiguration config;
+
+    property::parse_config(properties,config);
+
+    tables_out.fwd_table =
+        InternalMatchingTable::from_matching_table(config.fwd_table());
+    tables_out.input_members =
+        InternalMatchingTable::from_matching_table(config.input_members());
+}
+
+void
+ByInputValueForwardingEngine::install_tables(ForwardingTables& tables)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputValueForwardingEngine::install_tables)
+
+    ForwardingEngine::install_tables(tables);
+    input_members = std::move(tables.input_members);
+    /* the integer tables of each member were compiled from fwd_table */
+    input_members_cache.clear();
+}
+
 void
 ByInputValueForwardingEngine::get_forwarding_key(
     TypedInput<DynamicData>& input,
@@ -222,22 +437,33 @@ ByInputValueForwardingEngine::get_forwarding_key(
         input.name().c_str(), data, fwd_key_out.c_str())
 }
 
-std::map<std::string,InputMemberValue>&
-ByInputValueForwardingEngine::get_input_map(
-    TypedInput<dds::core::xtypes::DynamicData>& input)
+InternalMatchingTableEntry*
+ByInputValueForwardingEngine::find_forwarding_entry(
+    TypedInput<DynamicData>& input,
+    const DynamicData& data)
 {
-    const std::string& in_name = input.name();
-    std::map<std::string,std::map<std::string,InputMemberValue>>::const_iterator
-        input_it = input_members_cache.find(in_name);
-    
-    if (input_it == input_members_cache.end())
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputValueForwardingEngine::find_forwarding_entry)
+
+    InputMemberValue& mem_value = cache_input_member(input, data);
+    int64_t value = 0;
+
+    if (!mem_value.has_integer_table || !mem_value.to_integer(data, value))
     {
-        /* no entry for this input, create one */
-        std::map<std::string,InputMemberValue> in_map;
-        input_members_cache[in_name] =  in_map;
+        mem_value.to_string(data, fwd_key);
+        return fwd_table.lookup(fwd_key);
     }
 
-    return input_members_cache[in_name];
+    std::size_t entry_i = mem_value.integer_table.find(value);
+
+    RTI_PRCS_FWD_TRACE_3("forwarding VALUE:","input=%s, value=%lld, entry=%ld",
+        input.name().c_str(), static_cast<long long>(value),
+        static_cast<long>(entry_i))
+
+    if (entry_i == InternalMatchingTable::NO_ENTRY)
+    {
+        return nullptr;
+    }
+    return &fwd_table.entries[entry_i];
 }
 
 InputMemberValue&
@@ -245,24 +471,23 @@ ByInputValueForwardingEngine::cache_input_member(
     TypedInput<dds::core::xtypes::DynamicData>& input,
     const dds::core::xtypes::DynamicData& data)
 {
-    std::map<std::string,InputMemberValue>& in_map = get_input_map(input);
-
-    InternalMatchingTableEntry& in_mem_entry =
-        input_members.find(input.name().c_str());
+    const std::string& in_name = input.name();
+    std::unordered_map<std::string,InputMemberValue>::iterator in_mem_it =
+        input_members_cache.find(in_name);
 
-    std::map<std::string,InputMemberValue>::iterator in_mem_it =
-        in_map.find(in_mem_entry.out_name);
-    
-    if (in_mem_it != in_map.end())
+    if (in_mem_it != input_members_cache.end())
     {
         /* input already cached */
         return in_mem_it->second;
     }
 
-    InputMemberValue mem_entry(in_mem_entry.out_name.c_str(), data);
-    in_map[in_mem_entry.out_name] = mem_entry;
+    /* Resolve the member configured for this input only once, since the
+       type of its samples cannot change */
+    InternalMatchingTableEntry& in_mem_entry = input_members.find(in_name);
+
+    InputMemberValue mem_entry(in_mem_entry.out_name.c_str(), data, fwd_table);
 
-    return in_map[in_mem_entry.out_name];
+    return input_members_cache.emplace(in_name, mem_entry).first->second;
 }
 
 Processor* 
@@ -276,7 +501,7 @@ ByInputValueForwardingEnginePlugin::create_processor(
 
     property::parse_config(properties,config);
     
-    return new ByInputValueForwardingEngine(config);
+    return new ByInputValueForwardingEngine(config, properties);
 }
 
 void 
@@ -292,6 +517,15 @@ ByInputValueForwardingEnginePlugin::ByInputValueForwardingEnginePlugin(
     const rti::routing::PropertySet&)
 {
     RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputValueForwardingEnginePlugin::ByInputValueForwardingEnginePlugin)
+
+    RTI_PRCS_FWD_Log_initialize();
+}
+
+ByInputValueForwardingEnginePlugin::~ByInputValueForwardingEnginePlugin()
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ByInputValueForwardingEnginePlugin::~ByInputValueForwardingEnginePlugin)
+
+    RTI_PRCS_FWD_Log_finalize();
 }
 
 struct RTI_RoutingServiceProcessorPlugin *
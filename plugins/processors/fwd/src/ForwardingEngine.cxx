@@ -23,20 +23,125 @@ using namespace rti::routing::adapter;
 using namespace rti::prcs::fwd;
 
 
+const std::size_t InternalMatchingTable::MAX_CACHED_KEYS = 1024;
+const std::size_t InternalMatchingTable::NO_ENTRY =
+        static_cast<std::size_t>(-1);
+
+const std::size_t IntegerMatchingTable::MAX_DENSE_LEN = 4096;
+
+/*
+ * Parse a key which contains only a decimal integer, written the way it
+ * is printed: an optional '-', and no '+', whitespace or leading zeros.
+ * Any other spelling (e.g. " 7", "+7", "07" or "-0") must keep being
+ * compared as a string, or it would match the same values as "7" or "0".
+ */
+static bool
+parse_integer_key(const char *in_key, int64_t& value_out)
+{
+    char *end = nullptr;
+    const char *digits = (*in_key == '-') ? in_key + 1 : in_key;
+
+    if (*digits < '0' || *digits > '9')
+    {
+        return false;
+    }
+    if (*digits == '0' && (digits[1] != '\0' || digits != in_key))
+    {
+        return false;
+    }
+    for (const char *c = digits; *c != '\0'; c++)
+    {
+        if (*c < '0' || *c > '9')
+        {
+            return false;
+        }
+    }
+    errno = 0;
+    long long value = strtoll(in_key, &end, 10);
+    if (errno != 0 || *end != '\0')
+    {
+        return false;
+    }
+    value_out = static_cast<int64_t>(value);
+    return true;
+}
+
 InternalMatchingTableEntry::InternalMatchingTableEntry(
     const char *in_key,
     const char *out_name)
+    : kind(MatchingTableEntryKind::KEY),
+      range_min(0),
+      range_max(0)
 {
     this->in_key = in_key;
     this->out_name = out_name;
+    this->out_names.push_back(this->out_name);
+    /* Any of the characters interpreted by REDAString_fnmatch */
+    this->is_glob =
+        (std::string::npos != this->in_key.find_first_of("*?[\\"));
+
+    RTI_PRCS_FWD_LOG_3("new MATCH entry:",
+        "in_key=%s, out_name=%s, glob=%d", in_key, out_name, this->is_glob)
+}
+
+InternalMatchingTableEntry::InternalMatchingTableEntry(
+    const MatchingTableEntry& entry)
+    : kind(entry.kind()),
+      in_key(entry.in_key()),
+      out_name(entry.out_name()),
+      is_glob(false),
+      range_min(entry.range_min()),
+      range_max(entry.range_max()),
+      values(entry.values().begin(), entry.values().end()),
+      out_names(entry.out_names().begin(), entry.out_names().end()),
+      filter(entry.filter().begin(), entry.filter().end())
+{
+    std::sort(this->values.begin(), this->values.end());
+    if (this->out_names.empty())
+    {
+        this->out_names.push_back(this->out_name);
+    }
+    if (this->kind == MatchingTableEntryKind::KEY)
+    {
+        this->is_glob =
+            (std::string::npos != this->in_key.find_first_of("*?[\\"));
+    }
 
-    RTI_PRCS_FWD_LOG_2("new MATCH entry:",
-        "in_key=%s, out_name=%s", in_key, out_name)
+    RTI_PRCS_FWD_LOG_4("new MATCH entry:",
+        "kind=%d, range=[%lld,%lld], out_name=%s",
+        static_cast<int>(this->kind),
+        static_cast<long long>(this->range_min),
+        static_cast<long long>(this->range_max),
+        this->out_name.c_str())
+}
+
+bool
+InternalMatchingTableEntry::match(int64_t value) const
+{
+    switch (this->kind)
+    {
+    case MatchingTableEntryKind::INTEGER_RANGE:
+        return (value >= this->range_min && value <= this->range_max);
+    case MatchingTableEntryKind::INTEGER_SET:
+        return std::binary_search(
+                this->values.begin(), this->values.end(), value);
+    default:
+        return false;
+    }
 }
 
 bool
 InternalMatchingTableEntry::match(const char *in_key)
 {
+    if (this->kind != MatchingTableEntryKind::KEY)
+    {
+        int64_t value = 0;
+        return (parse_integer_key(in_key, value) && match(value));
+    }
+    if (!this->is_glob)
+    {
+        return (this->in_key == in_key);
+    }
     if (0 == REDAString_fnmatch(this->in_key.c_str(), in_key, 0))
     {
         return true;
@@ -47,40 +152,519 @@ InternalMatchingTableEntry::match(const char *in_key)
     }
 }
 
-InternalMatchingTableEntry&
-InternalMatchingTable::find(const char *in_key)
+std::size_t
+InternalMatchingTable::resolve(const std::string& in_key)
+{
+    std::size_t resolved = NO_ENTRY;
+
+    auto literal_it = literal_entries.find(in_key);
+    if (literal_it != literal_entries.end())
+    {
+        resolved = literal_it->second;
+    }
+
+    /* A literal entry is the first match, unless it is preceded by a
+       pattern which also matches the key */
+    for (std::size_t glob_i : glob_entries)
+    {
+        if (glob_i >= resolved)
+        {
+            break;
+        }
+        if (entries[glob_i].match(in_key.c_str()))
+        {
+            resolved = glob_i;
+            break;
+        }
+    }
+
+    return resolved;
+}
+
+InternalMatchingTableEntry*
+InternalMatchingTable::lookup(const std::string& in_key)
 {
+    std::size_t resolved = NO_ENTRY;
+
+    auto literal_it = literal_entries.find(in_key);
+    if (literal_it != literal_entries.end() &&
+        (glob_entries.empty() || literal_it->second < glob_entries.front()))
+    {
+        /* No pattern precedes the literal entry */
+        return &entries[literal_it->second];
+    }
 
-    for (InternalMatchingTableEntry& entry : entries)
+    auto cached_it = resolved_keys.find(in_key);
+    if (cached_it != resolved_keys.end())
     {
-        if (entry.match(in_key))
+        resolved = cached_it->second;
+    }
+    else
+    {
+        resolved = resolve(in_key);
+        /* Evict a single key to make room, so that a burst of new keys
+           doesn't also throw away the resolution of every hot key */
+        if (resolved_keys.size() >= MAX_CACHED_KEYS)
         {
-            return entry;
+            resolved_keys.erase(resolved_keys.begin());
         }
+        resolved_keys.emplace(in_key, resolved);
+    }
+
+    if (resolved == NO_ENTRY)
+    {
+        return nullptr;
+    }
+
+    return &entries[resolved];
+}
+
+InternalMatchingTableEntry&
+InternalMatchingTable::find(const std::string& in_key)
+{
+    InternalMatchingTableEntry *entry = lookup(in_key);
+
+    if (entry == nullptr)
+    {
+        throw dds::core::InvalidArgumentError(
+                    "no entry found for key: "+in_key);
     }
-    
-    std::string in_key_str = in_key;
-    throw dds::core::InvalidArgumentError(
-                "no entry found for key: "+in_key_str);
+
+    return *entry;
+}
+
+InternalMatchingTableEntry&
+InternalMatchingTable::find(const char *in_key)
+{
+    return find(std::string(in_key));
 }
 
 InternalMatchingTableEntry&
 InternalMatchingTable::add(const char *in_key, const char *out_name)
 {
-    try
+    return add(InternalMatchingTableEntry(in_key, out_name));
+}
+
+InternalMatchingTableEntry&
+InternalMatchingTable::add(const MatchingTableEntry& entry)
+{
+    return add(InternalMatchingTableEntry(entry));
+}
+
+InternalMatchingTableEntry&
+InternalMatchingTable::add(const InternalMatchingTableEntry& entry)
+{
+    if (entry.kind == MatchingTableEntryKind::KEY)
+    {
+        try
+        {
+            InternalMatchingTableEntry& cur_entry = find(entry.in_key);
+            cur_entry.out_name = entry.out_name;
+            cur_entry.out_names = entry.out_names;
+            cur_entry.filter = entry.filter;
+            return cur_entry;
+        }
+        catch(...)
+        {
+            /* no entry for this key yet */
+        }
+    }
+
+    std::size_t entry_i = entries.size();
+
+    entries.push_back(entry);
+    /* Entries matching integer values are always matched in order, by
+       parsing the key, like patterns */
+    if (entry.is_glob || entry.kind != MatchingTableEntryKind::KEY)
+    {
+        glob_entries.push_back(entry_i);
+    }
+    else
+    {
+        literal_entries.emplace(entry.in_key, entry_i);
+    }
+    /* Keys which didn't match any entry might match the new one */
+    resolved_keys.clear();
+
+    return entries.back();
+}
+
+IntegerMatchingTable::IntegerMatchingTable()
+    : dense_min(0)
+{
+
+}
+
+bool
+IntegerMatchingTable::compile(
+    const InternalMatchingTable& table,
+    const std::unordered_map<std::string,int64_t> *enum_values)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::IntegerMatchingTable::compile)
+
+    std::vector<IntegerMatchingSegment> ranges;
+
+    segments.clear();
+    dense.clear();
+
+    for (std::size_t i = 0; i < table.entries.size(); i++)
+    {
+        const InternalMatchingTableEntry& entry = table.entries[i];
+        int64_t value = 0;
+
+        switch (entry.kind)
+        {
+        case MatchingTableEntryKind::INTEGER_RANGE:
+            ranges.push_back({ entry.range_min, entry.range_max, i });
+            break;
+        case MatchingTableEntryKind::INTEGER_SET:
+            for (int64_t set_value : entry.values)
+            {
+                ranges.push_back({ set_value, set_value, i });
+            }
+            break;
+        default:
+            if (entry.is_glob)
+            {
+                return false;
+            }
+            if (enum_values != nullptr)
+            {
+                auto enum_it = enum_values->find(entry.in_key);
+                if (enum_it != enum_values->end())
+                {
+                    value = enum_it->second;
+                }
+                else if (!parse_integer_key(entry.in_key.c_str(), value))
+                {
+                    return false;
+                }
+            }
+            else if (!parse_integer_key(entry.in_key.c_str(), value))
+            {
+                return false;
+            }
+            ranges.push_back({ value, value, i });
+            break;
+        }
+    }
+
+    /* Sweep the ranges in order of their bounds. Between two consecutive
+       bounds the set of active ranges doesn't change, and the one which
+       comes first in the table is the entry matching that segment. */
+    const int64_t max_value = std::numeric_limits<int64_t>::max();
+    std::vector<IntegerMatchingSegment> starts(ranges), ends(ranges);
+    std::multiset<std::size_t> active;
+    std::size_t start_i = 0,
+                end_i = 0;
+    int64_t pos = 0;
+
+    std::sort(starts.begin(), starts.end(),
+        [](const IntegerMatchingSegment& a, const IntegerMatchingSegment& b) {
+            return a.min < b.min;
+        });
+    std::sort(ends.begin(), ends.end(),
+        [](const IntegerMatchingSegment& a, const IntegerMatchingSegment& b) {
+            return a.max < b.max;
+        });
+
+    while (start_i < starts.size() || !active.empty())
+    {
+        if (active.empty())
+        {
+            pos = starts[start_i].min;
+        }
+        while (start_i < starts.size() && starts[start_i].min == pos)
+        {
+            active.insert(starts[start_i].entry);
+            start_i++;
+        }
+
+        int64_t seg_max = ends[end_i].max;
+        if (start_i < starts.size() && starts[start_i].min - 1 < seg_max)
+        {
+            seg_max = starts[start_i].min - 1;
+        }
+
+        IntegerMatchingSegment segment = { pos, seg_max, *active.begin() };
+        if (!segments.empty() &&
+            segments.back().entry == segment.entry &&
+            segments.back().max + 1 == segment.min)
+        {
+            segments.back().max = segment.max;
+        }
+        else
+        {
+            segments.push_back(segment);
+        }
+
+        while (end_i < ends.size() && ends[end_i].max == seg_max)
+        {
+            active.erase(active.find(ends[end_i].entry));
+            end_i++;
+        }
+        if (seg_max == max_value)
+        {
+            break;
+        }
+        pos = seg_max + 1;
+    }
+
+    if (!segments.empty() &&
+        static_cast<uint64_t>(segments.back().max) -
+            static_cast<uint64_t>(segments.front().min) < MAX_DENSE_LEN)
+    {
+        dense_min = segments.front().min;
+        dense.assign(
+            static_cast<std::size_t>(segments.back().max - dense_min) + 1,
+            InternalMatchingTable::NO_ENTRY);
+        for (const IntegerMatchingSegment& segment : segments)
+        {
+            for (int64_t v = segment.min; v <= segment.max; v++)
+            {
+                dense[static_cast<std::size_t>(v - dense_min)] = segment.entry;
+            }
+        }
+    }
+
+    RTI_PRCS_FWD_LOG_2("compiled INTEGER table:","segments=%u, dense=%u",
+        static_cast<unsigned int>(segments.size()),
+        static_cast<unsigned int>(dense.size()))
+
+    return true;
+}
+
+std::size_t
+IntegerMatchingTable::find(int64_t value) const
+{
+    if (!dense.empty())
+    {
+        if (value < dense_min ||
+            static_cast<uint64_t>(value) - static_cast<uint64_t>(dense_min)
+                >= dense.size())
+        {
+            return InternalMatchingTable::NO_ENTRY;
+        }
+        return dense[static_cast<std::size_t>(value - dense_min)];
+    }
+
+    /* find the last segment starting at, or before, the value */
+    auto segment_it = std::upper_bound(
+            segments.begin(),
+            segments.end(),
+            value,
+            [](int64_t v, const IntegerMatchingSegment& segment) {
+                return v < segment.min;
+            });
+    if (segment_it == segments.begin())
     {
-        InternalMatchingTableEntry& cur_entry = find(in_key);
-        cur_entry.out_name = out_name;
-        return cur_entry;
+        return InternalMatchingTable::NO_ENTRY;
     }
-    catch(...)
+    --segment_it;
+    if (value > segment_it->max)
+    {
+        return InternalMatchingTable::NO_ENTRY;
+    }
+    return segment_it->entry;
+}
+
+
+template<class T>
+static int
+compare_values(const T& a, const T& b)
+{
+    return (a < b)? -1 : ((b < a)? 1 : 0);
+}
+
+static int64_t
+read_integer_member(
+    const DynamicData& data,
+    uint32_t member_index,
+    TypeKind::type member_kind)
+{
+    switch (member_kind)
     {
-        InternalMatchingTableEntry entry(in_key, out_name);
-        entries.push_back(entry);
-        return entries.back();
+    case TypeKind::BOOLEAN_TYPE:
+        return (data.value<bool>(member_index))? 1 : 0;
+    case TypeKind::CHAR_8_TYPE:
+        return data.value<char>(member_index);
+    case TypeKind::UINT_8_TYPE:
+        return data.value<uint8_t>(member_index);
+    case TypeKind::UINT_16_TYPE:
+        return data.value<uint16_t>(member_index);
+    case TypeKind::UINT_32_TYPE:
+        return data.value<uint32_t>(member_index);
+    case TypeKind::INT_16_TYPE:
+        return data.value<int16_t>(member_index);
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::ENUMERATION_TYPE:
+        return data.value<int32_t>(member_index);
+    case TypeKind::INT_64_TYPE:
+        return data.value<int64_t>(member_index);
+    default:
+        /* Should never get here */
+        throw dds::core::InvalidArgumentError("unexpected filter member type");
     }
 }
 
+FilterPredicate::FilterPredicate(
+    const FilterCondition& condition,
+    const DynamicData& data)
+    : member_index(data.member_index(condition.member())),
+      member_kind(data.member_info(member_index).member_kind().underlying()),
+      op(condition.op()),
+      value_kind(condition.value_kind()),
+      integer_value(condition.integer_value()),
+      float_value(condition.float_value()),
+      string_value(condition.string_value())
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::FilterPredicate::FilterPredicate)
+
+    switch (member_kind)
+    {
+    case TypeKind::STRING_TYPE:
+        if (value_kind != FilterValueKind::STRING_VALUE)
+        {
+            throw dds::core::InvalidArgumentError(
+                "string members can only be compared to strings: " +
+                    condition.member());
+        }
+        break;
+    case TypeKind::ENUMERATION_TYPE:
+        if (value_kind == FilterValueKind::STRING_VALUE)
+        {
+            /* compare the ordinal of the enumerator with this label */
+            const StructType& struct_type =
+                    static_cast<const StructType&>(
+                        rti::core::xtypes::resolve_alias(data.type()));
+            const EnumType& enum_type =
+                    static_cast<const EnumType&>(
+                        rti::core::xtypes::resolve_alias(
+                            struct_type.member(condition.member()).type()));
+            bool found = false;
+
+            for (uint32_t i = 0; i < enum_type.member_count() && !found; i++)
+            {
+                const EnumMember& enum_member = enum_type.member(i);
+                if (enum_member.name() == string_value)
+                {
+                    integer_value = enum_member.ordinal();
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                throw dds::core::InvalidArgumentError(
+                    "unknown enumerator in filter: " +
+                        condition.member() + "=" + string_value);
+            }
+            value_kind = FilterValueKind::INTEGER_VALUE;
+        }
+        break;
+    case TypeKind::BOOLEAN_TYPE:
+    case TypeKind::CHAR_8_TYPE:
+    case TypeKind::UINT_8_TYPE:
+    case TypeKind::UINT_16_TYPE:
+    case TypeKind::UINT_32_TYPE:
+    case TypeKind::UINT_64_TYPE:
+    case TypeKind::INT_16_TYPE:
+    case TypeKind::INT_32_TYPE:
+    case TypeKind::INT_64_TYPE:
+    case TypeKind::FLOAT_32_TYPE:
+    case TypeKind::FLOAT_64_TYPE:
+        if (value_kind == FilterValueKind::STRING_VALUE)
+        {
+            throw dds::core::InvalidArgumentError(
+                "numeric members can only be compared to numbers: " +
+                    condition.member());
+        }
+        break;
+    default:
+        throw dds::core::InvalidArgumentError(
+                "unsupported filter member type: " + condition.member());
+    }
+
+    RTI_PRCS_FWD_LOG_3("new FILTER predicate:","member=%s, op=%d, kind=%d",
+        condition.member().c_str(),
+        static_cast<int>(op), static_cast<int>(value_kind))
+}
+
+bool
+FilterPredicate::evaluate(const DynamicData& data) const
+{
+    int cmp = 0;
+
+    if (!data.member_exists(member_index))
+    {
+        return false;
+    }
+
+    switch (member_kind)
+    {
+    case TypeKind::STRING_TYPE:
+        cmp = data.value<std::string>(member_index).compare(string_value);
+        break;
+    case TypeKind::FLOAT_32_TYPE:
+    case TypeKind::FLOAT_64_TYPE:
+    {
+        double value = (member_kind == TypeKind::FLOAT_32_TYPE)?
+                data.value<float>(member_index) :
+                data.value<double>(member_index);
+        cmp = compare_values(value,
+                (value_kind == FilterValueKind::FLOAT_VALUE)?
+                    float_value : static_cast<double>(integer_value));
+        break;
+    }
+    case TypeKind::UINT_64_TYPE:
+    {
+        uint64_t value = data.value<uint64_t>(member_index);
+        if (value_kind == FilterValueKind::FLOAT_VALUE)
+        {
+            cmp = compare_values(static_cast<double>(value), float_value);
+        }
+        else if (integer_value < 0)
+        {
+            cmp = 1;
+        }
+        else
+        {
+            cmp = compare_values(value, static_cast<uint64_t>(integer_value));
+        }
+        break;
+    }
+    default:
+    {
+        int64_t value = read_integer_member(data, member_index, member_kind);
+        if (value_kind == FilterValueKind::FLOAT_VALUE)
+        {
+            cmp = compare_values(static_cast<double>(value), float_value);
+        }
+        else
+        {
+            cmp = compare_values(value, integer_value);
+        }
+        break;
+    }
+    }
+
+    switch (op)
+    {
+    case FilterOperatorKind::EQUAL:
+        return (cmp == 0);
+    case FilterOperatorKind::NOT_EQUAL:
+        return (cmp != 0);
+    case FilterOperatorKind::LESS:
+        return (cmp < 0);
+    case FilterOperatorKind::LESS_OR_EQUAL:
+        return (cmp <= 0);
+    case FilterOperatorKind::GREATER:
+        return (cmp > 0);
+    case FilterOperatorKind::GREATER_OR_EQUAL:
+        return (cmp >= 0);
+    default:
+        return false;
+    }
+}
 
 InternalMatchingTable
 InternalMatchingTable::from_matching_table(const MatchingTable& table)
@@ -91,7 +675,7 @@ InternalMatchingTable::from_matching_table(const MatchingTable& table)
 
     for (auto & entry : table.entries())
     {
-        internal_table.add(entry.in_key().c_str(), entry.out_name().c_str());
+        internal_table.add(entry);
     }
 
     return internal_table;
@@ -109,11 +693,20 @@ ForwardingEngine::on_data_available(Route& route)
 
         try
         {
+            install_pending_tables();
+
             LoanedSamples<DynamicData> samples = input->take();
 
             RTI_PRCS_FWD_TRACE_2("TAKEN samples:","input=%s, samples=%d", 
                     input.name().c_str(), samples.length())
 
+            if (metrics)
+            {
+                cur_input_metrics = find_input_metrics(input);
+                cur_input_metrics->taken.add(samples.length());
+                cur_take_time = std::chrono::steady_clock::now();
+            }
+
             for (auto sample : samples)
             {
                 if (sample.info().valid())
@@ -121,10 +714,14 @@ ForwardingEngine::on_data_available(Route& route)
                     forward_data(route, input, sample.data());
                 }
             }
-            
+
+            /* The queued samples are only valid until the loan is
+               returned */
+            write_queued_data(input);
         }
         catch(const std::exception& e)
         {
+            clear_queued_data();
             RTI_PRCS_FWD_ERROR_2("EXCEPTION processing input:",
                 "input='%s', what='%s'", input.name().c_str(), e.what())
         }
@@ -132,12 +729,179 @@ ForwardingEngine::on_data_available(Route& route)
     }
 }
 
-ForwardingEngine::ForwardingEngine(ForwardingEngineConfiguration& config)
+ForwardingEngine::ForwardingEngine(
+    ForwardingEngineConfiguration& config,
+    const PropertySet& properties)
+    : properties(properties),
+      pending_tables(nullptr),
+      cur_input_metrics(nullptr),
+      unmatched_suppressed(0)
 {
     RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ForwardingEngine::ForwardingEngine)
 
+    if (!config.metrics_file().empty())
+    {
+        this->metrics.reset(new ForwardingMetrics(
+                config.metrics_file(), config.metrics_period_ms()));
+    }
+
     this->fwd_table =
         InternalMatchingTable::from_matching_table(config.fwd_table());
+    this->entry_outputs.resize(this->fwd_table.entries.size());
+}
+
+ForwardingEngine::~ForwardingEngine()
+{
+    delete pending_tables.exchange(nullptr);
+}
+
+void
+ForwardingEngine::update(const PropertySet& properties)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ForwardingEngine::update)
+
+    PropertySet new_properties(this->properties);
+
+    for (const auto& property : properties)
+    {
+        new_properties[property.first] = property.second;
+    }
+
+    /* Parse and build the new tables before touching the current ones,
+       so that an invalid configuration leaves them untouched */
+    std::unique_ptr<ForwardingTables> tables(new ForwardingTables());
+    try
+    {
+        parse_tables(new_properties, *tables);
+    }
+    catch (const std::exception& e)
+    {
+        RTI_PRCS_FWD_ERROR_1("EXCEPTION updating tables:","what='%s'",
+            e.what())
+        throw;
+    }
+
+    this->properties = new_properties;
+
+    RTI_PRCS_FWD_LOG_2("UPDATED tables:","fwd_entries=%ld, member_entries=%ld",
+        static_cast<long>(tables->fwd_table.entries.size()),
+        static_cast<long>(tables->input_members.entries.size()))
+
+    delete pending_tables.exchange(tables.release());
+}
+
+void
+ForwardingEngine::install_pending_tables()
+{
+    /* A relaxed load is enough to detect an update, the exchange
+       synchronizes with the one in update() */
+    if (pending_tables.load(std::memory_order_relaxed) == nullptr)
+    {
+        return;
+    }
+
+    std::unique_ptr<ForwardingTables> tables(pending_tables.exchange(nullptr));
+    if (tables)
+    {
+        install_tables(*tables);
+    }
+}
+
+void
+ForwardingEngine::install_tables(ForwardingTables& tables)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ForwardingEngine::install_tables)
+
+    fwd_table = std::move(tables.fwd_table);
+
+    /* Outputs are still cached by name, only entries must be resolved
+       again. Filters are compiled again for each input. */
+    entry_outputs.clear();
+    entry_outputs.resize(fwd_table.entries.size());
+    input_filters.clear();
+}
+
+const std::vector<std::size_t>&
+ForwardingEngine::resolve_outputs(Route& route, std::size_t entry_i)
+{
+    std::vector<std::size_t>& slots = entry_outputs[entry_i];
+
+    if (!slots.empty())
+    {
+        return slots;
+    }
+
+    for (const std::string& out_name : fwd_table.entries[entry_i].out_names)
+    {
+        std::size_t slot = InternalMatchingTable::NO_ENTRY;
+        auto slot_it = output_slots.find(out_name);
+        if (slot_it != output_slots.end())
+        {
+            /* another entry forwards to the same output */
+            slot = slot_it->second;
+        }
+        else
+        {
+            auto output = route.output<DynamicData>(out_name);
+            slot = outputs.size();
+            outputs.push_back(output);
+            output_queues.push_back(std::vector<const DynamicData*>());
+            output_slots[out_name] = slot;
+
+            RTI_PRCS_FWD_LOG_2("cached OUTPUT:","out=%s, slot=%ld",
+                out_name.c_str(), static_cast<long>(slot))
+        }
+        if (std::find(slots.begin(), slots.end(), slot) == slots.end())
+        {
+            slots.push_back(slot);
+        }
+    }
+
+    return slots;
+}
+
+bool
+ForwardingEngine::filter_data(
+    TypedInput<dds::core::xtypes::DynamicData>& input,
+    std::size_t entry_i,
+    const dds::core::xtypes::DynamicData& data)
+{
+    const InternalMatchingTableEntry& entry = fwd_table.entries[entry_i];
+
+    auto filters_it = input_filters.find(input.name());
+    if (filters_it == input_filters.end())
+    {
+        filters_it = input_filters.emplace(
+                input.name(),
+                std::vector<std::vector<FilterPredicate>>(
+                    fwd_table.entries.size())).first;
+    }
+
+    /* The filter is compiled for the type of this input's samples, the
+       first time it is used. It is only cached once every condition could
+       be compiled: if one of them throws, the sample is dropped and
+       reported by forward_data(), and compilation is tried again on the
+       next sample. */
+    std::vector<FilterPredicate>& predicates = filters_it->second[entry_i];
+    if (predicates.empty())
+    {
+        std::vector<FilterPredicate> compiled;
+        compiled.reserve(entry.filter.size());
+        for (const FilterCondition& condition : entry.filter)
+        {
+            compiled.push_back(FilterPredicate(condition, data));
+        }
+        predicates.swap(compiled);
+    }
+
+    for (const FilterPredicate& predicate : predicates)
+    {
+        if (!predicate.evaluate(data))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
 void
@@ -150,19 +914,172 @@ ForwardingEngine::forward_data(
 
     try
     {
-        std::string fwd_key;
-        get_forwarding_key(input, data, fwd_key);
-        InternalMatchingTableEntry& fwd_entry = fwd_table.find(fwd_key.c_str());
-        auto output = route.output<DynamicData>(fwd_entry.out_name);
-        RTI_PRCS_FWD_LOG_4("forwarding DATA:",
-            "input=%s, key=%s, match=%s, out=%s",
-            input.name().c_str(), fwd_key.c_str(), 
-            fwd_entry.in_key.c_str(), fwd_entry.out_name.c_str())
-        output.write(data);
+        InternalMatchingTableEntry *fwd_entry =
+            find_forwarding_entry(input, data);
+
+        if (fwd_entry == nullptr)
+        {
+            if (cur_input_metrics != nullptr)
+            {
+                cur_input_metrics->unmatched.add(1);
+            }
+            auto now = std::chrono::steady_clock::now();
+            if (now >= unmatched_warning_time)
+            {
+                RTI_PRCS_FWD_WARNING_2("UNMATCHED data:",
+                    "input=%s, not_reported=%llu",
+                    input.name().c_str(),
+                    static_cast<unsigned long long>(unmatched_suppressed))
+                unmatched_warning_time = now + std::chrono::seconds(1);
+                unmatched_suppressed = 0;
+            }
+            else
+            {
+                unmatched_suppressed++;
+            }
+            return;
+        }
+
+        std::size_t entry_i = fwd_entry - fwd_table.entries.data();
+
+        if (!fwd_entry->filter.empty() && !filter_data(input, entry_i, data))
+        {
+            if (cur_input_metrics != nullptr)
+            {
+                cur_input_metrics->filtered.add(1);
+            }
+            RTI_PRCS_FWD_TRACE_2("FILTERED data:", "input=%s, match=%s",
+                input.name().c_str(), fwd_entry->in_key.c_str())
+            return;
+        }
+
+        RTI_PRCS_FWD_LOG_3("forwarding DATA:",
+            "input=%s, match=%s, out=%s",
+            input.name().c_str(),
+            fwd_entry->in_key.c_str(), fwd_entry->out_name.c_str())
+        for (std::size_t slot : resolve_outputs(route, entry_i))
+        {
+            output_queues[slot].push_back(&data);
+        }
     }
     catch(const std::exception& e)
     {
+        /* The key couldn't be computed, a filter couldn't be evaluated,
+           or an output couldn't be resolved */
+        if (cur_input_metrics != nullptr)
+        {
+            cur_input_metrics->failed.add(1);
+        }
         RTI_PRCS_FWD_ERROR_2("EXCEPTION forwarding data:",
             "input='%s', what='%s'", input.name().c_str(), e.what())
     }
+}
+
+void
+ForwardingEngine::write_queued_data(
+    TypedInput<dds::core::xtypes::DynamicData>& input)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ForwardingEngine::write_queued_data)
+
+    for (std::size_t slot = 0; slot < outputs.size(); slot++)
+    {
+        std::vector<const DynamicData*>& queue = output_queues[slot];
+
+        if (queue.empty())
+        {
+            continue;
+        }
+
+        RTI_PRCS_FWD_TRACE_2("WRITING samples:","input=%s, samples=%ld",
+            input.name().c_str(), static_cast<long>(queue.size()))
+
+        /* The Processor API has no write of multiple samples, so the
+           samples of a group are written one by one */
+        std::size_t written = 0;
+        try
+        {
+            for (const DynamicData *data : queue)
+            {
+                outputs[slot].write(*data);
+                written++;
+            }
+        }
+        catch(const std::exception& e)
+        {
+            RTI_PRCS_FWD_ERROR_2("EXCEPTION writing data:",
+                "input='%s', what='%s'", input.name().c_str(), e.what())
+        }
+
+        if (cur_input_metrics != nullptr)
+        {
+            record_output_metrics(slot, written, queue.size() - written);
+        }
+
+        /* clear() keeps the capacity for the next take */
+        queue.clear();
+    }
+}
+
+InputMetrics*
+ForwardingEngine::find_input_metrics(
+    TypedInput<dds::core::xtypes::DynamicData>& input)
+{
+    auto metrics_it = input_metrics.find(input.name());
+    if (metrics_it != input_metrics.end())
+    {
+        return metrics_it->second;
+    }
+
+    InputMetrics *in_metrics = metrics->input(input.name());
+    input_metrics[input.name()] = in_metrics;
+    return in_metrics;
+}
+
+void
+ForwardingEngine::record_output_metrics(
+    std::size_t slot,
+    std::size_t written,
+    std::size_t failed)
+{
+    OutputMetrics *out_metrics = nullptr;
+
+    if (slot < cur_input_metrics->outputs.size())
+    {
+        out_metrics = cur_input_metrics->outputs[slot];
+    }
+    if (out_metrics == nullptr)
+    {
+        out_metrics = metrics->output(
+                *cur_input_metrics, slot, outputs[slot].name());
+    }
+
+    /* All the samples of a group are accounted the latency of the last
+       one, so that the clock is only read once per group */
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - cur_take_time);
+
+    out_metrics->forwarded.add(written);
+    out_metrics->failed.add(failed);
+    out_metrics->latency.record(
+            static_cast<uint64_t>(latency.count()), written);
+}
+
+void
+ForwardingEngine::clear_queued_data()
+{
+    for (std::vector<const DynamicData*>& queue : output_queues)
+    {
+        queue.clear();
+    }
+}
+
+InternalMatchingTableEntry*
+ForwardingEngine::find_forwarding_entry(
+    TypedInput<dds::core::xtypes::DynamicData>& input,
+    const dds::core::xtypes::DynamicData& data)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ForwardingEngine::find_forwarding_entry)
+
+    get_forwarding_key(input, data, fwd_key);
+    return fwd_table.lookup(fwd_key);
 }
\ No newline at end of file
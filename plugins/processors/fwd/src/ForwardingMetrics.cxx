@@ -0,0 +1,238 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#include <rtiprocess_fwd.hpp>
+
+#define RTI_PRCS_FWD_LOG_ARGS "rti::prcs::fwd::ForwardingMetrics"
+
+using namespace rti::prcs::fwd;
+
+const std::size_t MetricsHistogram::BUCKETS;
+
+void
+MetricsHistogram::record(uint64_t usec, uint64_t count)
+{
+    std::size_t bucket = 0;
+
+    while (bucket + 1 < BUCKETS && usec >= (static_cast<uint64_t>(1) << bucket))
+    {
+        bucket++;
+    }
+    buckets[bucket].add(count);
+}
+
+void*
+MetricsAllocation::operator new(std::size_t size)
+{
+    void *ptr = nullptr;
+
+#if defined(_MSC_VER) || defined(WIN32)
+    ptr = _aligned_malloc(size, alignof(MetricsCounter));
+#else
+    if (0 != posix_memalign(&ptr, alignof(MetricsCounter), size))
+    {
+        ptr = nullptr;
+    }
+#endif
+    if (ptr == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void
+MetricsAllocation::operator delete(void *ptr)
+{
+#if defined(_MSC_VER) || defined(WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+/*
+ * Names are written as JSON strings, escaping only the characters which
+ * would make the string invalid.
+ */
+static void
+write_json_string(FILE *out, const std::string& str)
+{
+    fputc('"', out);
+    for (char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            fputc('\\', out);
+            fputc(c, out);
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            fprintf(out, "\\u%04x", static_cast<unsigned int>(c));
+        }
+        else
+        {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+ForwardingMetrics::ForwardingMetrics(
+    const std::string& file,
+    uint32_t period_ms)
+    : file(file),
+      period(period_ms),
+      stopped(false)
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ForwardingMetrics::ForwardingMetrics)
+
+    RTI_PRCS_FWD_LOG_2("new METRICS:","file=%s, period_ms=%u",
+        file.c_str(), period_ms)
+
+    thread = std::thread(&ForwardingMetrics::run, this);
+}
+
+ForwardingMetrics::~ForwardingMetrics()
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ForwardingMetrics::~ForwardingMetrics)
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopped = true;
+    }
+    stop_cond.notify_all();
+    thread.join();
+
+    /* the last snapshot includes everything forwarded so far */
+    write_snapshot();
+}
+
+InputMetrics*
+ForwardingMetrics::input(const std::string& input_name)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    std::unique_ptr<InputMetrics> input(new InputMetrics());
+    input->name = input_name;
+    inputs.push_back(std::move(input));
+
+    return inputs.back().get();
+}
+
+OutputMetrics*
+ForwardingMetrics::output(
+    InputMetrics& input,
+    std::size_t slot,
+    const std::string& output_name)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    std::unique_ptr<OutputMetrics> output(new OutputMetrics());
+    output->input_name = input.name;
+    output->output_name = output_name;
+    outputs.push_back(std::move(output));
+
+    if (input.outputs.size() <= slot)
+    {
+        input.outputs.resize(slot + 1, nullptr);
+    }
+    input.outputs[slot] = outputs.back().get();
+
+    return outputs.back().get();
+}
+
+void
+ForwardingMetrics::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+
+    while (!stopped)
+    {
+        stop_cond.wait_for(guard, period);
+        if (stopped)
+        {
+            break;
+        }
+        guard.unlock();
+        write_snapshot();
+        guard.lock();
+    }
+}
+
+void
+ForwardingMetrics::write_snapshot()
+{
+    RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::ForwardingMetrics::write_snapshot)
+
+    /* Write to a temporary file, and rename it, so that readers never see
+       an incomplete snapshot */
+    const std::string tmp_file = file + ".tmp";
+    FILE *out = fopen(tmp_file.c_str(), "w");
+
+    if (out == nullptr)
+    {
+        RTI_PRCS_FWD_ERROR_1("failed to open metrics file:","file=%s",
+            tmp_file.c_str())
+        return;
+    }
+
+    auto now = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch());
+
+    std::lock_guard<std::mutex> guard(lock);
+
+    fprintf(out, "{\n  \"timestamp_usec\": %lld,\n  \"inputs\": [",
+        static_cast<long long>(now.count()));
+    for (std::size_t i = 0; i < inputs.size(); i++)
+    {
+        const InputMetrics& input = *inputs[i];
+
+        fprintf(out, "%s\n    { \"name\": ", (i > 0)? "," : "");
+        write_json_string(out, input.name);
+        fprintf(out,
+            ", \"taken\": %llu, \"filtered\": %llu, \"unmatched\": %llu"
+            ", \"failed\": %llu }",
+            static_cast<unsigned long long>(input.taken.get()),
+            static_cast<unsigned long long>(input.filtered.get()),
+            static_cast<unsigned long long>(input.unmatched.get()),
+            static_cast<unsigned long long>(input.failed.get()));
+    }
+    fprintf(out, "\n  ],\n  \"outputs\": [");
+    for (std::size_t i = 0; i < outputs.size(); i++)
+    {
+        const OutputMetrics& output = *outputs[i];
+
+        fprintf(out, "%s\n    { \"input\": ", (i > 0)? "," : "");
+        write_json_string(out, output.input_name);
+        fprintf(out, ", \"output\": ");
+        write_json_string(out, output.output_name);
+        fprintf(out,
+            ", \"forwarded\": %llu, \"failed\": %llu, \"latency_usec\": [",
+            static_cast<unsigned long long>(output.forwarded.get()),
+            static_cast<unsigned long long>(output.failed.get()));
+        for (std::size_t b = 0; b < MetricsHistogram::BUCKETS; b++)
+        {
+            fprintf(out, "%s%llu", (b > 0)? ", " : "",
+                static_cast<unsigned long long>(
+                    output.latency.buckets[b].get()));
+        }
+        fprintf(out, "] }");
+    }
+    fprintf(out, "\n  ]\n}\n");
+
+    if (0 != fclose(out) || 0 != rename(tmp_file.c_str(), file.c_str()))
+    {
+        RTI_PRCS_FWD_ERROR_1("failed to write metrics file:","file=%s",
+            file.c_str())
+    }
+}
@@ -0,0 +1,615 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#include <rtiprocess_fwd.hpp>
+
+#include <cstdarg>
+
+#define RTI_PRCS_FWD_LOG_ARGS "rti::prcs::fwd::Log"
+
+int RTI_PRCS_FWD_Log_level = RTI_PRCS_FWD_LOG_LEVEL_DEFAULT;
+
+namespace {
+
+/*
+ * The conversions of a log format whose arguments can be stored in a
+ * record. Each kind remembers the exact type the argument was read with,
+ * so that it can be passed back to fprintf() unchanged.
+ */
+enum class LogArgKind : unsigned char {
+    INT,
+    LONG,
+    LONGLONG,
+    UINT,
+    ULONG,
+    ULONGLONG,
+    SIZE,
+    DOUBLE,
+    POINTER,
+    STRING
+};
+
+union LogArg {
+    long long as_signed;
+    unsigned long long as_unsigned;
+    double as_double;
+    const void *as_pointer;
+    /* offset of a string argument in the record's strings */
+    std::size_t as_string;
+};
+
+const std::size_t LOG_SPEC_MAX_LEN = 16;
+
+/*
+ * Decode the conversion that starts right after a '%' of a format used by
+ * the RTI_PRCS_FWD_LOG_* macros: optional flags, a literal width and
+ * precision, one of the "h", "hh", "l", "ll" or "z" length modifiers, and
+ * an integer, floating point, pointer or string conversion.
+ */
+bool
+parse_log_spec(const char *spec, LogArgKind& kind, std::size_t& spec_len)
+{
+    std::size_t i = 0;
+    int longs = 0;
+    bool is_size = false;
+
+    while (spec[i] != '\0' && strchr("-+ #0", spec[i]) != nullptr)
+    {
+        i++;
+    }
+    while (spec[i] >= '0' && spec[i] <= '9')
+    {
+        i++;
+    }
+    if (spec[i] == '.')
+    {
+        i++;
+        while (spec[i] >= '0' && spec[i] <= '9')
+        {
+            i++;
+        }
+    }
+    if (spec[i] == 'h')
+    {
+        i += (spec[i + 1] == 'h') ? 2 : 1;
+    }
+    else if (spec[i] == 'l')
+    {
+        longs = (spec[i + 1] == 'l') ? 2 : 1;
+        i += longs;
+    }
+    else if (spec[i] == 'z')
+    {
+        is_size = true;
+        i++;
+    }
+
+    switch (spec[i])
+    {
+    case 'd': case 'i': case 'c':
+        kind = is_size ? LogArgKind::SIZE
+                : (longs == 2) ? LogArgKind::LONGLONG
+                : (longs == 1) ? LogArgKind::LONG
+                : LogArgKind::INT;
+        break;
+    case 'u': case 'o': case 'x': case 'X':
+        kind = is_size ? LogArgKind::SIZE
+                : (longs == 2) ? LogArgKind::ULONGLONG
+                : (longs == 1) ? LogArgKind::ULONG
+                : LogArgKind::UINT;
+        break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+        kind = LogArgKind::DOUBLE;
+        break;
+    case 'p':
+        kind = LogArgKind::POINTER;
+        break;
+    case 's':
+        if (longs > 0)
+        {
+            return false;
+        }
+        kind = LogArgKind::STRING;
+        break;
+    default:
+        return false;
+    }
+
+    spec_len = i + 1;
+    /* room for the '%' and a terminator when the drain thread copies it */
+    return spec_len + 2 <= LOG_SPEC_MAX_LEN;
+}
+
+/*
+ * The asynchronous backend of the forwarding engine's log: a bounded ring
+ * of records which the route threads append to without locks, and which
+ * is drained by a single background thread. The sequence number of a
+ * record tells whether it can be filled (seq == position) or written
+ * (seq == position + 1) at a certain position of the ring.
+ *
+ * A route thread never formats a message. It keeps the format, which is
+ * always a literal of the logging macros, and copies the arguments as
+ * binary values. Strings are copied too, since they are usually input and
+ * output names or keys owned by the engine's tables, which can be replaced
+ * by an update while the message waits in the ring.
+ */
+class LogBackend {
+public:
+    static const std::size_t RECORD_MAX_ARGS = 12;
+    static const std::size_t RECORD_STRINGS_LEN = 256;
+    static const std::size_t RING_CAPACITY = 4096;
+
+    LogBackend(FILE *output)
+        : records(new Record[RING_CAPACITY]),
+          push_pos(0),
+          pop_pos(0),
+          output(output),
+          stopped(false),
+          dropped(0)
+    {
+        for (std::size_t i = 0; i < RING_CAPACITY; i++)
+        {
+            records[i].seq.store(i, std::memory_order_relaxed);
+        }
+        thread = std::thread(&LogBackend::run, this);
+    }
+
+    ~LogBackend()
+    {
+        stopped.store(true, std::memory_order_release);
+        thread.join();
+        if (output != stdout)
+        {
+            fclose(output);
+        }
+    }
+
+    void
+    vprintf(const char *fmt, va_list args)
+    {
+        Record *record = nullptr;
+        uint64_t pos = push_pos.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            record = &records[pos % RING_CAPACITY];
+            uint64_t seq = record->seq.load(std::memory_order_acquire);
+            int64_t diff = static_cast<int64_t>(seq - pos);
+
+            if (diff == 0)
+            {
+                if (push_pos.compare_exchange_weak(
+                        pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                /* Forwarding must not slow down because the output can't
+                   keep up with the log: count the message and move on */
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            else
+            {
+                pos = push_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        if (!record->capture(fmt, args))
+        {
+            record->fmt = nullptr;
+            int len = vsnprintf(record->strings, RECORD_STRINGS_LEN, fmt, args);
+            if (len < 0)
+            {
+                record->strings[0] = '\0';
+            }
+            else if (static_cast<std::size_t>(len) >= RECORD_STRINGS_LEN)
+            {
+                /* Put back the line break which was cut with the rest */
+                record->strings[RECORD_STRINGS_LEN - 2] = '\n';
+            }
+        }
+        record->seq.store(pos + 1, std::memory_order_release);
+    }
+
+private:
+    struct Record {
+        std::atomic<uint64_t> seq;
+        /* nullptr if `strings` holds the message printed by the caller */
+        const char *fmt;
+        std::size_t args_len;
+        std::size_t strings_len;
+        LogArgKind kinds[RECORD_MAX_ARGS];
+        LogArg args[RECORD_MAX_ARGS];
+        char strings[RECORD_STRINGS_LEN];
+
+        /*
+         * Store the format and a binary copy of the arguments. The format
+         * is decoded before any argument is read, so when it can't be
+         * stored `args` is left untouched for the caller to print.
+         */
+        bool
+        capture(const char *format, va_list arg_list)
+        {
+            args_len = 0;
+            strings_len = 0;
+
+            const char *cur = format;
+            while ((cur = strchr(cur, '%')) != nullptr)
+            {
+                if (cur[1] == '%')
+                {
+                    cur += 2;
+                    continue;
+                }
+                std::size_t spec_len = 0;
+                if (args_len == RECORD_MAX_ARGS ||
+                        !parse_log_spec(cur + 1, kinds[args_len], spec_len))
+                {
+                    return false;
+                }
+                args_len++;
+                cur += 1 + spec_len;
+            }
+
+            for (std::size_t i = 0; i < args_len; i++)
+            {
+                LogArg& arg = args[i];
+                switch (kinds[i])
+                {
+                case LogArgKind::INT:
+                    arg.as_signed = va_arg(arg_list, int);
+                    break;
+                case LogArgKind::LONG:
+                    arg.as_signed = va_arg(arg_list, long);
+                    break;
+                case LogArgKind::LONGLONG:
+                    arg.as_signed = va_arg(arg_list, long long);
+                    break;
+                case LogArgKind::UINT:
+                    arg.as_unsigned = va_arg(arg_list, unsigned int);
+                    break;
+                case LogArgKind::ULONG:
+                    arg.as_unsigned = va_arg(arg_list, unsigned long);
+                    break;
+                case LogArgKind::ULONGLONG:
+                    arg.as_unsigned = va_arg(arg_list, unsigned long long);
+                    break;
+                case LogArgKind::SIZE:
+                    arg.as_unsigned = va_arg(arg_list, std::size_t);
+                    break;
+                case LogArgKind::DOUBLE:
+                    arg.as_double = va_arg(arg_list, double);
+                    break;
+                case LogArgKind::POINTER:
+                    arg.as_pointer = va_arg(arg_list, void*);
+                    break;
+                case LogArgKind::STRING:
+                    arg.as_string = copy_string(va_arg(arg_list, const char*));
+                    break;
+                }
+            }
+
+            fmt = format;
+            return true;
+        }
+
+        /* Append a string to `strings`, cutting whatever doesn't fit */
+        std::size_t
+        copy_string(const char *str)
+        {
+            if (str == nullptr)
+            {
+                str = "(null)";
+            }
+            if (strings_len == RECORD_STRINGS_LEN)
+            {
+                /* the terminator of the previous string */
+                return strings_len - 1;
+            }
+
+            std::size_t offset = strings_len;
+            std::size_t len = 0;
+            while (offset + len + 1 < RECORD_STRINGS_LEN && str[len] != '\0')
+            {
+                strings[offset + len] = str[len];
+                len++;
+            }
+            strings[offset + len] = '\0';
+            strings_len = offset + len + 1;
+            return offset;
+        }
+
+        /*
+         * Print the message on the drain thread, passing each stored
+         * argument to fprintf() with its own conversion.
+         */
+        void
+        write(FILE *out) const
+        {
+            if (fmt == nullptr)
+            {
+                fputs(strings, out);
+                return;
+            }
+
+            char spec[LOG_SPEC_MAX_LEN];
+            const char *cur = fmt;
+            const char *next = nullptr;
+            std::size_t i = 0;
+
+            while ((next = strchr(cur, '%')) != nullptr)
+            {
+                fwrite(cur, 1, static_cast<std::size_t>(next - cur), out);
+                if (next[1] == '%')
+                {
+                    fputc('%', out);
+                    cur = next + 2;
+                    continue;
+                }
+
+                LogArgKind kind = LogArgKind::INT;
+                std::size_t spec_len = 0;
+                /* capture() only succeeded if every conversion parsed */
+                (void) parse_log_spec(next + 1, kind, spec_len);
+                memcpy(spec, next, spec_len + 1);
+                spec[spec_len + 1] = '\0';
+                cur = next + 1 + spec_len;
+
+                const LogArg& arg = args[i++];
+                switch (kind)
+                {
+                case LogArgKind::INT:
+                    fprintf(out, spec, static_cast<int>(arg.as_signed));
+                    break;
+                case LogArgKind::LONG:
+                    fprintf(out, spec, static_cast<long>(arg.as_signed));
+                    break;
+                case LogArgKind::LONGLONG:
+                    fprintf(out, spec, arg.as_signed);
+                    break;
+                case LogArgKind::UINT:
+                    fprintf(out, spec, static_cast<unsigned int>(arg.as_unsigned));
+                    break;
+                case LogArgKind::ULONG:
+                    fprintf(out, spec, static_cast<unsigned long>(arg.as_unsigned));
+                    break;
+                case LogArgKind::ULONGLONG:
+                    fprintf(out, spec, arg.as_unsigned);
+                    break;
+                case LogArgKind::SIZE:
+                    fprintf(out, spec, static_cast<std::size_t>(arg.as_unsigned));
+                    break;
+                case LogArgKind::DOUBLE:
+                    fprintf(out, spec, arg.as_double);
+                    break;
+                case LogArgKind::POINTER:
+                    fprintf(out, spec, const_cast<void*>(arg.as_pointer));
+                    break;
+                case LogArgKind::STRING:
+                    fprintf(out, spec, strings + arg.as_string);
+                    break;
+                }
+            }
+            fputs(cur, out);
+        }
+    };
+
+    /*
+     * Write all the records which are ready, and report messages which
+     * were dropped since the last call. Only the drain thread pops records.
+     */
+    bool
+    drain(uint64_t& reported_dropped)
+    {
+        bool written = false;
+
+        for (;;)
+        {
+            Record& record = records[pop_pos % RING_CAPACITY];
+            if (record.seq.load(std::memory_order_acquire) != pop_pos + 1)
+            {
+                break;
+            }
+            record.write(output);
+            written = true;
+
+            /* The slot can be reused by the push one lap ahead */
+            record.seq.store(
+                    pop_pos + RING_CAPACITY, std::memory_order_release);
+            pop_pos++;
+        }
+
+        uint64_t cur_dropped = dropped.load(std::memory_order_relaxed);
+        if (cur_dropped != reported_dropped)
+        {
+            fprintf(output,
+                RTI_PRCS_FWD_LOG_HEAD_WARNING "%llu log messages DROPPED\n",
+                RTI_PRCS_FWD_LOG_ARGS,
+                static_cast<unsigned long long>(
+                    cur_dropped - reported_dropped));
+            reported_dropped = cur_dropped;
+            written = true;
+        }
+
+        if (written)
+        {
+            fflush(output);
+        }
+        return written;
+    }
+
+    void
+    run()
+    {
+        uint64_t reported_dropped = 0;
+        bool stop = false;
+
+        do
+        {
+            /* The destructor sets the flag after the last record was
+               pushed, so one more drain after seeing it writes them all */
+            stop = stopped.load(std::memory_order_acquire);
+
+            if (!drain(reported_dropped) && !stop)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        } while (!stop);
+    }
+
+    std::unique_ptr<Record[]> records;
+    std::atomic<uint64_t> push_pos;
+    uint64_t pop_pos;
+    FILE *output;
+    std::thread thread;
+    std::atomic<bool> stopped;
+    std::atomic<uint64_t> dropped;
+};
+
+const std::size_t LogBackend::RECORD_MAX_ARGS;
+const std::size_t LogBackend::RECORD_STRINGS_LEN;
+const std::size_t LogBackend::RING_CAPACITY;
+
+/*
+ * Forwarding engine plugins using the log. The plugin library is loaded,
+ * and its plugins created and deleted, by Routing Service's configuration
+ * thread only, so the count doesn't need to be atomic.
+ */
+std::size_t log_users = 0;
+
+/*
+ * Route threads load the backend on every message, while the last plugin
+ * to be deleted swaps it out. A route thread increments `log_writers`
+ * before loading the backend, and decrements it when its record is
+ * published, so the backend is only deleted once it was swapped out and
+ * no route thread can still be using it. Both sides use sequentially
+ * consistent operations, so that at least one of them sees the other.
+ */
+std::atomic<LogBackend*> log_backend(nullptr);
+
+std::atomic<std::size_t> log_writers(0);
+
+void
+load_log_level()
+{
+    static const char *level_names[] =
+    {
+        "SILENT", "ERROR", "WARNING", "INFO", "TRACE"
+    };
+    const char *level_str = getenv(RTI_PRCS_FWD_LOG_LEVEL_ENV);
+
+    if (level_str == nullptr)
+    {
+        return;
+    }
+    for (int i = RTI_PRCS_FWD_LOG_LEVEL_SILENT;
+            i <= RTI_PRCS_FWD_LOG_LEVEL_TRACE; i++)
+    {
+        if (strcmp(level_str, level_names[i]) == 0)
+        {
+            RTI_PRCS_FWD_Log_level = i;
+            return;
+        }
+    }
+    RTI_PRCS_FWD_WARNING("unknown log level in " RTI_PRCS_FWD_LOG_LEVEL_ENV)
+}
+
+}
+
+void
+RTI_PRCS_FWD_Log_initialize(void)
+{
+    load_log_level();
+
+    if (++log_users > 1)
+    {
+        return;
+    }
+
+    const char *output = getenv(RTI_PRCS_FWD_LOG_ASYNC_ENV);
+    if (output == nullptr)
+    {
+        return;
+    }
+
+    FILE *output_file = stdout;
+    if (strcmp(output, "stdout") != 0)
+    {
+        output_file = fopen(output, "a");
+        if (output_file == nullptr)
+        {
+            /* Messages will keep being written synchronously */
+            RTI_PRCS_FWD_ERROR_1("failed to open log file:","%s", output)
+            return;
+        }
+    }
+    try
+    {
+        log_backend.store(new LogBackend(output_file));
+    }
+    catch (const std::exception& e)
+    {
+        if (output_file != stdout)
+        {
+            fclose(output_file);
+        }
+        RTI_PRCS_FWD_ERROR_1("failed to start asynchronous log:","what=%s",
+            e.what())
+    }
+}
+
+void
+RTI_PRCS_FWD_Log_finalize(void)
+{
+    if (log_users == 0 || --log_users > 0)
+    {
+        return;
+    }
+
+    LogBackend *backend = log_backend.exchange(nullptr);
+    if (backend == nullptr)
+    {
+        return;
+    }
+
+    /* Route threads never block while logging, so this wait is short */
+    while (log_writers.load() != 0)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    delete backend;
+}
+
+void
+RTI_PRCS_FWD_Log_printf(const char *fmt, ...)
+{
+    va_list args;
+
+    log_writers.fetch_add(1);
+    LogBackend *backend = log_backend.load();
+
+    va_start(args, fmt);
+    if (backend == nullptr)
+    {
+        vfprintf(stdout, fmt, args);
+    }
+    else
+    {
+        backend->vprintf(fmt, args);
+    }
+    va_end(args);
+
+    log_writers.fetch_sub(1, std::memory_order_release);
+}
@@ -26,8 +26,19 @@ const std::string property::FORWARDING_TABLE = property::PREFIX + "forwarding_ta
 
 const std::string property::INPUT_MEMBERS_TABLE = property::PREFIX + "input_members";
 
+const std::string property::METRICS_FILE = property::PREFIX + "metrics_file";
+const std::string property::METRICS_PERIOD_MS = property::PREFIX + "metrics_period_ms";
+const uint32_t property::METRICS_PERIOD_MS_DEFAULT = 10000;
+
 const std::string property::FORWARDING_TABLE_KEY_IN_KEY = "input";
 const std::string property::FORWARDING_TABLE_KEY_OUT_NAME = "output";
+const std::string property::FORWARDING_TABLE_KEY_RANGE = "range";
+const std::string property::FORWARDING_TABLE_KEY_VALUES = "values";
+const std::string property::FORWARDING_TABLE_KEY_FILTER = "filter";
+
+const std::string property::FILTER_KEY_MEMBER = "member";
+const std::string property::FILTER_KEY_OPERATOR = "op";
+const std::string property::FILTER_KEY_VALUE = "value";
 
 const std::string property::INPUT_MEMBERS_TABLE_KEY_IN_KEY = "input";
 const std::string property::INPUT_MEMBERS_TABLE_KEY_OUT_NAME = "member";
@@ -65,6 +76,261 @@ parse_json_string(
     }
 }
 
+/*
+ * Parse a JSON array of integers. Returns false if the member is not
+ * present in the parent object.
+ */
+static bool
+parse_json_integer_array(
+    json_value& parent_obj,
+    const std::string& parent_name,
+    const std::string& member_name,
+    std::vector<int64_t>& member_value)
+{
+    const json_value& member_json_value = parent_obj[member_name.c_str()];
+    if (&member_json_value == &json_value_none)
+    {
+        return false;
+    }
+    if (member_json_value.type != json_array ||
+        member_json_value.u.array.length == 0)
+    {
+        throw dds::core::InvalidArgumentError(
+            "value must be a non-empty array of integers: " +
+                parent_name + "." + member_name);
+    }
+
+    member_value.clear();
+    for (unsigned int i = 0; i < member_json_value.u.array.length; i++)
+    {
+        const json_value& el_json_value = *member_json_value.u.array.values[i];
+        if (el_json_value.type != json_integer)
+        {
+            throw dds::core::InvalidArgumentError(
+                "value must be a non-empty array of integers: " +
+                    parent_name + "." + member_name);
+        }
+        member_value.push_back(el_json_value.u.integer);
+    }
+    return true;
+}
+
+/*
+ * Parse a JSON string, or a non-empty array of strings.
+ */
+static void
+parse_json_string_array(
+    json_value& parent_obj,
+    const std::string& parent_name,
+    const std::string& member_name,
+    std::vector<std::string>& member_value)
+{
+    const json_value& member_json_value = parent_obj[member_name.c_str()];
+
+    member_value.clear();
+    if (&member_json_value == &json_value_none)
+    {
+        return;
+    }
+    if (member_json_value.type == json_string)
+    {
+        std::string member_value_str;
+        parse_json_string(parent_obj, parent_name, member_name, member_value_str);
+        member_value.push_back(member_value_str);
+        return;
+    }
+    if (member_json_value.type != json_array ||
+        member_json_value.u.array.length == 0)
+    {
+        throw dds::core::InvalidArgumentError(
+            "value must be a string, or a non-empty array of strings: " +
+                parent_name + "." + member_name);
+    }
+    for (unsigned int i = 0; i < member_json_value.u.array.length; i++)
+    {
+        const json_value& el_json_value = *member_json_value.u.array.values[i];
+        if (el_json_value.type != json_string ||
+            el_json_value.u.string.length == 0)
+        {
+            throw dds::core::InvalidArgumentError(
+                "value must be a string, or a non-empty array of strings: " +
+                    parent_name + "." + member_name);
+        }
+        member_value.push_back(std::string(
+            el_json_value.u.string.ptr, el_json_value.u.string.length));
+    }
+}
+
+static FilterOperatorKind
+parse_filter_operator(const std::string& op, const std::string& prop_key)
+{
+    if (op == "==")
+    {
+        return FilterOperatorKind::EQUAL;
+    }
+    else if (op == "!=")
+    {
+        return FilterOperatorKind::NOT_EQUAL;
+    }
+    else if (op == "<")
+    {
+        return FilterOperatorKind::LESS;
+    }
+    else if (op == "<=")
+    {
+        return FilterOperatorKind::LESS_OR_EQUAL;
+    }
+    else if (op == ">")
+    {
+        return FilterOperatorKind::GREATER;
+    }
+    else if (op == ">=")
+    {
+        return FilterOperatorKind::GREATER_OR_EQUAL;
+    }
+    throw dds::core::InvalidArgumentError(
+            "unsupported filter operator: " + prop_key + "=" + op);
+}
+
+/*
+ * Parse the conditions that samples must satisfy to be forwarded by an
+ * entry, e.g. [ { "member": "x", "op": "<", "value": 10 } ]
+ */
+static void
+parse_filter(
+    MatchingTableEntry& entry,
+    json_value& entry_json_value,
+    const std::string& prop_key)
+{
+    const std::string filter_key =
+            prop_key + "." + property::FORWARDING_TABLE_KEY_FILTER;
+    const json_value& filter_json_value =
+        entry_json_value[property::FORWARDING_TABLE_KEY_FILTER.c_str()];
+
+    if (&filter_json_value == &json_value_none)
+    {
+        return;
+    }
+    if (filter_json_value.type != json_array)
+    {
+        throw dds::core::InvalidArgumentError(
+            "value must be an array of conditions: " + filter_key);
+    }
+
+    for (unsigned int i = 0; i < filter_json_value.u.array.length; i++)
+    {
+        json_value& cond_json_value = *filter_json_value.u.array.values[i];
+        FilterCondition condition;
+        std::string member_value;
+
+        if (cond_json_value.type != json_object)
+        {
+            throw dds::core::InvalidArgumentError(
+                "filter conditions must be JSON objects: " + filter_key);
+        }
+
+        parse_json_string(
+            cond_json_value,
+            filter_key,
+            property::FILTER_KEY_MEMBER,
+            member_value);
+        if (member_value.length() == 0)
+        {
+            throw dds::core::InvalidArgumentError(
+                "a filter condition is missing a required member: " +
+                    filter_key + "." + property::FILTER_KEY_MEMBER);
+        }
+        condition.member(member_value);
+
+        parse_json_string(
+            cond_json_value,
+            filter_key,
+            property::FILTER_KEY_OPERATOR,
+            member_value);
+        condition.op(parse_filter_operator(member_value, filter_key));
+
+        const json_value& value_json_value =
+            cond_json_value[property::FILTER_KEY_VALUE.c_str()];
+        switch (value_json_value.type)
+        {
+        case json_integer:
+            condition.value_kind(FilterValueKind::INTEGER_VALUE);
+            condition.integer_value(value_json_value.u.integer);
+            break;
+        case json_boolean:
+            condition.value_kind(FilterValueKind::INTEGER_VALUE);
+            condition.integer_value((value_json_value.u.boolean)? 1 : 0);
+            break;
+        case json_double:
+            condition.value_kind(FilterValueKind::FLOAT_VALUE);
+            condition.float_value(value_json_value.u.dbl);
+            break;
+        case json_string:
+            condition.value_kind(FilterValueKind::STRING_VALUE);
+            condition.string_value(std::string(
+                value_json_value.u.string.ptr,
+                value_json_value.u.string.length));
+            break;
+        default:
+            throw dds::core::InvalidArgumentError(
+                "value must be a number, a boolean, or a string: " +
+                    filter_key + "." + property::FILTER_KEY_VALUE);
+        }
+
+        entry.filter().push_back(condition);
+    }
+}
+
+/*
+ * Parse the members of an entry which matches integer values instead of
+ * a string key: either a "range" with the (inclusive) bounds of the
+ * matched values, or a set of "values". Returns false if the entry has
+ * none of the two.
+ */
+static bool
+parse_integer_entry(
+    MatchingTableEntry& entry,
+    json_value& entry_json_value,
+    const std::string& prop_key)
+{
+    std::vector<int64_t> range;
+
+    bool has_range = parse_json_integer_array(
+            entry_json_value,
+            prop_key,
+            property::FORWARDING_TABLE_KEY_RANGE,
+            range);
+    bool has_values = parse_json_integer_array(
+            entry_json_value,
+            prop_key,
+            property::FORWARDING_TABLE_KEY_VALUES,
+            entry.values());
+
+    if (has_range && has_values)
+    {
+        throw dds::core::InvalidArgumentError(
+                "a table entry cannot have both a range and values: " +
+                prop_key);
+    }
+    if (has_range)
+    {
+        if (range.size() != 2 || range[0] > range[1])
+        {
+            throw dds::core::InvalidArgumentError(
+                "range must be an array with a minimum and a maximum: " +
+                    prop_key + "." + property::FORWARDING_TABLE_KEY_RANGE);
+        }
+        entry.kind(MatchingTableEntryKind::INTEGER_RANGE);
+        entry.range_min(range[0]);
+        entry.range_max(range[1]);
+    }
+    else if (has_values)
+    {
+        entry.kind(MatchingTableEntryKind::INTEGER_SET);
+    }
+
+    return (has_range || has_values);
+}
 
 static void
 parse_from_json(
@@ -72,7 +338,9 @@ parse_from_json(
     const std::string& json_str,
     const std::string& prop_key,
     const std::string& member_in_key,
-    const std::string& member_out_name)
+    const std::string& member_out_name,
+    bool allow_integer_entries,
+    bool is_forwarding_table)
 {
     RTI_PRCS_FWD_LOG_FN(rti::prcs::fwd::property::parse_from_json<MatchingTable>)
 
@@ -117,6 +385,11 @@ parse_from_json(
         {
             entry.in_key() = member_value;
         }
+        else if (allow_integer_entries &&
+            parse_integer_entry(entry, entry_json_value, prop_key))
+        {
+            /* the entry is matched by value, not by key */
+        }
         else
         {
             throw dds::core::InvalidArgumentError(
@@ -124,11 +397,26 @@ parse_from_json(
                     prop_key +", member=" + member_in_key);
         }
 
-        parse_json_string(
-            entry_json_value, 
-            prop_key,
-            member_out_name,
-            member_value);
+        if (is_forwarding_table)
+        {
+            /* an entry may forward samples to multiple outputs */
+            parse_json_string_array(
+                entry_json_value,
+                prop_key,
+                member_out_name,
+                entry.out_names());
+            member_value = (entry.out_names().empty())?
+                    "" : entry.out_names()[0];
+            parse_filter(entry, entry_json_value, prop_key);
+        }
+        else
+        {
+            parse_json_string(
+                entry_json_value, 
+                prop_key,
+                member_out_name,
+                member_value);
+        }
         if (member_value.length() > 0)
         {
             entry.out_name() = member_value;
@@ -154,7 +442,9 @@ parse_matching_table(
     const PropertySet& properties,
     const std::string& prop_key,
     const std::string& member_in_key,
-    const std::string& member_out_name)
+    const std::string& member_out_name,
+    bool allow_integer_entries,
+    bool is_forwarding_table)
 {
     PropertySet::const_iterator it = properties.find(prop_key);
     if (it == properties.end()) 
@@ -168,7 +458,37 @@ parse_matching_table(
         json_str,
         prop_key,
         member_in_key,
-        member_out_name);
+        member_out_name,
+        allow_integer_entries,
+        is_forwarding_table);
+}
+
+static void
+parse_metrics_config(
+    const PropertySet& properties,
+    ForwardingEngineConfiguration& config)
+{
+    PropertySet::const_iterator it = properties.find(property::METRICS_FILE);
+    if (it != properties.end())
+    {
+        config.metrics_file(it->second);
+    }
+
+    config.metrics_period_ms(property::METRICS_PERIOD_MS_DEFAULT);
+    it = properties.find(property::METRICS_PERIOD_MS);
+    if (it != properties.end())
+    {
+        char *end = nullptr;
+        unsigned long period = strtoul(it->second.c_str(), &end, 10);
+        if (it->second.empty() || *end != '\0' || period == 0 ||
+            period > std::numeric_limits<uint32_t>::max())
+        {
+            throw dds::core::InvalidArgumentError(
+                "value must be a positive integer: " +
+                    property::METRICS_PERIOD_MS);
+        }
+        config.metrics_period_ms(static_cast<uint32_t>(period));
+    }
 }
 
 void
@@ -182,7 +502,11 @@ property::parse_config(
             properties,
             property::FORWARDING_TABLE,
             property::FORWARDING_TABLE_KEY_IN_KEY,
-            property::FORWARDING_TABLE_KEY_OUT_NAME);
+            property::FORWARDING_TABLE_KEY_OUT_NAME,
+            false /* allow_integer_entries */,
+            true /* is_forwarding_table */);
+
+    parse_metrics_config(properties, config);
 }
 
 void
@@ -197,7 +521,9 @@ property::parse_config(
             properties,
             property::FORWARDING_TABLE,
             property::FORWARDING_TABLE_KEY_IN_KEY,
-            property::FORWARDING_TABLE_KEY_OUT_NAME);
+            property::FORWARDING_TABLE_KEY_OUT_NAME,
+            true /* allow_integer_entries */,
+            true /* is_forwarding_table */);
     
     InputMembersTable table;
     parse_matching_table(
@@ -205,6 +531,10 @@ property::parse_config(
             properties,
             property::INPUT_MEMBERS_TABLE,
             property::INPUT_MEMBERS_TABLE_KEY_IN_KEY,
-            property::INPUT_MEMBERS_TABLE_KEY_OUT_NAME);
+            property::INPUT_MEMBERS_TABLE_KEY_OUT_NAME,
+            false /* allow_integer_entries */,
+            false /* is_forwarding_table */);
     config.input_members(table);
+
+    parse_metrics_config(properties, config);
 }
@@ -44,6 +44,133 @@ const struct _json_value json_value_none;
 
 typedef unsigned int json_uchar;
 
+/* Vectorized scanning of strings
+ *
+ * Most of the bytes of a JSON document are usually in strings, which are
+ * copied verbatim up to their closing quote, an escape sequence or an
+ * (invalid) nul character. A json_scan_fn returns the length of such a
+ * run of plain bytes, checking 16 (SSE2) or 32 (AVX2) bytes at a time.
+ * The implementation is selected at runtime by json_select_scan_fn.
+ *
+ * Define JSON_DISABLE_SIMD to always use the scalar implementation.
+ */
+
+#ifndef JSON_DISABLE_SIMD
+   #if defined (__SSE2__) || defined (_M_X64) || \
+       (defined (_M_IX86_FP) && _M_IX86_FP >= 2)
+      #define JSON_SCAN_SSE2
+      #include <emmintrin.h>
+      #ifdef _MSC_VER
+         #include <intrin.h>
+      #endif
+   #endif
+
+   /* AVX2 code is compiled for the function which uses it only, and it is
+    * only called if the CPU supports it */
+   #if defined (JSON_SCAN_SSE2) && defined (__GNUC__) && \
+       (defined (__clang__) || __GNUC__ >= 5)
+      #define JSON_SCAN_AVX2
+      #include <immintrin.h>
+   #endif
+#endif
+
+typedef size_t (* json_scan_fn) (const json_char * ptr, const json_char * end);
+
+static size_t json_scan_string_scalar (const json_char * ptr,
+                                       const json_char * end)
+{
+   const json_char * p = ptr;
+
+   while (p < end && *p != '"' && *p != '\\' && *p != 0)
+      ++ p;
+
+   return p - ptr;
+}
+
+#ifdef JSON_SCAN_SSE2
+
+static unsigned int json_first_bit (unsigned int mask)
+{
+   #ifdef _MSC_VER
+      unsigned long index;
+      _BitScanForward (&index, mask);
+      return (unsigned int) index;
+   #else
+      return (unsigned int) __builtin_ctz (mask);
+   #endif
+}
+
+static size_t json_scan_string_sse2 (const json_char * ptr,
+                                     const json_char * end)
+{
+   const __m128i quote = _mm_set1_epi8 ('"'),
+                 backslash = _mm_set1_epi8 ('\\'),
+                 nul = _mm_setzero_si128 ();
+   const json_char * p = ptr;
+
+   while (end - p >= 16)
+   {
+      __m128i chunk = _mm_loadu_si128 ((const __m128i *) p);
+      unsigned int mask = (unsigned int) _mm_movemask_epi8 (
+         _mm_or_si128 (_mm_or_si128 (_mm_cmpeq_epi8 (chunk, quote),
+                                     _mm_cmpeq_epi8 (chunk, backslash)),
+                       _mm_cmpeq_epi8 (chunk, nul)));
+
+      if (mask)
+         return (p - ptr) + json_first_bit (mask);
+
+      p += 16;
+   }
+
+   return (p - ptr) + json_scan_string_scalar (p, end);
+}
+
+#endif
+
+#ifdef JSON_SCAN_AVX2
+
+__attribute__ ((target ("avx2")))
+static size_t json_scan_string_avx2 (const json_char * ptr,
+                                     const json_char * end)
+{
+   const __m256i quote = _mm256_set1_epi8 ('"'),
+                 backslash = _mm256_set1_epi8 ('\\'),
+                 nul = _mm256_setzero_si256 ();
+   const json_char * p = ptr;
+
+   while (end - p >= 32)
+   {
+      __m256i chunk = _mm256_loadu_si256 ((const __m256i *) p);
+      unsigned int mask = (unsigned int) _mm256_movemask_epi8 (
+         _mm256_or_si256 (_mm256_or_si256 (_mm256_cmpeq_epi8 (chunk, quote),
+                                           _mm256_cmpeq_epi8 (chunk, backslash)),
+                          _mm256_cmpeq_epi8 (chunk, nul)));
+
+      if (mask)
+         return (p - ptr) + json_first_bit (mask);
+
+      p += 32;
+   }
+
+   return (p - ptr) + json_scan_string_sse2 (p, end);
+}
+
+#endif
+
+static json_scan_fn json_select_scan_fn (void)
+{
+   #ifdef JSON_SCAN_AVX2
+      if (__builtin_cpu_supports ("avx2"))
+         return json_scan_string_avx2;
+   #endif
+
+   #ifdef JSON_SCAN_SSE2
+      return json_scan_string_sse2;
+   #else
+      return json_scan_string_scalar;
+   #endif
+}
+
 static unsigned char hex_value (json_char c)
 {
    if (isdigit(c))
@@ -230,6 +357,7 @@ json_value * json_parse_ex (json_settings * settings,
    long flags;
    long num_digits = 0, num_e = 0;
    json_int_t num_fraction = 0;
+   json_scan_fn scan_string = json_select_scan_fn ();
 
    /* Skip UTF-8 BOM
     */
@@ -297,7 +425,7 @@ json_value * json_parse_ex (json_settings * settings,
                   case 't':  string_add ('\t');  break;
                   case 'u':
 
-                    if (end - state.ptr < 4 || 
+                    if (end - state.ptr <= 4 || 
                         (uc_b1 = hex_value (*++ state.ptr)) == 0xFF ||
                         (uc_b2 = hex_value (*++ state.ptr)) == 0xFF ||
                         (uc_b3 = hex_value (*++ state.ptr)) == 0xFF ||
@@ -314,7 +442,7 @@ json_value * json_parse_ex (json_settings * settings,
                     if ((uchar & 0xF800) == 0xD800) {
                         json_uchar uchar2;
                         
-                        if (end - state.ptr < 6 || (*++ state.ptr) != '\\' || (*++ state.ptr) != 'u' ||
+                        if (end - state.ptr <= 6 || (*++ state.ptr) != '\\' || (*++ state.ptr) != 'u' ||
                             (uc_b1 = hex_value (*++ state.ptr)) == 0xFF ||
                             (uc_b2 = hex_value (*++ state.ptr)) == 0xFF ||
                             (uc_b3 = hex_value (*++ state.ptr)) == 0xFF ||
@@ -426,7 +554,17 @@ json_value * json_parse_ex (json_settings * settings,
             }
             else
             {
-               string_add (b);
+               /* Add the whole run of plain bytes starting at b */
+               size_t run = scan_string (state.ptr, end);
+
+               if (run > state.uint_max - string_length)
+                  goto e_overflow;
+
+               if (!state.first_pass)
+                  memcpy (string + string_length, state.ptr, run);
+
+               string_length += (unsigned int) run;
+               state.ptr += run - 1;
                continue;
             }
          }
@@ -593,7 +731,7 @@ json_value * json_parse_ex (json_settings * settings,
 
                      case 't':
 
-                        if ((end - state.ptr) < 3 || *(++ state.ptr) != 'r' ||
+                        if ((end - state.ptr) <= 3 || *(++ state.ptr) != 'r' ||
                             *(++ state.ptr) != 'u' || *(++ state.ptr) != 'e')
                         {
                            goto e_unknown_value;
@@ -609,7 +747,7 @@ json_value * json_parse_ex (json_settings * settings,
 
                      case 'f':
 
-                        if ((end - state.ptr) < 4 || *(++ state.ptr) != 'a' ||
+                        if ((end - state.ptr) <= 4 || *(++ state.ptr) != 'a' ||
                             *(++ state.ptr) != 'l' || *(++ state.ptr) != 's' ||
                             *(++ state.ptr) != 'e')
                         {
@@ -624,7 +762,7 @@ json_value * json_parse_ex (json_settings * settings,
 
                      case 'n':
 
-                        if ((end - state.ptr) < 3 || *(++ state.ptr) != 'u' ||
+                        if ((end - state.ptr) <= 3 || *(++ state.ptr) != 'u' ||
                             *(++ state.ptr) != 'l' || *(++ state.ptr) != 'l')
                         {
                            goto e_unknown_value;
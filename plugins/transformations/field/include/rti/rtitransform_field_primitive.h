@@ -33,6 +33,7 @@
 #define TConfig         RTI_TSFM_Field_PrimitiveTransformationConfig
 #define TState          RTI_TSFM_Field_PrimitiveTransformationState
 #define T_static
+#define T_batch
 #include "rtitransform_simple_tmplt_declare.h"
 
 /*****************************************************************************
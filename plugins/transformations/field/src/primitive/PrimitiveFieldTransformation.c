@@ -584,27 +584,64 @@ done:
 }
 
 DDS_ReturnCode_t 
-RTI_TSFM_Field_PrimitiveTransformation_deserialize(
+RTI_TSFM_Field_PrimitiveTransformation_serialize_batch(
         RTI_TSFM_UserTypePlugin *plugin,
         RTI_TSFM_Transformation *transform,
+        DDS_DynamicData **samples_in,
+        DDS_DynamicData **samples_out,
+        DDS_UnsignedLong count)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong i = 0;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Field_PrimitiveTransformation_serialize_batch)
+
+    /* Every sample is formatted into the same payload buffer of the state,
+     * and copied into its output sample before the next one is formatted */
+    for (i = 0; i < count; i++)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_TSFM_Field_PrimitiveTransformation_serialize(
+                    plugin, transform, samples_in[i], samples_out[i]))
+        {
+            RTI_TSFM_ERROR_1("failed to serialize sample in batch:",
+                "index=%u", i)
+            goto done;
+        }
+    }
+
+    retcode = DDS_RETCODE_OK;
+done:
+
+    RTI_TSFM_TRACE_1("RTI_TSFM_Field_PrimitiveTransformation_serialize_batch:",
+            "retcode=%d", retcode)
+
+    return retcode;
+}
+
+/**
+ * @brief Deserialize the buffer member of a sample, copying it into a
+ * sequence owned by the caller, which can be reused for multiple samples.
+ */
+static DDS_ReturnCode_t 
+RTI_TSFM_Field_PrimitiveTransformation_deserialize_w_seq(
+        RTI_TSFM_Field_PrimitiveTransformation *self,
+        struct DDS_OctetSeq *buffer_seq,
         DDS_DynamicData *sample_in,
         DDS_DynamicData *sample_out)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
-    RTI_TSFM_Field_PrimitiveTransformation *self = 
-            (RTI_TSFM_Field_PrimitiveTransformation*)transform;
-    struct DDS_OctetSeq buffer_seq = DDS_SEQUENCE_INITIALIZER;
     char *buffer_seq_buff = NULL;
     DDS_UnsignedLong buffer_seq_max = 0,
                      buffer_seq_len = 0;
     DDS_Long field_val = 0;
 
-    RTI_TSFM_LOG_FN(RTI_TSFM_Field_PrimitiveTransformation_deserialize)
+    RTI_TSFM_LOG_FN(RTI_TSFM_Field_PrimitiveTransformation_deserialize_w_seq)
 
     if (DDS_RETCODE_OK !=
             DDS_DynamicData_get_octet_seq(
                 sample_in,
-                &buffer_seq,
+                buffer_seq,
                 self->config->buffer_member,
                 DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
     {
@@ -612,7 +649,7 @@ RTI_TSFM_Field_PrimitiveTransformation_deserialize(
         goto done;
     }
 
-    buffer_seq_buff = DDS_OctetSeq_get_contiguous_buffer(&buffer_seq);
+    buffer_seq_buff = DDS_OctetSeq_get_contiguous_buffer(buffer_seq);
     if (buffer_seq_buff == NULL)
     {
         /* TODO Log error */
@@ -621,8 +658,8 @@ RTI_TSFM_Field_PrimitiveTransformation_deserialize(
     /* The buffer should not be printed with printf() because there is
      * no guarantee that the string is well terminated (and most likely 
      * it won't be, i.e. no 'nul' terminator) */
-    buffer_seq_max = DDS_OctetSeq_get_maximum(&buffer_seq);
-    buffer_seq_len = DDS_OctetSeq_get_length(&buffer_seq);
+    buffer_seq_max = DDS_OctetSeq_get_maximum(buffer_seq);
+    buffer_seq_len = DDS_OctetSeq_get_length(buffer_seq);
 
     /* The payload might not be 'nul' terminated, so we copy it into
        a buffer and make sure there is one, so we can interpret safely as
@@ -893,6 +930,25 @@ RTI_TSFM_Field_PrimitiveTransformation_deserialize(
 
     retcode = DDS_RETCODE_OK;
 done:
+    return retcode;
+}
+
+DDS_ReturnCode_t 
+RTI_TSFM_Field_PrimitiveTransformation_deserialize(
+        RTI_TSFM_UserTypePlugin *plugin,
+        RTI_TSFM_Transformation *transform,
+        DDS_DynamicData *sample_in,
+        DDS_DynamicData *sample_out)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    RTI_TSFM_Field_PrimitiveTransformation *self = 
+            (RTI_TSFM_Field_PrimitiveTransformation*)transform;
+    struct DDS_OctetSeq buffer_seq = DDS_SEQUENCE_INITIALIZER;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Field_PrimitiveTransformation_deserialize)
+
+    retcode = RTI_TSFM_Field_PrimitiveTransformation_deserialize_w_seq(
+                self, &buffer_seq, sample_in, sample_out);
 
     if (!DDS_OctetSeq_finalize(&buffer_seq))
     {
@@ -905,8 +961,54 @@ done:
     return retcode;
 }
 
+DDS_ReturnCode_t 
+RTI_TSFM_Field_PrimitiveTransformation_deserialize_batch(
+        RTI_TSFM_UserTypePlugin *plugin,
+        RTI_TSFM_Transformation *transform,
+        DDS_DynamicData **samples_in,
+        DDS_DynamicData **samples_out,
+        DDS_UnsignedLong count)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    RTI_TSFM_Field_PrimitiveTransformation *self = 
+            (RTI_TSFM_Field_PrimitiveTransformation*)transform;
+    /* A single sequence for the whole batch, so that its buffer is only
+     * reallocated when a payload is larger than all the previous ones */
+    struct DDS_OctetSeq buffer_seq = DDS_SEQUENCE_INITIALIZER;
+    DDS_UnsignedLong i = 0;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Field_PrimitiveTransformation_deserialize_batch)
+
+    for (i = 0; i < count; i++)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_TSFM_Field_PrimitiveTransformation_deserialize_w_seq(
+                    self, &buffer_seq, samples_in[i], samples_out[i]))
+        {
+            RTI_TSFM_ERROR_1("failed to deserialize sample in batch:",
+                "index=%u", i)
+            goto done;
+        }
+    }
+
+    retcode = DDS_RETCODE_OK;
+done:
+
+    if (!DDS_OctetSeq_finalize(&buffer_seq))
+    {
+        /* TODO Log error */
+    }
+
+    RTI_TSFM_TRACE_1("RTI_TSFM_Field_PrimitiveTransformation_deserialize_batch:",
+            "retcode=%d", retcode)
+
+    return retcode;
+}
+
+
 #define T               RTI_TSFM_Field_PrimitiveTransformation
 #define TConfig         RTI_TSFM_Field_PrimitiveTransformationConfig
 #define TState          RTI_TSFM_Field_PrimitiveTransformationState
 #define T_static
+#define T_batch
 #include "rtitransform_simple_tmplt_define.h"
@@ -38,10 +38,34 @@ typedef struct RTI_TSFM_Json_FlatTypeTransformation_MemberMappingImpl
 
 typedef struct _json_value json_value;
 
+/**
+ * @brief A JSON value scanned from an input buffer, which is only valid
+ * until the next value is scanned.
+ *
+ * The type of the value is one of the json_type constants defined by
+ * json.h. Only scalar values are stored: objects and arrays are skipped,
+ * and only their type is reported.
+ */
+typedef struct RTI_TSFM_Json_MemberValueImpl
+{
+    int type;
+    union
+    {
+        DDS_Boolean boolean;
+        DDS_LongLong integer;
+        DDS_Double dbl;
+        struct
+        {
+            DDS_UnsignedLong length;
+            char *ptr; /* null terminated */
+        } string;
+    } u;
+} RTI_TSFM_Json_MemberValue;
+
 typedef DDS_ReturnCode_t (*RTI_TSFM_Json_FlatTypeTransformation_ParseMemberFn)(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample);
 
 struct RTI_TSFM_Json_FlatTypeTransformation_MemberMappingImpl
@@ -51,6 +75,7 @@ struct RTI_TSFM_Json_FlatTypeTransformation_MemberMappingImpl
     DDS_UnsignedLong max_len;
     DDS_Boolean optional;
     const char *name;
+    DDS_UnsignedLong name_len;
     RTI_TSFM_Json_FlatTypeTransformation_ParseMemberFn parse_fn;
 };
 
@@ -63,18 +88,41 @@ DDS_SEQUENCE(RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq,
              RTI_TSFM_Json_FlatTypeTransformation_MemberMapping);
 
 
+/**
+ * @brief An entry of the hash table which maps the names of JSON members
+ * to output_mappings.
+ *
+ * mapping is the index of the member mapping plus one, or 0 for a free slot.
+ */
+typedef struct RTI_TSFM_Json_FlatTypeTransformation_MemberSlotImpl
+{
+    DDS_UnsignedLong hash;
+    DDS_UnsignedLong mapping;
+} RTI_TSFM_Json_FlatTypeTransformation_MemberSlot;
+
 typedef struct RTI_TSFM_Json_FlatTypeTransformationStateImpl
 {
     char                *json_buffer;
     DDS_UnsignedLong    json_buffer_size;
     struct RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq output_mappings;
     struct RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq input_mappings;
+    /* Open-addressing table of the output_mappings, by member name */
+    RTI_TSFM_Json_FlatTypeTransformation_MemberSlot *member_slots;
+    DDS_UnsignedLong    member_slots_mask;
+    /* An output mapping was found in the current sample if its mark is
+       equal to member_mark, which changes with every sample */
+    DDS_UnsignedLong    *member_marks;
+    DDS_UnsignedLong    member_mark;
+    /* Unescaped string values, before they are copied into a sample */
+    char                *string_buffer;
+    DDS_UnsignedLong    string_buffer_size;
 } RTI_TSFM_Json_FlatTypeTransformationState;
 
 #define T               RTI_TSFM_Json_FlatTypeTransformation
 #define TConfig         RTI_TSFM_Json_FlatTypeTransformationConfig
 #define TState          RTI_TSFM_Json_FlatTypeTransformationState
 #define T_static
+#define T_batch
 #include "rtitransform_simple_tmplt_declare.h"
 
 /*****************************************************************************
@@ -98,6 +146,69 @@ typedef struct RTI_TSFM_Json_FlatTypeTransformationStateImpl
 #define RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_INDENT \
         RTI_TSFM_JSON_FLATTYPE_TRANSFORMATION_PROPERTY_PREFIX "indent"
 
+/*****************************************************************************
+ *                           JSON Value Arena
+ *****************************************************************************/
+#define RTI_TSFM_JSON_ARENA_SIZE_DEFAULT       4096
+
+typedef struct RTI_TSFM_Json_ArenaBlockImpl RTI_TSFM_Json_ArenaBlock;
+
+/**
+ * @brief A bump allocator for the values created by json_parse_ex.
+ *
+ * Values are allocated from a single buffer and released all at once by
+ * RTI_TSFM_Json_Arena_reset. Allocations that don't fit in the buffer
+ * are served from the heap, and the buffer is grown on the next reset to
+ * hold them, so that parsing documents of a similar size eventually
+ * requires no heap allocation at all.
+ */
+typedef struct RTI_TSFM_Json_ArenaImpl
+{
+    char *buffer;
+    DDS_UnsignedLong buffer_size;
+    DDS_UnsignedLong used;
+    RTI_TSFM_Json_ArenaBlock *blocks;
+    DDS_UnsignedLong blocks_size;
+} RTI_TSFM_Json_Arena;
+
+#define RTI_TSFM_Json_Arena_INITIALIZER \
+{ \
+    NULL, /* buffer */ \
+    0, /* buffer_size */ \
+    0, /* used */ \
+    NULL, /* blocks */ \
+    0 /* blocks_size */ \
+}
+
+DDS_ReturnCode_t
+RTI_TSFM_Json_Arena_initialize(
+    RTI_TSFM_Json_Arena *self,
+    DDS_UnsignedLong size);
+
+void
+RTI_TSFM_Json_Arena_finalize(RTI_TSFM_Json_Arena *self);
+
+DDS_ReturnCode_t
+RTI_TSFM_Json_Arena_reset(RTI_TSFM_Json_Arena *self);
+
+void*
+RTI_TSFM_Json_Arena_allocate(
+    RTI_TSFM_Json_Arena *self,
+    DDS_UnsignedLong size,
+    DDS_Boolean zero);
+
+/**
+ * @brief Parse a JSON document allocating all values from an arena.
+ *
+ * The returned value must not be released with json_value_free: it is
+ * valid until the arena is reset or finalized.
+ */
+json_value*
+RTI_TSFM_Json_Arena_parse(
+    RTI_TSFM_Json_Arena *self,
+    const char *json_buffer,
+    DDS_UnsignedLong json_buffer_size);
+
 /*****************************************************************************
  *                           JSON Shape Parser
  *****************************************************************************/
@@ -107,4 +218,16 @@ RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape(
     DDS_UnsignedLong json_buffer_size,
     DDS_DynamicData *sample);
 
+/**
+ * @brief Same as RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape,
+ * but the JSON document is parsed in an arena, which is reset before
+ * returning. A NULL arena uses the heap.
+ */
+DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape_w_arena(
+    RTI_TSFM_Json_Arena *arena,
+    const char *json_buffer,
+    DDS_UnsignedLong json_buffer_size,
+    DDS_DynamicData *sample);
+
 #endif /* rtitransform_json_flat_h */
\ No newline at end of file
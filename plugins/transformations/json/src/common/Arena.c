@@ -0,0 +1,214 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#include "rtitransform_json_flat.h"
+
+#include "json.h"
+
+#define RTI_TSFM_LOG_ARGS           "rtitransform::json::arena"
+
+/* Alignment of every allocation, enough for any member of a json_value */
+#define RTI_TSFM_JSON_ARENA_ALIGNMENT       8
+
+#define RTI_TSFM_Json_Arena_align(size_) \
+    (((size_) + RTI_TSFM_JSON_ARENA_ALIGNMENT - 1) & \
+        ~((DDS_UnsignedLong) RTI_TSFM_JSON_ARENA_ALIGNMENT - 1))
+
+/**
+ * @brief Header of the blocks allocated from the heap when the buffer of
+ * the arena is full. The union keeps the memory after it aligned.
+ */
+struct RTI_TSFM_Json_ArenaBlockImpl
+{
+    union
+    {
+        RTI_TSFM_Json_ArenaBlock *next;
+        DDS_Double align;
+    } u;
+};
+
+DDS_ReturnCode_t
+RTI_TSFM_Json_Arena_initialize(
+    RTI_TSFM_Json_Arena *self,
+    DDS_UnsignedLong size)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_Arena_initialize)
+
+    self->buffer = NULL;
+    self->buffer_size = 0;
+    self->used = 0;
+    self->blocks = NULL;
+    self->blocks_size = 0;
+
+    if (size == 0)
+    {
+        size = RTI_TSFM_JSON_ARENA_SIZE_DEFAULT;
+    }
+
+    self->buffer = (char*) RTI_TSFM_Heap_allocate(size);
+    if (self->buffer == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    self->buffer_size = size;
+
+    retcode = DDS_RETCODE_OK;
+
+done:
+    return retcode;
+}
+
+static void
+RTI_TSFM_Json_Arena_free_blocks(RTI_TSFM_Json_Arena *self)
+{
+    RTI_TSFM_Json_ArenaBlock *block = NULL;
+
+    while (self->blocks != NULL)
+    {
+        block = self->blocks;
+        self->blocks = block->u.next;
+        RTI_TSFM_Heap_free(block);
+    }
+}
+
+void
+RTI_TSFM_Json_Arena_finalize(RTI_TSFM_Json_Arena *self)
+{
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_Arena_finalize)
+
+    RTI_TSFM_Json_Arena_free_blocks(self);
+    if (self->buffer != NULL)
+    {
+        RTI_TSFM_Heap_free(self->buffer);
+    }
+    self->buffer = NULL;
+    self->buffer_size = 0;
+    self->used = 0;
+    self->blocks_size = 0;
+}
+
+DDS_ReturnCode_t
+RTI_TSFM_Json_Arena_reset(RTI_TSFM_Json_Arena *self)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong buffer_size = self->buffer_size;
+    char *buffer = NULL;
+
+    self->used = 0;
+
+    if (self->blocks == NULL)
+    {
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    /* The buffer was too small for the last document: grow it so that
+     * documents of the same size fit without any heap allocation */
+    RTI_TSFM_Json_Arena_free_blocks(self);
+    while (buffer_size < self->buffer_size + self->blocks_size)
+    {
+        buffer_size *= 2;
+    }
+    self->blocks_size = 0;
+
+    buffer = (char*) RTI_TSFM_Heap_allocate(buffer_size);
+    if (buffer == NULL)
+    {
+        /* The current buffer can still be used */
+        /* TODO Log error */
+        goto done;
+    }
+    RTI_TSFM_Heap_free(self->buffer);
+    self->buffer = buffer;
+    self->buffer_size = buffer_size;
+
+    retcode = DDS_RETCODE_OK;
+
+done:
+    return retcode;
+}
+
+void*
+RTI_TSFM_Json_Arena_allocate(
+    RTI_TSFM_Json_Arena *self,
+    DDS_UnsignedLong size,
+    DDS_Boolean zero)
+{
+    void *ptr = NULL;
+    RTI_TSFM_Json_ArenaBlock *block = NULL;
+
+    size = RTI_TSFM_Json_Arena_align(size);
+
+    if (self->buffer_size - self->used >= size)
+    {
+        ptr = self->buffer + self->used;
+        self->used += size;
+    }
+    else
+    {
+        block = (RTI_TSFM_Json_ArenaBlock*) RTI_TSFM_Heap_allocate(
+                    sizeof(RTI_TSFM_Json_ArenaBlock) + size);
+        if (block == NULL)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        block->u.next = self->blocks;
+        self->blocks = block;
+        self->blocks_size += size;
+        ptr = block + 1;
+    }
+
+    if (zero)
+    {
+        RTI_TSFM_Memory_zero(ptr, size);
+    }
+
+done:
+    return ptr;
+}
+
+static void*
+RTI_TSFM_Json_Arena_json_alloc(size_t size, int zero, void *user_data)
+{
+    return RTI_TSFM_Json_Arena_allocate(
+            (RTI_TSFM_Json_Arena*) user_data,
+            (DDS_UnsignedLong) size,
+            (zero)? DDS_BOOLEAN_TRUE : DDS_BOOLEAN_FALSE);
+}
+
+static void
+RTI_TSFM_Json_Arena_json_free(void *ptr, void *user_data)
+{
+    /* Memory is released all at once by RTI_TSFM_Json_Arena_reset */
+}
+
+json_value*
+RTI_TSFM_Json_Arena_parse(
+    RTI_TSFM_Json_Arena *self,
+    const char *json_buffer,
+    DDS_UnsignedLong json_buffer_size)
+{
+    json_settings settings;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_Arena_parse)
+
+    RTI_TSFM_Memory_zero(&settings, sizeof(settings));
+    settings.mem_alloc = RTI_TSFM_Json_Arena_json_alloc;
+    settings.mem_free = RTI_TSFM_Json_Arena_json_free;
+    settings.user_data = self;
+
+    return json_parse_ex(&settings, json_buffer, json_buffer_size, NULL);
+}
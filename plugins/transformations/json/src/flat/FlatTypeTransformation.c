@@ -23,7 +23,9 @@ RTI_TSFM_Json_FlatTypeTransformation_MemberMapping_initialize_w_params(
 {
     self->kind = DDS_TK_NULL;
     self->id = 0;
+    self->max_len = 0;
     self->name = NULL;
+    self->name_len = 0;
     self->parse_fn = NULL;
     return RTI_TRUE;
 }
@@ -63,7 +65,10 @@ RTI_TSFM_Json_FlatTypeTransformation_MemberMapping_copy(
 {
 
     dst->name = src->name;
+    dst->name_len = src->name_len;
     dst->kind = src->kind;
+    dst->max_len = src->max_len;
+    dst->optional = src->optional;
     dst->id = src->id;
     dst->parse_fn = src->parse_fn;
 
@@ -168,7 +173,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_short(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -181,7 +186,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_short(
     member_val = (DDS_Short) json_member_val->u.integer;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_short(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_short(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -197,7 +202,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_long(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -210,7 +215,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_long(
     member_val = (DDS_Long) json_member_val->u.integer;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_long(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_long(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -226,7 +231,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_ushort(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -239,7 +244,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_ushort(
     member_val = (DDS_UnsignedShort) json_member_val->u.integer;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_ushort(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_ushort(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -255,7 +260,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_ulong(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -268,7 +273,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_ulong(
     member_val = (DDS_UnsignedLong) json_member_val->u.integer;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_ulong(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_ulong(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -284,7 +289,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_ulonglong(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -297,7 +302,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_ulonglong(
     member_val = (DDS_UnsignedLongLong) json_member_val->u.integer;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_ulonglong(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_ulonglong(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -313,7 +318,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_longlong(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -326,7 +331,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_longlong(
     member_val = (DDS_LongLong) json_member_val->u.integer;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_longlong(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_longlong(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -342,7 +347,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_float(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -355,7 +360,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_float(
     member_val = (DDS_Float) json_member_val->u.dbl;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_float(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_float(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -371,7 +376,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_double(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -384,7 +389,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_double(
     member_val = (DDS_Double) json_member_val->u.dbl;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_double(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_double(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -400,7 +405,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_octet(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -413,7 +418,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_octet(
     member_val = (DDS_Octet) json_member_val->u.integer;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_octet(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_octet(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -429,7 +434,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_boolean(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -442,7 +447,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_boolean(
     member_val = (DDS_Boolean) json_member_val->u.boolean;
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_boolean(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_boolean(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -458,7 +463,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_char(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -478,7 +483,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_char(
     member_val = (DDS_Char) json_member_val->u.string.ptr[0];
 
     if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_char(sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, member_val))
+            DDS_DynamicData_set_char(sample, NULL, member->id, member_val))
     {
         /* TODO Log error */
         goto done;
@@ -494,7 +499,7 @@ static DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_parse_member_string(
     RTI_TSFM_Json_FlatTypeTransformation *self,
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
-    json_value *json_member_val,
+    RTI_TSFM_Json_MemberValue *json_member_val,
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
@@ -506,7 +511,7 @@ RTI_TSFM_Json_FlatTypeTransformation_parse_member_string(
 
     if (DDS_RETCODE_OK != 
             DDS_DynamicData_set_string(
-                    sample, member->name, DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED, json_member_val->u.string.ptr))
+                    sample, NULL, member->id, json_member_val->u.string.ptr))
     {
         /* TODO Log error */
         goto done;
@@ -681,105 +686,30 @@ done:
 }
 
 
+/**
+ * @brief Create a mapping for every member of a flat struct type.
+ *
+ * @return DDS_RETCODE_UNSUPPORTED if the type is not a struct, or if any
+ * of its members has a kind which is not supported.
+ */
 static DDS_ReturnCode_t
-RTI_TSFM_Json_FlatTypeTransformation_validate_input_type(
-        RTI_TSFM_Json_FlatTypeTransformation *self,
-        struct DDS_TypeCode *input_type)
-{
-    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
-    RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *mapping = NULL;
-
-    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_validate_input_type)
-
-    if (self->config->parent.type == RTI_TSFM_TransformationKind_SERIALIZER)
-    {
-        /* Nothing to check for serializer mode, since we can serialize any
-         * DDS type using DDS_DynamicData_print_json */
-        retcode = DDS_RETCODE_OK;
-        goto done;
-    }
-
-    /* Check that output type has the specified buffer member */
-    if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_ensure_length(
-            &self->state->input_mappings, 1, 1))
-    {
-        /* TODO Log error */
-        goto done;
-    }
-
-    mapping = 
-        RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
-                &self->state->input_mappings, 0);
-
-    if (DDS_RETCODE_OK != 
-            RTI_TSFM_Json_FlatTypeTransformation_validate_buffer_member(
-                    self, mapping, input_type, self->config->buffer_member))
-    {
-        /* TODO Log error */
-        goto done;
-    }
-    
-    retcode = DDS_RETCODE_OK;
-    
-done:
-    if (retcode != DDS_RETCODE_OK)
-    {
-        if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_set_length(
-                &self->state->input_mappings, 0))
-        {
-            /* TODO Log error */
-        }
-    }
-    return retcode;
-}
-
-static DDS_ReturnCode_t
-RTI_TSFM_Json_FlatTypeTransformation_validate_output_type(
+RTI_TSFM_Json_FlatTypeTransformation_map_members(
         RTI_TSFM_Json_FlatTypeTransformation *self,
-        struct DDS_TypeCode *output_type)
+        struct DDS_TypeCode *type,
+        struct RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq *mappings)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
     DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
     DDS_UnsignedLong members_count = 0,
-                     i = 0,
-                     buffer_member_id = 0;
-    struct DDS_TypeCode *member_type = NULL,
-                        *member_content_type = NULL;
+                     i = 0;
+    struct DDS_TypeCode *member_type = NULL;
     DDS_TCKind tckind = DDS_TK_NULL;
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *mapping = NULL;
 
-    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_validate_output_type)
-
-    if (self->config->parent.type == RTI_TSFM_TransformationKind_SERIALIZER)
-    {
-        /* Check that output type has the specified buffer member */
-        if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_ensure_length(
-                &self->state->output_mappings, 1, 1))
-        {
-            /* TODO Log error */
-            goto done;
-        }
-
-        mapping = 
-            RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
-                    &self->state->output_mappings, 0);
-
-        if (DDS_RETCODE_OK != 
-                RTI_TSFM_Json_FlatTypeTransformation_validate_buffer_member(
-                        self, mapping, output_type, self->config->buffer_member))
-        {
-            /* TODO Log error */
-            goto done;
-        }
-        
-        retcode = DDS_RETCODE_OK;
-        goto done;
-    }
-
-    /* Configure output for deserializer mode */
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_map_members)
 
     /* Check that the base type is a struct (only type supported for now) */
-    tckind = DDS_TypeCode_kind(output_type,&ex);
+    tckind = DDS_TypeCode_kind(type,&ex);
     if (ex != DDS_NO_EXCEPTION_CODE)
     {
         /* TODO Log error */
@@ -787,11 +717,11 @@ RTI_TSFM_Json_FlatTypeTransformation_validate_output_type(
     }
     if (tckind != DDS_TK_STRUCT)
     {
-        /* TODO Log error */
+        retcode = DDS_RETCODE_UNSUPPORTED;
         goto done;
     }
 
-    members_count = DDS_TypeCode_member_count(output_type, &ex);
+    members_count = DDS_TypeCode_member_count(type, &ex);
     if (ex != DDS_NO_EXCEPTION_CODE)
     {
         /* TODO Log error */
@@ -800,13 +730,13 @@ RTI_TSFM_Json_FlatTypeTransformation_validate_output_type(
 
     if (members_count == 0) 
     {
-        /* TODO Log error */
+        retcode = DDS_RETCODE_UNSUPPORTED;
         goto done;
     }
 
-    /* Allocate entries for output_mappings in transformation */
+    /* Allocate entries for the mappings in transformation */
     if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_ensure_length(
-            &self->state->output_mappings, members_count, members_count))
+            mappings, members_count, members_count))
     {
         /* TODO Log error */
         goto done;
@@ -816,8 +746,8 @@ RTI_TSFM_Json_FlatTypeTransformation_validate_output_type(
     {
         mapping = 
             RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
-                    &self->state->output_mappings, i);
-        member_type = DDS_TypeCode_member_type(output_type, i, &ex);
+                    mappings, i);
+        member_type = DDS_TypeCode_member_type(type, i, &ex);
         if (ex != DDS_NO_EXCEPTION_CODE)
         {
             /* TODO Log error */
@@ -833,27 +763,28 @@ RTI_TSFM_Json_FlatTypeTransformation_validate_output_type(
         if (!RTI_TSFM_Json_FlatTypeTransformation_validate_member_tckind(
                     tckind))
         {
-            /* TODO Log error */
+            retcode = DDS_RETCODE_UNSUPPORTED;
             goto done;
         }
 
         mapping->kind = tckind;
-        mapping->id = DDS_TypeCode_member_id(output_type, i, &ex);
+        mapping->id = DDS_TypeCode_member_id(type, i, &ex);
         if (ex != DDS_NO_EXCEPTION_CODE)
         {
             /* TODO Log error */
             goto done;
         }
 
-        mapping->name = DDS_TypeCode_member_name(output_type, i, &ex);
+        mapping->name = DDS_TypeCode_member_name(type, i, &ex);
         if (ex != DDS_NO_EXCEPTION_CODE)
         {
             /* TODO Log error */
             goto done;
         }
+        mapping->name_len = RTI_TSFM_String_length(mapping->name);
 
         mapping->optional = 
-            !DDS_TypeCode_is_member_required(output_type, i, &ex);
+            !DDS_TypeCode_is_member_required(type, i, &ex);
         if (ex != DDS_NO_EXCEPTION_CODE)
         {
             /* TODO Log error */
@@ -867,6 +798,7 @@ RTI_TSFM_Json_FlatTypeTransformation_validate_output_type(
             goto done;
         }
 
+        mapping->max_len = 0;
         if (mapping->kind == DDS_TK_STRING)
         {
             /* Store max_len flag for string values */
@@ -887,7 +819,7 @@ done:
     if (retcode != DDS_RETCODE_OK)
     {
         if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_set_length(
-                &self->state->output_mappings, 0))
+                mappings, 0))
         {
             /* TODO Log error */
         }
@@ -895,264 +827,2276 @@ done:
     return retcode;
 }
 
-DDS_ReturnCode_t
-RTI_TSFM_Json_FlatTypeTransformation_initialize(
-    RTI_TSFM_Json_FlatTypeTransformation *self,
-    RTI_TSFM_Json_FlatTypeTransformationPlugin *plugin,
-    const struct RTI_RoutingServiceTypeInfo *input_type_info,
-    const struct RTI_RoutingServiceTypeInfo *output_type_info,
-    const struct RTI_RoutingServiceProperties *properties,
-    RTI_RoutingServiceEnvironment *env)
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_validate_input_type(
+        RTI_TSFM_Json_FlatTypeTransformation *self,
+        struct DDS_TypeCode *input_type)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
-    struct DDS_TypeCode *tc = NULL;
+    RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *mapping = NULL;
+    DDS_UnsignedLong i = 0;
 
-    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_initialize)
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_validate_input_type)
 
-    if (DDS_RETCODE_OK != RTI_TSFM_Transformation_initialize(
-                                                    &self->parent,
-                                                    &plugin->parent,
-                                                    input_type_info,
-                                                    output_type_info,
-                                                    properties,
-                                                    env))
-    {
-        goto done;
-    }
-    
-    if (input_type_info->type_representation_kind !=
-            RTI_ROUTING_SERVICE_TYPE_REPRESENTATION_DYNAMIC_TYPE)
+    if (self->config->parent.type == RTI_TSFM_TransformationKind_SERIALIZER)
     {
-        /* TODO Log error */
+        /* Any DDS type can be serialized using DDS_DynamicData_print_json,
+         * but compact JSON for flat types is written directly from their
+         * member mappings. An empty sequence of input mappings selects
+         * DDS_DynamicData_print_json. */
+        if (self->config->indent != 0)
+        {
+            retcode = DDS_RETCODE_OK;
+            goto done;
+        }
+
+        retcode = RTI_TSFM_Json_FlatTypeTransformation_map_members(
+                self, input_type, &self->state->input_mappings);
+        if (retcode == DDS_RETCODE_UNSUPPORTED)
+        {
+            retcode = DDS_RETCODE_OK;
+            goto done;
+        }
+        if (retcode != DDS_RETCODE_OK)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+
+        /* The compact writer doesn't print the names of enumerators, so
+         * types with enumerations are still serialized by
+         * DDS_DynamicData_print_json */
+        for (i = 0;
+                i < RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_length(
+                        &self->state->input_mappings);
+                i++)
+        {
+            mapping =
+                RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
+                        &self->state->input_mappings, i);
+            if (mapping->kind == DDS_TK_ENUM)
+            {
+                if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_set_length(
+                        &self->state->input_mappings, 0))
+                {
+                    /* TODO Log error */
+                    retcode = DDS_RETCODE_ERROR;
+                }
+                break;
+            }
+        }
         goto done;
     }
 
-    tc = (struct DDS_TypeCode*) input_type_info->type_representation;
-
-    if (DDS_RETCODE_OK != 
-            RTI_TSFM_Json_FlatTypeTransformation_validate_input_type(self, tc))
+    /* Check that output type has the specified buffer member */
+    if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_ensure_length(
+            &self->state->input_mappings, 1, 1))
     {
         /* TODO Log error */
         goto done;
     }
 
-    tc = (struct DDS_TypeCode*) output_type_info->type_representation;
+    mapping = 
+        RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
+                &self->state->input_mappings, 0);
 
     if (DDS_RETCODE_OK != 
-            RTI_TSFM_Json_FlatTypeTransformation_validate_output_type(self, tc))
+            RTI_TSFM_Json_FlatTypeTransformation_validate_buffer_member(
+                    self, mapping, input_type, self->config->buffer_member))
     {
         /* TODO Log error */
         goto done;
     }
-
+    
     retcode = DDS_RETCODE_OK;
     
 done:
+    if (retcode != DDS_RETCODE_OK)
+    {
+        if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_set_length(
+                &self->state->input_mappings, 0))
+        {
+            /* TODO Log error */
+        }
+    }
     return retcode;
 }
 
+/**
+ * @brief Hash the name of a member (FNV-1a).
+ */
+static DDS_UnsignedLong
+RTI_TSFM_Json_FlatTypeTransformation_hash_member_name(
+        const char *name,
+        DDS_UnsignedLong name_len)
+{
+    DDS_UnsignedLong hash = 2166136261UL,
+                     i = 0;
 
-DDS_ReturnCode_t
-RTI_TSFM_Json_FlatTypeTransformationConfig_parse_from_properties(
-    RTI_TSFM_Json_FlatTypeTransformationConfig *self,
-    const struct RTI_RoutingServiceProperties * properties)
+    for (i = 0; i < name_len; i++)
+    {
+        hash ^= (unsigned char) name[i];
+        hash = (hash * 16777619UL) & 0xFFFFFFFFUL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Build the hash table used to look up the output mappings by the
+ * name of the JSON members.
+ *
+ * The table has at least twice as many slots as there are mappings, so
+ * that lookups rarely probe more than one slot.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_index_output_mappings(
+        RTI_TSFM_Json_FlatTypeTransformation *self)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong mappings_len = 0,
+                     slots_len = 16,
+                     hash = 0,
+                     i = 0,
+                     j = 0;
+    RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *mapping = NULL;
+    RTI_TSFM_Json_FlatTypeTransformation_MemberSlot *slots = NULL;
+    DDS_UnsignedLong *marks = NULL;
 
-    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformationConfig_parse_from_properties)
-    
-    if (DDS_RETCODE_OK != 
-            RTI_TSFM_TransformationConfig_parse_from_properties(
-                    &self->parent, properties))
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_index_output_mappings)
+
+    mappings_len =
+        RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_length(
+                &self->state->output_mappings);
+
+    while (slots_len < 2 * mappings_len)
+    {
+        slots_len *= 2;
+    }
+
+    slots = (RTI_TSFM_Json_FlatTypeTransformation_MemberSlot*)
+            RTI_TSFM_Heap_allocate(
+                sizeof(RTI_TSFM_Json_FlatTypeTransformation_MemberSlot) *
+                    slots_len);
+    if (slots == NULL)
     {
         /* TODO Log error */
         goto done;
     }
+    RTI_TSFM_Memory_zero(slots,
+        sizeof(RTI_TSFM_Json_FlatTypeTransformation_MemberSlot) * slots_len);
 
-    self->serialized_size_min = 255;
-    self->serialized_size_incr = self->serialized_size_min;
-    self->serialized_size_max = -1;
-    self->indent = 0;
+    marks = (DDS_UnsignedLong*)
+            RTI_TSFM_Heap_allocate(sizeof(DDS_UnsignedLong) * mappings_len);
+    if (marks == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    RTI_TSFM_Memory_zero(marks, sizeof(DDS_UnsignedLong) * mappings_len);
 
-    RTI_TSFM_lookup_property(properties, 
-        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_BUFFER_MEMBER,
-        DDS_String_replace(&self->buffer_member,pval);
-        if (self->buffer_member == NULL)
-        {
-            /* TODO Log error */
-            goto done;
-        })
-    
-    RTI_TSFM_lookup_property(properties, 
-        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_SERIALIZED_SIZE_MIN,
-        self->serialized_size_min = 
-                    RTI_TSFM_String_to_long(pval,NULL,0);
-        self->serialized_size_incr = self->serialized_size_min;)
+    for (i = 0; i < mappings_len; i++)
+    {
+        mapping =
+            RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
+                    &self->state->output_mappings, i);
+        hash = RTI_TSFM_Json_FlatTypeTransformation_hash_member_name(
+                    mapping->name, mapping->name_len);
 
-    RTI_TSFM_lookup_property(properties, 
-        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_SERIALIZED_SIZE_MAX,
-        self->serialized_size_max = 
-                    RTI_TSFM_String_to_long(pval,NULL,0);)
+        for (j = hash & (slots_len - 1);
+                slots[j].mapping != 0;
+                j = (j + 1) & (slots_len - 1))
+        {
+            /* linear probing */
+        }
+        slots[j].hash = hash;
+        slots[j].mapping = i + 1;
+    }
 
-    RTI_TSFM_lookup_property(properties, 
-        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_SERIALIZED_SIZE_INCR,
-        self->serialized_size_incr = 
-                    RTI_TSFM_String_to_long(pval,NULL,0);)
-    
-    RTI_TSFM_lookup_property(properties, 
-        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_INDENT,
-        self->indent = 
-                    RTI_TSFM_String_to_long(pval,NULL,0);)
+    if (self->state->member_slots != NULL)
+    {
+        RTI_TSFM_Heap_free(self->state->member_slots);
+    }
+    if (self->state->member_marks != NULL)
+    {
+        RTI_TSFM_Heap_free(self->state->member_marks);
+    }
+    self->state->member_slots = slots;
+    self->state->member_slots_mask = slots_len - 1;
+    self->state->member_marks = marks;
+    self->state->member_mark = 0;
+    slots = NULL;
+    marks = NULL;
 
     retcode = DDS_RETCODE_OK;
+
 done:
+    if (slots != NULL)
+    {
+        RTI_TSFM_Heap_free(slots);
+    }
+    if (marks != NULL)
+    {
+        RTI_TSFM_Heap_free(marks);
+    }
     return retcode;
 }
 
-DDS_ReturnCode_t
-RTI_TSFM_Json_FlatTypeTransformation_serialize(
-        RTI_TSFM_UserTypePlugin *plugin,
-        RTI_TSFM_Transformation *transform,
-        DDS_DynamicData *sample_in,
-        DDS_DynamicData *sample_out)
-{
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_validate_output_type(
+        RTI_TSFM_Json_FlatTypeTransformation *self,
+        struct DDS_TypeCode *output_type)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *mapping = NULL;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_validate_output_type)
+
+    if (self->config->parent.type == RTI_TSFM_TransformationKind_SERIALIZER)
+    {
+        /* Check that output type has the specified buffer member */
+        if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_ensure_length(
+                &self->state->output_mappings, 1, 1))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+
+        mapping = 
+            RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
+                    &self->state->output_mappings, 0);
+
+        if (DDS_RETCODE_OK != 
+                RTI_TSFM_Json_FlatTypeTransformation_validate_buffer_member(
+                        self, mapping, output_type, self->config->buffer_member))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    /* Configure output for deserializer mode */
+    if (DDS_RETCODE_OK !=
+            RTI_TSFM_Json_FlatTypeTransformation_map_members(
+                self, output_type, &self->state->output_mappings))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_TSFM_Json_FlatTypeTransformation_index_output_mappings(self))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    retcode = DDS_RETCODE_OK;
+    
+done:
+    if (retcode != DDS_RETCODE_OK)
+    {
+        if (!RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_set_length(
+                &self->state->output_mappings, 0))
+        {
+            /* TODO Log error */
+        }
+    }
+    return retcode;
+}
+
+DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_initialize(
+    RTI_TSFM_Json_FlatTypeTransformation *self,
+    RTI_TSFM_Json_FlatTypeTransformationPlugin *plugin,
+    const struct RTI_RoutingServiceTypeInfo *input_type_info,
+    const struct RTI_RoutingServiceTypeInfo *output_type_info,
+    const struct RTI_RoutingServiceProperties *properties,
+    RTI_RoutingServiceEnvironment *env)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    struct DDS_TypeCode *tc = NULL;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_initialize)
+
+    if (DDS_RETCODE_OK != RTI_TSFM_Transformation_initialize(
+                                                    &self->parent,
+                                                    &plugin->parent,
+                                                    input_type_info,
+                                                    output_type_info,
+                                                    properties,
+                                                    env))
+    {
+        goto done;
+    }
+    
+    if (input_type_info->type_representation_kind !=
+            RTI_ROUTING_SERVICE_TYPE_REPRESENTATION_DYNAMIC_TYPE)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    tc = (struct DDS_TypeCode*) input_type_info->type_representation;
+
+    if (DDS_RETCODE_OK != 
+            RTI_TSFM_Json_FlatTypeTransformation_validate_input_type(self, tc))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    tc = (struct DDS_TypeCode*) output_type_info->type_representation;
+
+    if (DDS_RETCODE_OK != 
+            RTI_TSFM_Json_FlatTypeTransformation_validate_output_type(self, tc))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    retcode = DDS_RETCODE_OK;
+    
+done:
+    return retcode;
+}
+
+
+DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformationConfig_parse_from_properties(
+    RTI_TSFM_Json_FlatTypeTransformationConfig *self,
+    const struct RTI_RoutingServiceProperties * properties)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformationConfig_parse_from_properties)
+    
+    if (DDS_RETCODE_OK != 
+            RTI_TSFM_TransformationConfig_parse_from_properties(
+                    &self->parent, properties))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    self->serialized_size_min = 255;
+    self->serialized_size_incr = self->serialized_size_min;
+    self->serialized_size_max = -1;
+    self->indent = 0;
+
+    RTI_TSFM_lookup_property(properties, 
+        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_BUFFER_MEMBER,
+        DDS_String_replace(&self->buffer_member,pval);
+        if (self->buffer_member == NULL)
+        {
+            /* TODO Log error */
+            goto done;
+        })
+    
+    RTI_TSFM_lookup_property(properties, 
+        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_SERIALIZED_SIZE_MIN,
+        self->serialized_size_min = 
+                    RTI_TSFM_String_to_long(pval,NULL,0);
+        self->serialized_size_incr = self->serialized_size_min;)
+
+    RTI_TSFM_lookup_property(properties, 
+        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_SERIALIZED_SIZE_MAX,
+        self->serialized_size_max = 
+                    RTI_TSFM_String_to_long(pval,NULL,0);)
+
+    RTI_TSFM_lookup_property(properties, 
+        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_SERIALIZED_SIZE_INCR,
+        self->serialized_size_incr = 
+                    RTI_TSFM_String_to_long(pval,NULL,0);)
+    
+    RTI_TSFM_lookup_property(properties, 
+        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_INDENT,
+        self->indent = 
+                    RTI_TSFM_String_to_long(pval,NULL,0);)
+
+    retcode = DDS_RETCODE_OK;
+done:
+    return retcode;
+}
+
+/* Initial size of the buffer for string values */
+#define RTI_TSFM_JSON_FLATTYPE_STRING_BUFFER_SIZE_MIN   256
+
+/**
+ * @brief Make sure that the string buffer of the transformation can hold
+ * at least size characters. Its content is not preserved.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_reserve_string_buffer(
+    RTI_TSFM_Json_FlatTypeTransformation *self,
+    DDS_UnsignedLong size)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong buffer_size = RTI_TSFM_JSON_FLATTYPE_STRING_BUFFER_SIZE_MIN;
+    char *buffer = NULL;
+
+    if (size <= self->state->string_buffer_size)
+    {
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    while (buffer_size < size)
+    {
+        buffer_size *= 2;
+    }
+
+    buffer = (char*) RTI_TSFM_Heap_allocate(buffer_size);
+    if (buffer == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (self->state->string_buffer != NULL)
+    {
+        RTI_TSFM_Heap_free(self->state->string_buffer);
+    }
+    self->state->string_buffer = buffer;
+    self->state->string_buffer_size = buffer_size;
+
+    retcode = DDS_RETCODE_OK;
+
+done:
+    return retcode;
+}
+
+/*****************************************************************************
+ *                          Compact JSON Writer
+ *****************************************************************************/
+
+/* Enough for any integer, and for floating point values printed with up
+ * to 17 significant digits */
+#define RTI_TSFM_JSON_FLATTYPE_WRITE_NUMBER_LEN_MAX 32
+
+/**
+ * @brief Make sure that json_buffer has room for size_incr more characters
+ * after the first size ones, keeping them.
+ *
+ * The buffer grows like RTI_TSFM_realloc_buffer does, so that it is only
+ * reallocated until it fits the largest sample.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_reserve_json_buffer(
+    RTI_TSFM_Json_FlatTypeTransformation *self,
+    DDS_UnsignedLong size,
+    DDS_UnsignedLong size_incr)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong buffer_size = self->state->json_buffer_size;
+    char *buffer = NULL;
+
+    if (self->state->json_buffer != NULL && size + size_incr <= buffer_size)
+    {
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    if (self->state->json_buffer == NULL || buffer_size == 0)
+    {
+        buffer_size = self->config->serialized_size_min;
+    }
+    while (buffer_size < size + size_incr)
+    {
+        buffer_size += (self->config->serialized_size_incr > 0)?
+            self->config->serialized_size_incr : buffer_size + 1;
+    }
+
+    if (self->config->serialized_size_max > 0 &&
+        buffer_size > (DDS_UnsignedLong) self->config->serialized_size_max)
+    {
+        RTI_TSFM_ERROR_2("serialized sample too large:",
+            "size=%lu, serialized_size_max=%ld",
+            (unsigned long) (size + size_incr),
+            (long) self->config->serialized_size_max)
+        goto done;
+    }
+
+    /* DDS_String_alloc reserves room for a nul terminator */
+    buffer = DDS_String_alloc(buffer_size);
+    if (buffer == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (self->state->json_buffer != NULL)
+    {
+        RTI_TSFM_Memory_copy(buffer, self->state->json_buffer, size);
+        DDS_String_free(self->state->json_buffer);
+    }
+    self->state->json_buffer = buffer;
+    self->state->json_buffer_size = buffer_size;
+
+    retcode = DDS_RETCODE_OK;
+
+done:
+    return retcode;
+}
+
+/**
+ * @brief Print an integer in decimal notation.
+ *
+ * @return The number of characters written.
+ */
+static DDS_UnsignedLong
+RTI_TSFM_Json_FlatTypeTransformation_format_integer(
+    char *out,
+    DDS_UnsignedLongLong magnitude,
+    DDS_Boolean negative)
+{
+    char digits[RTI_TSFM_JSON_FLATTYPE_WRITE_NUMBER_LEN_MAX];
+    DDS_UnsignedLong len = 0,
+                     i = 0;
+
+    do
+    {
+        digits[len++] = (char) ('0' + (magnitude % 10));
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    if (negative)
+    {
+        out[i++] = '-';
+    }
+    while (len > 0)
+    {
+        out[i++] = digits[--len];
+    }
+    return i;
+}
+
+/*
+ * Floating point values are printed with the Grisu2 algorithm (Florian
+ * Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with
+ * Integers", PLDI 2010), ported from the implementations of nlohmann/json
+ * and RapidJSON (MIT licensed, see THIRD-PARTY-NOTICES.md).
+ * The digits always read back to the same value, and they are the
+ * shortest such digits for all but a tiny fraction of the inputs. Output
+ * doesn't depend on the C locale.
+ */
+
+/**
+ * @brief A floating point value f * 2^e with a 64-bit significand.
+ */
+typedef struct RTI_TSFM_Json_DiyFpImpl
+{
+    DDS_UnsignedLongLong f;
+    int e;
+} RTI_TSFM_Json_DiyFp;
+
+/**
+ * @brief A normalized power of ten, c = f * 2^e ~= 10^k. The significand
+ * is split in two 32-bit halves so that the table is plain C89.
+ */
+typedef struct RTI_TSFM_Json_CachedPowerImpl
+{
+    DDS_UnsignedLong f_hi;
+    DDS_UnsignedLong f_lo;
+    int e;
+    int k;
+} RTI_TSFM_Json_CachedPower;
+
+/* Range of the binary exponent of the scaled values */
+#define RTI_TSFM_JSON_GRISU_ALPHA           (-60)
+#define RTI_TSFM_JSON_GRISU_GAMMA           (-32)
+
+#define RTI_TSFM_JSON_GRISU_POWERS_MIN_K    (-300)
+#define RTI_TSFM_JSON_GRISU_POWERS_STEP_K   8
+
+/* Values with their decimal point at a position in (MIN, MAX] relative
+ * to the first digit are printed without an exponent */
+#define RTI_TSFM_JSON_GRISU_EXP_MIN         (-4)
+#define RTI_TSFM_JSON_GRISU_EXP_MAX         15
+
+static const RTI_TSFM_Json_CachedPower
+RTI_TSFM_Json_CachedPower_TABLE[] =
+{
+    { 0xAB70FE17UL, 0xC79AC6CAUL, -1060, -300 },
+    { 0xFF77B1FCUL, 0xBEBCDC4FUL, -1034, -292 },
+    { 0xBE5691EFUL, 0x416BD60CUL, -1007, -284 },
+    { 0x8DD01FADUL, 0x907FFC3CUL,  -980, -276 },
+    { 0xD3515C28UL, 0x31559A83UL,  -954, -268 },
+    { 0x9D71AC8FUL, 0xADA6C9B5UL,  -927, -260 },
+    { 0xEA9C2277UL, 0x23EE8BCBUL,  -901, -252 },
+    { 0xAECC4991UL, 0x4078536DUL,  -874, -244 },
+    { 0x823C1279UL, 0x5DB6CE57UL,  -847, -236 },
+    { 0xC2109436UL, 0x4DFB5637UL,  -821, -228 },
+    { 0x9096EA6FUL, 0x3848984FUL,  -794, -220 },
+    { 0xD77485CBUL, 0x25823AC7UL,  -768, -212 },
+    { 0xA086CFCDUL, 0x97BF97F4UL,  -741, -204 },
+    { 0xEF340A98UL, 0x172AACE5UL,  -715, -196 },
+    { 0xB23867FBUL, 0x2A35B28EUL,  -688, -188 },
+    { 0x84C8D4DFUL, 0xD2C63F3BUL,  -661, -180 },
+    { 0xC5DD4427UL, 0x1AD3CDBAUL,  -635, -172 },
+    { 0x936B9FCEUL, 0xBB25C996UL,  -608, -164 },
+    { 0xDBAC6C24UL, 0x7D62A584UL,  -582, -156 },
+    { 0xA3AB6658UL, 0x0D5FDAF6UL,  -555, -148 },
+    { 0xF3E2F893UL, 0xDEC3F126UL,  -529, -140 },
+    { 0xB5B5ADA8UL, 0xAAFF80B8UL,  -502, -132 },
+    { 0x87625F05UL, 0x6C7C4A8BUL,  -475, -124 },
+    { 0xC9BCFF60UL, 0x34C13053UL,  -449, -116 },
+    { 0x964E858CUL, 0x91BA2655UL,  -422, -108 },
+    { 0xDFF97724UL, 0x70297EBDUL,  -396, -100 },
+    { 0xA6DFBD9FUL, 0xB8E5B88FUL,  -369,  -92 },
+    { 0xF8A95FCFUL, 0x88747D94UL,  -343,  -84 },
+    { 0xB9447093UL, 0x8FA89BCFUL,  -316,  -76 },
+    { 0x8A08F0F8UL, 0xBF0F156BUL,  -289,  -68 },
+    { 0xCDB02555UL, 0x653131B6UL,  -263,  -60 },
+    { 0x993FE2C6UL, 0xD07B7FACUL,  -236,  -52 },
+    { 0xE45C10C4UL, 0x2A2B3B06UL,  -210,  -44 },
+    { 0xAA242499UL, 0x697392D3UL,  -183,  -36 },
+    { 0xFD87B5F2UL, 0x8300CA0EUL,  -157,  -28 },
+    { 0xBCE50864UL, 0x92111AEBUL,  -130,  -20 },
+    { 0x8CBCCC09UL, 0x6F5088CCUL,  -103,  -12 },
+    { 0xD1B71758UL, 0xE219652CUL,   -77,   -4 },
+    { 0x9C400000UL, 0x00000000UL,   -50,    4 },
+    { 0xE8D4A510UL, 0x00000000UL,   -24,   12 },
+    { 0xAD78EBC5UL, 0xAC620000UL,     3,   20 },
+    { 0x813F3978UL, 0xF8940984UL,    30,   28 },
+    { 0xC097CE7BUL, 0xC90715B3UL,    56,   36 },
+    { 0x8F7E32CEUL, 0x7BEA5C70UL,    83,   44 },
+    { 0xD5D238A4UL, 0xABE98068UL,   109,   52 },
+    { 0x9F4F2726UL, 0x179A2245UL,   136,   60 },
+    { 0xED63A231UL, 0xD4C4FB27UL,   162,   68 },
+    { 0xB0DE6538UL, 0x8CC8ADA8UL,   189,   76 },
+    { 0x83C7088EUL, 0x1AAB65DBUL,   216,   84 },
+    { 0xC45D1DF9UL, 0x42711D9AUL,   242,   92 },
+    { 0x924D692CUL, 0xA61BE758UL,   269,  100 },
+    { 0xDA01EE64UL, 0x1A708DEAUL,   295,  108 },
+    { 0xA26DA399UL, 0x9AEF774AUL,   322,  116 },
+    { 0xF209787BUL, 0xB47D6B85UL,   348,  124 },
+    { 0xB454E4A1UL, 0x79DD1877UL,   375,  132 },
+    { 0x865B8692UL, 0x5B9BC5C2UL,   402,  140 },
+    { 0xC83553C5UL, 0xC8965D3DUL,   428,  148 },
+    { 0x952AB45CUL, 0xFA97A0B3UL,   455,  156 },
+    { 0xDE469FBDUL, 0x99A05FE3UL,   481,  164 },
+    { 0xA59BC234UL, 0xDB398C25UL,   508,  172 },
+    { 0xF6C69A72UL, 0xA3989F5CUL,   534,  180 },
+    { 0xB7DCBF53UL, 0x54E9BECEUL,   561,  188 },
+    { 0x88FCF317UL, 0xF22241E2UL,   588,  196 },
+    { 0xCC20CE9BUL, 0xD35C78A5UL,   614,  204 },
+    { 0x98165AF3UL, 0x7B2153DFUL,   641,  212 },
+    { 0xE2A0B5DCUL, 0x971F303AUL,   667,  220 },
+    { 0xA8D9D153UL, 0x5CE3B396UL,   694,  228 },
+    { 0xFB9B7CD9UL, 0xA4A7443CUL,   720,  236 },
+    { 0xBB764C4CUL, 0xA7A44410UL,   747,  244 },
+    { 0x8BAB8EEFUL, 0xB6409C1AUL,   774,  252 },
+    { 0xD01FEF10UL, 0xA657842CUL,   800,  260 },
+    { 0x9B10A4E5UL, 0xE9913129UL,   827,  268 },
+    { 0xE7109BFBUL, 0xA19C0C9DUL,   853,  276 },
+    { 0xAC2820D9UL, 0x623BF429UL,   880,  284 },
+    { 0x80444B5EUL, 0x7AA7CF85UL,   907,  292 },
+    { 0xBF21E440UL, 0x03ACDD2DUL,   933,  300 },
+    { 0x8E679C2FUL, 0x5E44FF8FUL,   960,  308 },
+    { 0xD433179DUL, 0x9C8CB841UL,   986,  316 },
+    { 0x9E19DB92UL, 0xB4E31BA9UL,  1013,  324 }
+};
+
+static RTI_TSFM_Json_DiyFp
+RTI_TSFM_Json_DiyFp_make(DDS_UnsignedLongLong f, int e)
+{
+    RTI_TSFM_Json_DiyFp x;
+
+    x.f = f;
+    x.e = e;
+    return x;
+}
+
+/**
+ * @brief Upper 64 bits of the 128-bit product of two values, rounded.
+ */
+static RTI_TSFM_Json_DiyFp
+RTI_TSFM_Json_DiyFp_mul(RTI_TSFM_Json_DiyFp x, RTI_TSFM_Json_DiyFp y)
+{
+    const DDS_UnsignedLongLong mask = 0xFFFFFFFFUL;
+    DDS_UnsignedLongLong x_lo = x.f & mask,
+                         x_hi = x.f >> 32,
+                         y_lo = y.f & mask,
+                         y_hi = y.f >> 32,
+                         p0 = x_lo * y_lo,
+                         p1 = x_lo * y_hi,
+                         p2 = x_hi * y_lo,
+                         p3 = x_hi * y_hi,
+                         q = 0;
+
+    q = (p0 >> 32) + (p1 & mask) + (p2 & mask);
+    q += ((DDS_UnsignedLongLong) 1) << 31;
+
+    return RTI_TSFM_Json_DiyFp_make(
+            p3 + (p2 >> 32) + (p1 >> 32) + (q >> 32), x.e + y.e + 64);
+}
+
+static RTI_TSFM_Json_DiyFp
+RTI_TSFM_Json_DiyFp_normalize(RTI_TSFM_Json_DiyFp x)
+{
+    while ((x.f >> 63) == 0)
+    {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+/**
+ * @brief Compute the normalized value v and the boundaries m- and m+ of
+ * the interval of values which round to v, with the exponent of m+.
+ *
+ * @param bits The binary representation of the value, which is not zero,
+ * NaN or infinite, without its sign.
+ * @param significand_bits The number of explicit significand bits of the
+ * format (52 for double, 23 for float).
+ * @param bias The exponent bias of the format, plus significand_bits.
+ */
+static void
+RTI_TSFM_Json_DiyFp_compute_boundaries(
+    DDS_UnsignedLongLong bits,
+    int significand_bits,
+    int bias,
+    RTI_TSFM_Json_DiyFp *v,
+    RTI_TSFM_Json_DiyFp *m_minus,
+    RTI_TSFM_Json_DiyFp *m_plus)
+{
+    const DDS_UnsignedLongLong hidden_bit =
+        ((DDS_UnsignedLongLong) 1) << significand_bits;
+    DDS_UnsignedLongLong significand = bits & (hidden_bit - 1);
+    int exponent = (int) (bits >> significand_bits);
+    RTI_TSFM_Json_DiyFp value;
+
+    if (exponent == 0)
+    {
+        /* Subnormal */
+        value = RTI_TSFM_Json_DiyFp_make(significand, 1 - bias);
+    }
+    else
+    {
+        value = RTI_TSFM_Json_DiyFp_make(
+                significand + hidden_bit, exponent - bias);
+    }
+
+    *m_plus = RTI_TSFM_Json_DiyFp_normalize(
+            RTI_TSFM_Json_DiyFp_make(2 * value.f + 1, value.e - 1));
+
+    /* The lower boundary is closer for powers of two, except for the
+     * smallest normal value */
+    if (significand == 0 && exponent > 1)
+    {
+        *m_minus = RTI_TSFM_Json_DiyFp_make(4 * value.f - 1, value.e - 2);
+    }
+    else
+    {
+        *m_minus = RTI_TSFM_Json_DiyFp_make(2 * value.f - 1, value.e - 1);
+    }
+    m_minus->f <<= m_minus->e - m_plus->e;
+    m_minus->e = m_plus->e;
+
+    *v = RTI_TSFM_Json_DiyFp_normalize(value);
+}
+
+/**
+ * @brief Find a cached power of ten c = 10^-k such that the binary
+ * exponent of c * 2^e is in [ALPHA, GAMMA].
+ */
+static const RTI_TSFM_Json_CachedPower*
+RTI_TSFM_Json_CachedPower_find(int e)
+{
+    /* k = ceil((ALPHA - e - 1) * log10(2)), with 78913 / 2^18 ~ log10(2).
+     * The product is shifted as a positive value, because the shift of
+     * a negative value is implementation defined in C89 */
+    const long f = RTI_TSFM_JSON_GRISU_ALPHA - e - 1;
+    long k = 0;
+
+    if (f > 0)
+    {
+        k = ((f * 78913L) >> 18) + 1;
+    }
+    else
+    {
+        k = -((-f * 78913L) >> 18);
+    }
+
+    return &RTI_TSFM_Json_CachedPower_TABLE[
+            (-RTI_TSFM_JSON_GRISU_POWERS_MIN_K + k +
+                (RTI_TSFM_JSON_GRISU_POWERS_STEP_K - 1)) /
+            RTI_TSFM_JSON_GRISU_POWERS_STEP_K];
+}
+
+/**
+ * @brief Move the last digit of buffer towards w while the result stays
+ * in the rounding interval.
+ */
+static void
+RTI_TSFM_Json_Grisu_round(
+    char *buffer,
+    int length,
+    DDS_UnsignedLongLong dist,
+    DDS_UnsignedLongLong delta,
+    DDS_UnsignedLongLong rest,
+    DDS_UnsignedLongLong ten_k)
+{
+    while (rest < dist &&
+           delta - rest >= ten_k &&
+           (rest + ten_k < dist || dist - rest > rest + ten_k - dist))
+    {
+        buffer[length - 1]--;
+        rest += ten_k;
+    }
+}
+
+/**
+ * @brief Generate the shortest digits of a value in (M-, M+), closest to
+ * w, as buffer * 10^decimal_exponent.
+ */
+static void
+RTI_TSFM_Json_Grisu_generate_digits(
+    char *buffer,
+    int *length,
+    int *decimal_exponent,
+    RTI_TSFM_Json_DiyFp m_minus,
+    RTI_TSFM_Json_DiyFp w,
+    RTI_TSFM_Json_DiyFp m_plus)
+{
+    const int shift = -m_plus.e;
+    const DDS_UnsignedLongLong one = ((DDS_UnsignedLongLong) 1) << shift;
+    DDS_UnsignedLongLong delta = m_plus.f - m_minus.f,
+                         dist = m_plus.f - w.f,
+                         p2 = m_plus.f & (one - 1),
+                         rest = 0;
+    DDS_UnsignedLong p1 = (DDS_UnsignedLong) (m_plus.f >> shift),
+                     pow10 = 1000000000UL,
+                     digit = 0;
+    int n = 10,
+        m = 0;
+
+    /* Integral part: p1 < 10^10 because of the range of the exponent */
+    while (n > 1 && p1 < pow10)
+    {
+        pow10 /= 10;
+        n--;
+    }
+
+    while (n > 0)
+    {
+        digit = p1 / pow10;
+        p1 %= pow10;
+        buffer[(*length)++] = (char) ('0' + digit);
+        n--;
+
+        rest = (((DDS_UnsignedLongLong) p1) << shift) + p2;
+        if (rest <= delta)
+        {
+            *decimal_exponent += n;
+            RTI_TSFM_Json_Grisu_round(
+                    buffer, *length, dist, delta, rest,
+                    ((DDS_UnsignedLongLong) pow10) << shift);
+            return;
+        }
+        pow10 /= 10;
+    }
+
+    /* Fractional part */
+    for (;;)
+    {
+        p2 *= 10;
+        buffer[(*length)++] = (char) ('0' + (p2 >> shift));
+        p2 &= one - 1;
+        m++;
+        delta *= 10;
+        dist *= 10;
+        if (p2 <= delta)
+        {
+            break;
+        }
+    }
+    *decimal_exponent -= m;
+    RTI_TSFM_Json_Grisu_round(buffer, *length, dist, delta, p2, one);
+}
+
+/**
+ * @brief Print a positive decimal exponent as e+NN, e-NN or e+NNN.
+ */
+static char*
+RTI_TSFM_Json_Grisu_write_exponent(char *out, int e)
+{
+    *out++ = 'e';
+    if (e < 0)
+    {
+        e = -e;
+        *out++ = '-';
+    }
+    else
+    {
+        *out++ = '+';
+    }
+    if (e >= 100)
+    {
+        *out++ = (char) ('0' + e / 100);
+        e %= 100;
+    }
+    *out++ = (char) ('0' + e / 10);
+    *out++ = (char) ('0' + e % 10);
+    return out;
+}
+
+/**
+ * @brief Lay out digits * 10^decimal_exponent as a JSON number which
+ * always has a fraction or an exponent. out holds the digits on input and
+ * must have room for 24 characters.
+ */
+static char*
+RTI_TSFM_Json_Grisu_format(char *out, int length, int decimal_exponent)
+{
+    /* Position of the decimal point, relative to the first digit */
+    const int point = length + decimal_exponent;
+    int i = 0;
+
+    if (length <= point && point <= RTI_TSFM_JSON_GRISU_EXP_MAX)
+    {
+        /* digits[000].0 */
+        for (i = length; i < point; i++)
+        {
+            out[i] = '0';
+        }
+        out[point] = '.';
+        out[point + 1] = '0';
+        return out + point + 2;
+    }
+
+    if (0 < point && point <= RTI_TSFM_JSON_GRISU_EXP_MAX)
+    {
+        /* dig.its */
+        RTI_TSFM_Memory_move(out + point + 1, out + point, length - point);
+        out[point] = '.';
+        return out + length + 1;
+    }
+
+    if (RTI_TSFM_JSON_GRISU_EXP_MIN < point && point <= 0)
+    {
+        /* 0.[000]digits */
+        RTI_TSFM_Memory_move(out + 2 - point, out, length);
+        out[0] = '0';
+        out[1] = '.';
+        for (i = 2; i < 2 - point; i++)
+        {
+            out[i] = '0';
+        }
+        return out + 2 - point + length;
+    }
+
+    /* d[.igits]e+NN */
+    if (length > 1)
+    {
+        RTI_TSFM_Memory_move(out + 2, out + 1, length - 1);
+        out[1] = '.';
+        out += length + 1;
+    }
+    else
+    {
+        out += 1;
+    }
+    return RTI_TSFM_Json_Grisu_write_exponent(out, point - 1);
+}
+
+/**
+ * @brief Print a floating point value with the shortest digits which read
+ * back to the same value, in the precision of the member.
+ *
+ * Integral values keep a fraction, so that they are deserialized as
+ * doubles. JSON has no representation for NaN and infinity, which are
+ * printed as null.
+ *
+ * @return The number of characters written, at most 25.
+ */
+static DDS_UnsignedLong
+RTI_TSFM_Json_FlatTypeTransformation_format_double(
+    char *out,
+    DDS_Double value,
+    DDS_Boolean single_precision)
+{
+    DDS_Float float_value = (DDS_Float) value;
+    DDS_UnsignedLong float_bits = 0;
+    DDS_UnsignedLongLong bits = 0;
+    RTI_TSFM_Json_DiyFp v,
+                        m_minus,
+                        m_plus,
+                        c;
+    const RTI_TSFM_Json_CachedPower *cached = NULL;
+    char *start = out;
+    int length = 0,
+        decimal_exponent = 0;
+
+    if (value != value || value - value != 0.0)
+    {
+        RTI_TSFM_Memory_copy(out, "null", 4);
+        return 4;
+    }
+
+    if (value < 0.0 || (value == 0.0 && 1.0 / value < 0.0))
+    {
+        *out++ = '-';
+        value = -value;
+        float_value = -float_value;
+    }
+    if (value == 0.0)
+    {
+        RTI_TSFM_Memory_copy(out, "0.0", 3);
+        return (DDS_UnsignedLong) (out - start) + 3;
+    }
+
+    if (single_precision)
+    {
+        RTI_TSFM_Memory_copy(&float_bits, &float_value, sizeof(float_bits));
+        RTI_TSFM_Json_DiyFp_compute_boundaries(
+                float_bits, 23, 127 + 23, &v, &m_minus, &m_plus);
+    }
+    else
+    {
+        RTI_TSFM_Memory_copy(&bits, &value, sizeof(bits));
+        RTI_TSFM_Json_DiyFp_compute_boundaries(
+                bits, 52, 1023 + 52, &v, &m_minus, &m_plus);
+    }
+
+    /* Scale the value and its boundaries by 10^-k, so that the integral
+     * part of the result fits in 32 bits */
+    cached = RTI_TSFM_Json_CachedPower_find(m_plus.e);
+    c = RTI_TSFM_Json_DiyFp_make(
+            (((DDS_UnsignedLongLong) cached->f_hi) << 32) | cached->f_lo,
+            cached->e);
+    v = RTI_TSFM_Json_DiyFp_mul(v, c);
+    m_minus = RTI_TSFM_Json_DiyFp_mul(m_minus, c);
+    m_plus = RTI_TSFM_Json_DiyFp_mul(m_plus, c);
+
+    /* Stay inside the interval despite the rounding of the products */
+    m_minus.f += 1;
+    m_plus.f -= 1;
+
+    decimal_exponent = -cached->k;
+    RTI_TSFM_Json_Grisu_generate_digits(
+            out, &length, &decimal_exponent, m_minus, v, m_plus);
+
+    out = RTI_TSFM_Json_Grisu_format(out, length, decimal_exponent);
+    return (DDS_UnsignedLong) (out - start);
+}
+
+/**
+ * @brief Print a string as a quoted JSON string.
+ *
+ * Characters are checked eight at a time with bitwise operations on a
+ * 64-bit word, and runs which don't need to be escaped are copied as a
+ * whole. out must have room for 6 * len + 2 characters.
+ *
+ * @return The number of characters written.
+ */
+static DDS_UnsignedLong
+RTI_TSFM_Json_FlatTypeTransformation_format_string(
+    char *out,
+    const char *str,
+    DDS_UnsignedLong len)
+{
+    static const char hex_digits[] = "0123456789abcdef";
+    const DDS_UnsignedLongLong ones = ((DDS_UnsignedLongLong) -1) / 0xFF,
+                               highs = ones * 0x80;
+    DDS_UnsignedLongLong word = 0,
+                         quotes = 0,
+                         backslashes = 0;
+    DDS_UnsignedLong i = 0,
+                     o = 0;
+    unsigned char c = 0;
+
+    out[o++] = '"';
+
+    while (i < len)
+    {
+        /* A byte of the word is flagged if it is a control character,
+         * a quote or a backslash (bytes above a flagged one may be flagged
+         * too, which only sends them to the slow path) */
+        while (len - i >= sizeof(word))
+        {
+            RTI_TSFM_Memory_copy(&word, str + i, sizeof(word));
+            quotes = word ^ (ones * '"');
+            backslashes = word ^ (ones * '\\');
+            if ((((word - ones * 0x20) & ~word) |
+                 ((quotes - ones) & ~quotes) |
+                 ((backslashes - ones) & ~backslashes)) & highs)
+            {
+                break;
+            }
+            RTI_TSFM_Memory_copy(out + o, str + i, sizeof(word));
+            i += sizeof(word);
+            o += sizeof(word);
+        }
+        if (i >= len)
+        {
+            break;
+        }
+
+        c = (unsigned char) str[i++];
+        switch (c)
+        {
+        case '"':   out[o++] = '\\'; out[o++] = '"';  break;
+        case '\\':  out[o++] = '\\'; out[o++] = '\\'; break;
+        case '\b':  out[o++] = '\\'; out[o++] = 'b';  break;
+        case '\f':  out[o++] = '\\'; out[o++] = 'f';  break;
+        case '\n':  out[o++] = '\\'; out[o++] = 'n';  break;
+        case '\r':  out[o++] = '\\'; out[o++] = 'r';  break;
+        case '\t':  out[o++] = '\\'; out[o++] = 't';  break;
+        default:
+            if (c < 0x20)
+            {
+                out[o++] = '\\';
+                out[o++] = 'u';
+                out[o++] = '0';
+                out[o++] = '0';
+                out[o++] = hex_digits[c >> 4];
+                out[o++] = hex_digits[c & 0xF];
+            }
+            else
+            {
+                out[o++] = (char) c;
+            }
+        }
+    }
+
+    out[o++] = '"';
+    return o;
+}
+
+/**
+ * @brief Get the value of a string member into the string buffer of the
+ * transformation, growing it if the string doesn't fit.
+ *
+ * When the buffer is too small, DDS_DynamicData_get_string fails with
+ * DDS_RETCODE_OUT_OF_RESOURCES and returns the length of the string, so
+ * the buffer is grown at most once per call.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_get_string_member(
+    RTI_TSFM_Json_FlatTypeTransformation *self,
+    RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
+    DDS_DynamicData *sample)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong size = 0;
+    char *value = NULL;
+
+    if (self->state->string_buffer == NULL)
+    {
+        retcode =
+            RTI_TSFM_Json_FlatTypeTransformation_reserve_string_buffer(
+                self, 1);
+        if (retcode != DDS_RETCODE_OK)
+        {
+            goto done;
+        }
+    }
+
+    value = self->state->string_buffer;
+    size = self->state->string_buffer_size;
+    retcode = DDS_DynamicData_get_string(
+            sample, &value, &size, NULL, member->id);
+    if (retcode != DDS_RETCODE_OUT_OF_RESOURCES)
+    {
+        goto done;
+    }
+
+    /* size is the length of the string, without its nul terminator */
+    if (size < self->state->string_buffer_size || size > member->max_len)
+    {
+        RTI_TSFM_ERROR_2("invalid length of string member:",
+            "member=%s, length=%lu", member->name, (unsigned long) size)
+        retcode = DDS_RETCODE_ERROR;
+        goto done;
+    }
+    retcode = RTI_TSFM_Json_FlatTypeTransformation_reserve_string_buffer(
+            self, size + 1);
+    if (retcode != DDS_RETCODE_OK)
+    {
+        goto done;
+    }
+
+    value = self->state->string_buffer;
+    size = self->state->string_buffer_size;
+    retcode = DDS_DynamicData_get_string(
+            sample, &value, &size, NULL, member->id);
+
+done:
+    return retcode;
+}
+
+/**
+ * @brief Append a member of a sample to json_buffer, as "name":value.
+ *
+ * @return DDS_RETCODE_NO_DATA if the member is an optional member without
+ * a value, which is omitted.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_write_member(
+    RTI_TSFM_Json_FlatTypeTransformation *self,
+    RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *member,
+    DDS_DynamicData *sample,
+    DDS_UnsignedLong *size)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    char number[RTI_TSFM_JSON_FLATTYPE_WRITE_NUMBER_LEN_MAX];
+    DDS_UnsignedLong number_len = 0,
+                     string_len = 0,
+                     value_len_max = 0;
+    DDS_Short short_val = 0;
+    DDS_UnsignedShort ushort_val = 0;
+    DDS_Long long_val = 0;
+    DDS_UnsignedLong ulong_val = 0;
+    DDS_LongLong longlong_val = 0;
+    DDS_UnsignedLongLong ulonglong_val = 0;
+    DDS_Octet octet_val = 0;
+    DDS_Float float_val = .0;
+    DDS_Double double_val = .0;
+    DDS_Boolean boolean_val = DDS_BOOLEAN_FALSE;
+    DDS_Char char_val = '\0';
+    char *out = NULL;
+
+    switch (member->kind)
+    {
+    case DDS_TK_SHORT:
+        retcode = DDS_DynamicData_get_short(
+                sample, &short_val, NULL, member->id);
+        longlong_val = short_val;
+        break;
+    case DDS_TK_USHORT:
+        retcode = DDS_DynamicData_get_ushort(
+                sample, &ushort_val, NULL, member->id);
+        ulonglong_val = ushort_val;
+        break;
+    case DDS_TK_LONG:
+        retcode = DDS_DynamicData_get_long(
+                sample, &long_val, NULL, member->id);
+        longlong_val = long_val;
+        break;
+    case DDS_TK_ULONG:
+        retcode = DDS_DynamicData_get_ulong(
+                sample, &ulong_val, NULL, member->id);
+        ulonglong_val = ulong_val;
+        break;
+    case DDS_TK_LONGLONG:
+        retcode = DDS_DynamicData_get_longlong(
+                sample, &longlong_val, NULL, member->id);
+        break;
+    case DDS_TK_ULONGLONG:
+        retcode = DDS_DynamicData_get_ulonglong(
+                sample, &ulonglong_val, NULL, member->id);
+        break;
+    case DDS_TK_OCTET:
+        retcode = DDS_DynamicData_get_octet(
+                sample, &octet_val, NULL, member->id);
+        ulonglong_val = octet_val;
+        break;
+    case DDS_TK_FLOAT:
+        retcode = DDS_DynamicData_get_float(
+                sample, &float_val, NULL, member->id);
+        break;
+    case DDS_TK_DOUBLE:
+        retcode = DDS_DynamicData_get_double(
+                sample, &double_val, NULL, member->id);
+        break;
+    case DDS_TK_BOOLEAN:
+        retcode = DDS_DynamicData_get_boolean(
+                sample, &boolean_val, NULL, member->id);
+        break;
+    case DDS_TK_CHAR:
+        retcode = DDS_DynamicData_get_char(
+                sample, &char_val, NULL, member->id);
+        break;
+    case DDS_TK_STRING:
+        retcode = RTI_TSFM_Json_FlatTypeTransformation_get_string_member(
+                self, member, sample);
+        break;
+    default:
+        /* TODO Log error */
+        goto done;
+    }
+    if (retcode != DDS_RETCODE_OK)
+    {
+        if (retcode != DDS_RETCODE_NO_DATA)
+        {
+            RTI_TSFM_ERROR_2("failed to get member value:",
+                "member=%s, retcode=%d", member->name, retcode)
+        }
+        goto done;
+    }
+    retcode = DDS_RETCODE_ERROR;
+
+    switch (member->kind)
+    {
+    case DDS_TK_SHORT:
+    case DDS_TK_LONG:
+    case DDS_TK_LONGLONG:
+        number_len = RTI_TSFM_Json_FlatTypeTransformation_format_integer(
+                number,
+                (longlong_val < 0)?
+                    0 - (DDS_UnsignedLongLong) longlong_val :
+                    (DDS_UnsignedLongLong) longlong_val,
+                longlong_val < 0);
+        break;
+    case DDS_TK_USHORT:
+    case DDS_TK_ULONG:
+    case DDS_TK_ULONGLONG:
+    case DDS_TK_OCTET:
+        number_len = RTI_TSFM_Json_FlatTypeTransformation_format_integer(
+                number, ulonglong_val, DDS_BOOLEAN_FALSE);
+        break;
+    case DDS_TK_FLOAT:
+        number_len = RTI_TSFM_Json_FlatTypeTransformation_format_double(
+                number, float_val, DDS_BOOLEAN_TRUE);
+        break;
+    case DDS_TK_DOUBLE:
+        number_len = RTI_TSFM_Json_FlatTypeTransformation_format_double(
+                number, double_val, DDS_BOOLEAN_FALSE);
+        break;
+    case DDS_TK_BOOLEAN:
+        number_len = (boolean_val)? 4 : 5;
+        RTI_TSFM_Memory_copy(
+                number, (boolean_val)? "true" : "false", number_len);
+        break;
+    case DDS_TK_CHAR:
+        /* Printed as a string of one character */
+        string_len = (char_val == '\0')? 0 : 1;
+        break;
+    default:
+        string_len = RTI_TSFM_String_length(self->state->string_buffer);
+        break;
+    }
+
+    if (member->kind == DDS_TK_STRING || member->kind == DDS_TK_CHAR)
+    {
+        value_len_max = 6 * string_len + 2;
+    }
+    else
+    {
+        value_len_max = number_len;
+    }
+
+    /* ,"name":value */
+    if (DDS_RETCODE_OK !=
+            RTI_TSFM_Json_FlatTypeTransformation_reserve_json_buffer(
+                self, *size, member->name_len + 4 + value_len_max))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    out = self->state->json_buffer + *size;
+    if (*size > 1)
+    {
+        *out++ = ',';
+    }
+    *out++ = '"';
+    RTI_TSFM_Memory_copy(out, member->name, member->name_len);
+    out += member->name_len;
+    *out++ = '"';
+    *out++ = ':';
+
+    if (member->kind == DDS_TK_STRING)
+    {
+        out += RTI_TSFM_Json_FlatTypeTransformation_format_string(
+                out, self->state->string_buffer, string_len);
+    }
+    else if (member->kind == DDS_TK_CHAR)
+    {
+        out += RTI_TSFM_Json_FlatTypeTransformation_format_string(
+                out, &char_val, string_len);
+    }
+    else
+    {
+        RTI_TSFM_Memory_copy(out, number, number_len);
+        out += number_len;
+    }
+
+    *size = (DDS_UnsignedLong) (out - self->state->json_buffer);
+
+    retcode = DDS_RETCODE_OK;
+
+done:
+    return retcode;
+}
+
+/**
+ * @brief Serialize a sample of a flat type as compact JSON in json_buffer,
+ * in a single pass over its input mappings.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_write_sample(
+    RTI_TSFM_Json_FlatTypeTransformation *self,
+    DDS_DynamicData *sample,
+    DDS_UnsignedLong *size_out)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_UnsignedLong i = 0,
+                     mappings_len = 0,
+                     size = 0;
+    RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *mapping = NULL;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_write_sample)
+
+    if (DDS_RETCODE_OK !=
+            RTI_TSFM_Json_FlatTypeTransformation_reserve_json_buffer(
+                self, 0, 1))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    self->state->json_buffer[size++] = '{';
+
+    mappings_len =
+        RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_length(
+                &self->state->input_mappings);
+
+    for (i = 0; i < mappings_len; i++)
+    {
+        mapping =
+            RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
+                    &self->state->input_mappings, i);
+
+        retcode = RTI_TSFM_Json_FlatTypeTransformation_write_member(
+                self, mapping, sample, &size);
+        if (retcode == DDS_RETCODE_NO_DATA)
+        {
+            /* Optional members without a value are omitted */
+            continue;
+        }
+        if (retcode != DDS_RETCODE_OK)
+        {
+            /* TODO Log error */
+            goto done;
+        }
+    }
+    retcode = DDS_RETCODE_ERROR;
+
+    if (DDS_RETCODE_OK !=
+            RTI_TSFM_Json_FlatTypeTransformation_reserve_json_buffer(
+                self, size, 1))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    self->state->json_buffer[size++] = '}';
+    self->state->json_buffer[size] = '\0';
+
+    *size_out = size;
+
+    retcode = DDS_RETCODE_OK;
+
+done:
+    return retcode;
+}
+
+/**
+ * @brief Look up the buffer member of the samples of a batch only once.
+ *
+ * A top-level member is resolved to its id, using the type of `sample`,
+ * which is shared by every sample of the batch. A nested selector (e.g.
+ * "a.b") can only be resolved by DynamicData, so it is still looked up by
+ * name for every sample.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_resolve_buffer_member(
+        RTI_TSFM_Json_FlatTypeTransformation *self,
+        DDS_DynamicData *sample,
+        const char **member_name_out,
+        DDS_DynamicDataMemberId *member_id_out)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
+    const DDS_TypeCode *type = NULL;
+    DDS_UnsignedLong member_i = 0;
+    DDS_DynamicDataMemberId member_id = DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_resolve_buffer_member)
+
+    *member_name_out = self->config->buffer_member;
+    *member_id_out = DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED;
+
+    if (strpbrk(self->config->buffer_member, ".[") != NULL)
+    {
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    type = DDS_DynamicData_get_type(sample);
+    if (type == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    member_i = DDS_TypeCode_find_member_by_name(
+            type, self->config->buffer_member, &ex);
+    if (ex != DDS_NO_EXCEPTION_CODE)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    member_id = DDS_TypeCode_member_id(type, member_i, &ex);
+    if (ex != DDS_NO_EXCEPTION_CODE)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    *member_name_out = NULL;
+    *member_id_out = member_id;
+
+    retcode = DDS_RETCODE_OK;
+done:
+    return retcode;
+}
+
+/**
+ * @brief Serialize a sample into the buffer member of `sample_out`, which
+ * is identified either by `member_name` or by `member_id`.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_serialize_w_member(
+        RTI_TSFM_Json_FlatTypeTransformation *self,
+        const char *member_name,
+        DDS_DynamicDataMemberId member_id,
+        DDS_DynamicData *sample_in,
+        DDS_DynamicData *sample_out)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    struct DDS_OctetSeq buffer_seq = DDS_SEQUENCE_INITIALIZER;
+    DDS_Boolean serialized = DDS_BOOLEAN_FALSE,
+                buffer_seq_initd = DDS_BOOLEAN_FALSE,
+                failed_serialization = DDS_BOOLEAN_FALSE;
+    DDS_UnsignedLong serialized_size = 0;
+    char* p = NULL;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_serialize_w_member)
+
+    if (RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_length(
+            &self->state->input_mappings) > 0)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_TSFM_Json_FlatTypeTransformation_write_sample(
+                    self, sample_in, &serialized_size))
+        {
+            /* TODO Log error */
+            goto done;
+        }
+        serialized = DDS_BOOLEAN_TRUE;
+    }
+
+    while (!serialized)
+    {
+        if (failed_serialization ||
+            self->state->json_buffer == NULL ||
+            self->state->json_buffer_size == 0)
+        {
+            failed_serialization = DDS_BOOLEAN_FALSE;
+            if (DDS_RETCODE_OK != 
+                    RTI_TSFM_realloc_buffer(
+                        self->config->serialized_size_min,
+                        self->config->serialized_size_incr,
+                        self->config->serialized_size_max,
+                        &self->state->json_buffer,
+                        &self->state->json_buffer_size))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+        }
+
+        serialized_size = self->state->json_buffer_size;
+        if (DDS_RETCODE_OK !=
+                DDS_DynamicDataFormatter_to_json(
+                    sample_in,
+                    self->state->json_buffer,
+                    &serialized_size,
+                    self->config->indent))
+        {
+            failed_serialization = DDS_BOOLEAN_TRUE;
+            continue;
+        }
+
+        /* update serialized_size to actual length of string */
+        p = strchr(self->state->json_buffer, '\0');
+        if (p == NULL)
+        {
+            /* TODO log */
+            goto done;
+        }
+        serialized_size = (p - self->state->json_buffer);
+        if (serialized_size == 0)
+        {
+            /* empty message */
+            /* TODO log */
+            goto done;
+        }
+
+        if (self->config->indent == 0)
+        {
+            /* Replace all '\n' with a space */
+            for (p = self->state->json_buffer; 
+                (p = strchr(p, '\n')) != NULL; 
+                p++)
+            {
+                *p = ' ';
+            }
+
+        }
+
+        serialized = DDS_BOOLEAN_TRUE;
+    }
+
+    if (!DDS_OctetSeq_loan_contiguous(
+                &buffer_seq, 
+                self->state->json_buffer,
+                serialized_size,
+                self->state->json_buffer_size))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            DDS_DynamicData_set_octet_seq(
+                sample_out,
+                member_name,
+                member_id,
+                &buffer_seq))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+
+    retcode = DDS_RETCODE_OK;
+done:
+    return retcode;
+}
+
+DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_serialize(
+        RTI_TSFM_UserTypePlugin *plugin,
+        RTI_TSFM_Transformation *transform,
+        DDS_DynamicData *sample_in,
+        DDS_DynamicData *sample_out)
+{
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
     RTI_TSFM_Json_FlatTypeTransformation *self = 
             (RTI_TSFM_Json_FlatTypeTransformation*)transform;
-    struct DDS_OctetSeq buffer_seq = DDS_SEQUENCE_INITIALIZER;
-    DDS_Boolean serialized = DDS_BOOLEAN_FALSE,
-                buffer_seq_initd = DDS_BOOLEAN_FALSE,
-                failed_serialization = DDS_BOOLEAN_FALSE;
-    DDS_UnsignedLong serialized_size = 0;
-    char* p = NULL;
 
     RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_serialize)
 
-    while (!serialized)
+    retcode = RTI_TSFM_Json_FlatTypeTransformation_serialize_w_member(
+                self,
+                self->config->buffer_member,
+                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
+                sample_in,
+                sample_out);
+
+    RTI_TSFM_TRACE_1("RTI_TSFM_Json_FlatTypeTransformation_serialize:",
+            "retcode=%d", retcode)
+
+    return retcode;
+}
+
+DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_serialize_batch(
+        RTI_TSFM_UserTypePlugin *plugin,
+        RTI_TSFM_Transformation *transform,
+        DDS_DynamicData **samples_in,
+        DDS_DynamicData **samples_out,
+        DDS_UnsignedLong count)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    RTI_TSFM_Json_FlatTypeTransformation *self = 
+            (RTI_TSFM_Json_FlatTypeTransformation*)transform;
+    const char *member_name = NULL;
+    DDS_DynamicDataMemberId member_id = DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED;
+    DDS_UnsignedLong i = 0;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_serialize_batch)
+
+    if (count == 0)
     {
-        if (failed_serialization ||
-            self->state->json_buffer == NULL ||
-            self->state->json_buffer_size == 0)
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_TSFM_Json_FlatTypeTransformation_resolve_buffer_member(
+                self, samples_out[0], &member_name, &member_id))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    /* Every sample is written into the same JSON buffer of the state, and
+     * copied into its output sample before the next one is serialized */
+    for (i = 0; i < count; i++)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_TSFM_Json_FlatTypeTransformation_serialize_w_member(
+                    self,
+                    member_name,
+                    member_id,
+                    samples_in[i],
+                    samples_out[i]))
         {
-            failed_serialization = DDS_BOOLEAN_FALSE;
-            if (DDS_RETCODE_OK != 
-                    RTI_TSFM_realloc_buffer(
-                        self->config->serialized_size_min,
-                        self->config->serialized_size_incr,
-                        self->config->serialized_size_max,
-                        &self->state->json_buffer,
-                        &self->state->json_buffer_size))
+            RTI_TSFM_ERROR_1("failed to serialize sample in batch:",
+                "index=%u", i)
+            goto done;
+        }
+    }
+
+    retcode = DDS_RETCODE_OK;
+done:
+
+    RTI_TSFM_TRACE_1("RTI_TSFM_Json_FlatTypeTransformation_serialize_batch:",
+            "retcode=%d", retcode)
+
+    return retcode;
+}
+
+/*****************************************************************************
+ *                          Streaming JSON Scanner
+ *****************************************************************************/
+
+/* Maximum nesting of the objects and arrays skipped by the scanner */
+#define RTI_TSFM_JSON_FLATTYPE_SCAN_DEPTH_MAX       64
+/* Maximum length of a JSON number with a fraction or an exponent */
+#define RTI_TSFM_JSON_FLATTYPE_SCAN_NUMBER_LEN_MAX  63
+
+/**
+ * @brief Position of the scanner in a JSON buffer.
+ *
+ * The buffer is not null terminated, so every access must be checked
+ * against end.
+ */
+typedef struct RTI_TSFM_Json_ScannerImpl
+{
+    const char *start;
+    const char *ptr;
+    const char *end;
+} RTI_TSFM_Json_Scanner;
+
+#define RTI_TSFM_Json_Scanner_peek(s_) \
+    (((s_)->ptr < (s_)->end)? *(s_)->ptr : '\0')
+
+#define RTI_TSFM_Json_Scanner_offset(s_) \
+    ((unsigned long)((s_)->ptr - (s_)->start))
+
+#define RTI_TSFM_Json_Scanner_is_digit(c_) \
+    ((c_) >= '0' && (c_) <= '9')
+
+#define RTI_TSFM_Json_Scanner_skip_whitespace(s_) \
+{\
+    while ((s_)->ptr < (s_)->end && \
+            (*(s_)->ptr == ' ' || *(s_)->ptr == '\t' || \
+             *(s_)->ptr == '\n' || *(s_)->ptr == '\r'))\
+    {\
+        (s_)->ptr++;\
+    }\
+}
+
+#define RTI_TSFM_Json_Scanner_match(s_,lit_,lit_len_) \
+    ((s_)->end - (s_)->ptr >= (lit_len_) && \
+        RTI_TSFM_Memory_compare((s_)->ptr, (lit_), (lit_len_)) == 0)
+
+static DDS_Long
+RTI_TSFM_Json_Scanner_parse_hex4(const char *hex)
+{
+    DDS_Long result = 0,
+             i = 0;
+
+    for (i = 0; i < 4; i++)
+    {
+        result <<= 4;
+        if (hex[i] >= '0' && hex[i] <= '9')
+        {
+            result |= hex[i] - '0';
+        }
+        else if (hex[i] >= 'a' && hex[i] <= 'f')
+        {
+            result |= hex[i] - 'a' + 10;
+        }
+        else if (hex[i] >= 'A' && hex[i] <= 'F')
+        {
+            result |= hex[i] - 'A' + 10;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Scan a JSON string, whose opening quote is at the current position
+ * of the scanner.
+ *
+ * If the string contains escape sequences, or if copy is true, the string
+ * is unescaped and null terminated in the string buffer of the
+ * transformation. Otherwise, the value points to the string in the input
+ * buffer, and it is not null terminated.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_scan_string(
+    RTI_TSFM_Json_FlatTypeTransformation *self,
+    RTI_TSFM_Json_Scanner *scanner,
+    DDS_Boolean copy,
+    RTI_TSFM_Json_MemberValue *value)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    const char *start = scanner->ptr + 1,
+               *p = start,
+               *q = NULL;
+    DDS_Boolean escaped = DDS_BOOLEAN_FALSE;
+    DDS_Long codepoint = 0,
+             low_surrogate = 0;
+    char *out = NULL;
+
+    /* Find the closing quote first, so that the unescaped string can be
+     * stored with a single check of the size of the string buffer */
+    while (p < scanner->end && *p != '"')
+    {
+        if (*p == '\\')
+        {
+            escaped = DDS_BOOLEAN_TRUE;
+            if (scanner->end - p < 2)
             {
-                /* TODO Log error */
-                goto done;
+                p = scanner->end;
+                break;
             }
+            p++;
         }
+        p++;
+    }
+    if (p >= scanner->end)
+    {
+        RTI_TSFM_ERROR_1("INVALID JSON: unterminated string:",
+            "offset=%lu", RTI_TSFM_Json_Scanner_offset(scanner))
+        goto done;
+    }
 
-        serialized_size = self->state->json_buffer_size;
-        if (DDS_RETCODE_OK !=
-                DDS_DynamicDataFormatter_to_json(
-                    sample_in,
-                    self->state->json_buffer,
-                    &serialized_size,
-                    self->config->indent))
+    value->type = json_string;
+
+    if (!escaped && !copy)
+    {
+        value->u.string.ptr = (char*) start;
+        value->u.string.length = (DDS_UnsignedLong) (p - start);
+        scanner->ptr = p + 1;
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    /* Unescaped strings are never longer than their JSON representation */
+    if (DDS_RETCODE_OK !=
+            RTI_TSFM_Json_FlatTypeTransformation_reserve_string_buffer(
+                self, (DDS_UnsignedLong) (p - start) + 1))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    out = self->state->string_buffer;
+
+    if (!escaped)
+    {
+        RTI_TSFM_Memory_copy(out, start, p - start);
+        out += p - start;
+    }
+
+    for (q = start; escaped && q < p;)
+    {
+        if (*q != '\\')
         {
-            failed_serialization = DDS_BOOLEAN_TRUE;
+            *out++ = *q++;
             continue;
         }
-
-        /* update serialized_size to actual length of string */
-        p = strchr(self->state->json_buffer, '\0');
-        if (p == NULL)
+        q++;
+        switch (*q++)
         {
-            /* TODO log */
+        case '"':   *out++ = '"';  break;
+        case '\\':  *out++ = '\\'; break;
+        case '/':   *out++ = '/';  break;
+        case 'b':   *out++ = '\b'; break;
+        case 'f':   *out++ = '\f'; break;
+        case 'n':   *out++ = '\n'; break;
+        case 'r':   *out++ = '\r'; break;
+        case 't':   *out++ = '\t'; break;
+        case 'u':
+            if (p - q < 4 ||
+                (codepoint = RTI_TSFM_Json_Scanner_parse_hex4(q)) < 0)
+            {
+                RTI_TSFM_ERROR_1("INVALID JSON: invalid unicode escape:",
+                    "offset=%lu", (unsigned long) (q - scanner->start))
+                goto done;
+            }
+            q += 4;
+
+            /* Combine UTF-16 surrogate pairs into a single code point.
+             * Like json_parse, reject surrogates which are not part of a
+             * pair, so that the output is always valid UTF-8 */
+            if (codepoint >= 0xD800 && codepoint <= 0xDFFF)
+            {
+                if (codepoint > 0xDBFF ||
+                    p - q < 6 || q[0] != '\\' || q[1] != 'u' ||
+                    (low_surrogate = RTI_TSFM_Json_Scanner_parse_hex4(q + 2))
+                        < 0xDC00 ||
+                    low_surrogate > 0xDFFF)
+                {
+                    RTI_TSFM_ERROR_1("INVALID JSON: unpaired surrogate:",
+                        "offset=%lu", (unsigned long) (q - 6 - scanner->start))
+                    goto done;
+                }
+                codepoint = 0x10000 +
+                    ((codepoint - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                q += 6;
+            }
+
+            if (codepoint < 0x80)
+            {
+                *out++ = (char) codepoint;
+            }
+            else if (codepoint < 0x800)
+            {
+                *out++ = (char) (0xC0 | (codepoint >> 6));
+                *out++ = (char) (0x80 | (codepoint & 0x3F));
+            }
+            else if (codepoint < 0x10000)
+            {
+                *out++ = (char) (0xE0 | (codepoint >> 12));
+                *out++ = (char) (0x80 | ((codepoint >> 6) & 0x3F));
+                *out++ = (char) (0x80 | (codepoint & 0x3F));
+            }
+            else
+            {
+                *out++ = (char) (0xF0 | (codepoint >> 18));
+                *out++ = (char) (0x80 | ((codepoint >> 12) & 0x3F));
+                *out++ = (char) (0x80 | ((codepoint >> 6) & 0x3F));
+                *out++ = (char) (0x80 | (codepoint & 0x3F));
+            }
+            break;
+        default:
+            RTI_TSFM_ERROR_1("INVALID JSON: invalid escape sequence:",
+                "offset=%lu", (unsigned long) (q - 2 - scanner->start))
             goto done;
         }
-        serialized_size = (p - self->state->json_buffer);
-        if (serialized_size == 0)
+    }
+    *out = '\0';
+
+    value->u.string.ptr = self->state->string_buffer;
+    value->u.string.length =
+        (DDS_UnsignedLong) (out - self->state->string_buffer);
+    scanner->ptr = p + 1;
+
+    retcode = DDS_RETCODE_OK;
+
+done:
+    return retcode;
+}
+
+/**
+ * @brief Scan a JSON number. Numbers without a fraction or an exponent are
+ * returned as integers, all others as doubles.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_scan_number(
+    RTI_TSFM_Json_Scanner *scanner,
+    RTI_TSFM_Json_MemberValue *value)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    const char *p = scanner->ptr;
+    DDS_Boolean negative = DDS_BOOLEAN_FALSE,
+                is_double = DDS_BOOLEAN_FALSE;
+    DDS_UnsignedLongLong magnitude = 0;
+    char number[RTI_TSFM_JSON_FLATTYPE_SCAN_NUMBER_LEN_MAX + 1];
+
+    if (p < scanner->end && *p == '-')
+    {
+        negative = DDS_BOOLEAN_TRUE;
+        p++;
+    }
+    if (p >= scanner->end || !RTI_TSFM_Json_Scanner_is_digit(*p))
+    {
+        goto invalid;
+    }
+    if (*p == '0')
+    {
+        p++;
+    }
+    else
+    {
+        while (p < scanner->end && RTI_TSFM_Json_Scanner_is_digit(*p))
         {
-            /* empty message */
-            /* TODO log */
-            goto done;
+            magnitude = magnitude * 10 + (DDS_UnsignedLongLong) (*p - '0');
+            p++;
         }
+    }
 
-        if (self->config->indent == 0)
+    if (p < scanner->end && *p == '.')
+    {
+        is_double = DDS_BOOLEAN_TRUE;
+        p++;
+        if (p >= scanner->end || !RTI_TSFM_Json_Scanner_is_digit(*p))
+        {
+            goto invalid;
+        }
+        while (p < scanner->end && RTI_TSFM_Json_Scanner_is_digit(*p))
+        {
+            p++;
+        }
+    }
+
+    if (p < scanner->end && (*p == 'e' || *p == 'E'))
+    {
+        is_double = DDS_BOOLEAN_TRUE;
+        p++;
+        if (p < scanner->end && (*p == '+' || *p == '-'))
+        {
+            p++;
+        }
+        if (p >= scanner->end || !RTI_TSFM_Json_Scanner_is_digit(*p))
+        {
+            goto invalid;
+        }
+        while (p < scanner->end && RTI_TSFM_Json_Scanner_is_digit(*p))
+        {
+            p++;
+        }
+    }
+
+    if (is_double)
+    {
+        if (p - scanner->ptr > RTI_TSFM_JSON_FLATTYPE_SCAN_NUMBER_LEN_MAX)
+        {
+            goto invalid;
+        }
+        RTI_TSFM_Memory_copy(number, scanner->ptr, p - scanner->ptr);
+        number[p - scanner->ptr] = '\0';
+
+        value->type = json_double;
+        value->u.dbl = RTI_TSFM_String_to_double(number, NULL);
+    }
+    else
+    {
+        /* Values above the range of DDS_LongLong wrap around, so that they
+         * are read back correctly by unsigned members */
+        value->type = json_integer;
+        value->u.integer = (DDS_LongLong) (negative ? 0 - magnitude : magnitude);
+    }
+
+    scanner->ptr = p;
+    retcode = DDS_RETCODE_OK;
+    goto done;
+
+invalid:
+    RTI_TSFM_ERROR_1("INVALID JSON: invalid number:",
+        "offset=%lu", RTI_TSFM_Json_Scanner_offset(scanner))
+done:
+    return retcode;
+}
+
+/**
+ * @brief Scan the JSON value at the current position of the scanner.
+ *
+ * Objects and arrays are validated and skipped, and only their type is
+ * returned. Strings are copied to the string buffer only if copy is true
+ * (see RTI_TSFM_Json_FlatTypeTransformation_scan_string).
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_scan_value(
+    RTI_TSFM_Json_FlatTypeTransformation *self,
+    RTI_TSFM_Json_Scanner *scanner,
+    DDS_Boolean copy,
+    DDS_UnsignedLong depth,
+    RTI_TSFM_Json_MemberValue *value)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    RTI_TSFM_Json_MemberValue nested_value;
+    char close = '\0';
+
+    switch (RTI_TSFM_Json_Scanner_peek(scanner))
+    {
+    case '"':
+        retcode = RTI_TSFM_Json_FlatTypeTransformation_scan_string(
+                self, scanner, copy, value);
+        goto done;
+    case '-':
+    case '0': case '1': case '2': case '3': case '4':
+    case '5': case '6': case '7': case '8': case '9':
+        retcode = RTI_TSFM_Json_FlatTypeTransformation_scan_number(
+                scanner, value);
+        goto done;
+    case 't':
+        if (!RTI_TSFM_Json_Scanner_match(scanner, "true", 4))
+        {
+            goto invalid;
+        }
+        scanner->ptr += 4;
+        value->type = json_boolean;
+        value->u.boolean = DDS_BOOLEAN_TRUE;
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    case 'f':
+        if (!RTI_TSFM_Json_Scanner_match(scanner, "false", 5))
+        {
+            goto invalid;
+        }
+        scanner->ptr += 5;
+        value->type = json_boolean;
+        value->u.boolean = DDS_BOOLEAN_FALSE;
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    case 'n':
+        if (!RTI_TSFM_Json_Scanner_match(scanner, "null", 4))
         {
-            /* Replace all '\n' with a space */
-            for (p = self->state->json_buffer; 
-                (p = strchr(p, '\n')) != NULL; 
-                p++)
-            {
-                *p = ' ';
-            }
-
+            goto invalid;
         }
-
-        serialized = DDS_BOOLEAN_TRUE;
+        scanner->ptr += 4;
+        value->type = json_null;
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    case '{':
+        value->type = json_object;
+        close = '}';
+        break;
+    case '[':
+        value->type = json_array;
+        close = ']';
+        break;
+    default:
+        goto invalid;
     }
 
-    if (!DDS_OctetSeq_loan_contiguous(
-                &buffer_seq, 
-                self->state->json_buffer,
-                serialized_size,
-                self->state->json_buffer_size))
+    if (depth >= RTI_TSFM_JSON_FLATTYPE_SCAN_DEPTH_MAX)
     {
-        /* TODO Log error */
+        RTI_TSFM_ERROR_1("INVALID JSON: value nested too deeply:",
+            "offset=%lu", RTI_TSFM_Json_Scanner_offset(scanner))
         goto done;
     }
 
-    if (DDS_RETCODE_OK !=
-            DDS_DynamicData_set_octet_seq(
-                sample_out,
-                self->config->buffer_member,
-                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
-                &buffer_seq))
+    scanner->ptr++;
+    RTI_TSFM_Json_Scanner_skip_whitespace(scanner);
+    if (RTI_TSFM_Json_Scanner_peek(scanner) == close)
     {
-        /* TODO Log error */
+        scanner->ptr++;
+        retcode = DDS_RETCODE_OK;
         goto done;
     }
 
+    for (;;)
+    {
+        if (close == '}')
+        {
+            if (RTI_TSFM_Json_Scanner_peek(scanner) != '"')
+            {
+                goto invalid;
+            }
+            if (DDS_RETCODE_OK !=
+                    RTI_TSFM_Json_FlatTypeTransformation_scan_string(
+                        self, scanner, DDS_BOOLEAN_FALSE, &nested_value))
+            {
+                goto done;
+            }
+            RTI_TSFM_Json_Scanner_skip_whitespace(scanner);
+            if (RTI_TSFM_Json_Scanner_peek(scanner) != ':')
+            {
+                goto invalid;
+            }
+            scanner->ptr++;
+            RTI_TSFM_Json_Scanner_skip_whitespace(scanner);
+        }
 
-    retcode = DDS_RETCODE_OK;
-done:
+        if (DDS_RETCODE_OK !=
+                RTI_TSFM_Json_FlatTypeTransformation_scan_value(
+                    self, scanner, DDS_BOOLEAN_FALSE, depth + 1,
+                    &nested_value))
+        {
+            goto done;
+        }
 
-    RTI_TSFM_TRACE_1("RTI_TSFM_Json_FlatTypeTransformation_serialize:",
-            "retcode=%d", retcode)
+        RTI_TSFM_Json_Scanner_skip_whitespace(scanner);
+        if (RTI_TSFM_Json_Scanner_peek(scanner) == close)
+        {
+            scanner->ptr++;
+            break;
+        }
+        if (RTI_TSFM_Json_Scanner_peek(scanner) != ',')
+        {
+            goto invalid;
+        }
+        scanner->ptr++;
+        RTI_TSFM_Json_Scanner_skip_whitespace(scanner);
+    }
+
+    retcode = DDS_RETCODE_OK;
+    goto done;
 
+invalid:
+    RTI_TSFM_ERROR_1("INVALID JSON: unexpected character:",
+        "offset=%lu", RTI_TSFM_Json_Scanner_offset(scanner))
+done:
     return retcode;
 }
 
-#define SHAPE_TYPE_FIELDS           4
-#define SHAPE_TYPE_FIELD_COLOR      "color"
-#define SHAPE_TYPE_FIELD_X          "x"
-#define SHAPE_TYPE_FIELD_Y          "y"
-#define SHAPE_TYPE_FIELD_SHAPESIZE  "shapesize"
-
-DDS_ReturnCode_t
-RTI_TSFM_Json_FlatTypeTransformation_find_json_member(
-    const char *member_name,
-    json_value *value,
-    json_object_entry **member_out)
+/**
+ * @brief Look up the output mapping of a JSON member.
+ *
+ * @return The index of the mapping in output_mappings plus one, or 0 if
+ * the output type has no member with that name.
+ */
+static DDS_UnsignedLong
+RTI_TSFM_Json_FlatTypeTransformation_find_output_mapping(
+    RTI_TSFM_Json_FlatTypeTransformation *self,
+    const char *name,
+    DDS_UnsignedLong name_len)
 {
-    DDS_UnsignedLong i = 0;
-    json_object_entry *member = NULL;
-
-    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_find_json_member)
+    RTI_TSFM_Json_FlatTypeTransformation_MemberSlot *slot = NULL;
+    RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *mapping = NULL;
+    DDS_UnsignedLong hash = 0,
+                     i = 0;
 
-    *member_out = NULL;
+    hash = RTI_TSFM_Json_FlatTypeTransformation_hash_member_name(
+                name, name_len);
 
-    for (i = 0; i < value->u.object.length && *member_out == NULL; i++)
+    for (i = hash & self->state->member_slots_mask;
+            self->state->member_slots[i].mapping != 0;
+            i = (i + 1) & self->state->member_slots_mask)
     {
-        member = &value->u.object.values[i];
-
-        if (RTI_TSFM_String_compare(member->name,member_name) == 0)
+        slot = &self->state->member_slots[i];
+        if (slot->hash != hash)
+        {
+            continue;
+        }
+        mapping =
+            RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
+                    &self->state->output_mappings, slot->mapping - 1);
+        if (mapping->name_len == name_len &&
+            RTI_TSFM_Memory_compare(mapping->name, name, name_len) == 0)
         {
-            *member_out = member;
+            return slot->mapping;
         }
     }
-
-    return DDS_RETCODE_OK;
+    return 0;
 }
 
+/**
+ * @brief Deserialize a JSON object into a sample of the output type.
+ *
+ * The JSON buffer is scanned once: the name of every member is looked up
+ * in the hash table of the output mappings, and its value is stored in
+ * the sample as soon as it has been scanned. Members which are not part of
+ * the output type are skipped, and only the first occurrence of a member
+ * is used.
+ */
 DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_deserialize_sample(
     RTI_TSFM_Json_FlatTypeTransformation *self,
@@ -1161,12 +3105,13 @@ RTI_TSFM_Json_FlatTypeTransformation_deserialize_sample(
     DDS_DynamicData *sample)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
-    json_value *value = NULL,
-               *member_value = NULL;
-    json_object_entry *member = NULL;
+    RTI_TSFM_Json_Scanner scanner;
+    RTI_TSFM_Json_MemberValue name,
+                              value;
     DDS_UnsignedLong i = 0,
-                     mappings_len = 0;
-    DDS_Long member_val_l = 0;
+                     mappings_len = 0,
+                     mapping_idx = 0,
+                     mark = 0;
     RTI_TSFM_Json_FlatTypeTransformation_MemberMapping *mapping = NULL;
 
     RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_deserialize_sample)
@@ -1175,52 +3120,125 @@ RTI_TSFM_Json_FlatTypeTransformation_deserialize_sample(
      * no guarantee that the string is well terminated (and most likely 
      * it won't be, i.e. no 'nul' terminator) */
 
-    value = json_parse(json_buffer, json_buffer_size);
-    if (value == NULL)
+    scanner.start = json_buffer;
+    scanner.ptr = json_buffer;
+    scanner.end = json_buffer + json_buffer_size;
+
+    mappings_len = 
+        RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_length(
+                &self->state->output_mappings);
+
+    /* Use a new mark for the members found in this sample, and only clear
+     * the marks when the counter wraps around */
+    self->state->member_mark++;
+    if (self->state->member_mark == 0)
     {
-        /* TODO Log error */
-        RTI_TSFM_ERROR("failed: json_parse")
-        goto done;
+        RTI_TSFM_Memory_zero(self->state->member_marks,
+            sizeof(DDS_UnsignedLong) * mappings_len);
+        self->state->member_mark = 1;
     }
-    if (value->type != json_object)
+    mark = self->state->member_mark;
+
+    RTI_TSFM_Json_Scanner_skip_whitespace(&scanner);
+    if (RTI_TSFM_Json_Scanner_peek(&scanner) != '{')
     {
-        /* TODO Log error */
-        RTI_TSFM_ERROR("failed: invalid parsed value")
+        RTI_TSFM_ERROR("INVALID JSON: expected an object")
         goto done;
     }
+    scanner.ptr++;
+    RTI_TSFM_Json_Scanner_skip_whitespace(&scanner);
 
-    mappings_len = 
-        RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_length(
-                &self->state->output_mappings);
-    
-    for (i = 0; i < mappings_len; i++)
+    if (RTI_TSFM_Json_Scanner_peek(&scanner) == '}')
     {
-        mapping = 
-            RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
-                    &self->state->output_mappings,i);
-        if (DDS_RETCODE_OK != 
-                RTI_TSFM_Json_FlatTypeTransformation_find_json_member(
-                        mapping->name, value, &member))
+        scanner.ptr++;
+    }
+    else for (;;)
+    {
+        if (RTI_TSFM_Json_Scanner_peek(&scanner) != '"')
+        {
+            goto invalid;
+        }
+        if (DDS_RETCODE_OK !=
+                RTI_TSFM_Json_FlatTypeTransformation_scan_string(
+                    self, &scanner, DDS_BOOLEAN_FALSE, &name))
         {
-            /* TODO Log error */
             goto done;
         }
-        if (member == NULL)
+        RTI_TSFM_Json_Scanner_skip_whitespace(&scanner);
+        if (RTI_TSFM_Json_Scanner_peek(&scanner) != ':')
+        {
+            goto invalid;
+        }
+        scanner.ptr++;
+        RTI_TSFM_Json_Scanner_skip_whitespace(&scanner);
+
+        mapping_idx =
+            RTI_TSFM_Json_FlatTypeTransformation_find_output_mapping(
+                self, name.u.string.ptr, name.u.string.length);
+
+        if (mapping_idx == 0 ||
+            self->state->member_marks[mapping_idx - 1] == mark)
         {
-            if (!mapping->optional)
+            if (DDS_RETCODE_OK !=
+                    RTI_TSFM_Json_FlatTypeTransformation_scan_value(
+                        self, &scanner, DDS_BOOLEAN_FALSE, 0, &value))
             {
-                RTI_TSFM_ERROR_1("required member not found in JSON sample:",
-                    "member=%s", mapping->name)
                 goto done;
             }
-            continue;
         }
+        else
+        {
+            mapping = 
+                RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
+                        &self->state->output_mappings, mapping_idx - 1);
 
-        if (DDS_RETCODE_OK != 
-                RTI_TSFM_Json_FlatTypeTransformation_parse_member(
-                        self, mapping, member->value, sample))
+            if (DDS_RETCODE_OK !=
+                    RTI_TSFM_Json_FlatTypeTransformation_scan_value(
+                        self, &scanner, DDS_BOOLEAN_TRUE, 0, &value))
+            {
+                goto done;
+            }
+            self->state->member_marks[mapping_idx - 1] = mark;
+
+            if (DDS_RETCODE_OK != 
+                    RTI_TSFM_Json_FlatTypeTransformation_parse_member(
+                            self, mapping, &value, sample))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+        }
+
+        RTI_TSFM_Json_Scanner_skip_whitespace(&scanner);
+        if (RTI_TSFM_Json_Scanner_peek(&scanner) == '}')
         {
-            /* TODO Log error */
+            scanner.ptr++;
+            break;
+        }
+        if (RTI_TSFM_Json_Scanner_peek(&scanner) != ',')
+        {
+            goto invalid;
+        }
+        scanner.ptr++;
+        RTI_TSFM_Json_Scanner_skip_whitespace(&scanner);
+    }
+
+    /* Like json_parse, stop at a nul terminator if the buffer includes one */
+    RTI_TSFM_Json_Scanner_skip_whitespace(&scanner);
+    if (RTI_TSFM_Json_Scanner_peek(&scanner) != '\0')
+    {
+        goto invalid;
+    }
+
+    for (i = 0; i < mappings_len; i++)
+    {
+        mapping = 
+            RTI_TSFM_Json_FlatTypeTransformation_MemberMappingSeq_get_reference(
+                    &self->state->output_mappings,i);
+        if (self->state->member_marks[i] != mark && !mapping->optional)
+        {
+            RTI_TSFM_ERROR_1("required member not found in JSON sample:",
+                "member=%s", mapping->name)
             goto done;
         }
     }
@@ -1230,22 +3248,38 @@ RTI_TSFM_Json_FlatTypeTransformation_deserialize_sample(
 #endif
 
     retcode = DDS_RETCODE_OK;
-    
-done:
-    if (value != NULL)
-    {
-        json_value_free(value);
-    }
+    goto done;
 
+invalid:
+    RTI_TSFM_ERROR_1("INVALID JSON: unexpected character:",
+        "offset=%lu", RTI_TSFM_Json_Scanner_offset(&scanner))
+done:
     return retcode;
 }
 
 
+#define SHAPE_TYPE_FIELDS           4
+#define SHAPE_TYPE_FIELD_COLOR      "color"
+#define SHAPE_TYPE_FIELD_X          "x"
+#define SHAPE_TYPE_FIELD_Y          "y"
+#define SHAPE_TYPE_FIELD_SHAPESIZE  "shapesize"
+
 DDS_ReturnCode_t
 RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape(
     const char *json_buffer,
     DDS_UnsignedLong json_buffer_size,
     DDS_DynamicData *shape)
+{
+    return RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape_w_arena(
+                NULL, json_buffer, json_buffer_size, shape);
+}
+
+DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape_w_arena(
+    RTI_TSFM_Json_Arena *arena,
+    const char *json_buffer,
+    DDS_UnsignedLong json_buffer_size,
+    DDS_DynamicData *shape)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
     json_value *value = NULL,
@@ -1254,13 +3288,22 @@ RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape(
     DDS_UnsignedLong i = 0;
     DDS_Long member_val_l = 0;
 
-    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape)
+    RTI_TSFM_LOG_FN(
+        RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape_w_arena)
 
     /* json_buffer should not be printed with printf() because there is
      * no guarantee that the string is well terminated (and most likely 
      * it won't be, i.e. no 'nul' terminator) */
 
-    value = json_parse(json_buffer, json_buffer_size);
+    if (arena != NULL)
+    {
+        value = RTI_TSFM_Json_Arena_parse(
+                    arena, json_buffer, json_buffer_size);
+    }
+    else
+    {
+        value = json_parse(json_buffer, json_buffer_size);
+    }
     if (value == NULL)
     {
         /* TODO Log error */
@@ -1429,7 +3472,12 @@ RTI_TSFM_Json_FlatTypeTransformation_deserialize_shape(
     retcode = DDS_RETCODE_OK;
     
 done:
-    if (value != NULL)
+    if (arena != NULL)
+    {
+        /* The parsed values are released all at once */
+        RTI_TSFM_Json_Arena_reset(arena);
+    }
+    else if (value != NULL)
     {
         json_value_free(value);
     }
@@ -1437,35 +3485,37 @@ done:
     return retcode;
 }
 
-DDS_ReturnCode_t 
-RTI_TSFM_Json_FlatTypeTransformation_deserialize(
-        RTI_TSFM_UserTypePlugin *plugin,
-        RTI_TSFM_Transformation *transform,
+/**
+ * @brief Deserialize the buffer member of a sample, copying it into a
+ * sequence owned by the caller, which can be reused for multiple samples.
+ */
+static DDS_ReturnCode_t
+RTI_TSFM_Json_FlatTypeTransformation_deserialize_w_seq(
+        RTI_TSFM_Json_FlatTypeTransformation *self,
+        struct DDS_OctetSeq *buffer_seq,
+        const char *member_name,
+        DDS_DynamicDataMemberId member_id,
         DDS_DynamicData *sample_in,
         DDS_DynamicData *sample_out)
 {
     DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
-    RTI_TSFM_Json_FlatTypeTransformation *self = 
-            (RTI_TSFM_Json_FlatTypeTransformation*)transform;
-    struct DDS_OctetSeq buffer_seq = DDS_SEQUENCE_INITIALIZER;
     char *buffer_seq_buff = NULL;
-    DDS_UnsignedLong buffer_seq_max = 0,
-                     buffer_seq_len = 0;
+    DDS_UnsignedLong buffer_seq_len = 0;
 
-    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_deserialize)
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_deserialize_w_seq)
 
     if (DDS_RETCODE_OK !=
             DDS_DynamicData_get_octet_seq(
                 sample_in,
-                &buffer_seq,
-                self->config->buffer_member,
-                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED))
+                buffer_seq,
+                member_name,
+                member_id))
     {
         /* TODO Log error */
         goto done;
     }
 
-    buffer_seq_buff = DDS_OctetSeq_get_contiguous_buffer(&buffer_seq);
+    buffer_seq_buff = DDS_OctetSeq_get_contiguous_buffer(buffer_seq);
     if (buffer_seq_buff == NULL)
     {
         /* TODO Log error */
@@ -1474,8 +3524,7 @@ RTI_TSFM_Json_FlatTypeTransformation_deserialize(
     /* The buffer should not be printed with printf() because there is
      * no guarantee that the string is well terminated (and most likely 
      * it won't be, i.e. no 'nul' terminator) */
-    buffer_seq_max = DDS_OctetSeq_get_maximum(&buffer_seq);
-    buffer_seq_len = DDS_OctetSeq_get_length(&buffer_seq);
+    buffer_seq_len = DDS_OctetSeq_get_length(buffer_seq);
 
     if (DDS_RETCODE_OK !=
             RTI_TSFM_Json_FlatTypeTransformation_deserialize_sample(
@@ -1487,6 +3536,30 @@ RTI_TSFM_Json_FlatTypeTransformation_deserialize(
 
     retcode = DDS_RETCODE_OK;
 done:
+    return retcode;
+}
+
+DDS_ReturnCode_t 
+RTI_TSFM_Json_FlatTypeTransformation_deserialize(
+        RTI_TSFM_UserTypePlugin *plugin,
+        RTI_TSFM_Transformation *transform,
+        DDS_DynamicData *sample_in,
+        DDS_DynamicData *sample_out)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    RTI_TSFM_Json_FlatTypeTransformation *self = 
+            (RTI_TSFM_Json_FlatTypeTransformation*)transform;
+    struct DDS_OctetSeq buffer_seq = DDS_SEQUENCE_INITIALIZER;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_deserialize)
+
+    retcode = RTI_TSFM_Json_FlatTypeTransformation_deserialize_w_seq(
+                self,
+                &buffer_seq,
+                self->config->buffer_member,
+                DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
+                sample_in,
+                sample_out);
 
     if (!DDS_OctetSeq_finalize(&buffer_seq))
     {
@@ -1499,6 +3572,71 @@ done:
     return retcode;
 }
 
+DDS_ReturnCode_t 
+RTI_TSFM_Json_FlatTypeTransformation_deserialize_batch(
+        RTI_TSFM_UserTypePlugin *plugin,
+        RTI_TSFM_Transformation *transform,
+        DDS_DynamicData **samples_in,
+        DDS_DynamicData **samples_out,
+        DDS_UnsignedLong count)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    RTI_TSFM_Json_FlatTypeTransformation *self = 
+            (RTI_TSFM_Json_FlatTypeTransformation*)transform;
+    /* A single sequence for the whole batch, so that its buffer is only
+     * reallocated when a payload is larger than all the previous ones */
+    struct DDS_OctetSeq buffer_seq = DDS_SEQUENCE_INITIALIZER;
+    const char *member_name = NULL;
+    DDS_DynamicDataMemberId member_id = DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED;
+    DDS_UnsignedLong i = 0;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_Json_FlatTypeTransformation_deserialize_batch)
+
+    if (count == 0)
+    {
+        retcode = DDS_RETCODE_OK;
+        goto done;
+    }
+
+    if (DDS_RETCODE_OK !=
+            RTI_TSFM_Json_FlatTypeTransformation_resolve_buffer_member(
+                self, samples_in[0], &member_name, &member_id))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        if (DDS_RETCODE_OK !=
+                RTI_TSFM_Json_FlatTypeTransformation_deserialize_w_seq(
+                    self,
+                    &buffer_seq,
+                    member_name,
+                    member_id,
+                    samples_in[i],
+                    samples_out[i]))
+        {
+            RTI_TSFM_ERROR_1("failed to deserialize sample in batch:",
+                "index=%u", i)
+            goto done;
+        }
+    }
+
+    retcode = DDS_RETCODE_OK;
+done:
+
+    if (!DDS_OctetSeq_finalize(&buffer_seq))
+    {
+        /* TODO Log error */
+    }
+
+    RTI_TSFM_TRACE_1("RTI_TSFM_Json_FlatTypeTransformation_deserialize_batch:",
+            "retcode=%d", retcode)
+
+    return retcode;
+}
+
 
 static RTI_TSFM_Json_FlatTypeTransformationState*
 RTI_TSFM_Json_FlatTypeTransformationState_create_data()
@@ -1531,6 +3669,12 @@ RTI_TSFM_Json_FlatTypeTransformationState_create_data()
     }
     state->json_buffer = NULL;
     state->json_buffer_size = 0;
+    state->member_slots = NULL;
+    state->member_slots_mask = 0;
+    state->member_marks = NULL;
+    state->member_mark = 0;
+    state->string_buffer = NULL;
+    state->string_buffer_size = 0;
 
     retval = state;
     
@@ -1559,6 +3703,18 @@ RTI_TSFM_Json_FlatTypeTransformationState_delete_data(
     {
         DDS_String_free(data->json_buffer);
     }
+    if (data->member_slots != NULL)
+    {
+        RTI_TSFM_Heap_free(data->member_slots);
+    }
+    if (data->member_marks != NULL)
+    {
+        RTI_TSFM_Heap_free(data->member_marks);
+    }
+    if (data->string_buffer != NULL)
+    {
+        RTI_TSFM_Heap_free(data->string_buffer);
+    }
     RTI_TSFM_Heap_free(data);
 }
 
@@ -1569,4 +3725,5 @@ RTI_TSFM_Json_FlatTypeTransformationState_delete_data(
 #define TState_new      RTI_TSFM_Json_FlatTypeTransformationState_create_data
 #define TState_delete   RTI_TSFM_Json_FlatTypeTransformationState_delete_data
 #define T_static
+#define T_batch
 #include "rtitransform_simple_tmplt_define.h"
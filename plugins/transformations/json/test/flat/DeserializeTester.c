@@ -0,0 +1,355 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#include <stdio.h>
+
+#include "TestFramework.h"
+#include "FlatTypeTester.h"
+
+/* Nesting accepted by the streaming deserializer in skipped members
+ * (RTI_TSFM_JSON_FLATTYPE_SCAN_DEPTH_MAX) */
+#define JSON_FLAT_TEST_SCAN_DEPTH_MAX   64
+
+#define json_flat_test_assert_str(sample_,expected_) \
+{\
+    char str_[JSON_FLAT_TEST_STRING_MAX_LEN + 1];\
+    char *str_ptr_ = str_;\
+    DDS_UnsignedLong str_size_ = sizeof(str_);\
+    assert_retcode_ok(\
+        DDS_DynamicData_get_string((sample_), &str_ptr_, &str_size_,\
+            "str", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));\
+    assert_string_equal((expected_), str_);\
+}
+
+/* Check that the streaming deserializer rejects a buffer, without
+ * comparing with json_parse, which accepts it */
+#define json_flat_test_assert_rejected(s_,json_) \
+{\
+    DDS_DynamicData *rejected_ = json_flat_test_new_sample((s_));\
+    assert_retcode_not_ok(\
+        json_flat_test_deserialize((s_), (json_),\
+            RTI_TSFM_String_length((json_)), rejected_));\
+    DDS_DynamicData_delete(rejected_);\
+}
+
+void
+json_flat_test_deserialize_members(void **state)
+{
+    struct json_flat_test_state *s = json_flat_test_state_from(state);
+    DDS_DynamicData *sample = NULL;
+    const char *json =
+        " {\"id\" : -42 ,\n\t\"str\":\"hello\", \"s\":-7, \"us\":65535,"
+        "\"ul\":4294967295,\"ll\":-9223372036854775807,\"f\":1.5,"
+        "\"d\":-1.25e2,\"o\":255,\"b\":true,\"c\":\"x\"}\r\n";
+    DDS_Long id = 0;
+    DDS_Double d = 0.0;
+    DDS_Char c = '\0';
+
+    json_flat_test_compare(
+        s, json, RTI_TSFM_String_length(json), DDS_BOOLEAN_TRUE, &sample);
+
+    assert_retcode_ok(DDS_DynamicData_get_long(
+        sample, &id, "id", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    assert_int_equal(-42, id);
+    json_flat_test_assert_str(sample, "hello")
+    assert_retcode_ok(DDS_DynamicData_get_double(
+        sample, &d, "d", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    assert_true(d == -125.0);
+    assert_retcode_ok(DDS_DynamicData_get_char(
+        sample, &c, "c", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    assert_int_equal('x', c);
+
+    DDS_DynamicData_delete(sample);
+
+    /* Values of the wrong type, or out of the bounds of the member */
+    json_flat_test_compare_str(s,
+        "{\"id\":1.5,\"str\":\"a\"}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":2}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\",\"d\":1}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\",\"c\":\"xy\"}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"01234567890123456\"}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\",\"b\":null}", DDS_BOOLEAN_FALSE);
+
+    /* Not an object, or followed by another value */
+    json_flat_test_compare_str(s, "[1,2]", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\"} {}", DDS_BOOLEAN_FALSE);
+}
+
+void
+json_flat_test_deserialize_escapes(void **state)
+{
+    struct json_flat_test_state *s = json_flat_test_state_from(state);
+    DDS_DynamicData *sample = NULL;
+    const char *json_simple =
+            "{\"id\":1,\"str\":\"\\\"\\\\\\/\\b\\f\\n\\r\\t\",\"c\":\"\\n\"}",
+               *json_unicode =
+            "{\"id\":1,\"str\":\"\\u0041\\u00e9\\u20AC\"}";
+    DDS_Char c = '\0';
+
+    json_flat_test_compare(
+        s, json_simple, RTI_TSFM_String_length(json_simple),
+        DDS_BOOLEAN_TRUE, &sample);
+    json_flat_test_assert_str(sample, "\"\\/\b\f\n\r\t")
+    assert_retcode_ok(DDS_DynamicData_get_char(
+        sample, &c, "c", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    assert_int_equal('\n', c);
+    DDS_DynamicData_delete(sample);
+
+    /* One, two and three bytes in UTF-8 */
+    json_flat_test_compare(
+        s, json_unicode, RTI_TSFM_String_length(json_unicode),
+        DDS_BOOLEAN_TRUE, &sample);
+    json_flat_test_assert_str(sample, "A\xc3\xa9\xe2\x82\xac")
+    DDS_DynamicData_delete(sample);
+
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"\\u12G4\"}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"\\u12\"}", DDS_BOOLEAN_FALSE);
+
+    /* json_parse copies the character which follows an unknown escape */
+    json_flat_test_assert_rejected(s,
+        "{\"id\":1,\"str\":\"\\x\"}")
+}
+
+void
+json_flat_test_deserialize_surrogates(void **state)
+{
+    struct json_flat_test_state *s = json_flat_test_state_from(state);
+    DDS_DynamicData *sample = NULL;
+    const char *json_pair =
+        "{\"id\":1,\"str\":\"<\\ud83d\\ude00>\"}";
+
+    /* A pair is a single code point, four bytes in UTF-8 */
+    json_flat_test_compare(
+        s, json_pair, RTI_TSFM_String_length(json_pair),
+        DDS_BOOLEAN_TRUE, &sample);
+    json_flat_test_assert_str(sample, "<\xf0\x9f\x98\x80>")
+    DDS_DynamicData_delete(sample);
+
+    /* Lone high and low surrogates */
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"\\ud83d\"}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"\\ud83dx\"}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"\\ude00\"}", DDS_BOOLEAN_FALSE);
+
+    /* json_parse combines a high surrogate with any escape which follows
+     * it, the streaming deserializer only with a low surrogate */
+    json_flat_test_assert_rejected(s,
+        "{\"id\":1,\"str\":\"\\ud83d\\u0041\"}")
+    json_flat_test_assert_rejected(s,
+        "{\"id\":1,\"str\":\"\\ude00\\ud83d\"}")
+}
+
+void
+json_flat_test_deserialize_unknown_members(void **state)
+{
+    struct json_flat_test_state *s = json_flat_test_state_from(state);
+    DDS_DynamicData *sample = NULL;
+    const char *json =
+        "{\"id\":1,"
+        "\"unknown\":{\"nested\":[1,-2.5e3,{\"deep\":\"}]\\\"[\"}],"
+            "\"x\":null,\"y\":{},\"z\":[]},"
+        "\"str\":\"a\","
+        "\"other\":[true,false,null,\"\\ud83d\\ude00\",[[]]],"
+        "\"s\":3,"
+        "\"last\":\"\"}";
+    DDS_Short short_val = 0;
+
+    json_flat_test_compare(
+        s, json, RTI_TSFM_String_length(json), DDS_BOOLEAN_TRUE, &sample);
+    assert_retcode_ok(DDS_DynamicData_get_short(
+        sample, &short_val, "s", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    assert_int_equal(3, short_val);
+    DDS_DynamicData_delete(sample);
+
+    /* Skipped members must still be valid JSON */
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\",\"x\":{\"y\"}}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\",\"x\":[1}}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\",\"x\":tru}", DDS_BOOLEAN_FALSE);
+
+    /* json_parse accepts a trailing comma in arrays */
+    json_flat_test_assert_rejected(s,
+        "{\"id\":1,\"str\":\"a\",\"x\":[1,]}")
+}
+
+void
+json_flat_test_deserialize_duplicate_members(void **state)
+{
+    struct json_flat_test_state *s = json_flat_test_state_from(state);
+    DDS_DynamicData *sample = NULL;
+    const char *json =
+        "{\"id\":1,\"str\":\"first\",\"s\":1,"
+        "\"id\":2,\"str\":\"second\",\"s\":\"not a number\"}";
+    DDS_Long id = 0;
+    DDS_Short short_val = 0;
+
+    /* The first occurrence of a member is used, and the others are only
+     * validated as JSON, whatever their type */
+    json_flat_test_compare(
+        s, json, RTI_TSFM_String_length(json), DDS_BOOLEAN_TRUE, &sample);
+    assert_retcode_ok(DDS_DynamicData_get_long(
+        sample, &id, "id", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    assert_int_equal(1, id);
+    json_flat_test_assert_str(sample, "first")
+    assert_retcode_ok(DDS_DynamicData_get_short(
+        sample, &short_val, "s", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    assert_int_equal(1, short_val);
+    DDS_DynamicData_delete(sample);
+
+    /* The members found in the previous sample don't hide the members of
+     * the next one */
+    json_flat_test_compare_str(s,
+        "{\"str\":\"b\",\"id\":3,\"id\":4,\"str\":\"c\"}", DDS_BOOLEAN_TRUE);
+}
+
+void
+json_flat_test_deserialize_missing_members(void **state)
+{
+    struct json_flat_test_state *s = json_flat_test_state_from(state);
+    DDS_DynamicData *sample = NULL;
+    const char *json = "{\"str\":\"a\",\"id\":1}";
+    DDS_Short short_val = 0;
+
+    json_flat_test_compare_str(s, "{\"id\":1}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s, "{\"str\":\"a\"}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s, "{}", DDS_BOOLEAN_FALSE);
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"s\":2,\"unknown\":\"str\"}", DDS_BOOLEAN_FALSE);
+
+    /* Optional members without a value are left unset */
+    json_flat_test_compare(
+        s, json, RTI_TSFM_String_length(json), DDS_BOOLEAN_TRUE, &sample);
+    assert_int_equal(DDS_RETCODE_NO_DATA,
+        DDS_DynamicData_get_short(
+            sample, &short_val, "s", DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    DDS_DynamicData_delete(sample);
+
+    /* A sample which has all the members after one which misses a
+     * required member */
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\",\"s\":2}", DDS_BOOLEAN_TRUE);
+}
+
+void
+json_flat_test_deserialize_ulonglong(void **state)
+{
+    struct json_flat_test_state *s = json_flat_test_state_from(state);
+    DDS_DynamicData *sample = NULL;
+    const char *json_max =
+            "{\"id\":1,\"str\":\"a\",\"ull\":18446744073709551615}",
+               *json_above =
+            "{\"id\":1,\"str\":\"a\",\"ull\":9223372036854775808}";
+    DDS_UnsignedLongLong ulonglong_val = 0;
+
+    /* Values above the range of DDS_LongLong are read back correctly.
+     * json_parse overflows a signed integer on them, so only values up to
+     * the maximum DDS_LongLong are compared */
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\",\"ull\":9223372036854775807}",
+        DDS_BOOLEAN_TRUE);
+
+    sample = json_flat_test_new_sample(s);
+    assert_retcode_ok(json_flat_test_deserialize(
+        s, json_max, RTI_TSFM_String_length(json_max), sample));
+    assert_retcode_ok(DDS_DynamicData_get_ulonglong(
+        sample, &ulonglong_val, "ull",
+        DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    assert_true(ulonglong_val == (DDS_UnsignedLongLong) -1);
+    DDS_DynamicData_delete(sample);
+
+    sample = json_flat_test_new_sample(s);
+    assert_retcode_ok(json_flat_test_deserialize(
+        s, json_above, RTI_TSFM_String_length(json_above), sample));
+    assert_retcode_ok(DDS_DynamicData_get_ulonglong(
+        sample, &ulonglong_val, "ull",
+        DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    assert_true(ulonglong_val == ((DDS_UnsignedLongLong) 1) << 63);
+    DDS_DynamicData_delete(sample);
+
+    json_flat_test_compare_str(s,
+        "{\"id\":1,\"str\":\"a\",\"ll\":-9223372036854775807}",
+        DDS_BOOLEAN_TRUE);
+}
+
+static void
+json_flat_test_nested_json(char *json, DDS_UnsignedLong depth)
+{
+    DDS_UnsignedLong i = 0;
+
+    json += sprintf(json, "{\"id\":1,\"str\":\"a\",\"x\":");
+    for (i = 0; i < depth; i++)
+    {
+        *json++ = (i % 2 == 0)? '[' : '{';
+        if (i % 2 == 1)
+        {
+            json += sprintf(json, "\"y\":");
+        }
+    }
+    *json++ = '0';
+    for (i = depth; i > 0; i--)
+    {
+        *json++ = ((i - 1) % 2 == 0)? ']' : '}';
+    }
+    sprintf(json, ",\"s\":1}");
+}
+
+void
+json_flat_test_deserialize_depth_limit(void **state)
+{
+    struct json_flat_test_state *s = json_flat_test_state_from(state);
+    DDS_DynamicData *sample = NULL;
+    char json[64 + 6 * (JSON_FLAT_TEST_SCAN_DEPTH_MAX + 1)];
+
+    json_flat_test_nested_json(json, JSON_FLAT_TEST_SCAN_DEPTH_MAX);
+    json_flat_test_compare_str(s, json, DDS_BOOLEAN_TRUE);
+
+    /* json_parse has no limit, the streaming deserializer rejects the
+     * sample instead of recursing any deeper */
+    json_flat_test_nested_json(json, JSON_FLAT_TEST_SCAN_DEPTH_MAX + 1);
+    sample = json_flat_test_new_sample(s);
+    assert_retcode_ok(json_flat_test_deserialize_reference(
+        s, json, RTI_TSFM_String_length(json), sample));
+    DDS_DynamicData_delete(sample);
+    json_flat_test_assert_rejected(s, json)
+}
+
+void
+json_flat_test_deserialize_truncated(void **state)
+{
+    struct json_flat_test_state *s = json_flat_test_state_from(state);
+    const char *json =
+        "{\"id\":-1,\"str\":\"a\\\"\\u00e9\",\"x\":[1,{\"y\":null}],"
+        "\"d\":1.5e1,\"b\":false,\"c\":\"z\"}";
+    DDS_UnsignedLong json_len = RTI_TSFM_String_length(json),
+                     i = 0;
+
+    json_flat_test_compare(s, json, json_len, DDS_BOOLEAN_TRUE, NULL);
+
+    /* Every prefix of the buffer is invalid, and must be rejected without
+     * reading past its end */
+    for (i = 1; i < json_len; i++)
+    {
+        json_flat_test_compare(s, json, i, DDS_BOOLEAN_FALSE, NULL);
+    }
+}
@@ -0,0 +1,43 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#ifndef DeserializeTester_h
+#define DeserializeTester_h
+
+void
+json_flat_test_deserialize_members(void **state);
+
+void
+json_flat_test_deserialize_escapes(void **state);
+
+void
+json_flat_test_deserialize_surrogates(void **state);
+
+void
+json_flat_test_deserialize_unknown_members(void **state);
+
+void
+json_flat_test_deserialize_duplicate_members(void **state);
+
+void
+json_flat_test_deserialize_missing_members(void **state);
+
+void
+json_flat_test_deserialize_ulonglong(void **state);
+
+void
+json_flat_test_deserialize_depth_limit(void **state);
+
+void
+json_flat_test_deserialize_truncated(void **state);
+
+#endif /* DeserializeTester_h */
@@ -0,0 +1,546 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#include "TestFramework.h"
+#include "FlatTypeTester.h"
+
+#include "json.h"
+
+#define JSON_FLAT_TEST_FLAT_TYPE_NAME       "FlatType"
+#define JSON_FLAT_TEST_BUFFER_TYPE_NAME     "BufferType"
+
+#define json_flat_test_add_member(s_,name_,tc_,flags_) \
+{\
+    DDS_ExceptionCode_t ex_ = DDS_NO_EXCEPTION_CODE;\
+    DDS_TypeCode_add_member((s_)->flat_type, (name_),\
+        DDS_TYPECODE_MEMBER_ID_INVALID, (tc_), (flags_), &ex_);\
+    assert_int_equal(DDS_NO_EXCEPTION_CODE, ex_);\
+}
+
+#define json_flat_test_add_optional(s_,name_,tckind_) \
+    json_flat_test_add_member((s_),(name_),\
+        DDS_TypeCodeFactory_get_primitive_tc(factory, (tckind_)),\
+        DDS_TYPECODE_NONKEY_MEMBER)
+
+static void
+json_flat_test_create_types(struct json_flat_test_state *s)
+{
+    struct DDS_TypeCodeFactory *factory = NULL;
+    struct DDS_StructMemberSeq members = DDS_SEQUENCE_INITIALIZER;
+    DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
+
+    factory = DDS_TypeCodeFactory_get_instance();
+    assert_non_null(factory);
+
+    s->string_type = DDS_TypeCodeFactory_create_string_tc(
+            factory, JSON_FLAT_TEST_STRING_MAX_LEN, &ex);
+    assert_int_equal(DDS_NO_EXCEPTION_CODE, ex);
+
+    s->payload_type = DDS_TypeCodeFactory_create_sequence_tc(
+            factory,
+            JSON_FLAT_TEST_PAYLOAD_MAX_LEN,
+            DDS_TypeCodeFactory_get_primitive_tc(factory, DDS_TK_OCTET),
+            &ex);
+    assert_int_equal(DDS_NO_EXCEPTION_CODE, ex);
+
+    s->flat_type = DDS_TypeCodeFactory_create_struct_tc(
+            factory, JSON_FLAT_TEST_FLAT_TYPE_NAME, &members, &ex);
+    assert_int_equal(DDS_NO_EXCEPTION_CODE, ex);
+
+    json_flat_test_add_member(s, "id",
+        DDS_TypeCodeFactory_get_primitive_tc(factory, DDS_TK_LONG),
+        DDS_TYPECODE_NONKEY_REQUIRED_MEMBER)
+    json_flat_test_add_member(s, "str",
+        s->string_type,
+        DDS_TYPECODE_NONKEY_REQUIRED_MEMBER)
+    json_flat_test_add_optional(s, "s", DDS_TK_SHORT)
+    json_flat_test_add_optional(s, "us", DDS_TK_USHORT)
+    json_flat_test_add_optional(s, "ul", DDS_TK_ULONG)
+    json_flat_test_add_optional(s, "ll", DDS_TK_LONGLONG)
+    json_flat_test_add_optional(s, "ull", DDS_TK_ULONGLONG)
+    json_flat_test_add_optional(s, "f", DDS_TK_FLOAT)
+    json_flat_test_add_optional(s, "d", DDS_TK_DOUBLE)
+    json_flat_test_add_optional(s, "o", DDS_TK_OCTET)
+    json_flat_test_add_optional(s, "b", DDS_TK_BOOLEAN)
+    json_flat_test_add_optional(s, "c", DDS_TK_CHAR)
+
+    s->buffer_type = DDS_TypeCodeFactory_create_struct_tc(
+            factory, JSON_FLAT_TEST_BUFFER_TYPE_NAME, &members, &ex);
+    assert_int_equal(DDS_NO_EXCEPTION_CODE, ex);
+
+    DDS_TypeCode_add_member(s->buffer_type, JSON_FLAT_TEST_BUFFER_MEMBER,
+        DDS_TYPECODE_MEMBER_ID_INVALID, s->payload_type,
+        DDS_TYPECODE_NONKEY_REQUIRED_MEMBER, &ex);
+    assert_int_equal(DDS_NO_EXCEPTION_CODE, ex);
+}
+
+static void
+json_flat_test_delete_types(struct json_flat_test_state *s)
+{
+    struct DDS_TypeCodeFactory *factory = DDS_TypeCodeFactory_get_instance();
+    struct DDS_TypeCode **types[4];
+    DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
+    DDS_UnsignedLong i = 0;
+
+    /* Structs first, since they refer to the other types */
+    types[0] = &s->flat_type;
+    types[1] = &s->buffer_type;
+    types[2] = &s->string_type;
+    types[3] = &s->payload_type;
+
+    for (i = 0; i < sizeof(types) / sizeof(types[0]); i++)
+    {
+        if (*types[i] != NULL)
+        {
+            DDS_TypeCodeFactory_delete_tc(factory, *types[i], &ex);
+            *types[i] = NULL;
+        }
+    }
+}
+
+static RTI_TSFM_Json_FlatTypeTransformation*
+json_flat_test_create_transformation(
+    struct json_flat_test_state *s,
+    const char *transform_type)
+{
+    RTI_TSFM_Json_FlatTypeTransformation *transform = NULL;
+    struct RTI_RoutingServiceNameValue property_values[2];
+    struct RTI_RoutingServiceProperties properties;
+    struct RTI_RoutingServiceTypeInfo flat_info,
+                                      buffer_info;
+    DDS_Boolean serializer = DDS_BOOLEAN_FALSE;
+
+    property_values[0].name = RTI_TSFM_PROPERTY_TRANSFORMATION_TYPE;
+    property_values[0].value = transform_type;
+    property_values[1].name =
+        RTI_TSFM_JSON_FLATTYPE_PROPERTY_TRANSFORMATION_BUFFER_MEMBER;
+    property_values[1].value = JSON_FLAT_TEST_BUFFER_MEMBER;
+    properties.count = sizeof(property_values) / sizeof(property_values[0]);
+    properties.properties = property_values;
+
+    flat_info.type_name = JSON_FLAT_TEST_FLAT_TYPE_NAME;
+    flat_info.type_representation_kind =
+        RTI_ROUTING_SERVICE_TYPE_REPRESENTATION_DYNAMIC_TYPE;
+    flat_info.type_representation = s->flat_type;
+
+    buffer_info.type_name = JSON_FLAT_TEST_BUFFER_TYPE_NAME;
+    buffer_info.type_representation_kind =
+        RTI_ROUTING_SERVICE_TYPE_REPRESENTATION_DYNAMIC_TYPE;
+    buffer_info.type_representation = s->buffer_type;
+
+    serializer = (RTI_TSFM_String_compare(transform_type, "serializer") == 0);
+    transform = (RTI_TSFM_Json_FlatTypeTransformation*)
+        RTI_TSFM_Json_FlatTypeTransformationPlugin_create_transformation(
+            s->plugin,
+            (serializer)? &flat_info : &buffer_info,
+            (serializer)? &buffer_info : &flat_info,
+            &properties,
+            NULL);
+    assert_non_null(transform);
+
+    return transform;
+}
+
+int
+json_flat_test_setup(void **state)
+{
+    struct json_flat_test_state *s = NULL;
+    struct RTI_RoutingServiceProperties properties;
+
+    s = (struct json_flat_test_state*)
+        RTI_TSFM_Heap_allocate(sizeof(struct json_flat_test_state));
+    assert_non_null(s);
+    RTI_TSFM_Memory_zero(s, sizeof(struct json_flat_test_state));
+
+    json_flat_test_create_types(s);
+
+    properties.count = 0;
+    properties.properties = NULL;
+    s->plugin = RTI_TSFM_Json_FlatTypeTransformationPlugin_create(
+                    &properties, NULL);
+    assert_non_null(s->plugin);
+
+    s->serializer = json_flat_test_create_transformation(s, "serializer");
+    s->deserializer = json_flat_test_create_transformation(s, "deserializer");
+
+    s->buffer_sample = DDS_DynamicData_new(
+            s->buffer_type, &DDS_DYNAMIC_DATA_PROPERTY_DEFAULT);
+    assert_non_null(s->buffer_sample);
+
+    *state = s;
+
+    return 0;
+}
+
+int
+json_flat_test_teardown(void **state)
+{
+    struct json_flat_test_state *s =
+            *((struct json_flat_test_state**)state);
+
+    if (s->buffer_sample != NULL)
+    {
+        DDS_DynamicData_delete(s->buffer_sample);
+    }
+    if (s->serializer != NULL)
+    {
+        RTI_TSFM_Json_FlatTypeTransformationPlugin_delete_transformation(
+            s->plugin, s->serializer, NULL);
+    }
+    if (s->deserializer != NULL)
+    {
+        RTI_TSFM_Json_FlatTypeTransformationPlugin_delete_transformation(
+            s->plugin, s->deserializer, NULL);
+    }
+    if (s->plugin != NULL)
+    {
+        RTI_TSFM_Json_FlatTypeTransformationPlugin_delete(s->plugin, NULL);
+    }
+    json_flat_test_delete_types(s);
+    RTI_TSFM_Heap_free(s);
+
+    *state = NULL;
+
+    return 0;
+}
+
+DDS_DynamicData*
+json_flat_test_new_sample(struct json_flat_test_state *s)
+{
+    DDS_DynamicData *sample = NULL;
+
+    sample = DDS_DynamicData_new(
+            s->flat_type, &DDS_DYNAMIC_DATA_PROPERTY_DEFAULT);
+    assert_non_null(sample);
+
+    return sample;
+}
+
+DDS_ReturnCode_t
+json_flat_test_deserialize(
+    struct json_flat_test_state *s,
+    const char *json,
+    DDS_UnsignedLong json_len,
+    DDS_DynamicData *sample)
+{
+    struct DDS_OctetSeq payload = DDS_SEQUENCE_INITIALIZER;
+
+    /* The payload is copied into the buffer sample, so the deserializer
+     * never sees the nul terminator of json */
+    assert_true(DDS_OctetSeq_loan_contiguous(
+                    &payload, (DDS_Octet*) json, json_len, json_len));
+    assert_retcode_ok(
+        DDS_DynamicData_set_octet_seq(
+            s->buffer_sample,
+            JSON_FLAT_TEST_BUFFER_MEMBER,
+            DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED,
+            &payload));
+    assert_true(DDS_OctetSeq_unloan(&payload));
+
+    return RTI_TSFM_Json_FlatTypeTransformation_deserialize(
+                NULL, &s->deserializer->parent, s->buffer_sample, sample);
+}
+
+DDS_ReturnCode_t
+json_flat_test_serialize(
+    struct json_flat_test_state *s,
+    DDS_DynamicData *sample,
+    char *json,
+    DDS_UnsignedLong *json_len)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    struct DDS_OctetSeq payload = DDS_SEQUENCE_INITIALIZER;
+    DDS_UnsignedLong len = 0;
+
+    retcode = RTI_TSFM_Json_FlatTypeTransformation_serialize(
+                NULL, &s->serializer->parent, sample, s->buffer_sample);
+    if (retcode != DDS_RETCODE_OK)
+    {
+        goto done;
+    }
+
+    assert_retcode_ok(
+        DDS_DynamicData_get_octet_seq(
+            s->buffer_sample,
+            &payload,
+            JSON_FLAT_TEST_BUFFER_MEMBER,
+            DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED));
+    len = DDS_OctetSeq_get_length(&payload);
+    assert_true(len <= JSON_FLAT_TEST_PAYLOAD_MAX_LEN);
+    RTI_TSFM_Memory_copy(json, DDS_OctetSeq_get_contiguous_buffer(&payload), len);
+    json[len] = '\0';
+    *json_len = len;
+
+done:
+    DDS_OctetSeq_finalize(&payload);
+    return retcode;
+}
+
+static DDS_ReturnCode_t
+json_flat_test_set_reference_member(
+    DDS_DynamicData *sample,
+    const char *name,
+    struct DDS_TypeCode *member_type,
+    json_value *value)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
+    DDS_TCKind kind = DDS_TK_NULL;
+    DDS_DynamicDataMemberId id = DDS_DYNAMIC_DATA_MEMBER_ID_UNSPECIFIED;
+
+    kind = DDS_TypeCode_kind(member_type, &ex);
+    if (ex != DDS_NO_EXCEPTION_CODE)
+    {
+        goto done;
+    }
+
+    switch (kind)
+    {
+    case DDS_TK_FLOAT:
+    case DDS_TK_DOUBLE:
+        if (value->type != json_double)
+        {
+            goto done;
+        }
+        break;
+    case DDS_TK_BOOLEAN:
+        if (value->type != json_boolean)
+        {
+            goto done;
+        }
+        break;
+    case DDS_TK_CHAR:
+        if (value->type != json_string || value->u.string.length != 1)
+        {
+            goto done;
+        }
+        break;
+    case DDS_TK_STRING:
+        if (value->type != json_string ||
+            value->u.string.length > DDS_TypeCode_length(member_type, &ex))
+        {
+            goto done;
+        }
+        break;
+    default:
+        if (value->type != json_integer)
+        {
+            goto done;
+        }
+        break;
+    }
+
+    switch (kind)
+    {
+    case DDS_TK_SHORT:
+        retcode = DDS_DynamicData_set_short(
+                sample, name, id, (DDS_Short) value->u.integer);
+        break;
+    case DDS_TK_USHORT:
+        retcode = DDS_DynamicData_set_ushort(
+                sample, name, id, (DDS_UnsignedShort) value->u.integer);
+        break;
+    case DDS_TK_LONG:
+        retcode = DDS_DynamicData_set_long(
+                sample, name, id, (DDS_Long) value->u.integer);
+        break;
+    case DDS_TK_ULONG:
+        retcode = DDS_DynamicData_set_ulong(
+                sample, name, id, (DDS_UnsignedLong) value->u.integer);
+        break;
+    case DDS_TK_LONGLONG:
+        retcode = DDS_DynamicData_set_longlong(
+                sample, name, id, (DDS_LongLong) value->u.integer);
+        break;
+    case DDS_TK_ULONGLONG:
+        retcode = DDS_DynamicData_set_ulonglong(
+                sample, name, id, (DDS_UnsignedLongLong) value->u.integer);
+        break;
+    case DDS_TK_OCTET:
+        retcode = DDS_DynamicData_set_octet(
+                sample, name, id, (DDS_Octet) value->u.integer);
+        break;
+    case DDS_TK_FLOAT:
+        retcode = DDS_DynamicData_set_float(
+                sample, name, id, (DDS_Float) value->u.dbl);
+        break;
+    case DDS_TK_DOUBLE:
+        retcode = DDS_DynamicData_set_double(
+                sample, name, id, (DDS_Double) value->u.dbl);
+        break;
+    case DDS_TK_BOOLEAN:
+        retcode = DDS_DynamicData_set_boolean(
+                sample, name, id,
+                (value->u.boolean)? DDS_BOOLEAN_TRUE : DDS_BOOLEAN_FALSE);
+        break;
+    case DDS_TK_CHAR:
+        retcode = DDS_DynamicData_set_char(
+                sample, name, id, (DDS_Char) value->u.string.ptr[0]);
+        break;
+    case DDS_TK_STRING:
+        retcode = DDS_DynamicData_set_string(
+                sample, name, id, value->u.string.ptr);
+        break;
+    default:
+        break;
+    }
+
+done:
+    return retcode;
+}
+
+DDS_ReturnCode_t
+json_flat_test_deserialize_reference(
+    struct json_flat_test_state *s,
+    const char *json,
+    DDS_UnsignedLong json_len,
+    DDS_DynamicData *sample)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    DDS_ExceptionCode_t ex = DDS_NO_EXCEPTION_CODE;
+    json_value *value = NULL,
+               *member_value = NULL;
+    json_object_entry *entry = NULL;
+    DDS_UnsignedLong members_count = 0,
+                     name_len = 0,
+                     i = 0,
+                     j = 0;
+    const char *name = NULL;
+    DDS_Boolean required = DDS_BOOLEAN_FALSE;
+
+    value = json_parse(json, json_len);
+    if (value == NULL || value->type != json_object)
+    {
+        goto done;
+    }
+
+    members_count = DDS_TypeCode_member_count(s->flat_type, &ex);
+    assert_int_equal(DDS_NO_EXCEPTION_CODE, ex);
+
+    for (i = 0; i < members_count; i++)
+    {
+        name = DDS_TypeCode_member_name(s->flat_type, i, &ex);
+        assert_int_equal(DDS_NO_EXCEPTION_CODE, ex);
+        required = DDS_TypeCode_is_member_required(s->flat_type, i, &ex);
+        assert_int_equal(DDS_NO_EXCEPTION_CODE, ex);
+        name_len = RTI_TSFM_String_length(name);
+
+        member_value = NULL;
+        for (j = 0; j < value->u.object.length && member_value == NULL; j++)
+        {
+            entry = &value->u.object.values[j];
+            if (entry->name_length == name_len &&
+                RTI_TSFM_Memory_compare(entry->name, name, name_len) == 0)
+            {
+                member_value = entry->value;
+            }
+        }
+
+        if (member_value == NULL)
+        {
+            if (required)
+            {
+                goto done;
+            }
+            continue;
+        }
+
+        if (DDS_RETCODE_OK !=
+                json_flat_test_set_reference_member(
+                    sample,
+                    name,
+                    DDS_TypeCode_member_type(s->flat_type, i, &ex),
+                    member_value))
+        {
+            goto done;
+        }
+    }
+
+    retcode = DDS_RETCODE_OK;
+
+done:
+    if (value != NULL)
+    {
+        json_value_free(value);
+    }
+    return retcode;
+}
+
+void
+json_flat_test_compare(
+    struct json_flat_test_state *s,
+    const char *json,
+    DDS_UnsignedLong json_len,
+    DDS_Boolean valid,
+    DDS_DynamicData **sample_out)
+{
+    DDS_DynamicData *sample = NULL,
+                    *expected = NULL;
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR,
+                     expected_retcode = DDS_RETCODE_ERROR;
+
+    sample = json_flat_test_new_sample(s);
+    expected = json_flat_test_new_sample(s);
+
+    retcode = json_flat_test_deserialize(s, json, json_len, sample);
+    expected_retcode =
+        json_flat_test_deserialize_reference(s, json, json_len, expected);
+
+    if (valid)
+    {
+        assert_retcode_ok(expected_retcode);
+        assert_retcode_ok(retcode);
+        assert_true(DDS_DynamicData_equal(sample, expected));
+    }
+    else
+    {
+        assert_retcode_not_ok(expected_retcode);
+        assert_retcode_not_ok(retcode);
+    }
+
+    DDS_DynamicData_delete(expected);
+    if (sample_out != NULL)
+    {
+        *sample_out = sample;
+    }
+    else
+    {
+        DDS_DynamicData_delete(sample);
+    }
+}
+
+#define json_flat_test(t_) \
+    cmocka_unit_test_setup_teardown(t_,\
+                                    json_flat_test_setup,\
+                                    json_flat_test_teardown)
+
+int main(void) {
+    const struct CMUnitTest tests[] = {
+        json_flat_test(json_flat_test_deserialize_members),
+        json_flat_test(json_flat_test_deserialize_escapes),
+        json_flat_test(json_flat_test_deserialize_surrogates),
+        json_flat_test(json_flat_test_deserialize_unknown_members),
+        json_flat_test(json_flat_test_deserialize_duplicate_members),
+        json_flat_test(json_flat_test_deserialize_missing_members),
+        json_flat_test(json_flat_test_deserialize_ulonglong),
+        json_flat_test(json_flat_test_deserialize_depth_limit),
+        json_flat_test(json_flat_test_deserialize_truncated),
+        json_flat_test(json_flat_test_serialize_round_trip),
+        json_flat_test(json_flat_test_serialize_formatter),
+        json_flat_test(json_flat_test_serialize_escapes),
+        json_flat_test(json_flat_test_serialize_numbers),
+        json_flat_test(json_flat_test_serialize_not_finite),
+        json_flat_test(json_flat_test_serialize_optional_members),
+        json_flat_test(json_flat_test_serialize_char)
+    };
+    return cmocka_run_group_tests(tests, NULL, NULL);
+}
@@ -0,0 +1,115 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#ifndef FlatTypeTester_h
+#define FlatTypeTester_h
+
+#include "rtitransform_json.h"
+
+#include "DeserializeTester.h"
+#include "SerializeTester.h"
+
+/* Member of BufferType which contains the JSON payload */
+#define JSON_FLAT_TEST_BUFFER_MEMBER        "payload"
+#define JSON_FLAT_TEST_PAYLOAD_MAX_LEN      4096
+#define JSON_FLAT_TEST_STRING_MAX_LEN       16
+
+/**
+ * @brief State shared by the tests of a FlatType transformation.
+ *
+ * FlatType has a required long "id" and a required string<16> "str",
+ * followed by an optional member of every other supported primitive kind:
+ * "s" (short), "us" (unsigned short), "ul" (unsigned long), "ll" (long
+ * long), "ull" (unsigned long long), "f" (float), "d" (double), "o"
+ * (octet), "b" (boolean), and "c" (char).
+ *
+ * BufferType has a single sequence<octet> member called "payload".
+ *
+ * Every test gets a serializer and a deserializer between the two types.
+ */
+struct json_flat_test_state
+{
+    struct DDS_TypeCode *string_type;
+    struct DDS_TypeCode *payload_type;
+    struct DDS_TypeCode *flat_type;
+    struct DDS_TypeCode *buffer_type;
+    struct RTI_RoutingServiceTransformationPlugin *plugin;
+    RTI_TSFM_Json_FlatTypeTransformation *serializer;
+    RTI_TSFM_Json_FlatTypeTransformation *deserializer;
+    DDS_DynamicData *buffer_sample;
+};
+
+#define json_flat_test_state_from(state_) \
+    (*((struct json_flat_test_state**)(state_)))
+
+int
+json_flat_test_setup(void **state);
+
+int
+json_flat_test_teardown(void **state);
+
+DDS_DynamicData*
+json_flat_test_new_sample(struct json_flat_test_state *s);
+
+/**
+ * @brief Deserialize a JSON buffer with the transformation under test.
+ */
+DDS_ReturnCode_t
+json_flat_test_deserialize(
+    struct json_flat_test_state *s,
+    const char *json,
+    DDS_UnsignedLong json_len,
+    DDS_DynamicData *sample);
+
+/**
+ * @brief Serialize a sample with the transformation under test. json must
+ * have room for JSON_FLAT_TEST_PAYLOAD_MAX_LEN + 1 characters, and it is
+ * nul terminated.
+ */
+DDS_ReturnCode_t
+json_flat_test_serialize(
+    struct json_flat_test_state *s,
+    DDS_DynamicData *sample,
+    char *json,
+    DDS_UnsignedLong *json_len);
+
+/**
+ * @brief Deserialize a JSON buffer like the transformation did before
+ * it had a streaming deserializer: the buffer is parsed by json_parse, and
+ * every member of FlatType is set from the first JSON member with its name.
+ */
+DDS_ReturnCode_t
+json_flat_test_deserialize_reference(
+    struct json_flat_test_state *s,
+    const char *json,
+    DDS_UnsignedLong json_len,
+    DDS_DynamicData *sample);
+
+/**
+ * @brief Check that the streaming deserializer and the json_parse reference
+ * agree on a JSON buffer: either both fail, or both succeed and produce
+ * equal samples. If sample_out is not NULL, it returns the sample created
+ * by the streaming deserializer, which must be deleted by the caller.
+ */
+void
+json_flat_test_compare(
+    struct json_flat_test_state *s,
+    const char *json,
+    DDS_UnsignedLong json_len,
+    DDS_Boolean valid,
+    DDS_DynamicData **sample_out);
+
+#define json_flat_test_compare_str(s_,json_,valid_) \
+    json_flat_test_compare( \
+        (s_),(json_),RTI_TSFM_String_length((json_)),(valid_),NULL)
+
+#endif /* FlatTypeTester_h */
@@ -0,0 +1,37 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#ifndef SerializeTester_h
+#define SerializeTester_h
+
+void
+json_flat_test_serialize_round_trip(void **state);
+
+void
+json_flat_test_serialize_formatter(void **state);
+
+void
+json_flat_test_serialize_escapes(void **state);
+
+void
+json_flat_test_serialize_numbers(void **state);
+
+void
+json_flat_test_serialize_not_finite(void **state);
+
+void
+json_flat_test_serialize_optional_members(void **state);
+
+void
+json_flat_test_serialize_char(void **state);
+
+#endif /* SerializeTester_h */
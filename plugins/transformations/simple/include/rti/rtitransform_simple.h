@@ -76,6 +76,27 @@ typedef DDS_ReturnCode_t
         DDS_DynamicData *sample_in,
         DDS_DynamicData *sample_out);
 
+/**
+ * @brief Optional variants of the sample functions, which receive all the
+ * samples passed to a single call of the transformation, so that plugins
+ * can share lookups and buffers between them.
+ */
+typedef DDS_ReturnCode_t 
+(*RTI_TSFM_UserTypePlugin_SerializeBatchFn)(
+        RTI_TSFM_UserTypePlugin *plugin,
+        RTI_TSFM_Transformation *transform,
+        DDS_DynamicData **samples_in,
+        DDS_DynamicData **samples_out,
+        DDS_UnsignedLong count);
+
+typedef DDS_ReturnCode_t 
+(*RTI_TSFM_UserTypePlugin_DeserializeBatchFn)(
+        RTI_TSFM_UserTypePlugin *plugin,
+        RTI_TSFM_Transformation *transform,
+        DDS_DynamicData **samples_in,
+        DDS_DynamicData **samples_out,
+        DDS_UnsignedLong count);
+
 typedef void
 (*RTI_TSFM_UserTypePlugin_DeletePluginFn)(
         RTI_TSFM_UserTypePlugin *self,
@@ -86,6 +107,9 @@ typedef struct RTI_TSFM_UserTypePluginImpl
     RTI_TSFM_UserTypePlugin_DeletePluginFn          delete_plugin;
     RTI_TSFM_UserTypePlugin_SerializeSampleFn       serialize_sample;
     RTI_TSFM_UserTypePlugin_DeserializeSampleFn     deserialize_sample;
+    /* Used instead of the sample functions when not NULL */
+    RTI_TSFM_UserTypePlugin_SerializeBatchFn        serialize_batch;
+    RTI_TSFM_UserTypePlugin_DeserializeBatchFn      deserialize_batch;
     void                                           *user_object;
 } RTI_TSFM_UserTypePlugin;
 
@@ -93,6 +117,8 @@ typedef struct RTI_TSFM_UserTypePluginImpl
 {\
     (p_)->serialize_sample = NULL; \
     (p_)->deserialize_sample = NULL; \
+    (p_)->serialize_batch = NULL; \
+    (p_)->deserialize_batch = NULL; \
     (p_)->user_object = NULL; \
 }
 
@@ -25,7 +25,9 @@
 #define RTI_TSFM_USE_LOG                    1
 #endif
 
-#ifndef RTI_TSFM_ENABLE_TRACE
+/* Trace messages, including function calls, are never compiled in a
+   release build, even if RTI_TSFM_ENABLE_TRACE is defined */
+#if !defined(RTI_TSFM_ENABLE_TRACE) || defined(NDEBUG)
 #define RTI_TSFM_USE_TRACE                  0
 #else
 #define RTI_TSFM_USE_TRACE                  1
@@ -34,6 +36,69 @@
 #define RTI_TSFM_XSTR(x_)           #x_
 #define RTI_TSFM_STRINGIFY(x_)      RTI_TSFM_XSTR(x_)
 
+/*****************************************************************************
+ *
+ *****************************************************************************/
+
+/*
+ * Messages which are compiled in are filtered at run-time against a cached
+ * verbosity level. A filtered message only costs a comparison with the
+ * level, and its arguments are never formatted. The level is loaded when
+ * the plugin is created, from the RTI_TSFM_LOG_LEVEL environment variable.
+ */
+#define RTI_TSFM_LOG_LEVEL_SILENT           0
+#define RTI_TSFM_LOG_LEVEL_ERROR            1
+#define RTI_TSFM_LOG_LEVEL_WARNING          2
+#define RTI_TSFM_LOG_LEVEL_INFO             3
+#define RTI_TSFM_LOG_LEVEL_TRACE            4
+
+#define RTI_TSFM_LOG_LEVEL_ENV              "RTI_TSFM_LOG_LEVEL"
+
+#define RTI_TSFM_LOG_ASYNC_ENV              "RTI_TSFM_LOG_ASYNC"
+
+#if RTI_TSFM_USE_TRACE
+#define RTI_TSFM_LOG_LEVEL_DEFAULT          RTI_TSFM_LOG_LEVEL_TRACE
+#else
+#define RTI_TSFM_LOG_LEVEL_DEFAULT          RTI_TSFM_LOG_LEVEL_INFO
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern int RTI_TSFM_Log_level;
+
+/*
+ * Load the verbosity level from the environment, and start the asynchronous
+ * backend if it is enabled. The level can be one of SILENT, ERROR, WARNING,
+ * INFO or TRACE. Plugins call this function when they are created, and
+ * RTI_TSFM_Log_finalize() when they are deleted.
+ */
+void
+RTI_TSFM_Log_initialize(void);
+
+void
+RTI_TSFM_Log_finalize(void);
+
+/*
+ * Write a message to the log. Messages are written to stdout by the calling
+ * thread, unless the RTI_TSFM_LOG_ASYNC environment variable is set to
+ * the path of a file, or to "stdout". In that case, a transformation only
+ * stores `fmt` and a copy of its arguments in a slot of a lock-free ring
+ * shared by all the transformations of the library, and a background
+ * thread formats and writes them. `fmt` must be a string literal. When the
+ * ring is full, messages are dropped, and counted.
+ */
+void
+RTI_TSFM_Log_printf(const char *fmt, ...);
+
+#ifdef __cplusplus
+}
+#endif
+
+#define RTI_TSFM_LOG_ENABLED(lvl_) \
+    (RTI_TSFM_Log_level >= (lvl_))
+
 /*****************************************************************************
  *
  *****************************************************************************/
@@ -53,100 +118,144 @@
 #if RTI_TSFM_USE_LOG
 
 #define RTI_TSFM_LOG(msg_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s\n", RTI_TSFM_LOG_ARGS, (msg_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s\n", RTI_TSFM_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_TSFM_LOG_1(msg_,fmt_,a1_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_)); \
+    }
 
 #define RTI_TSFM_LOG_2(msg_,fmt_,a1_,a2_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_TSFM_LOG_3(msg_,fmt_,a1_,a2_,a3_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_)); \
+    }
 
 #define RTI_TSFM_LOG_4(msg_,fmt_,a1_,a2_,a3_,a4_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_)); \
+    }
 
 #define RTI_TSFM_LOG_5(msg_,fmt_,a1_,a2_,a3_,a4_,a5_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_)); \
+    }
 
 #define RTI_TSFM_LOG_6(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_)); \
+    }
 
 #define RTI_TSFM_LOG_7(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_)); \
+    }
 
 #define RTI_TSFM_LOG_8(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_)); \
+    }
 
 #define RTI_TSFM_LOG_9(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), (a9_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), (a9_)); \
+    }
 
 #define RTI_TSFM_LOG_10(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_)); \
+    }
 
 #define RTI_TSFM_LOG_11(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_)); \
+    }
 
 #define RTI_TSFM_LOG_12(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_)); \
+    }
 
 #define RTI_TSFM_LOG_13(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_,a13_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_), \
-            (a13_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_), \
+                (a13_)); \
+    }
 
 #define RTI_TSFM_LOG_16(msg_,fmt_,\
                    a1_,a2_,a3_,a4_,\
                    a5_,a6_,a7_,a8_,\
                    a9_,a10_,a11_,a12_,\
                    a13_,a14_,a15_,a16_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_), \
-            (a13_), (a14_), (a15_), (a16_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_INFO)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_), \
+                (a13_), (a14_), (a15_), (a16_)); \
+    }
 
 #define RTI_TSFM_WARNING(msg_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_WARNING "%s\n", RTI_TSFM_LOG_ARGS, (msg_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_WARNING)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_WARNING "%s\n", RTI_TSFM_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_TSFM_ERROR(msg_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_ERROR "%s\n", RTI_TSFM_LOG_ARGS, (msg_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_ERROR)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_ERROR "%s\n", RTI_TSFM_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_TSFM_ERROR_1(msg_,fmt_,a1_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_ERROR)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_)); \
+    }
 
 #define RTI_TSFM_ERROR_2(msg_,fmt_,a1_,a2_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_ERROR)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_TSFM_ERROR_3(msg_,fmt_,a1_,a2_,a3_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_), (a3_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_ERROR)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_), (a3_)); \
+    }
 
 #define RTI_TSFM_ERROR_4(msg_,fmt_,a1_,a2_,a3_,a4_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_ERROR)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_)); \
+    }
 
 #define RTI_TSFM_ERROR_5(msg_,fmt_,a1_,a2_,a3_,a4_,a5_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_), (a5_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_ERROR)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_ERROR "%s:" fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_), (a3_), (a4_), (a5_)); \
+    }
 
 #else
 
@@ -192,62 +301,90 @@
 #if RTI_TSFM_USE_TRACE
 
 #define RTI_TSFM_TRACE(msg_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s\n",RTI_TSFM_LOG_ARGS, (msg_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s\n",RTI_TSFM_LOG_ARGS, (msg_)); \
+    }
 
 #define RTI_TSFM_TRACE_1(msg_,fmt_,a1_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_)); \
+    }
 
 #define RTI_TSFM_TRACE_2(msg_,fmt_,a1_,a2_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), (a1_), (a2_)); \
+    }
 
 #define RTI_TSFM_TRACE_3(msg_,fmt_,a1_,a2_,a3_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_)); \
+    }
 
 #define RTI_TSFM_TRACE_4(msg_,fmt_,a1_,a2_,a3_,a4_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_)); \
+    }
 
 #define RTI_TSFM_TRACE_5(msg_,fmt_,a1_,a2_,a3_,a4_,a5_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_)); \
+    }
 
 #define RTI_TSFM_TRACE_6(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_)); \
+    }
 
 #define RTI_TSFM_TRACE_7(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_)); \
+    }
 
 #define RTI_TSFM_TRACE_8(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_)); \
+    }
 
 #define RTI_TSFM_TRACE_9(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_)); \
+    }
 
 #define RTI_TSFM_TRACE_10(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_)); \
+    }
 
 #define RTI_TSFM_TRACE_11(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_), (a11_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD_TRACE "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), (a5_), (a6_), (a7_), (a8_), (a9_), (a10_), (a11_)); \
+    }
 
 #define RTI_TSFM_TRACE_12(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_)); \
+    }
 
 #define RTI_TSFM_TRACE_13(msg_,fmt_,a1_,a2_,a3_,a4_,a5_,a6_,a7_,a8_,a9_,a10_,a11_,a12_,a13_) \
-    fprintf(stdout,RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
-            (a1_), (a2_), (a3_), (a4_), \
-            (a5_), (a6_), (a7_), (a8_), \
-            (a9_), (a10_), (a11_), (a12_), \
-            (a13_));
+    if (RTI_TSFM_LOG_ENABLED(RTI_TSFM_LOG_LEVEL_TRACE)) { \
+        RTI_TSFM_Log_printf(RTI_TSFM_LOG_HEAD "%s " fmt_ "\n", RTI_TSFM_LOG_ARGS, (msg_), \
+                (a1_), (a2_), (a3_), (a4_), \
+                (a5_), (a6_), (a7_), (a8_), \
+                (a9_), (a10_), (a11_), (a12_), \
+                (a13_)); \
+    }
 
 #else
 
@@ -87,6 +87,7 @@
 #define RTI_TSFM_Heap_free                    free
 #endif
 #define RTI_TSFM_Memory_copy                  memcpy
+#define RTI_TSFM_Memory_move                  memmove
 #define RTI_TSFM_Memory_set                   memset
 #define RTI_TSFM_Memory_compare               memcmp
 #define RTI_TSFM_Memory_zero(ptr_,size_)      (memset((ptr_),0,(size_)))
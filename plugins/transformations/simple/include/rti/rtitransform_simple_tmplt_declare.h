@@ -64,6 +64,14 @@
 #ifndef T_deserialize
 #define T_deserialize                   concat(T, _deserialize)
 #endif /* T_deserialize */
+#ifdef T_batch
+#ifndef T_serialize_batch
+#define T_serialize_batch               concat(T, _serialize_batch)
+#endif /* T_serialize_batch */
+#ifndef T_deserialize_batch
+#define T_deserialize_batch             concat(T, _deserialize_batch)
+#endif /* T_deserialize_batch */
+#endif /* T_batch */
 #endif /* T_static */
 
 /*****************************************************************************
@@ -167,6 +175,22 @@ T_deserialize(RTI_TSFM_UserTypePlugin *plugin,
               RTI_TSFM_Transformation *self,
               DDS_DynamicData *sample_in,
               DDS_DynamicData *sample_out);
+
+#ifdef T_batch
+DDS_ReturnCode_t 
+T_serialize_batch(RTI_TSFM_UserTypePlugin *plugin,
+                  RTI_TSFM_Transformation *self,
+                  DDS_DynamicData **samples_in,
+                  DDS_DynamicData **samples_out,
+                  DDS_UnsignedLong count);
+
+DDS_ReturnCode_t 
+T_deserialize_batch(RTI_TSFM_UserTypePlugin *plugin,
+                    RTI_TSFM_Transformation *self,
+                    DDS_DynamicData **samples_in,
+                    DDS_DynamicData **samples_out,
+                    DDS_UnsignedLong count);
+#endif /* T_batch */
 #endif /* T_static */
 
 #ifdef TPluginConfig_parse
@@ -199,6 +223,9 @@ TConfig_parse(TConfig *self,
 #undef T_static
 #undef T_serialize
 #undef T_deserialize
+#undef T_batch
+#undef T_serialize_batch
+#undef T_deserialize_batch
 #undef TConfig
 #undef TState
 #undef TPluginConfig
@@ -106,6 +106,14 @@
 #ifndef T_deserialize
 #define T_deserialize               concat(T,_deserialize)
 #endif /* T_deserialize */
+#ifdef T_batch
+#ifndef T_serialize_batch
+#define T_serialize_batch           concat(T,_serialize_batch)
+#endif /* T_serialize_batch */
+#ifndef T_deserialize_batch
+#define T_deserialize_batch         concat(T,_deserialize_batch)
+#endif /* T_deserialize_batch */
+#endif /* T_batch */
 #endif /* T_static */
 
 /*****************************************************************************
@@ -131,6 +139,8 @@ TPlugin_create(const struct RTI_RoutingServiceProperties *properties,
 
     RTI_TSFM_LOG_FN(TPlugin_create)
 
+    RTI_TSFM_Log_initialize();
+
     if (DDS_RETCODE_OK != TPlugin_new(properties, env, &self))
     {
         goto done;
@@ -144,6 +154,7 @@ done:
     }
     else
     {
+        RTI_TSFM_Log_finalize();
         return NULL;
     }
 }
@@ -209,6 +220,10 @@ TPlugin_new(const struct RTI_RoutingServiceProperties *properties,
     {
         goto done;
     }
+#ifdef T_batch
+    user_plugin->serialize_batch = T_serialize_batch;
+    user_plugin->deserialize_batch = T_deserialize_batch;
+#endif /* T_batch */
    
     if (DDS_RETCODE_OK !=
             RTI_TSFM_TransformationPlugin_initialize_static(
@@ -337,6 +352,8 @@ TPlugin_delete(struct RTI_RoutingServiceTransformationPlugin *plugin,
 #endif /* TPlugin_finalize */
     RTI_TSFM_Heap_free(self);
 
+    RTI_TSFM_Log_finalize();
+
     retval = DDS_BOOLEAN_TRUE;
 
 done:
@@ -738,6 +755,9 @@ T_update(RTI_RoutingServiceTransformation transformation,
 #undef T_static
 #undef T_serialize
 #undef T_deserialize
+#undef T_batch
+#undef T_serialize_batch
+#undef T_deserialize_batch
 #undef TConfig
 #undef TState
 #undef T_VERSION_MAJOR
@@ -15,6 +15,74 @@
 
 #include "rtitransform_simple.h"
 
+/*
+ * Atomic operations used by the asynchronous log backend, which is shared
+ * by all the transformations built on this library. Loads have acquire
+ * semantics, stores have release semantics, and read-modify-write
+ * operations are full barriers. Increment and decrement return the new
+ * value of the counter.
+ */
+typedef DDS_UnsignedLongLong RTI_TSFM_AtomicCounter;
+
+#if RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_POSIX
+
+#if defined(__ATOMIC_ACQUIRE)
+#define RTI_TSFM_Atomic_load(p_) \
+    __atomic_load_n((p_), __ATOMIC_ACQUIRE)
+#define RTI_TSFM_Atomic_store(p_,v_) \
+    __atomic_store_n((p_), (v_), __ATOMIC_RELEASE)
+#define RTI_TSFM_Atomic_load_ptr(p_) \
+    __atomic_load_n((p_), __ATOMIC_ACQUIRE)
+#define RTI_TSFM_Atomic_exchange_ptr(p_,v_) \
+    __atomic_exchange_n((p_), (v_), __ATOMIC_SEQ_CST)
+#else
+#define RTI_TSFM_Atomic_load(p_) \
+    __sync_fetch_and_add((p_), 0)
+#define RTI_TSFM_Atomic_store(p_,v_) \
+{\
+    __sync_synchronize(); \
+    *(p_) = (v_); \
+}
+#define RTI_TSFM_Atomic_load_ptr(p_) \
+    __sync_fetch_and_add((p_), 0)
+#define RTI_TSFM_Atomic_exchange_ptr(p_,v_) \
+    (__sync_synchronize(), __sync_lock_test_and_set((p_), (v_)))
+#endif
+
+#define RTI_TSFM_Atomic_compare_and_swap(p_,o_,n_) \
+    __sync_bool_compare_and_swap((p_), (o_), (n_))
+
+#define RTI_TSFM_Atomic_increment(p_) \
+    __sync_add_and_fetch((p_), 1)
+
+#define RTI_TSFM_Atomic_decrement(p_) \
+    __sync_sub_and_fetch((p_), 1)
+
+#elif RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_WINDOWS
+
+#define RTI_TSFM_Atomic_load(p_) \
+    ((RTI_TSFM_AtomicCounter)InterlockedCompareExchange64(\
+        (volatile LONG64*)(p_), 0, 0))
+#define RTI_TSFM_Atomic_store(p_,v_) \
+    ((void)InterlockedExchange64((volatile LONG64*)(p_), (LONG64)(v_)))
+
+#define RTI_TSFM_Atomic_compare_and_swap(p_,o_,n_) \
+    (InterlockedCompareExchange64(\
+        (volatile LONG64*)(p_), (LONG64)(n_), (LONG64)(o_)) == (LONG64)(o_))
+
+#define RTI_TSFM_Atomic_increment(p_) \
+    ((RTI_TSFM_AtomicCounter)InterlockedIncrement64((volatile LONG64*)(p_)))
+
+#define RTI_TSFM_Atomic_decrement(p_) \
+    ((RTI_TSFM_AtomicCounter)InterlockedDecrement64((volatile LONG64*)(p_)))
+
+#define RTI_TSFM_Atomic_load_ptr(p_) \
+    InterlockedCompareExchangePointer((PVOID volatile*)(p_), NULL, NULL)
+#define RTI_TSFM_Atomic_exchange_ptr(p_,v_) \
+    InterlockedExchangePointer((PVOID volatile*)(p_), (PVOID)(v_))
+
+#endif
+
 RTIBool
 RTI_TSFM_DDS_DynamicDataPtr_initialize_w_params(
     DDS_DynamicData **self,
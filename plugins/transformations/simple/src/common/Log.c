@@ -0,0 +1,666 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#include "Log.h"
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_WINDOWS
+#include <process.h>
+#endif
+
+#define RTI_TSFM_LOG_ARGS           "rtitransform::simple::log"
+
+int RTI_TSFM_Log_level = RTI_TSFM_LOG_LEVEL_DEFAULT;
+
+/*
+ * Every transformation plugin built on this library (simple, field, JSON)
+ * counts as a user of the log while it exists. Transformation plugins are
+ * only loaded and unloaded by the Routing Service thread which processes
+ * the configuration.
+ */
+static DDS_UnsignedLong RTI_TSFM_Log_users = 0;
+
+/*
+ * Transformations run on the session threads of every route, which might
+ * still be logging when the last plugin is deleted. They announce
+ * themselves in `RTI_TSFM_Log_writers` before loading the backend, so that
+ * RTI_TSFM_Log_finalize() can unpublish it and wait for them to leave
+ * before deleting it.
+ */
+static struct RTI_TSFM_LogBackend *RTI_TSFM_Log_backend = NULL;
+
+static RTI_TSFM_AtomicCounter RTI_TSFM_Log_writers = 0;
+
+static void
+RTI_TSFM_Log_load_level(void)
+{
+    static const char *level_names[] =
+    {
+        "SILENT", "ERROR", "WARNING", "INFO", "TRACE"
+    };
+    const char *level_str = getenv(RTI_TSFM_LOG_LEVEL_ENV);
+    int i = 0;
+
+    if (level_str == NULL)
+    {
+        return;
+    }
+    for (i = RTI_TSFM_LOG_LEVEL_SILENT; i <= RTI_TSFM_LOG_LEVEL_TRACE; i++)
+    {
+        if (strcmp(level_str, level_names[i]) == 0)
+        {
+            RTI_TSFM_Log_level = i;
+            return;
+        }
+    }
+    RTI_TSFM_WARNING("unknown log level in " RTI_TSFM_LOG_LEVEL_ENV)
+}
+
+/*
+ * Parse one conversion of a log format, starting right after its '%'. A
+ * record can store the arguments of the integer, floating point, pointer
+ * and string conversions, with at most an "h", "hh", "l", "ll" or "z"
+ * length modifier. Widths and precisions must be literal numbers.
+ */
+static DDS_Boolean
+RTI_TSFM_LogRecord_parse_spec(
+    const char *spec,
+    RTI_TSFM_LogArgKind *kind_out,
+    DDS_UnsignedLong *spec_len_out)
+{
+    DDS_UnsignedLong i = 0;
+    int longs = 0;
+    DDS_Boolean is_size = DDS_BOOLEAN_FALSE;
+
+    while (spec[i] == '-' || spec[i] == '+' || spec[i] == ' ' ||
+            spec[i] == '#' || spec[i] == '0')
+    {
+        i += 1;
+    }
+    while (spec[i] >= '0' && spec[i] <= '9')
+    {
+        i += 1;
+    }
+    if (spec[i] == '.')
+    {
+        i += 1;
+        while (spec[i] >= '0' && spec[i] <= '9')
+        {
+            i += 1;
+        }
+    }
+    if (spec[i] == 'h')
+    {
+        i += (spec[i + 1] == 'h')? 2 : 1;
+    }
+    else if (spec[i] == 'l')
+    {
+        longs = (spec[i + 1] == 'l')? 2 : 1;
+        i += longs;
+    }
+    else if (spec[i] == 'z')
+    {
+        is_size = DDS_BOOLEAN_TRUE;
+        i += 1;
+    }
+
+    switch (spec[i])
+    {
+    case 'd':
+    case 'i':
+    case 'c':
+        *kind_out = (is_size)? RTI_TSFM_LogArgKind_SIZE :
+                    (longs == 2)? RTI_TSFM_LogArgKind_LONGLONG :
+                    (longs == 1)? RTI_TSFM_LogArgKind_LONG :
+                    RTI_TSFM_LogArgKind_INT;
+        break;
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        *kind_out = (is_size)? RTI_TSFM_LogArgKind_SIZE :
+                    (longs == 2)? RTI_TSFM_LogArgKind_ULONGLONG :
+                    (longs == 1)? RTI_TSFM_LogArgKind_ULONG :
+                    RTI_TSFM_LogArgKind_UINT;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+        *kind_out = RTI_TSFM_LogArgKind_DOUBLE;
+        break;
+    case 'p':
+        *kind_out = RTI_TSFM_LogArgKind_POINTER;
+        break;
+    case 's':
+        if (longs > 0)
+        {
+            return DDS_BOOLEAN_FALSE;
+        }
+        *kind_out = RTI_TSFM_LogArgKind_STRING;
+        break;
+    default:
+        return DDS_BOOLEAN_FALSE;
+    }
+
+    /* '%', the specification, and a terminator must fit in a buffer */
+    *spec_len_out = i + 1;
+    return (*spec_len_out + 2 <= RTI_TSFM_LOG_SPEC_MAX_LEN);
+}
+
+/*
+ * Fill a record from a transformation thread. The format is scanned once
+ * to find the type of every argument, and the arguments are then copied
+ * without being converted to text. Nothing is read from `args` unless the
+ * whole format can be stored, so that the caller can still print it.
+ */
+static DDS_Boolean
+RTI_TSFM_LogRecord_capture(
+    struct RTI_TSFM_LogRecord *self,
+    const char *fmt,
+    va_list args)
+{
+    const char *cur = fmt,
+               *str = NULL;
+    RTI_TSFM_LogArgKind kind = RTI_TSFM_LogArgKind_INT;
+    DDS_UnsignedLong spec_len = 0,
+                     avail = 0,
+                     len = 0,
+                     i = 0;
+    union RTI_TSFM_LogArg *arg = NULL;
+
+    self->args_len = 0;
+    self->strings_len = 0;
+
+    while ((cur = strchr(cur, '%')) != NULL)
+    {
+        if (cur[1] == '%')
+        {
+            cur += 2;
+            continue;
+        }
+        if (self->args_len == RTI_TSFM_LOG_RECORD_MAX_ARGS ||
+            !RTI_TSFM_LogRecord_parse_spec(cur + 1, &kind, &spec_len))
+        {
+            return DDS_BOOLEAN_FALSE;
+        }
+        self->kinds[self->args_len] = (unsigned char)kind;
+        self->args_len += 1;
+        cur += 1 + spec_len;
+    }
+
+    for (i = 0; i < self->args_len; i++)
+    {
+        arg = &self->args[i];
+        switch ((RTI_TSFM_LogArgKind)self->kinds[i])
+        {
+        case RTI_TSFM_LogArgKind_INT:
+            arg->as_signed = va_arg(args, int);
+            break;
+        case RTI_TSFM_LogArgKind_LONG:
+            arg->as_signed = va_arg(args, long);
+            break;
+        case RTI_TSFM_LogArgKind_LONGLONG:
+            arg->as_signed = va_arg(args, long long);
+            break;
+        case RTI_TSFM_LogArgKind_UINT:
+            arg->as_unsigned = va_arg(args, unsigned int);
+            break;
+        case RTI_TSFM_LogArgKind_ULONG:
+            arg->as_unsigned = va_arg(args, unsigned long);
+            break;
+        case RTI_TSFM_LogArgKind_ULONGLONG:
+            arg->as_unsigned = va_arg(args, unsigned long long);
+            break;
+        case RTI_TSFM_LogArgKind_SIZE:
+            arg->as_unsigned = va_arg(args, size_t);
+            break;
+        case RTI_TSFM_LogArgKind_DOUBLE:
+            arg->as_double = va_arg(args, double);
+            break;
+        case RTI_TSFM_LogArgKind_POINTER:
+            arg->as_pointer = va_arg(args, void*);
+            break;
+        case RTI_TSFM_LogArgKind_STRING:
+            str = va_arg(args, const char*);
+            if (str == NULL)
+            {
+                str = "(null)";
+            }
+            /* Strings share the record's buffer: whatever doesn't fit is
+               cut, and strings after a full buffer print as "" */
+            arg->as_string = self->strings_len;
+            avail = RTI_TSFM_LOG_RECORD_STRINGS_LEN - self->strings_len;
+            if (avail == 0)
+            {
+                arg->as_string = self->strings_len - 1;
+                break;
+            }
+            for (len = 0; len + 1 < avail && str[len] != '\0'; len++)
+            {
+                self->strings[self->strings_len + len] = str[len];
+            }
+            self->strings[self->strings_len + len] = '\0';
+            self->strings_len += len + 1;
+            break;
+        }
+    }
+
+    self->fmt = fmt;
+    return DDS_BOOLEAN_TRUE;
+}
+
+/*
+ * Print a record on the drain thread, one conversion at a time: the text
+ * between conversions is copied as is, and each conversion is printed
+ * with its stored argument, cast back to the type it was read as.
+ */
+static void
+RTI_TSFM_LogRecord_write(
+    const struct RTI_TSFM_LogRecord *self,
+    FILE *output)
+{
+    char spec[RTI_TSFM_LOG_SPEC_MAX_LEN];
+    const char *cur = self->fmt,
+               *next = NULL;
+    const union RTI_TSFM_LogArg *arg = NULL;
+    RTI_TSFM_LogArgKind kind = RTI_TSFM_LogArgKind_INT;
+    DDS_UnsignedLong spec_len = 0,
+                     i = 0;
+
+    if (self->fmt == NULL)
+    {
+        fputs(self->strings, output);
+        return;
+    }
+
+    while ((next = strchr(cur, '%')) != NULL)
+    {
+        fwrite(cur, 1, (size_t)(next - cur), output);
+        if (next[1] == '%')
+        {
+            fputc('%', output);
+            cur = next + 2;
+            continue;
+        }
+
+        /* Cannot fail, the record was only published if it did not */
+        (void)RTI_TSFM_LogRecord_parse_spec(next + 1, &kind, &spec_len);
+        RTI_TSFM_Memory_copy(spec, next, spec_len + 1);
+        spec[spec_len + 1] = '\0';
+        cur = next + 1 + spec_len;
+
+        arg = &self->args[i];
+        switch ((RTI_TSFM_LogArgKind)self->kinds[i])
+        {
+        case RTI_TSFM_LogArgKind_INT:
+            fprintf(output, spec, (int)arg->as_signed);
+            break;
+        case RTI_TSFM_LogArgKind_LONG:
+            fprintf(output, spec, (long)arg->as_signed);
+            break;
+        case RTI_TSFM_LogArgKind_LONGLONG:
+            fprintf(output, spec, (long long)arg->as_signed);
+            break;
+        case RTI_TSFM_LogArgKind_UINT:
+            fprintf(output, spec, (unsigned int)arg->as_unsigned);
+            break;
+        case RTI_TSFM_LogArgKind_ULONG:
+            fprintf(output, spec, (unsigned long)arg->as_unsigned);
+            break;
+        case RTI_TSFM_LogArgKind_ULONGLONG:
+            fprintf(output, spec, (unsigned long long)arg->as_unsigned);
+            break;
+        case RTI_TSFM_LogArgKind_SIZE:
+            fprintf(output, spec, (size_t)arg->as_unsigned);
+            break;
+        case RTI_TSFM_LogArgKind_DOUBLE:
+            fprintf(output, spec, arg->as_double);
+            break;
+        case RTI_TSFM_LogArgKind_POINTER:
+            fprintf(output, spec, (void*)arg->as_pointer);
+            break;
+        case RTI_TSFM_LogArgKind_STRING:
+            fprintf(output, spec, self->strings + arg->as_string);
+            break;
+        }
+        i += 1;
+    }
+    fputs(cur, output);
+}
+
+/*
+ * Write all the records which are ready, and report messages which were
+ * dropped since the last call. Only the drain thread pops records, so
+ * `pop_pos` is never modified concurrently. Returns DDS_BOOLEAN_TRUE if
+ * anything was written to the output.
+ */
+static DDS_Boolean
+RTI_TSFM_LogBackend_drain(
+    struct RTI_TSFM_LogBackend *self,
+    RTI_TSFM_AtomicCounter *reported_dropped)
+{
+    struct RTI_TSFM_LogRecord *record = NULL;
+    RTI_TSFM_AtomicCounter pos = self->pop_pos,
+                           dropped = 0;
+    DDS_Boolean written = DDS_BOOLEAN_FALSE;
+
+    for (;;)
+    {
+        record = &self->records[pos % RTI_TSFM_LOG_RING_CAPACITY];
+        if (RTI_TSFM_Atomic_load(&record->seq) != pos + 1)
+        {
+            break;
+        }
+        RTI_TSFM_LogRecord_write(record, self->output);
+        written = DDS_BOOLEAN_TRUE;
+
+        /* Hand the slot to the writer one lap ahead */
+        RTI_TSFM_Atomic_store(&record->seq, pos + RTI_TSFM_LOG_RING_CAPACITY);
+        pos += 1;
+    }
+    self->pop_pos = pos;
+
+    dropped = RTI_TSFM_Atomic_load(&self->dropped);
+    if (dropped != *reported_dropped)
+    {
+        fprintf(self->output,
+            RTI_TSFM_LOG_HEAD_WARNING "%llu log messages DROPPED\n",
+            RTI_TSFM_LOG_ARGS,
+            (unsigned long long)(dropped - *reported_dropped));
+        *reported_dropped = dropped;
+        written = DDS_BOOLEAN_TRUE;
+    }
+
+    if (written)
+    {
+        fflush(self->output);
+    }
+    return written;
+}
+
+#if RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_POSIX
+static void*
+#elif RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_WINDOWS
+static unsigned __stdcall
+#endif
+RTI_TSFM_LogBackend_drain_thread(void *arg)
+{
+    struct RTI_TSFM_LogBackend *self = (struct RTI_TSFM_LogBackend*)arg;
+    struct DDS_Duration_t period = { 0, RTI_TSFM_LOG_DRAIN_PERIOD_NS };
+    RTI_TSFM_AtomicCounter reported_dropped = 0;
+    DDS_Boolean stopped = DDS_BOOLEAN_FALSE;
+
+    do
+    {
+        /* Read `stopped` first: a final drain runs after the flag is seen,
+           so no record published before RTI_TSFM_Log_finalize() is lost */
+        stopped = (RTI_TSFM_Atomic_load(&self->stopped) != 0);
+
+        if (!RTI_TSFM_LogBackend_drain(self, &reported_dropped) && !stopped)
+        {
+            NDDS_Utility_sleep(&period);
+        }
+    } while (!stopped);
+
+    return 0;
+}
+
+static void
+RTI_TSFM_LogBackend_delete(struct RTI_TSFM_LogBackend *self)
+{
+    if (self->thread_started)
+    {
+        RTI_TSFM_Atomic_store(&self->stopped, 1);
+#if RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_POSIX
+        if (0 != pthread_join(self->thread, NULL))
+        {
+            /* The drain thread might still be using the backend */
+            RTI_TSFM_ERROR("failed to join log drain thread")
+            return;
+        }
+#elif RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_WINDOWS
+        if (WAIT_OBJECT_0 != WaitForSingleObject(self->thread, INFINITE))
+        {
+            /* The drain thread might still be using the backend */
+            RTI_TSFM_ERROR("failed to join log drain thread")
+            return;
+        }
+        CloseHandle(self->thread);
+#endif
+    }
+    if (self->output != NULL && self->output != stdout)
+    {
+        fclose(self->output);
+    }
+    if (self->records != NULL)
+    {
+        RTI_TSFM_Heap_free(self->records);
+    }
+    RTI_TSFM_Heap_free(self);
+}
+
+static DDS_ReturnCode_t
+RTI_TSFM_LogBackend_new(
+    const char *output,
+    struct RTI_TSFM_LogBackend **backend_out)
+{
+    DDS_ReturnCode_t retcode = DDS_RETCODE_ERROR;
+    struct RTI_TSFM_LogBackend *backend = NULL;
+    DDS_UnsignedLong i = 0;
+
+    RTI_TSFM_LOG_FN(RTI_TSFM_LogBackend_new)
+
+    backend = (struct RTI_TSFM_LogBackend*)
+        RTI_TSFM_Heap_allocate(sizeof(struct RTI_TSFM_LogBackend));
+    if (backend == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    RTI_TSFM_Memory_zero(backend, sizeof(struct RTI_TSFM_LogBackend));
+
+    backend->records = (struct RTI_TSFM_LogRecord*)
+        RTI_TSFM_Heap_allocate(
+            sizeof(struct RTI_TSFM_LogRecord) * RTI_TSFM_LOG_RING_CAPACITY);
+    if (backend->records == NULL)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+    for (i = 0; i < RTI_TSFM_LOG_RING_CAPACITY; i++)
+    {
+        backend->records[i].seq = i;
+    }
+
+    if (strcmp(output, "stdout") == 0)
+    {
+        backend->output = stdout;
+    }
+    else
+    {
+        backend->output = fopen(output, "a");
+        if (backend->output == NULL)
+        {
+            RTI_TSFM_ERROR_1("failed to open log file:","%s",output)
+            goto done;
+        }
+    }
+
+#if RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_POSIX
+    if (0 != pthread_create(&backend->thread, NULL,
+                RTI_TSFM_LogBackend_drain_thread, backend))
+    {
+        /* TODO Log error */
+        goto done;
+    }
+#elif RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_WINDOWS
+    backend->thread = (HANDLE)_beginthreadex(
+            NULL, 0, RTI_TSFM_LogBackend_drain_thread, backend, 0, NULL);
+    if (backend->thread == 0)
+    {
+        /* TODO Log error */
+        goto done;
+    }
+#endif
+    backend->thread_started = DDS_BOOLEAN_TRUE;
+
+    *backend_out = backend;
+
+    retcode = DDS_RETCODE_OK;
+done:
+    if (retcode != DDS_RETCODE_OK && backend != NULL)
+    {
+        RTI_TSFM_LogBackend_delete(backend);
+    }
+    return retcode;
+}
+
+void
+RTI_TSFM_Log_initialize(void)
+{
+    const char *output = NULL;
+    struct RTI_TSFM_LogBackend *backend = NULL;
+
+    RTI_TSFM_Log_load_level();
+
+    RTI_TSFM_Log_users += 1;
+    if (RTI_TSFM_Log_users > 1)
+    {
+        return;
+    }
+
+    output = getenv(RTI_TSFM_LOG_ASYNC_ENV);
+    if (output == NULL)
+    {
+        return;
+    }
+    if (DDS_RETCODE_OK != RTI_TSFM_LogBackend_new(output, &backend))
+    {
+        /* Messages will keep being written synchronously */
+        RTI_TSFM_ERROR_1("failed to start asynchronous log:","output=%s",
+            output)
+        return;
+    }
+    (void)RTI_TSFM_Atomic_exchange_ptr(&RTI_TSFM_Log_backend, backend);
+}
+
+void
+RTI_TSFM_Log_finalize(void)
+{
+    struct RTI_TSFM_LogBackend *backend = NULL;
+    struct DDS_Duration_t period = { 0, RTI_TSFM_LOG_QUIESCE_PERIOD_NS };
+
+    if (RTI_TSFM_Log_users == 0)
+    {
+        return;
+    }
+    RTI_TSFM_Log_users -= 1;
+    if (RTI_TSFM_Log_users > 0)
+    {
+        return;
+    }
+
+    backend = (struct RTI_TSFM_LogBackend*)
+        RTI_TSFM_Atomic_exchange_ptr(&RTI_TSFM_Log_backend, NULL);
+    if (backend == NULL)
+    {
+        return;
+    }
+
+    /* New messages are now printed directly. Wait for the transformations
+       which loaded the backend before the exchange to store their
+       records: a compare-and-swap of the count with itself is a full
+       barrier that succeeds once it is zero. */
+    while (!RTI_TSFM_Atomic_compare_and_swap(&RTI_TSFM_Log_writers, 0, 0))
+    {
+        NDDS_Utility_sleep(&period);
+    }
+    RTI_TSFM_LogBackend_delete(backend);
+}
+
+void
+RTI_TSFM_Log_printf(const char *fmt, ...)
+{
+    struct RTI_TSFM_LogBackend *backend = NULL;
+    struct RTI_TSFM_LogRecord *record = NULL;
+    RTI_TSFM_AtomicCounter pos = 0,
+                           seq = 0;
+    DDS_LongLong diff = 0;
+    va_list args;
+    int len = 0;
+
+    (void)RTI_TSFM_Atomic_increment(&RTI_TSFM_Log_writers);
+    backend = (struct RTI_TSFM_LogBackend*)
+        RTI_TSFM_Atomic_load_ptr(&RTI_TSFM_Log_backend);
+
+    va_start(args, fmt);
+
+    if (backend == NULL)
+    {
+        vfprintf(stdout, fmt, args);
+        goto done;
+    }
+
+    pos = RTI_TSFM_Atomic_load(&backend->push_pos);
+    for (;;)
+    {
+        record = &backend->records[pos % RTI_TSFM_LOG_RING_CAPACITY];
+        seq = RTI_TSFM_Atomic_load(&record->seq);
+        diff = (DDS_LongLong)(seq - pos);
+
+        if (diff == 0)
+        {
+            if (RTI_TSFM_Atomic_compare_and_swap(
+                    &backend->push_pos, pos, pos + 1))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* The ring is full: the drain thread is a whole lap behind.
+               A transformation never blocks on logging, so the message
+               is only counted. */
+            (void)RTI_TSFM_Atomic_increment(&backend->dropped);
+            goto done;
+        }
+        pos = RTI_TSFM_Atomic_load(&backend->push_pos);
+    }
+
+    if (!RTI_TSFM_LogRecord_capture(record, fmt, args))
+    {
+        record->fmt = NULL;
+        len = vsnprintf(record->strings,
+                RTI_TSFM_LOG_RECORD_STRINGS_LEN, fmt, args);
+        if (len < 0)
+        {
+            record->strings[0] = '\0';
+        }
+        else if (len >= RTI_TSFM_LOG_RECORD_STRINGS_LEN)
+        {
+            /* vsnprintf() cut the trailing '\n' of the format */
+            record->strings[RTI_TSFM_LOG_RECORD_STRINGS_LEN - 2] = '\n';
+        }
+    }
+    RTI_TSFM_Atomic_store(&record->seq, pos + 1);
+
+done:
+    va_end(args);
+
+    (void)RTI_TSFM_Atomic_decrement(&RTI_TSFM_Log_writers);
+}
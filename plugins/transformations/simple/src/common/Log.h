@@ -0,0 +1,102 @@
+/*
+ * (c) 2019 Copyright, Real-Time Innovations, Inc.  All rights reserved.
+ *
+ * RTI grants Licensee a license to use, modify, compile, and create derivative
+ * works of the Software.  Licensee has the right to distribute object form
+ * only for use with RTI products.  The Software is provided "as is", with no
+ * warranty of any type, including any warranty for fitness for any purpose.
+ * RTI is under no obligation to maintain or support the Software.  RTI shall
+ * not be liable for any incidental or consequential damages arising out of the
+ * use or inability to use the software.
+ */
+
+#ifndef Log_h
+#define Log_h
+
+#include "rtitransform_simple.h"
+
+#include "Infrastructure.h"
+
+#define RTI_TSFM_LOG_RECORD_MAX_ARGS        12
+
+#define RTI_TSFM_LOG_RECORD_STRINGS_LEN     256
+
+#define RTI_TSFM_LOG_SPEC_MAX_LEN           16
+
+#define RTI_TSFM_LOG_RING_CAPACITY          4096
+
+#define RTI_TSFM_LOG_DRAIN_PERIOD_NS        10000000
+
+#define RTI_TSFM_LOG_QUIESCE_PERIOD_NS      100000
+
+#if RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_POSIX
+typedef pthread_t RTI_TSFM_Thread;
+#elif RTI_TSFM_PLATFORM == RTI_TSFM_PLATFORM_WINDOWS
+typedef HANDLE RTI_TSFM_Thread;
+#endif
+
+typedef enum RTI_TSFM_LogArgKind
+{
+    RTI_TSFM_LogArgKind_INT,
+    RTI_TSFM_LogArgKind_LONG,
+    RTI_TSFM_LogArgKind_LONGLONG,
+    RTI_TSFM_LogArgKind_UINT,
+    RTI_TSFM_LogArgKind_ULONG,
+    RTI_TSFM_LogArgKind_ULONGLONG,
+    RTI_TSFM_LogArgKind_SIZE,
+    RTI_TSFM_LogArgKind_DOUBLE,
+    RTI_TSFM_LogArgKind_POINTER,
+    RTI_TSFM_LogArgKind_STRING
+} RTI_TSFM_LogArgKind;
+
+union RTI_TSFM_LogArg
+{
+    DDS_LongLong            as_signed;
+    DDS_UnsignedLongLong    as_unsigned;
+    double                  as_double;
+    const void              *as_pointer;
+    /* offset of a string argument in the record's `strings` */
+    DDS_UnsignedLong        as_string;
+};
+
+/*
+ * A slot of the log ring. `seq` tells whether the slot is free for the
+ * message logged at a certain position (seq == position), or holds it
+ * until the drain thread formats it (seq == position + 1).
+ *
+ * A transformation only stores the format (a literal from the
+ * RTI_TSFM_LOG_* macros) and the raw arguments. Member names and other
+ * strings are copied into `strings`, because the samples they come from
+ * are returned to the reader right after the transformation runs. A format
+ * with a conversion that can't be stored is printed into `strings`
+ * instead, and `fmt` is set to NULL.
+ */
+struct RTI_TSFM_LogRecord
+{
+    RTI_TSFM_AtomicCounter  seq;
+    const char              *fmt;
+    DDS_UnsignedLong        args_len;
+    DDS_UnsignedLong        strings_len;
+    unsigned char           kinds[RTI_TSFM_LOG_RECORD_MAX_ARGS];
+    union RTI_TSFM_LogArg   args[RTI_TSFM_LOG_RECORD_MAX_ARGS];
+    char                    strings[RTI_TSFM_LOG_RECORD_STRINGS_LEN];
+};
+
+/*
+ * The asynchronous backend used by every transformation of the library:
+ * a bounded ring of records which any thread can append to without locks,
+ * and which is drained by a single background thread.
+ */
+struct RTI_TSFM_LogBackend
+{
+    struct RTI_TSFM_LogRecord   *records;
+    RTI_TSFM_AtomicCounter      push_pos;
+    RTI_TSFM_AtomicCounter      pop_pos;
+    FILE                        *output;
+    RTI_TSFM_Thread             thread;
+    DDS_Boolean                 thread_started;
+    RTI_TSFM_AtomicCounter      stopped;
+    RTI_TSFM_AtomicCounter      dropped;
+};
+
+#endif /* Log_h */
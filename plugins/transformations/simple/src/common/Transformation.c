@@ -468,56 +468,90 @@ RTI_TSFM_Transformation_transform(
 
     for (i = 0; i < in_count; i++)
     {
-        DDS_DynamicData *out_sample = out_samples[i],
-                        *in_sample = in_samples[i];
-
-        if (out_sample == NULL)
+        if (out_samples[i] == NULL)
         {
-            out_sample = 
+            out_samples[i] = 
                 DDS_DynamicDataTypeSupport_create_data(self->tsupport);
-            out_samples[i] = out_sample;
         }
 
-        if (in_sample == NULL || out_sample == NULL)
+        if (in_samples[i] == NULL || out_samples[i] == NULL)
         {
             /* TODO Log error */
             goto done;
         }
-        
-        switch (self->config->type)
+    }
+
+    switch (self->config->type)
+    {
+    case RTI_TSFM_TransformationKind_SERIALIZER:
+        if (self->plugin->user_plugin->serialize_batch != NULL)
+        {
+            if (DDS_RETCODE_OK != 
+                    self->plugin->user_plugin->serialize_batch(
+                                            self->plugin->user_plugin, 
+                                            self, 
+                                            in_samples,
+                                            out_samples,
+                                            in_count))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+            out_samples_initd = in_count;
+            break;
+        }
+        for (i = 0; i < in_count; i++)
         {
-        case RTI_TSFM_TransformationKind_SERIALIZER:
             if (DDS_RETCODE_OK != 
                     self->plugin->user_plugin->serialize_sample(
                                             self->plugin->user_plugin, 
                                             self, 
-                                            in_sample,
-                                            out_sample))
+                                            in_samples[i],
+                                            out_samples[i]))
             {
                 /* TODO Log error */
                 goto done;
             }
+            out_samples_initd += 1;
+        }
+        break;
+    
+    case RTI_TSFM_TransformationKind_DESERIALIZER:
+        if (self->plugin->user_plugin->deserialize_batch != NULL)
+        {
+            if (DDS_RETCODE_OK != 
+                    self->plugin->user_plugin->deserialize_batch(
+                                            self->plugin->user_plugin, 
+                                            self, 
+                                            in_samples,
+                                            out_samples,
+                                            in_count))
+            {
+                /* TODO Log error */
+                goto done;
+            }
+            out_samples_initd = in_count;
             break;
-        
-        case RTI_TSFM_TransformationKind_DESERIALIZER:
+        }
+        for (i = 0; i < in_count; i++)
+        {
             if (DDS_RETCODE_OK != 
                     self->plugin->user_plugin->deserialize_sample(
                                             self->plugin->user_plugin, 
                                             self, 
-                                            in_sample,
-                                            out_sample))
+                                            in_samples[i],
+                                            out_samples[i]))
             {
                 /* TODO Log error */
                 goto done;
             }
-            break;
-        
-        default:
-            /* TODO Log error */
-            goto done;
+            out_samples_initd += 1;
         }
-
-        out_samples_initd += 1;
+        break;
+    
+    default:
+        /* TODO Log error */
+        goto done;
     }
 
     self->read_buffer_loaned = DDS_BOOLEAN_TRUE;